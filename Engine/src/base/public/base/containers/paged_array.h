@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "base/debug/assert.h"
+
+namespace Mizu
+{
+
+// Fixed max size array split into pages that are allocated on demand. The page table is sized once on construction
+// and pages are never moved, so references stay valid and a reader can access allocated elements while a single
+// writer allocates new pages, as long as it learned about the element through a release/acquire pair.
+template <typename T, size_t PageSize = 1024>
+class paged_array
+{
+    static_assert(PageSize > 0, "Can't create paged_array with PageSize == 0");
+
+  public:
+    paged_array() = default;
+
+    explicit paged_array(size_t max_size, const T& default_value = T{})
+        : m_max_size(max_size)
+        , m_num_pages((max_size + PageSize - 1) / PageSize)
+        , m_default_value(default_value)
+    {
+        m_pages = std::make_unique<std::atomic<T*>[]>(m_num_pages);
+        for (size_t i = 0; i < m_num_pages; ++i)
+        {
+            m_pages[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~paged_array()
+    {
+        for (size_t i = 0; i < m_num_pages; ++i)
+        {
+            delete[] m_pages[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    paged_array(const paged_array&) = delete;
+    paged_array& operator=(const paged_array&) = delete;
+
+    // Allocates the page containing `pos` if needed, new elements are set to the default value.
+    // Must only be called from the writer thread.
+    void ensure(size_t pos)
+    {
+        MIZU_ASSERT(pos < m_max_size, "Position is out of range");
+
+        std::atomic<T*>& page = m_pages[pos / PageSize];
+        if (page.load(std::memory_order_relaxed) != nullptr)
+            return;
+
+        T* new_page = new T[PageSize];
+        std::fill(new_page, new_page + PageSize, m_default_value);
+
+        page.store(new_page, std::memory_order_release);
+    }
+
+    bool is_allocated(size_t pos) const
+    {
+        return pos < m_max_size && m_pages[pos / PageSize].load(std::memory_order_acquire) != nullptr;
+    }
+
+    T& operator[](size_t pos) { return get_page(pos)[pos % PageSize]; }
+    const T& operator[](size_t pos) const { return get_page(pos)[pos % PageSize]; }
+
+    size_t max_size() const { return m_max_size; }
+
+    size_t num_allocated_pages() const
+    {
+        size_t num_allocated = 0;
+        for (size_t i = 0; i < m_num_pages; ++i)
+        {
+            num_allocated += m_pages[i].load(std::memory_order_relaxed) != nullptr ? 1 : 0;
+        }
+
+        return num_allocated;
+    }
+
+  private:
+    std::unique_ptr<std::atomic<T*>[]> m_pages;
+    size_t m_max_size = 0;
+    size_t m_num_pages = 0;
+    T m_default_value{};
+
+    T* get_page(size_t pos) const
+    {
+        MIZU_ASSERT(pos < m_max_size, "Position is out of range");
+
+        T* page = m_pages[pos / PageSize].load(std::memory_order_acquire);
+        MIZU_ASSERT(page != nullptr, "Accessing a page that has not been allocated");
+
+        return page;
+    }
+};
+
+} // namespace Mizu
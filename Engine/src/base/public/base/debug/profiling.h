@@ -18,6 +18,10 @@ namespace Mizu
 
 #define MIZU_PROFILE_ZONE_END(_ctx) TracyCZoneEnd(_ctx)
 
+// Appends text to / renames the zone of the enclosing MIZU_PROFILE_SCOPED
+#define MIZU_PROFILE_ZONE_TEXT(_text, _size) ZoneText(_text, _size)
+#define MIZU_PROFILE_ZONE_NAME(_name, _size) ZoneName(_name, _size)
+
 #define MIZU_PROFILE_FRAME_MARK FrameMark
 
 #define MIZU_PROFILE_FIBER_ENTER(_name) TracyCFiberEnter(_name)
@@ -40,6 +44,9 @@ namespace Mizu
 
 #define MIZU_PROFILE_ZONE_END(_ctx)
 
+#define MIZU_PROFILE_ZONE_TEXT(_text, _size)
+#define MIZU_PROFILE_ZONE_NAME(_name, _size)
+
 #define MIZU_PROFILE_FRAME_MARK
 
 #define MIZU_PROFILE_FIBER_ENTER(_name)
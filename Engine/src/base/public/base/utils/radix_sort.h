@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+
+#include "base/debug/assert.h"
+
+namespace Mizu
+{
+
+// Stable LSD radix sort of 64-bit keys, `values` are reordered along with their keys. Sorting small values (like
+// indices into the real elements) instead of the elements themselves avoids moving big payloads around on every pass.
+// The temporary spans must be at least as big as `keys`. Passes where every key has the same digit are skipped, so
+// keys that only use some of their bits are cheaper to sort.
+inline void radix_sort(
+    std::span<uint64_t> keys,
+    std::span<uint32_t> values,
+    std::span<uint64_t> tmp_keys,
+    std::span<uint32_t> tmp_values)
+{
+    constexpr uint32_t RADIX_BITS = 8;
+    constexpr uint32_t RADIX_SIZE = 1u << RADIX_BITS;
+    constexpr uint32_t RADIX_MASK = RADIX_SIZE - 1;
+    constexpr uint32_t NUM_PASSES = 64 / RADIX_BITS;
+
+    MIZU_ASSERT(keys.size() == values.size(), "Every key must have a value ({} != {})", keys.size(), values.size());
+    MIZU_ASSERT(
+        tmp_keys.size() >= keys.size() && tmp_values.size() >= keys.size(),
+        "Temporary buffers are too small for {} keys",
+        keys.size());
+    MIZU_ASSERT(keys.size() <= std::numeric_limits<uint32_t>::max(), "Too many keys to sort ({})", keys.size());
+
+    const size_t count = keys.size();
+    if (count <= 1)
+        return;
+
+    // Histograms of every digit are built in a single read of the keys
+    std::array<std::array<uint32_t, RADIX_SIZE>, NUM_PASSES> histograms{};
+    for (const uint64_t key : keys)
+    {
+        for (uint32_t pass = 0; pass < NUM_PASSES; ++pass)
+        {
+            histograms[pass][(key >> (pass * RADIX_BITS)) & RADIX_MASK] += 1;
+        }
+    }
+
+    uint64_t* src_keys = keys.data();
+    uint32_t* src_values = values.data();
+    uint64_t* dst_keys = tmp_keys.data();
+    uint32_t* dst_values = tmp_values.data();
+
+    for (uint32_t pass = 0; pass < NUM_PASSES; ++pass)
+    {
+        std::array<uint32_t, RADIX_SIZE>& offsets = histograms[pass];
+        const uint32_t shift = pass * RADIX_BITS;
+
+        // Every key has the same digit, the pass would not change the order
+        if (offsets[(src_keys[0] >> shift) & RADIX_MASK] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for (uint32_t& bucket : offsets)
+        {
+            const uint32_t bucket_count = bucket;
+            bucket = offset;
+            offset += bucket_count;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint64_t key = src_keys[i];
+            const uint32_t dst = offsets[(key >> shift) & RADIX_MASK]++;
+
+            dst_keys[dst] = key;
+            dst_values[dst] = src_values[i];
+        }
+
+        std::swap(src_keys, dst_keys);
+        std::swap(src_values, dst_values);
+    }
+
+    if (src_keys != keys.data())
+    {
+        std::copy_n(src_keys, count, keys.data());
+        std::copy_n(src_values, count, values.data());
+    }
+}
+
+} // namespace Mizu
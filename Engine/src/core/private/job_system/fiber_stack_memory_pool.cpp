@@ -1,34 +1,123 @@
 #include "core/job_system/fiber_stack_memory_pool.h"
 
-#include <cstring>
+#if MIZU_PLATFORM_WINDOWS
+
+#include <windows.h>
+
+#elif MIZU_PLATFORM_UNIX
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#endif
 
 #include "base/debug/assert.h"
 
 namespace Mizu
 {
 
-bool FiberStackMemoryPool::init(size_t num_pools, size_t size_bytes)
+static size_t get_system_page_size()
 {
-    m_num_pools = num_pools;
-    m_size_bytes = size_bytes;
+#if MIZU_PLATFORM_WINDOWS
+    SYSTEM_INFO system_info{};
+    GetSystemInfo(&system_info);
+    return static_cast<size_t>(system_info.dwPageSize);
+#elif MIZU_PLATFORM_UNIX
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
 
-    const size_t total_size = num_pools * size_bytes;
-    m_pool = std::vector<uint8_t>(total_size);
+static uint8_t* reserve_address_space(size_t size)
+{
+#if MIZU_PLATFORM_WINDOWS
+    void* ptr = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+    return static_cast<uint8_t*>(ptr);
+#elif MIZU_PLATFORM_UNIX
+    void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return ptr != MAP_FAILED ? static_cast<uint8_t*>(ptr) : nullptr;
+#endif
+}
+
+static bool commit_memory(uint8_t* ptr, size_t size)
+{
+#if MIZU_PLATFORM_WINDOWS
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#elif MIZU_PLATFORM_UNIX
+    // Pages are only backed by physical memory once they are touched, mprotect just makes them accessible.
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+static void release_address_space(uint8_t* ptr, [[maybe_unused]] size_t size)
+{
+#if MIZU_PLATFORM_WINDOWS
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#elif MIZU_PLATFORM_UNIX
+    munmap(ptr, size);
+#endif
+}
+
+FiberStackMemoryPool::~FiberStackMemoryPool()
+{
+    release();
+}
+
+bool FiberStackMemoryPool::init(size_t num_stacks, size_t size_bytes)
+{
+    MIZU_ASSERT(num_stacks > 0 && size_bytes > 0, "Invalid FiberStackMemoryPool dimensions");
+
+    release();
+
+    m_num_stacks = num_stacks;
+
+    m_page_size = get_system_page_size();
+    m_stack_size = (size_bytes + m_page_size - 1) & ~(m_page_size - 1);
+
+    // Each slot is laid out as [guard page][stack], the guard page is never committed.
+    m_slot_size = m_page_size + m_stack_size;
+    m_reserved_size = num_stacks * m_slot_size;
+
+    m_base = reserve_address_space(m_reserved_size);
+    if (m_base == nullptr)
+    {
+        MIZU_LOG_ERROR("Failed to reserve {} bytes for fiber stacks", m_reserved_size);
+        m_reserved_size = 0;
+        return false;
+    }
+
+    m_committed = std::make_unique<std::atomic<bool>[]>(num_stacks);
+    m_committed_size.store(0, std::memory_order_relaxed);
 
     return true;
 }
 
 uint8_t* FiberStackMemoryPool::get_memory(size_t index)
 {
-    MIZU_ASSERT(index < m_num_pools, "Trying to get memory with invalid index");
+    MIZU_ASSERT(index < m_num_stacks, "Trying to get memory with invalid index");
+
+    uint8_t* stack = m_base + index * m_slot_size + m_page_size;
+
+    // A slot index is owned by a single fiber at a time, the exchange only guards against committing twice.
+    if (!m_committed[index].exchange(true, std::memory_order_acq_rel))
+    {
+        MIZU_VERIFY(commit_memory(stack, m_stack_size), "Failed to commit fiber stack memory");
+        m_committed_size.fetch_add(m_stack_size, std::memory_order_relaxed);
+    }
 
-    const size_t pool_index = index * m_size_bytes;
-    MIZU_ASSERT(pool_index < m_pool.size() && pool_index + m_size_bytes < m_pool.size(), "Invalid index");
+    return stack;
+}
+
+void FiberStackMemoryPool::release()
+{
+    if (m_base == nullptr)
+        return;
 
-    uint8_t* start = &m_pool[pool_index];
-    std::memset(start, 0u, m_size_bytes);
+    release_address_space(m_base, m_reserved_size);
 
-    return start;
+    m_base = nullptr;
+    m_reserved_size = 0;
+    m_committed.reset();
+    m_committed_size.store(0, std::memory_order_relaxed);
 }
 
 } // namespace Mizu
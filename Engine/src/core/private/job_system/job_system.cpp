@@ -1,6 +1,10 @@
 #include "core/job_system/job_system.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdio>
+#include <immintrin.h>
 #include <string>
 #include <thread>
 #include <utility>
@@ -44,6 +48,17 @@ JobHandle::JobHandle(JobHandle&& other)
 {
 }
 
+JobHandle& JobHandle::operator=(JobHandle&& other)
+{
+    if (this == &other)
+        return *this;
+
+    this->~JobHandle();
+    new (this) JobHandle(std::move(other));
+
+    return *this;
+}
+
 JobHandle::~JobHandle()
 {
     if (owner == nullptr)
@@ -68,19 +83,28 @@ JobHandle::~JobHandle()
 JobHandle PendingJob::submit()
 {
     m_submitted = true;
-    return m_owner->submit_internal(std::move(*this));
+
+    JobHandle handle = m_owner->submit_internal(std::move(*this));
+    m_owner->release_handles(m_owned_dependencies.as_span());
+
+    return handle;
 }
 
 // Needs to be here because it needs to know that JobSystem is a complete type to be able to call submit_internal
 JobHandle PendingBatch::submit()
 {
     m_submitted = true;
-    return m_owner->submit_internal(std::move(*this));
+
+    JobHandle handle = m_owner->submit_internal(std::move(*this));
+    m_owner->release_handles(m_owned_dependencies.as_span());
+
+    return handle;
 }
 
 static constexpr uint32_t MainWorkerId = 0;
 thread_local uint32_t s_worker_id = std::numeric_limits<uint32_t>::max();
 thread_local size_t s_external_submission_round_robin = 0;
+thread_local uint32_t s_backpressure_depth = 0;
 
 JobSystem::~JobSystem()
 {
@@ -91,11 +115,47 @@ JobSystem::~JobSystem()
 
 bool JobSystem::init(uint32_t num_workers, bool reserve_main_thread)
 {
-    MIZU_ASSERT(num_workers > 0, "Must have at least one worker thread");
+    JobSystemDescription desc{};
+    desc.num_workers = num_workers;
+    desc.reserve_main_thread = reserve_main_thread;
+
+    return init(desc);
+}
+
+bool JobSystem::init(const JobSystemDescription& desc)
+{
+    MIZU_ASSERT(desc.num_workers > 0, "Must have at least one worker thread");
 
-    m_small_fiber_stack_pool.init(PoolCapacity, get_stack_bytes(StackSize::Small));
-    m_medium_fiber_stack_pool.init(PoolCapacity, get_stack_bytes(StackSize::Medium));
-    m_large_fiber_stack_pool.init(PoolCapacity, get_stack_bytes(StackSize::Large));
+    uint32_t num_workers = desc.num_workers;
+    const bool reserve_main_thread = desc.reserve_main_thread;
+
+    m_idle_config = desc.idle;
+    m_worker_counters_enabled = desc.enable_worker_counters;
+
+    const JobSystemCapacityConfig& capacity = desc.capacity;
+    MIZU_ASSERT(
+        capacity.initial_pool_capacity > 0 && capacity.initial_pool_capacity <= capacity.max_pool_capacity,
+        "Invalid job pool capacity range");
+    MIZU_ASSERT(
+        capacity.initial_queue_capacity >= 2 && capacity.initial_queue_capacity <= capacity.max_queue_capacity,
+        "Invalid worker queue capacity range");
+
+    m_job_record_pool.init(capacity.initial_pool_capacity, capacity.max_pool_capacity);
+    m_completion_record_pool.init(capacity.initial_pool_capacity, capacity.max_pool_capacity);
+    m_wait_node_pool.init(capacity.initial_pool_capacity, capacity.max_pool_capacity);
+
+    for (const StackSize stack_size : {StackSize::Small, StackSize::Medium, StackSize::Large})
+    {
+        get_fiber_slot_pool(stack_size).init(capacity.initial_pool_capacity, capacity.max_pool_capacity);
+
+        // Only reserves address space, stacks are committed once a fiber slot is first used
+        FiberStackMemoryPool& stack_pool = get_fiber_stack_memory_pool(stack_size);
+        if (!stack_pool.init(capacity.max_pool_capacity, get_stack_bytes(stack_size)))
+        {
+            MIZU_LOG_ERROR("Failed to initialize fiber stack memory pool");
+            return false;
+        }
+    }
 
     const uint32_t num_cores = std::thread::hardware_concurrency();
     num_workers = std::min(num_workers, num_cores);
@@ -105,11 +165,59 @@ bool JobSystem::init(uint32_t num_workers, bool reserve_main_thread)
     m_is_enabled.store(true, std::memory_order_relaxed);
     m_main_thread_reserved = reserve_main_thread;
 
+    // Assign worker groups, group workers are taken right after the main worker
+    const uint32_t first_group_worker = reserve_main_thread ? 1 : 0;
+    const uint32_t num_available_workers = num_workers - first_group_worker;
+
+    const uint32_t num_simulation_workers = std::min(desc.groups.num_simulation_workers, num_available_workers);
+    const uint32_t num_render_workers =
+        std::min(desc.groups.num_render_workers, num_available_workers - num_simulation_workers);
+
+    if (num_simulation_workers != desc.groups.num_simulation_workers
+        || num_render_workers != desc.groups.num_render_workers)
+    {
+        MIZU_LOG_WARNING(
+            "Worker group layout does not fit in {} workers, using {} simulation and {} render workers",
+            num_workers,
+            num_simulation_workers,
+            num_render_workers);
+    }
+
+    for (std::vector<uint32_t>& group_workers : m_group_workers)
+    {
+        group_workers.clear();
+    }
+
     for (uint32_t i = 0; i < num_workers; i++)
     {
         WorkerInfo& info = m_workers[i];
         info.idx = i;
 
+        info.local_queue.init(capacity.initial_queue_capacity, capacity.max_queue_capacity);
+        info.incoming_queue.init(capacity.initial_queue_capacity, capacity.max_queue_capacity);
+
+        for (WorkerGroupLane& lane : info.group_lanes)
+        {
+            lane.queue.init(capacity.initial_queue_capacity, capacity.max_queue_capacity);
+            lane.incoming_queue.init(capacity.initial_queue_capacity, capacity.max_queue_capacity);
+        }
+
+        if (i == MainWorkerId && reserve_main_thread)
+            info.group = WorkerGroup::Main;
+        else if (i < first_group_worker + num_simulation_workers)
+            info.group = WorkerGroup::Simulation;
+        else if (i < first_group_worker + num_simulation_workers + num_render_workers)
+            info.group = WorkerGroup::Render;
+        else
+            info.group = WorkerGroup::General;
+
+        m_group_workers[static_cast<size_t>(info.group)].push_back(i);
+    }
+
+    for (uint32_t i = 0; i < num_workers; i++)
+    {
+        WorkerInfo& info = m_workers[i];
+
         // idx == 0 is reserved for the main thread
         if (i == MainWorkerId && reserve_main_thread)
             continue;
@@ -131,7 +239,7 @@ void JobSystem::attach_as_main_worker()
     worker_job(main_thread_info);
 }
 
-void JobSystem::wait_for(JobHandle handle)
+void JobSystem::wait_for(JobHandleRef handle)
 {
     if (is_valid_worker_id(s_worker_id))
     {
@@ -168,7 +276,7 @@ void JobSystem::wait_for(JobHandle handle)
     }
 }
 
-bool JobSystem::wait_for_blocking(JobHandle handle)
+bool JobSystem::wait_for_blocking(JobHandleRef handle)
 {
     CompletionRecord* completion_record = try_get_job_handle_completion_record(handle);
     if (completion_record == nullptr)
@@ -182,9 +290,187 @@ bool JobSystem::wait_for_blocking(JobHandle handle)
     return true;
 }
 
+void JobSystem::release_handles(std::span<JobHandle> handles)
+{
+    static constexpr size_t ChunkSize = 64;
+
+    struct PendingRelease
+    {
+        CompletionRecord* record = nullptr;
+        uint32_t count = 0;
+    };
+
+    for (size_t chunk_begin = 0; chunk_begin < handles.size(); chunk_begin += ChunkSize)
+    {
+        const size_t chunk_end = std::min(chunk_begin + ChunkSize, handles.size());
+
+        std::array<PendingRelease, ChunkSize> releases{};
+        size_t num_releases = 0;
+
+        for (size_t i = chunk_begin; i < chunk_end; ++i)
+        {
+            JobHandle& handle = handles[i];
+
+            CompletionRecord* completion_record =
+                handle.owner == this ? try_get_job_handle_completion_record(handle) : nullptr;
+
+            if (completion_record == nullptr)
+            {
+                // Owned by another JobSystem or already stale, release it the regular way
+                handle = JobHandle{};
+                continue;
+            }
+
+            // Detach without touching the references, they are dropped below
+            handle.completion_index = CompletionRecordPoolIndex{};
+            handle.owner = nullptr;
+
+            PendingRelease* releases_end = releases.data() + num_releases;
+            PendingRelease* release = std::find_if(releases.data(), releases_end, [&](const PendingRelease& r) {
+                return r.record == completion_record;
+            });
+
+            if (release == releases_end)
+            {
+                release->record = completion_record;
+                num_releases += 1;
+            }
+
+            release->count += 1;
+        }
+
+        std::array<CompletionRecordPoolIndex, ChunkSize> records_to_free{};
+        size_t num_records_to_free = 0;
+
+        for (size_t i = 0; i < num_releases; ++i)
+        {
+            const PendingRelease& release = releases[i];
+
+            MIZU_ASSERT(
+                release.record->references.load(std::memory_order_relaxed) >= release.count,
+                "JobHandle has completion record that has not enough references");
+
+            const uint32_t references =
+                release.record->references.fetch_sub(release.count, std::memory_order_acq_rel) - release.count;
+            if (references == 0)
+            {
+                records_to_free[num_records_to_free++] = release.record->pool_index;
+            }
+        }
+
+        m_completion_record_pool.free_batch(std::span(records_to_free.data(), num_records_to_free));
+    }
+}
+
+FiberStackMemoryStats JobSystem::get_fiber_stack_memory_stats() const
+{
+    FiberStackMemoryStats stats{};
+
+    for (const StackSize stack_size : {StackSize::Small, StackSize::Medium, StackSize::Large})
+    {
+        const FiberStackMemoryPool& stack_pool = get_fiber_stack_memory_pool(stack_size);
+        stats.reserved_bytes += stack_pool.get_reserved_size();
+        stats.committed_bytes += stack_pool.get_committed_size();
+    }
+
+    return stats;
+}
+
+JobSystemCapacityStats JobSystem::get_capacity_stats() const
+{
+    const auto get_pool_stats = [](const auto& pool) {
+        JobPoolCapacityStats stats{};
+        stats.capacity = pool.get_capacity();
+        stats.max_capacity = pool.get_max_capacity();
+        stats.high_water = pool.get_high_water();
+
+        return stats;
+    };
+
+    JobSystemCapacityStats stats{};
+    stats.job_records = get_pool_stats(m_job_record_pool);
+    stats.completion_records = get_pool_stats(m_completion_record_pool);
+    stats.wait_nodes = get_pool_stats(m_wait_node_pool);
+    stats.small_fiber_slots = get_pool_stats(get_fiber_slot_pool(StackSize::Small));
+    stats.medium_fiber_slots = get_pool_stats(get_fiber_slot_pool(StackSize::Medium));
+    stats.large_fiber_slots = get_pool_stats(get_fiber_slot_pool(StackSize::Large));
+
+    for (const WorkerInfo& info : m_workers)
+    {
+        stats.max_queue_capacity = std::max(stats.max_queue_capacity, info.local_queue.get_capacity());
+        stats.max_queue_capacity = std::max(stats.max_queue_capacity, info.incoming_queue.get_capacity());
+
+        for (const WorkerGroupLane& lane : info.group_lanes)
+        {
+            stats.max_queue_capacity = std::max(stats.max_queue_capacity, lane.queue.get_capacity());
+            stats.max_queue_capacity = std::max(stats.max_queue_capacity, lane.incoming_queue.get_capacity());
+        }
+    }
+
+    stats.num_backpressure_waits = m_num_backpressure_waits.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+JobSystemCounters JobSystem::get_counters() const
+{
+    JobSystemCounters counters{};
+
+    if (m_worker_counters_enabled)
+    {
+        counters.workers.reserve(m_workers.size());
+
+        for (const WorkerInfo& info : m_workers)
+        {
+            JobWorkerCounters& worker_counters = counters.workers.emplace_back();
+            worker_counters.num_jobs_executed = info.num_jobs_executed.load(std::memory_order_relaxed);
+            worker_counters.num_steal_attempts = info.num_steal_attempts.load(std::memory_order_relaxed);
+            worker_counters.num_steals = info.num_steals.load(std::memory_order_relaxed);
+            worker_counters.idle_time_ns = info.idle_time_ns.load(std::memory_order_relaxed);
+        }
+    }
+
+    counters.num_small_fibers_in_use = get_fiber_slot_pool(StackSize::Small).get_num_allocated();
+    counters.num_medium_fibers_in_use = get_fiber_slot_pool(StackSize::Medium).get_num_allocated();
+    counters.num_large_fibers_in_use = get_fiber_slot_pool(StackSize::Large).get_num_allocated();
+
+    return counters;
+}
+
+uint32_t JobSystem::get_num_group_workers(JobAffinity affinity) const
+{
+    const JobTarget target = resolve_job_target(affinity);
+    if (target.group == WorkerGroup::General)
+        return 0;
+
+    return static_cast<uint32_t>(m_group_workers[static_cast<size_t>(target.group)].size());
+}
+
+JobSystemIdleStats JobSystem::get_idle_stats() const
+{
+    JobSystemIdleStats stats{};
+
+    for (const WorkerInfo& info : m_workers)
+    {
+        stats.num_spins += info.num_idle_spins.load(std::memory_order_relaxed);
+        stats.num_yields += info.num_idle_yields.load(std::memory_order_relaxed);
+        stats.num_parks += info.num_parks.load(std::memory_order_relaxed);
+        stats.num_wakes += info.num_wakes.load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
 void JobSystem::kill()
 {
-    m_is_enabled.store(false, std::memory_order_relaxed);
+    m_is_enabled.store(false, std::memory_order_seq_cst);
+
+    // Unconditionally bump every epoch, a worker that is about to park will see the change and not go to sleep
+    for (WorkerInfo& info : m_workers)
+    {
+        info.wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+        info.wake_epoch.notify_one();
+    }
 }
 
 void JobSystem::wait_workers_dead()
@@ -212,34 +498,49 @@ void JobSystem::worker_job(WorkerInfo& info)
     info.worker_fiber = fiber_convert_thread_to_fiber();
 
     JobRecordRef job_record_ref{};
+    uint32_t idle_rounds = 0;
     while (m_is_enabled.load(std::memory_order_relaxed))
     {
         // Drain fairness amount of incoming jobs
         drain_incoming_queue(info, FairnessDrainBatchSize);
 
-        // Try to get from local queue first
-        if (info.local_queue.pop(job_record_ref))
+        if (try_pop_job(info, job_record_ref))
         {
+            idle_rounds = 0;
             execute_job(job_record_ref);
             continue;
         }
 
-        // If the local queue is empty, drain a batch of jobs and try to get a job from the local queue
-        if (drain_incoming_queue(info, DrainBatchSize) > 0 && info.local_queue.pop(job_record_ref))
+        // If the local queues are empty, drain a batch of jobs and try to get a job from the local queues
+        if (drain_incoming_queue(info, DrainBatchSize) > 0 && try_pop_job(info, job_record_ref))
         {
+            idle_rounds = 0;
             execute_job(job_record_ref);
             continue;
         }
 
-        // If there are no jobs in the incoming queue, try to steal
-        if (try_steal_job(info, job_record_ref))
+        // If there are no jobs in the incoming queues, try to steal, group work first
+        if (try_steal_group_job(info, JobLane::Normal, job_record_ref) || try_steal_job(info, job_record_ref))
         {
+            idle_rounds = 0;
             execute_job(job_record_ref);
             continue;
         }
 
-        // TODO: Revisit what is the best way to do this, should the thread sleep?
-        std::this_thread::yield();
+        if (m_worker_counters_enabled)
+        {
+            const auto idle_start = std::chrono::steady_clock::now();
+            idle_worker(info, idle_rounds);
+
+            const auto idle_time = std::chrono::steady_clock::now() - idle_start;
+            info.idle_time_ns.fetch_add(
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(idle_time).count()),
+                std::memory_order_relaxed);
+        }
+        else
+        {
+            idle_worker(info, idle_rounds);
+        }
     }
 
     fiber_revert_fiber_to_thread(info.worker_fiber);
@@ -249,18 +550,47 @@ void JobSystem::worker_job(WorkerInfo& info)
 
 size_t JobSystem::drain_incoming_queue(WorkerInfo& info, size_t batch_size)
 {
+    const auto drain = [batch_size](auto& incoming_queue, auto& local_queue) {
+        size_t count = 0;
+
+        // Stop before popping a job that doesn't fit, it would be lost
+        JobRecordRef job_record_ref{};
+        while (count < batch_size && !local_queue.full() && incoming_queue.pop(job_record_ref))
+        {
+            local_queue.push(job_record_ref);
+            count += 1;
+        }
+
+        return count;
+    };
+
     size_t count = 0;
 
-    JobRecordRef job_record_ref{};
-    while (count < batch_size && info.incoming_queue.pop(job_record_ref))
+    for (WorkerGroupLane& lane : info.group_lanes)
     {
-        info.local_queue.push(job_record_ref);
-        count += 1;
+        count += drain(lane.incoming_queue, lane.queue);
     }
 
+    count += drain(info.incoming_queue, info.local_queue);
+
     return count;
 }
 
+bool JobSystem::try_pop_job(WorkerInfo& info, JobRecordRef& out_record_ref)
+{
+    // High priority group jobs skip ahead of everything else, including the ones queued on other workers of the group
+    if (info.group_lanes[static_cast<size_t>(JobLane::High)].queue.pop(out_record_ref))
+        return true;
+
+    if (try_steal_group_job(info, JobLane::High, out_record_ref))
+        return true;
+
+    if (info.group_lanes[static_cast<size_t>(JobLane::Normal)].queue.pop(out_record_ref))
+        return true;
+
+    return info.local_queue.pop(out_record_ref);
+}
+
 bool JobSystem::try_steal_job(WorkerInfo& info, JobRecordRef& out_record_ref)
 {
     // Don't steal from yourself
@@ -274,7 +604,230 @@ bool JobSystem::try_steal_job(WorkerInfo& info, JobRecordRef& out_record_ref)
     const size_t steal_id = info.steal_id++ % m_workers.size();
 
     WorkerInfo& steal_info = m_workers[steal_id];
-    return steal_info.local_queue.steal(out_record_ref);
+    const bool stolen = steal_info.local_queue.steal(out_record_ref);
+
+    if (m_worker_counters_enabled)
+    {
+        info.num_steal_attempts.fetch_add(1, std::memory_order_relaxed);
+        info.num_steals.fetch_add(stolen ? 1 : 0, std::memory_order_relaxed);
+    }
+
+    return stolen;
+}
+
+bool JobSystem::try_steal_group_job(WorkerInfo& info, JobLane lane, JobRecordRef& out_record_ref)
+{
+    // Group jobs can only be stolen by workers of the same group
+    const std::vector<uint32_t>& group_workers = m_group_workers[static_cast<size_t>(info.group)];
+    const size_t num_group_workers = group_workers.size();
+
+    for (size_t i = 0; i < num_group_workers; ++i)
+    {
+        const uint32_t steal_id = group_workers[info.group_steal_id++ % num_group_workers];
+        if (steal_id == info.idx)
+            continue;
+
+        WorkerInfo& steal_info = m_workers[steal_id];
+        const bool stolen = steal_info.group_lanes[static_cast<size_t>(lane)].queue.steal(out_record_ref);
+
+        if (m_worker_counters_enabled)
+        {
+            info.num_steal_attempts.fetch_add(1, std::memory_order_relaxed);
+            info.num_steals.fetch_add(stolen ? 1 : 0, std::memory_order_relaxed);
+        }
+
+        if (stolen)
+            return true;
+    }
+
+    return false;
+}
+
+static void cpu_relax()
+{
+    _mm_pause();
+}
+
+void JobSystem::idle_worker(WorkerInfo& info, uint32_t& idle_rounds)
+{
+    if (m_idle_config.strategy == JobSystemIdleStrategy::Yield)
+    {
+        info.num_idle_yields.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+        return;
+    }
+
+    if (idle_rounds < m_idle_config.spin_count)
+    {
+        idle_rounds += 1;
+        info.num_idle_spins.fetch_add(1, std::memory_order_relaxed);
+        cpu_relax();
+        return;
+    }
+
+    if (idle_rounds < m_idle_config.spin_count + m_idle_config.yield_count)
+    {
+        idle_rounds += 1;
+        info.num_idle_yields.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+        return;
+    }
+
+    park_worker(info);
+    idle_rounds = 0;
+}
+
+void JobSystem::park_worker(WorkerInfo& info)
+{
+    const uint32_t epoch = info.wake_epoch.load(std::memory_order_seq_cst);
+
+    info.is_parked.store(true, std::memory_order_seq_cst);
+    m_num_parked_workers.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Pairs with the fence in wake_worker/wake_any_worker: either the producer sees is_parked and bumps the epoch, or
+    // this check sees the pushed job.
+    if (m_is_enabled.load(std::memory_order_seq_cst) && !has_pending_work(info))
+    {
+        info.num_parks.fetch_add(1, std::memory_order_relaxed);
+
+        MIZU_PROFILE_SCOPED_NAME("WorkerParked");
+        info.wake_epoch.wait(epoch, std::memory_order_seq_cst);
+    }
+
+    m_num_parked_workers.fetch_sub(1, std::memory_order_seq_cst);
+    info.is_parked.store(false, std::memory_order_seq_cst);
+}
+
+bool JobSystem::has_pending_work(const WorkerInfo& info) const
+{
+    if (!info.incoming_queue.empty() || !info.local_queue.empty())
+        return true;
+
+    for (const WorkerGroupLane& lane : info.group_lanes)
+    {
+        if (!lane.incoming_queue.empty() || !lane.queue.empty())
+            return true;
+    }
+
+    for (const uint32_t group_worker_id : m_group_workers[static_cast<size_t>(info.group)])
+    {
+        for (const WorkerGroupLane& lane : m_workers[group_worker_id].group_lanes)
+        {
+            if (group_worker_id != info.idx && !lane.queue.empty())
+                return true;
+        }
+    }
+
+    for (const WorkerInfo& other_info : m_workers)
+    {
+        if (other_info.idx != info.idx && is_stealable_worker_id(other_info.idx) && !other_info.local_queue.empty())
+            return true;
+    }
+
+    return false;
+}
+
+void JobSystem::wake_worker(WorkerInfo& info)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!info.is_parked.load(std::memory_order_seq_cst))
+        return;
+
+    info.num_wakes.fetch_add(1, std::memory_order_relaxed);
+    info.wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+    info.wake_epoch.notify_one();
+}
+
+void JobSystem::wake_any_worker()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_num_parked_workers.load(std::memory_order_seq_cst) == 0)
+        return;
+
+    const size_t start = m_wake_round_robin.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        WorkerInfo& info = m_workers[(start + i) % m_workers.size()];
+        if (info.idx != s_worker_id && try_claim_parked_worker(info))
+            return;
+    }
+}
+
+void JobSystem::wake_any_group_worker(WorkerGroup group)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_num_parked_workers.load(std::memory_order_seq_cst) == 0)
+        return;
+
+    for (const uint32_t group_worker_id : m_group_workers[static_cast<size_t>(group)])
+    {
+        if (group_worker_id != s_worker_id && try_claim_parked_worker(m_workers[group_worker_id]))
+            return;
+    }
+}
+
+bool JobSystem::try_claim_parked_worker(WorkerInfo& info)
+{
+    bool expected = true;
+    if (!info.is_parked.compare_exchange_strong(expected, false, std::memory_order_seq_cst))
+        return false;
+
+    info.num_wakes.fetch_add(1, std::memory_order_relaxed);
+    info.wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+    info.wake_epoch.notify_one();
+
+    return true;
+}
+
+void JobSystem::apply_backpressure()
+{
+    // Limits how deep jobs can be nested on the stack of the submitter
+    static constexpr uint32_t MaxBackpressureDepth = 4;
+
+    m_num_backpressure_waits.fetch_add(1, std::memory_order_relaxed);
+
+    if (is_valid_worker_id(s_worker_id) && s_backpressure_depth < MaxBackpressureDepth
+        && try_help_execute_job(get_thread_worker_info()))
+    {
+        return;
+    }
+
+    // External threads can't execute jobs, wait for the workers to make room
+    std::this_thread::yield();
+}
+
+bool JobSystem::try_help_execute_job(WorkerInfo& info)
+{
+    constexpr size_t DrainBatchSize = 16;
+
+    JobRecordRef job_record_ref{};
+
+    const bool found_job = try_pop_job(info, job_record_ref)
+                           || (drain_incoming_queue(info, DrainBatchSize) > 0 && try_pop_job(info, job_record_ref))
+                           || try_steal_group_job(info, JobLane::Normal, job_record_ref)
+                           || try_steal_job(info, job_record_ref);
+    if (!found_job)
+        return false;
+
+    // The job switches back to worker_fiber when it finishes or suspends, point it to the current context (which may
+    // be the fiber of another job) and restore the previous one afterwards.
+    const FiberHandle worker_fiber = info.worker_fiber;
+    const FiberSlotPoolIndex running_fiber_slot_index = info.running_fiber_slot_index;
+    const StackSize running_fiber_stack_size = info.running_fiber_stack_size;
+
+    s_backpressure_depth += 1;
+    execute_job(job_record_ref);
+    s_backpressure_depth -= 1;
+
+    info.worker_fiber = worker_fiber;
+    info.running_fiber_slot_index = running_fiber_slot_index;
+    info.running_fiber_stack_size = running_fiber_stack_size;
+
+    return true;
 }
 
 void JobSystem::execute_job(const JobRecordRef& job_record_ref)
@@ -329,6 +882,9 @@ void JobSystem::execute_job(const JobRecordRef& job_record_ref)
 
     worker_info.running_fiber_slot_index = FiberSlotPoolIndex{};
 
+    if (m_worker_counters_enabled)
+        worker_info.num_jobs_executed.fetch_add(1, std::memory_order_relaxed);
+
     const uint32_t counter = completion_record.counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
     if (counter == 0)
     {
@@ -477,7 +1033,7 @@ JobHandle JobSystem::submit_internal(PendingJob&& job)
 
     completion_record.references.fetch_add(1, std::memory_order_relaxed);
 
-    submit_job_record_internal(job_record, job.m_desc, job.m_dependencies);
+    submit_job_record_internal(job_record, job.m_desc, job.m_dependencies.as_span());
 
     JobHandle handle{};
     handle.completion_index = completion_record.pool_index;
@@ -502,7 +1058,7 @@ JobHandle JobSystem::submit_internal(PendingBatch&& batch)
         init_fiber_slot(fiber_slot, job_record, desc);
         init_job_record(desc, job_record, completion_record, fiber_slot);
 
-        submit_job_record_internal(job_record, desc, batch.m_dependencies);
+        submit_job_record_internal(job_record, desc, batch.m_dependencies.as_span());
     }
 
     // If the batch is empty, set as completed already and reset is_completed and waiting_job_head.
@@ -521,16 +1077,94 @@ JobHandle JobSystem::submit_internal(PendingBatch&& batch)
     return handle;
 }
 
+JobHandle JobSystem::parallel_for_internal(JobRange range, size_t grain_size, ParallelForTask* task)
+{
+    if (range.empty())
+    {
+        delete task;
+        return schedule_batch().submit();
+    }
+
+    task->m_grain_size = std::max(grain_size, size_t{1});
+
+    CompletionRecord& completion_record = allocate_completion_record();
+    init_completion_record(completion_record, 0);
+
+    // Reference held by the returned handle
+    completion_record.references.fetch_add(1, std::memory_order_relaxed);
+
+    spawn_parallel_for_job(*task, range, completion_record);
+
+    JobHandle handle{};
+    handle.completion_index = completion_record.pool_index;
+    handle.generation = completion_record.generation;
+    handle.owner = this;
+
+    return handle;
+}
+
+void JobSystem::spawn_parallel_for_job(ParallelForTask& task, JobRange range, CompletionRecord& completion_record)
+{
+    // The spawning job still holds its own count, so the completion record can't complete while splitting
+    completion_record.counter.fetch_add(1, std::memory_order_relaxed);
+    completion_record.references.fetch_add(1, std::memory_order_relaxed);
+    task.m_references.fetch_add(1, std::memory_order_relaxed);
+
+    JobDescription desc = JobDescription::create([this, &task, range, &completion_record]() {
+        execute_parallel_for_job(task, range, completion_record);
+    });
+
+    JobRecord& job_record = allocate_job_record();
+    FiberSlot& fiber_slot = allocate_fiber_slot(desc.m_stack_size);
+
+    init_fiber_slot(fiber_slot, job_record, desc);
+    init_job_record(desc, job_record, completion_record, fiber_slot);
+
+    submit_job_record_internal(job_record, desc, {});
+}
+
+void JobSystem::execute_parallel_for_job(ParallelForTask& task, JobRange range, CompletionRecord& completion_record)
+{
+    MIZU_PROFILE_SCOPED;
+
+    const size_t grain_size = task.m_grain_size;
+
+    while (!range.empty())
+    {
+        // Lazy splitting, only give half of the range away once the previous half has been stolen. Without idle
+        // workers the range is executed in order by a single job.
+        const WorkerInfo& info = get_thread_worker_info();
+        if (range.size() >= 2 * grain_size && is_stealable_worker_id(info.idx) && info.local_queue.empty())
+        {
+            const size_t middle = range.begin + range.size() / 2;
+            spawn_parallel_for_job(task, JobRange{middle, range.end}, completion_record);
+
+            range.end = middle;
+            continue;
+        }
+
+        const size_t chunk_end = std::min(range.begin + grain_size, range.end);
+        task.execute(JobRange{range.begin, chunk_end});
+
+        range.begin = chunk_end;
+    }
+
+    if (task.m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete &task;
+    }
+}
+
 void JobSystem::submit_job_record_internal(
     JobRecord& job_record,
     [[maybe_unused]] const JobDescription& job_desc,
-    std::span<JobHandle> dependencies)
+    std::span<const JobHandleRef> dependencies)
 {
     // Start with a submission sentinel so dependency completions cannot drive the counter to zero
     // until all visible dependency edges have been published.
     job_record.num_remaining_dependencies.store(1, std::memory_order_relaxed);
 
-    for (const JobHandle& job_dependency : dependencies)
+    for (const JobHandleRef& job_dependency : dependencies)
     {
         CompletionRecord* dep_completion_record = try_get_job_handle_completion_record(job_dependency);
         if (dep_completion_record == nullptr)
@@ -616,69 +1250,116 @@ void JobSystem::init_fiber_slot(FiberSlot& fiber_slot, JobRecord& job_record, co
         reinterpret_cast<void*>(&job_record));
 }
 
-template <typename T>
-concept IsQueue = requires(T t, JobRecordRef value) {
-    { t.push(value) } -> std::same_as<bool>;
-};
-
-template <typename T>
-    requires IsQueue<T>
-static bool try_enqueue_job_record(T& queue, JobRecordRef value, uint32_t num_attempts)
-{
-    uint32_t attempts = 0;
-    while (attempts < num_attempts)
-    {
-        if (queue.push(value))
-            return true;
-
-        attempts += 1;
-        std::this_thread::yield();
-    }
-
-    return false;
-}
-
 void JobSystem::enqueue_job_record(const JobRecord& job_record)
 {
-    static constexpr uint32_t MaxEnqueueAttempts = 128;
+    // Queues only fail to push once they reach their maximum capacity
+    const auto push = [this](auto& queue, JobRecordRef value) {
+        while (!queue.push(value))
+        {
+            apply_backpressure();
+        }
+    };
 
-    const JobAffinity affinity = job_record.affinity;
+    const JobTarget target = resolve_job_target(job_record.affinity);
 
     JobRecordRef job_record_ref{};
     job_record_ref.index = job_record.pool_index;
     job_record_ref.generation = job_record.generation;
 
-    if (affinity == JobAffinity::Main && s_worker_id != MainWorkerId && is_valid_worker_id(s_worker_id))
+    const bool is_worker_thread = is_valid_worker_id(s_worker_id);
+    const bool is_group_job = target.group == WorkerGroup::Simulation || target.group == WorkerGroup::Render
+                              || target.lane == JobLane::High;
+
+    if (target.group == WorkerGroup::Main && s_worker_id != MainWorkerId)
     {
-        WorkerInfo& main_thread_info = m_workers[0];
-        // main_thread_info.incoming_queue.push(job_record_ref);
-        MIZU_VERIFY(
-            try_enqueue_job_record(main_thread_info.incoming_queue, job_record_ref, MaxEnqueueAttempts),
-            "Failed to enqueue job");
+        WorkerInfo& main_thread_info = m_workers[MainWorkerId];
+        push(main_thread_info.incoming_queue, job_record_ref);
+
+        wake_worker(main_thread_info);
     }
-    else if (affinity != JobAffinity::Any && affinity != JobAffinity::Main)
+    else if (is_group_job)
     {
-        // TODO: Should send to one of the workers with the specified affinity
-        MIZU_UNREACHABLE("Not implemented");
+        const size_t group_idx = static_cast<size_t>(target.group);
+        const size_t lane_idx = static_cast<size_t>(target.lane);
+
+        if (is_worker_thread && get_thread_worker_info().group == target.group)
+        {
+            WorkerInfo& worker_info = get_thread_worker_info();
+            push(worker_info.group_lanes[lane_idx].queue, job_record_ref);
+
+            wake_any_group_worker(target.group);
+        }
+        else
+        {
+            const std::vector<uint32_t>& group_workers = m_group_workers[group_idx];
+            const size_t round_robin = m_group_round_robin[group_idx].fetch_add(1, std::memory_order_relaxed);
+
+            WorkerInfo& worker_info = m_workers[group_workers[round_robin % group_workers.size()]];
+            push(worker_info.group_lanes[lane_idx].incoming_queue, job_record_ref);
+
+            wake_worker(worker_info);
+        }
     }
-    else if (is_valid_worker_id(s_worker_id))
+    else if (is_worker_thread)
     {
         WorkerInfo& worker_info = get_thread_worker_info();
-        // worker_info.local_queue.push(job_record_ref);
-        MIZU_VERIFY(
-            try_enqueue_job_record(worker_info.local_queue, job_record_ref, MaxEnqueueAttempts),
-            "Failed to enqueue job");
+        push(worker_info.local_queue, job_record_ref);
+
+        // The job can be stolen, give a parked worker the chance to pick it up
+        if (is_stealable_worker_id(worker_info.idx))
+            wake_any_worker();
     }
     else
     {
         // Trying to submit from a thread that is not a worker, distribute to random worker via round-robin
         WorkerInfo& worker_info = m_workers[s_external_submission_round_robin++ % m_workers.size()];
-        MIZU_VERIFY(
-            try_enqueue_job_record(worker_info.incoming_queue, job_record_ref, MaxEnqueueAttempts),
-            "Failed to enqueue job");
+        push(worker_info.incoming_queue, job_record_ref);
+
+        wake_worker(worker_info);
     }
 }
 
+JobSystem::JobTarget JobSystem::resolve_job_target(JobAffinity affinity) const
+{
+    JobTarget target{};
+
+    switch (affinity)
+    {
+    case JobAffinity::Any:
+        target = JobTarget{WorkerGroup::General, JobLane::Normal};
+        break;
+    case JobAffinity::Main:
+        target = JobTarget{WorkerGroup::Main, JobLane::Normal};
+        break;
+    case JobAffinity::SimulationHigh:
+        target = JobTarget{WorkerGroup::Simulation, JobLane::High};
+        break;
+    case JobAffinity::Simulation:
+        target = JobTarget{WorkerGroup::Simulation, JobLane::Normal};
+        break;
+    case JobAffinity::RenderHigh:
+        target = JobTarget{WorkerGroup::Render, JobLane::High};
+        break;
+    case JobAffinity::Render:
+        target = JobTarget{WorkerGroup::Render, JobLane::Normal};
+        break;
+    }
+
+    // Without a reserved main thread, worker 0 still executes the Main jobs
+    if (target.group == WorkerGroup::Main)
+        return target;
+
+    // Groups without workers fall back to the general workers
+    if (m_group_workers[static_cast<size_t>(target.group)].empty())
+        target.group = WorkerGroup::General;
+
+    // Without general workers there is no high priority lane to use, plain Any job
+    if (target.group == WorkerGroup::General && m_group_workers[static_cast<size_t>(WorkerGroup::General)].empty())
+        target.lane = JobLane::Normal;
+
+    return target;
+}
+
 JobRecord* JobSystem::try_get_job_record(const JobRecordRef& job_record_ref)
 {
     if (!job_record_ref.is_valid())
@@ -698,7 +1379,7 @@ JobRecord& JobSystem::get_job_record(const JobRecordRef& job_record_ref)
     return *record;
 }
 
-CompletionRecord* JobSystem::try_get_job_handle_completion_record(const JobHandle& handle)
+CompletionRecord* JobSystem::try_get_job_handle_completion_record(const JobHandleRef& handle)
 {
     if (!handle.is_valid())
         return nullptr;
@@ -713,7 +1394,7 @@ CompletionRecord* JobSystem::try_get_job_handle_completion_record(const JobHandl
     return &record;
 }
 
-CompletionRecord& JobSystem::get_job_handle_completion_record(const JobHandle& handle)
+CompletionRecord& JobSystem::get_job_handle_completion_record(const JobHandleRef& handle)
 {
     CompletionRecord* record = try_get_job_handle_completion_record(handle);
     MIZU_ASSERT(record != nullptr, "Invalid job handle");
@@ -761,10 +1442,23 @@ FiberSlot& JobSystem::get_fiber_slot(FiberSlotPoolIndex index, StackSize stack_s
     return *slot;
 }
 
+template <typename PoolT>
+auto JobSystem::allocate_pool_index(PoolT& pool)
+{
+    // Pools only fail to allocate once they reach their maximum capacity
+    auto index = pool.allocate();
+    while (!index.is_valid())
+    {
+        apply_backpressure();
+        index = pool.allocate();
+    }
+
+    return index;
+}
+
 JobRecord& JobSystem::allocate_job_record()
 {
-    JobRecordPoolIndex index = m_job_record_pool.allocate();
-    MIZU_ASSERT(index.is_valid(), "JobRecord allocate failed");
+    const JobRecordPoolIndex index = allocate_pool_index(m_job_record_pool);
 
     JobRecord& record = m_job_record_pool.get(index);
     record.generation += 1;
@@ -774,8 +1468,7 @@ JobRecord& JobSystem::allocate_job_record()
 
 CompletionRecord& JobSystem::allocate_completion_record()
 {
-    CompletionRecordPoolIndex index = m_completion_record_pool.allocate();
-    MIZU_ASSERT(index.is_valid(), "CompletionRecord allocate failed");
+    const CompletionRecordPoolIndex index = allocate_pool_index(m_completion_record_pool);
 
     CompletionRecord& record = m_completion_record_pool.get(index);
     record.generation += 1;
@@ -785,8 +1478,7 @@ CompletionRecord& JobSystem::allocate_completion_record()
 
 WaitNode& JobSystem::allocate_wait_node()
 {
-    WaitNodePoolIndex index = m_wait_node_pool.allocate();
-    MIZU_ASSERT(index.is_valid(), "WaitNode allocate failed");
+    const WaitNodePoolIndex index = allocate_pool_index(m_wait_node_pool);
 
     return m_wait_node_pool.get(index);
 }
@@ -795,8 +1487,7 @@ FiberSlot& JobSystem::allocate_fiber_slot(StackSize stack_size)
 {
     FiberSlotPool& pool = get_fiber_slot_pool(stack_size);
 
-    const FiberSlotPoolIndex index = pool.allocate();
-    MIZU_ASSERT(index.is_valid(), "FiberSlot allocate failed");
+    const FiberSlotPoolIndex index = allocate_pool_index(pool);
 
     FiberSlot& fiber_slot = pool.get(index);
     fiber_slot.stack_size = stack_size;
@@ -810,6 +1501,8 @@ void JobSystem::free_job_record(JobRecord& job_record)
     job_record.state.store(JobState::Free, std::memory_order_relaxed);
     job_record.waiting_on_completion_index = CompletionRecordPoolIndex{};
     job_record.waiting_on_completion_generation = 0;
+    // Release the captures now instead of when the record is reused
+    job_record.func = InplaceJobFunction{};
     m_job_record_pool.free(job_record.pool_index);
 }
 
@@ -848,6 +1541,19 @@ JobSystem::FiberSlotPool& JobSystem::get_fiber_slot_pool(StackSize stack_size)
     }
 }
 
+const JobSystem::FiberSlotPool& JobSystem::get_fiber_slot_pool(StackSize stack_size) const
+{
+    switch (stack_size)
+    {
+    case StackSize::Small:
+        return m_small_fiber_pool;
+    case StackSize::Medium:
+        return m_medium_fiber_pool;
+    case StackSize::Large:
+        return m_large_fiber_pool;
+    }
+}
+
 FiberStackMemoryPool& JobSystem::get_fiber_stack_memory_pool(StackSize stack_size)
 {
     switch (stack_size)
@@ -861,6 +1567,19 @@ FiberStackMemoryPool& JobSystem::get_fiber_stack_memory_pool(StackSize stack_siz
     }
 }
 
+const FiberStackMemoryPool& JobSystem::get_fiber_stack_memory_pool(StackSize stack_size) const
+{
+    switch (stack_size)
+    {
+    case StackSize::Small:
+        return m_small_fiber_stack_pool;
+    case StackSize::Medium:
+        return m_medium_fiber_stack_pool;
+    case StackSize::Large:
+        return m_large_fiber_stack_pool;
+    }
+}
+
 size_t JobSystem::get_stack_bytes(StackSize stack_size) const
 {
     // TODO: MAKE THIS SIZES CONFIGURABLE BY USER
@@ -880,10 +1599,22 @@ bool JobSystem::is_valid_worker_id(uint32_t worker_id) const
     return worker_id < m_workers.size();
 }
 
+bool JobSystem::is_stealable_worker_id(uint32_t worker_id) const
+{
+    // HACK: Don't steal from main worker
+    return !(m_main_thread_reserved && worker_id == MainWorkerId);
+}
+
 JobSystem::WorkerInfo& JobSystem::get_thread_worker_info()
 {
     MIZU_ASSERT(is_valid_worker_id(s_worker_id), "Invalid worker index for this thread");
     return m_workers[s_worker_id];
 }
 
+uint32_t JobSystem::get_thread_worker_id() const
+{
+    MIZU_ASSERT(is_valid_worker_id(s_worker_id), "Invalid worker index for this thread");
+    return s_worker_id;
+}
+
 } // namespace Mizu
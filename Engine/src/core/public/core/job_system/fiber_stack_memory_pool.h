@@ -1,23 +1,55 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <memory>
 
 namespace Mizu
 {
 
+// Reserves address space for `num_stacks` fiber stacks up front and only commits the memory of a stack the first time
+// it's requested. Every stack has a no-access guard page right below it (stacks grow downwards), so a stack overflow
+// faults instead of silently corrupting the neighbouring stack.
+//
+// Memory returned by `get_memory` is not cleared, fibers must not rely on a zeroed stack.
 class FiberStackMemoryPool
 {
   public:
-    bool init(size_t num_pools, size_t size_bytes);
+    FiberStackMemoryPool() = default;
+    FiberStackMemoryPool(const FiberStackMemoryPool&) = delete;
+    FiberStackMemoryPool& operator=(const FiberStackMemoryPool&) = delete;
+    FiberStackMemoryPool(FiberStackMemoryPool&&) = delete;
+    FiberStackMemoryPool& operator=(FiberStackMemoryPool&&) = delete;
 
+    ~FiberStackMemoryPool();
+
+    bool init(size_t num_stacks, size_t size_bytes);
+
+    // Returns the lowest address of the stack with the given index, committing it if needed.
+    // The stack spans [ptr, ptr + size_bytes).
     uint8_t* get_memory(size_t index);
 
+    size_t get_reserved_size() const { return m_reserved_size; }
+    size_t get_committed_size() const { return m_committed_size.load(std::memory_order_relaxed); }
+
+    size_t get_stack_size() const { return m_stack_size; }
+    size_t get_guard_size() const { return m_page_size; }
+
   private:
-    size_t m_num_pools = 0;
-    size_t m_size_bytes = 0;
+    size_t m_num_stacks = 0;
+
+    size_t m_page_size = 0;
+    size_t m_stack_size = 0;
+    size_t m_slot_size = 0;
+
+    uint8_t* m_base = nullptr;
+    size_t m_reserved_size = 0;
+
+    std::unique_ptr<std::atomic<bool>[]> m_committed;
+    std::atomic<size_t> m_committed_size = 0;
 
-    std::vector<uint8_t> m_pool;
+    void release();
 };
 
 } // namespace Mizu
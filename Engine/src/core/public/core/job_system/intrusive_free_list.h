@@ -4,9 +4,13 @@
 #include <concepts>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <span>
 #include <type_traits>
 #include <vector>
 
+#include "base/debug/assert.h"
+
 namespace Mizu
 {
 
@@ -34,11 +38,16 @@ struct IntrusiveFreeListIndex
 // clang-format off
 template <typename Tag>
 concept IsIntrusiveFreeListIndexValid =
-    sizeof(IntrusiveFreeListIndex<Tag>) == sizeof(uint32_t) 
+    sizeof(IntrusiveFreeListIndex<Tag>) == sizeof(uint32_t)
     && alignof(IntrusiveFreeListIndex<Tag>) == alignof(uint32_t)
     && std::is_trivially_copyable_v<IntrusiveFreeListIndex<Tag>>;
 // clang-format on
 
+// Records are stored in fixed size segments that are allocated on demand, so the list can grow from `initial_capacity`
+// up to `max_capacity` without moving (or invalidating references to) the records already handed out. Segments are
+// only released when the list is destroyed.
+//
+// `Capacity` is the default initial and maximum capacity, use `init` to configure a growable list.
 template <typename T, size_t Capacity, typename IndexTag>
 class IntrusiveFreeList
 {
@@ -50,6 +59,10 @@ class IntrusiveFreeList
     static_assert(IsIntrusiveFreeListIndexValid<IndexTag>, "Index must remain a trivially copyable uint32_t wrapper");
     static_assert(IsValidIntrusiveFreeListType<T, Index>, "T must contain pool_index and next_free members");
 
+    static constexpr uint32_t SegmentShift = 8;
+    static constexpr uint32_t SegmentSize = 1u << SegmentShift;
+    static constexpr uint32_t SegmentMask = SegmentSize - 1;
+
     inline static T s_invalid_record{};
 
     struct alignas(8) TaggedIndex
@@ -63,37 +76,58 @@ class IntrusiveFreeList
     static_assert(sizeof(TaggedIndex) == sizeof(uint64_t));
 
   public:
-    IntrusiveFreeList() : m_list(Capacity)
+    IntrusiveFreeList() { init(Capacity, Capacity); }
+
+    IntrusiveFreeList(const IntrusiveFreeList&) = delete;
+    IntrusiveFreeList& operator=(const IntrusiveFreeList&) = delete;
+
+    ~IntrusiveFreeList() { release_segments(); }
+
+    // Not thread-safe, must be called before the list is shared. Invalidates all previously allocated indices.
+    void init(size_t initial_capacity, size_t max_capacity)
     {
-        for (typename Index::ValueT i = 0; i < Capacity; ++i)
+        MIZU_ASSERT(
+            initial_capacity > 0 && initial_capacity <= max_capacity, "Invalid IntrusiveFreeList capacity range");
+        MIZU_ASSERT(
+            max_capacity < std::numeric_limits<typename Index::ValueT>::max(), "Capacity exceeds addressable range");
+
+        release_segments();
+
+        m_max_capacity = static_cast<uint32_t>(max_capacity);
+        m_segments = std::vector<std::atomic<T*>>((max_capacity + SegmentSize - 1) / SegmentSize);
+
+        const uint32_t initial = static_cast<uint32_t>(initial_capacity);
+        for (uint32_t i = 0; i < initial; ++i)
         {
-            T& record = m_list[i];
-            record.pool_index = Index{i};
-            record.next_free = (i != Capacity - 1) ? Index{i + 1} : Index{};
+            T& record = get_or_create_record(Index{i});
+            record.next_free = (i != initial - 1) ? Index{i + 1} : Index{};
         }
 
+        m_num_created.store(initial, std::memory_order_relaxed);
+        m_num_allocated.store(0, std::memory_order_relaxed);
+        m_high_water.store(0, std::memory_order_relaxed);
+
         m_free_head.store({0, 0}, std::memory_order_relaxed);
     }
 
     Index allocate()
     {
-        while (true)
-        {
-            TaggedIndex head = m_free_head.load(std::memory_order_acquire);
-            if (head.index == Index::InvalidValue)
-                return Index{};
+        Index index = pop_free();
+        if (!index.is_valid())
+            index = create();
 
-            T& record = get_record(Index{head.index});
-            const uint32_t next = record.next_free.value;
-            const TaggedIndex next_head{next, head.tag + 1};
+        if (index.is_valid())
+        {
+            const uint32_t num_allocated = m_num_allocated.fetch_add(1, std::memory_order_relaxed) + 1;
 
-            if (m_free_head.compare_exchange_weak(
-                    head, next_head, std::memory_order_acq_rel, std::memory_order_acquire))
+            uint32_t high_water = m_high_water.load(std::memory_order_relaxed);
+            while (num_allocated > high_water
+                   && !m_high_water.compare_exchange_weak(high_water, num_allocated, std::memory_order_relaxed))
             {
-                record.next_free = Index{};
-                return Index{head.index};
             }
         }
+
+        return index;
     }
 
     void free(Index index)
@@ -109,6 +143,35 @@ class IntrusiveFreeList
 
             if (m_free_head.compare_exchange_weak(head, new_head, std::memory_order_acq_rel, std::memory_order_acquire))
             {
+                m_num_allocated.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    // Links the records locally and publishes them with a single CAS on the free list head
+    void free_batch(std::span<const Index> indices)
+    {
+        if (indices.empty())
+            return;
+
+        for (size_t i = 0; i + 1 < indices.size(); ++i)
+        {
+            get_record(indices[i]).next_free = indices[i + 1];
+        }
+
+        T& last_record = get_record(indices.back());
+
+        while (true)
+        {
+            TaggedIndex head = m_free_head.load(std::memory_order_acquire);
+            last_record.next_free = Index{head.index};
+
+            const TaggedIndex new_head{indices.front().value, head.tag + 1};
+
+            if (m_free_head.compare_exchange_weak(head, new_head, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                m_num_allocated.fetch_sub(static_cast<uint32_t>(indices.size()), std::memory_order_relaxed);
                 return;
             }
         }
@@ -130,12 +193,115 @@ class IntrusiveFreeList
         return get_record(index);
     }
 
+    // Number of records created so far, the list never shrinks
+    size_t get_capacity() const { return m_num_created.load(std::memory_order_relaxed); }
+    size_t get_max_capacity() const { return m_max_capacity; }
+
+    size_t get_num_allocated() const { return m_num_allocated.load(std::memory_order_relaxed); }
+
+    // Maximum number of records that have been allocated at the same time
+    size_t get_high_water() const { return m_high_water.load(std::memory_order_relaxed); }
+
   private:
-    std::vector<T> m_list;
+    std::vector<std::atomic<T*>> m_segments;
+    uint32_t m_max_capacity = 0;
+
     std::atomic<TaggedIndex> m_free_head;
+    std::atomic<uint32_t> m_num_created = 0;
 
-    T& get_record(Index index) { return m_list[static_cast<size_t>(index.value)]; }
-    const T& get_record(Index index) const { return m_list[static_cast<size_t>(index.value)]; }
+    std::atomic<uint32_t> m_num_allocated = 0;
+    std::atomic<uint32_t> m_high_water = 0;
+
+    Index pop_free()
+    {
+        while (true)
+        {
+            TaggedIndex head = m_free_head.load(std::memory_order_acquire);
+            if (head.index == Index::InvalidValue)
+                return Index{};
+
+            T& record = get_record(Index{head.index});
+            const uint32_t next = record.next_free.value;
+            const TaggedIndex next_head{next, head.tag + 1};
+
+            if (m_free_head.compare_exchange_weak(
+                    head, next_head, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                record.next_free = Index{};
+                return Index{head.index};
+            }
+        }
+    }
+
+    // Grows the list by one record, records past the initial capacity never go through the free list before their
+    // first allocation.
+    Index create()
+    {
+        uint32_t num_created = m_num_created.load(std::memory_order_relaxed);
+        while (true)
+        {
+            if (num_created >= m_max_capacity)
+                return Index{};
+
+            if (m_num_created.compare_exchange_weak(num_created, num_created + 1, std::memory_order_relaxed))
+                break;
+        }
+
+        const Index index{num_created};
+
+        T& record = get_or_create_record(index);
+        record.next_free = Index{};
+
+        return index;
+    }
+
+    T& get_or_create_record(Index index)
+    {
+        std::atomic<T*>& segment_ptr = m_segments[index.value >> SegmentShift];
+
+        T* segment = segment_ptr.load(std::memory_order_acquire);
+        if (segment == nullptr)
+        {
+            const uint32_t first_index = index.value & ~SegmentMask;
+
+            T* new_segment = new T[SegmentSize];
+            for (uint32_t i = 0; i < SegmentSize; ++i)
+            {
+                new_segment[i].pool_index = Index{first_index + i};
+            }
+
+            if (segment_ptr.compare_exchange_strong(
+                    segment, new_segment, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                segment = new_segment;
+            }
+            else
+            {
+                // Another thread created the segment first
+                delete[] new_segment;
+            }
+        }
+
+        return segment[index.value & SegmentMask];
+    }
+
+    void release_segments()
+    {
+        for (std::atomic<T*>& segment_ptr : m_segments)
+        {
+            delete[] segment_ptr.exchange(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    T& get_record(Index index)
+    {
+        return m_segments[index.value >> SegmentShift].load(std::memory_order_acquire)[index.value & SegmentMask];
+    }
+
+    const T& get_record(Index index) const
+    {
+        return m_segments[index.value >> SegmentShift].load(std::memory_order_acquire)[index.value & SegmentMask];
+    }
 };
 
-} // namespace Mizu
\ No newline at end of file
+} // namespace Mizu
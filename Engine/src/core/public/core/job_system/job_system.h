@@ -1,12 +1,15 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <functional>
 #include <limits>
 #include <span>
 #include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "base/containers/inplace_vector.h"
 #include "base/debug/assert.h"
@@ -34,6 +37,9 @@ using CompletionRecordPoolIndex = IntrusiveFreeListIndex<CompletionRecordPoolTag
 using WaitNodePoolIndex = IntrusiveFreeListIndex<WaitNodePoolTag>;
 using FiberSlotPoolIndex = IntrusiveFreeListIndex<FiberSlotPoolTag>;
 
+// Simulation* and Render* jobs only execute on the workers of their group (see JobWorkerGroupLayout), the *High
+// variants are served before any other job of the group. If the group has no workers, the jobs are executed by the
+// general workers, *High jobs still skipping ahead of Any jobs.
 enum class JobAffinity
 {
     Any,
@@ -53,6 +59,118 @@ enum class StackSize
 
 class JobSystem;
 
+enum class JobSystemIdleStrategy
+{
+    // Yield the thread's time slice every time a worker runs out of work, keeps the core busy.
+    Yield,
+    // Spin for a while, then yield, and finally park the worker until new work is enqueued.
+    Adaptive,
+};
+
+struct JobSystemIdleConfig
+{
+    JobSystemIdleStrategy strategy = JobSystemIdleStrategy::Adaptive;
+
+    // Number of consecutive empty rounds spent spinning before starting to yield
+    uint32_t spin_count = 64;
+    // Number of consecutive empty rounds spent yielding before parking the worker
+    uint32_t yield_count = 16;
+};
+
+struct JobWorkerGroupLayout
+{
+    // Workers dedicated to JobAffinity::Simulation and JobAffinity::SimulationHigh jobs
+    uint32_t num_simulation_workers = 0;
+    // Workers dedicated to JobAffinity::Render and JobAffinity::RenderHigh jobs
+    uint32_t num_render_workers = 0;
+};
+
+struct JobSystemCapacityConfig
+{
+    // Records created up front for each pool (jobs, completions, wait nodes and fibers of each stack size). The pools
+    // grow on demand up to max_pool_capacity, fiber stack address space is reserved for all of them.
+    uint32_t initial_pool_capacity = 2048;
+    uint32_t max_pool_capacity = 8192;
+
+    // Capacity of each worker queue, must be powers of 2
+    uint32_t initial_queue_capacity = 512;
+    uint32_t max_queue_capacity = 8192;
+};
+
+struct JobSystemDescription
+{
+    uint32_t num_workers = 0;
+    bool reserve_main_thread = true;
+
+    // Group workers are taken from the workers not reserved for the main thread. When they have no group work left,
+    // they also execute JobAffinity::Any jobs.
+    JobWorkerGroupLayout groups{};
+    JobSystemIdleConfig idle{};
+    JobSystemCapacityConfig capacity{};
+
+    // Per worker counters sampled with JobSystem::get_counters(), off by default as they add atomic increments and
+    // clock reads to the scheduling hot paths
+    bool enable_worker_counters = false;
+};
+
+struct JobSystemIdleStats
+{
+    uint64_t num_spins = 0;
+    uint64_t num_yields = 0;
+    uint64_t num_parks = 0;
+    uint64_t num_wakes = 0;
+};
+
+struct JobPoolCapacityStats
+{
+    size_t capacity = 0;
+    size_t max_capacity = 0;
+    // Maximum number of records in use at the same time
+    size_t high_water = 0;
+};
+
+struct JobSystemCapacityStats
+{
+    JobPoolCapacityStats job_records{};
+    JobPoolCapacityStats completion_records{};
+    JobPoolCapacityStats wait_nodes{};
+    JobPoolCapacityStats small_fiber_slots{};
+    JobPoolCapacityStats medium_fiber_slots{};
+    JobPoolCapacityStats large_fiber_slots{};
+
+    // Largest capacity any worker queue has grown to
+    size_t max_queue_capacity = 0;
+    // Number of times a submitter found a pool or queue at its maximum capacity and had to help execute jobs or wait
+    uint64_t num_backpressure_waits = 0;
+};
+
+struct JobWorkerCounters
+{
+    // Jobs whose function returned on this worker
+    uint64_t num_jobs_executed = 0;
+    uint64_t num_steal_attempts = 0;
+    uint64_t num_steals = 0;
+    // Time spent spinning, yielding or parked without work
+    uint64_t idle_time_ns = 0;
+};
+
+struct JobSystemCounters
+{
+    // Indexed by worker id, empty when JobSystemDescription::enable_worker_counters is not set
+    std::vector<JobWorkerCounters> workers;
+
+    // Fibers currently allocated, either ready, running or suspended in wait_for
+    size_t num_small_fibers_in_use = 0;
+    size_t num_medium_fibers_in_use = 0;
+    size_t num_large_fibers_in_use = 0;
+};
+
+struct FiberStackMemoryStats
+{
+    size_t reserved_bytes = 0;
+    size_t committed_bytes = 0;
+};
+
 struct MIZU_CORE_API JobHandle
 {
     CompletionRecordPoolIndex completion_index{};
@@ -63,6 +181,7 @@ struct MIZU_CORE_API JobHandle
     JobHandle(const JobHandle& other);
     JobHandle& operator=(const JobHandle& other);
     JobHandle(JobHandle&& other);
+    JobHandle& operator=(JobHandle&& other);
 
     ~JobHandle();
 
@@ -71,6 +190,27 @@ struct MIZU_CORE_API JobHandle
     bool is_valid() const { return completion_index.is_valid(); }
 };
 
+// Non-owning view of a JobHandle, copying it does not touch the completion record references. The JobHandle it was
+// created from must outlive every use of the ref, which for dependencies means until `submit()` returns.
+struct JobHandleRef
+{
+    CompletionRecordPoolIndex completion_index{};
+    size_t generation = 0;
+    JobSystem* owner = nullptr;
+
+    JobHandleRef() = default;
+    JobHandleRef(const JobHandle& handle)
+        : completion_index(handle.completion_index)
+        , generation(handle.generation)
+        , owner(handle.owner)
+    {
+    }
+
+    bool operator==(const JobHandleRef& other) const = default;
+
+    bool is_valid() const { return completion_index.is_valid(); }
+};
+
 class JobDescription
 {
   public:
@@ -143,12 +283,21 @@ class MIZU_CORE_API PendingJob
         return std::move(*this);
     }
 
-    PendingJob& depends_on(JobHandle handle)
+    PendingJob& depends_on(JobHandleRef handle)
     {
         m_dependencies.push_back(handle);
         return *this;
     }
 
+    // Keeps the handle alive until the job is submitted, its reference is released with the rest of the owned
+    // dependencies in a single batch
+    PendingJob& depends_on(JobHandle&& handle)
+    {
+        m_dependencies.push_back(JobHandleRef{handle});
+        m_owned_dependencies.push_back(std::move(handle));
+        return *this;
+    }
+
     PendingJob& depends_on(std::span<const JobHandle> handles)
     {
         for (const JobHandle& handle : handles)
@@ -159,13 +308,24 @@ class MIZU_CORE_API PendingJob
         return *this;
     }
 
+    PendingJob& depends_on(std::span<const JobHandleRef> handles)
+    {
+        for (const JobHandleRef& handle : handles)
+        {
+            depends_on(handle);
+        }
+
+        return *this;
+    }
+
     JobHandle submit();
 
   private:
     JobSystem* m_owner = nullptr;
 
     JobDescription m_desc{};
-    inplace_vector<JobHandle, MaxJobDependencies> m_dependencies{};
+    inplace_vector<JobHandleRef, MaxJobDependencies> m_dependencies{};
+    inplace_vector<JobHandle, MaxJobDependencies> m_owned_dependencies{};
 
     bool m_submitted = false;
 
@@ -203,12 +363,21 @@ class MIZU_CORE_API PendingBatch
         return add(JobDescription::create(func, args...));
     }
 
-    PendingBatch& depends_on(JobHandle handle)
+    PendingBatch& depends_on(JobHandleRef handle)
     {
         m_dependencies.push_back(handle);
         return *this;
     }
 
+    // Keeps the handle alive until the batch is submitted, its reference is released with the rest of the owned
+    // dependencies in a single batch
+    PendingBatch& depends_on(JobHandle&& handle)
+    {
+        m_dependencies.push_back(JobHandleRef{handle});
+        m_owned_dependencies.push_back(std::move(handle));
+        return *this;
+    }
+
     PendingBatch& depends_on(std::span<const JobHandle> handles)
     {
         for (const JobHandle& handle : handles)
@@ -219,6 +388,16 @@ class MIZU_CORE_API PendingBatch
         return *this;
     }
 
+    PendingBatch& depends_on(std::span<const JobHandleRef> handles)
+    {
+        for (const JobHandleRef& handle : handles)
+        {
+            depends_on(handle);
+        }
+
+        return *this;
+    }
+
     JobHandle submit();
 
   private:
@@ -226,7 +405,8 @@ class MIZU_CORE_API PendingBatch
 
     static constexpr size_t MaxBatchJobs = 64;
     inplace_vector<JobDescription, MaxBatchJobs> m_jobs{};
-    inplace_vector<JobHandle, MaxJobDependencies> m_dependencies{};
+    inplace_vector<JobHandleRef, MaxJobDependencies> m_dependencies{};
+    inplace_vector<JobHandle, MaxJobDependencies> m_owned_dependencies{};
 
     bool m_submitted = false;
 
@@ -235,6 +415,61 @@ class MIZU_CORE_API PendingBatch
     friend class JobSystem;
 };
 
+struct JobRange
+{
+    size_t begin = 0;
+    size_t end = 0;
+
+    size_t size() const { return end - begin; }
+    bool empty() const { return begin >= end; }
+};
+
+// Type-erased function shared by all the jobs of a parallel_for, released by the last job that finishes
+class ParallelForTask
+{
+  public:
+    virtual ~ParallelForTask() = default;
+    virtual void execute(JobRange chunk) = 0;
+
+  private:
+    size_t m_grain_size = 1;
+    std::atomic<uint32_t> m_references = 0;
+
+    friend class JobSystem;
+};
+
+template <typename Func>
+class ParallelForTaskImpl final : public ParallelForTask
+{
+  public:
+    static_assert(
+        std::is_invocable_v<Func&, JobRange> || std::is_invocable_v<Func&, size_t>,
+        "parallel_for function must be invocable with a JobRange or a size_t index");
+
+    template <typename F>
+    explicit ParallelForTaskImpl(F&& func) : m_func(std::forward<F>(func))
+    {
+    }
+
+    void execute(JobRange chunk) override
+    {
+        if constexpr (std::is_invocable_v<Func&, JobRange>)
+        {
+            m_func(chunk);
+        }
+        else
+        {
+            for (size_t i = chunk.begin; i < chunk.end; ++i)
+            {
+                m_func(i);
+            }
+        }
+    }
+
+  private:
+    Func m_func;
+};
+
 enum class JobState
 {
     Free,
@@ -341,10 +576,15 @@ class MIZU_CORE_API JobSystem
     ~JobSystem();
 
     bool init(uint32_t num_workers, bool reserve_main_thread = true);
+    bool init(const JobSystemDescription& desc);
     void attach_as_main_worker();
 
-    void wait_for(JobHandle handle);
-    bool wait_for_blocking(JobHandle handle);
+    void wait_for(JobHandleRef handle);
+    bool wait_for_blocking(JobHandleRef handle);
+
+    // Drops the references of all the handles, grouping the ones that point to the same completion record so each
+    // record is only touched once. Handles are left invalid.
+    void release_handles(std::span<JobHandle> handles);
 
     void kill();
     void wait_workers_dead();
@@ -357,14 +597,110 @@ class MIZU_CORE_API JobSystem
 
     PendingBatch schedule_batch() { return PendingBatch{this}; }
 
+    // Invokes `func` for every index of `range`, either once per index (`func(size_t)`) or once per chunk of at least
+    // `grain_size` indices (`func(JobRange)`). The range is split lazily, only while other workers are around to steal
+    // the other half. `func` is copied and the returned handle completes once the whole range has been processed.
+    template <typename Func>
+    JobHandle parallel_for(JobRange range, size_t grain_size, Func&& func)
+    {
+        using TaskT = ParallelForTaskImpl<std::decay_t<Func>>;
+        return parallel_for_internal(range, grain_size, new TaskT(std::forward<Func>(func)));
+    }
+
+    // Maps every chunk (`map(JobRange) -> T`) or index (`map(size_t) -> T`) of `range` and combines the results with
+    // `reduce(T, T) -> T`, which must be associative and commutative. Waits for the result with `wait_for`, so it
+    // suspends the calling fiber instead of blocking the worker.
+    template <typename T, typename MapFunc, typename ReduceFunc>
+    T parallel_reduce(JobRange range, size_t grain_size, T identity, MapFunc&& map, ReduceFunc&& reduce)
+    {
+        // One partial result per worker, each on its own cache line
+        struct alignas(64) PartialResult
+        {
+            T value;
+        };
+
+        std::vector<PartialResult> partials(m_workers.size(), PartialResult{identity});
+
+        const JobHandle handle = parallel_for(range, grain_size, [&](JobRange chunk) {
+            T chunk_result = identity;
+            if constexpr (std::is_invocable_v<MapFunc&, JobRange>)
+            {
+                chunk_result = map(chunk);
+            }
+            else
+            {
+                for (size_t i = chunk.begin; i < chunk.end; ++i)
+                {
+                    chunk_result = reduce(std::move(chunk_result), map(i));
+                }
+            }
+
+            PartialResult& partial = partials[get_thread_worker_id()];
+            partial.value = reduce(std::move(partial.value), std::move(chunk_result));
+        });
+
+        wait_for(handle);
+
+        T result = identity;
+        for (PartialResult& partial : partials)
+        {
+            result = reduce(std::move(result), std::move(partial.value));
+        }
+
+        return result;
+    }
+
+    JobSystemIdleStats get_idle_stats() const;
+    FiberStackMemoryStats get_fiber_stack_memory_stats() const;
+    JobSystemCapacityStats get_capacity_stats() const;
+    JobSystemCounters get_counters() const;
+
+    uint32_t get_num_group_workers(JobAffinity affinity) const;
+
   private:
+    // Default capacities, the actual ones come from JobSystemCapacityConfig
     static constexpr size_t WorkerQueueCapacity = 512;
     static constexpr size_t PoolCapacity = 2048;
 
+    enum class WorkerGroup
+    {
+        General,
+        Main,
+        Simulation,
+        Render,
+    };
+
+    static constexpr size_t NumWorkerGroups = 4;
+
+    enum class JobLane
+    {
+        High,
+        Normal,
+    };
+
+    static constexpr size_t NumJobLanes = 2;
+
+    struct JobTarget
+    {
+        WorkerGroup group = WorkerGroup::General;
+        JobLane lane = JobLane::Normal;
+    };
+
+    // Jobs that can only be executed by workers of the same group, never stolen by workers of other groups
+    struct WorkerGroupLane
+    {
+        WorkStealingDeque<JobRecordRef, WorkerQueueCapacity> queue{};
+        MpscQueue<JobRecordRef, WorkerQueueCapacity> incoming_queue{};
+    };
+
     struct WorkerInfo
     {
         uint32_t idx = 0;
         size_t steal_id = 0;
+        size_t group_steal_id = 0;
+
+        WorkerGroup group = WorkerGroup::General;
+        std::array<WorkerGroupLane, NumJobLanes> group_lanes{};
 
         FiberHandle worker_fiber{};
 
@@ -373,11 +709,37 @@ class MIZU_CORE_API JobSystem
 
         WorkStealingDeque<JobRecordRef, WorkerQueueCapacity> local_queue{};
         MpscQueue<JobRecordRef, WorkerQueueCapacity> incoming_queue{};
+
+        // Parking, the worker waits on wake_epoch changing while is_parked is set
+        std::atomic<uint32_t> wake_epoch = 0;
+        std::atomic<bool> is_parked = false;
+
+        std::atomic<uint64_t> num_idle_spins = 0;
+        std::atomic<uint64_t> num_idle_yields = 0;
+        std::atomic<uint64_t> num_parks = 0;
+        std::atomic<uint64_t> num_wakes = 0;
+
+        // Only updated when m_worker_counters_enabled
+        std::atomic<uint64_t> num_jobs_executed = 0;
+        std::atomic<uint64_t> num_steal_attempts = 0;
+        std::atomic<uint64_t> num_steals = 0;
+        std::atomic<uint64_t> idle_time_ns = 0;
     };
 
     std::deque<WorkerInfo> m_workers;
     bool m_main_thread_reserved = false;
 
+    std::array<std::vector<uint32_t>, NumWorkerGroups> m_group_workers{};
+    std::array<std::atomic<size_t>, NumWorkerGroups> m_group_round_robin{};
+
+    JobSystemIdleConfig m_idle_config{};
+    std::atomic<uint32_t> m_num_parked_workers = 0;
+    std::atomic<size_t> m_wake_round_robin = 0;
+
+    std::atomic<uint64_t> m_num_backpressure_waits = 0;
+
+    bool m_worker_counters_enabled = false;
+
     using JobRecordPool = IntrusiveFreeList<JobRecord, PoolCapacity, JobRecordPoolTag>;
     using CompletionRecordPool = IntrusiveFreeList<CompletionRecord, PoolCapacity, CompletionRecordPoolTag>;
     using WaitNodePool = IntrusiveFreeList<WaitNode, PoolCapacity, WaitNodePoolTag>;
@@ -394,7 +756,18 @@ class MIZU_CORE_API JobSystem
 
     void worker_job(WorkerInfo& info);
     size_t drain_incoming_queue(WorkerInfo& info, size_t batch_size);
+    bool try_pop_job(WorkerInfo& info, JobRecordRef& out_record_ref);
     bool try_steal_job(WorkerInfo& info, JobRecordRef& out_record_ref);
+    bool try_steal_group_job(WorkerInfo& info, JobLane lane, JobRecordRef& out_record_ref);
+    void idle_worker(WorkerInfo& info, uint32_t& idle_rounds);
+    void park_worker(WorkerInfo& info);
+    bool has_pending_work(const WorkerInfo& info) const;
+    void wake_worker(WorkerInfo& info);
+    void wake_any_worker();
+    void wake_any_group_worker(WorkerGroup group);
+    bool try_claim_parked_worker(WorkerInfo& info);
+    void apply_backpressure();
+    bool try_help_execute_job(WorkerInfo& info);
     void execute_job(const JobRecordRef& job_record_ref);
     static void execute_fiber(void* info);
     void finalize_requested_job_suspend(JobRecord& job_record);
@@ -402,10 +775,13 @@ class MIZU_CORE_API JobSystem
 
     JobHandle submit_internal(PendingJob&& job);
     JobHandle submit_internal(PendingBatch&& batch);
+    JobHandle parallel_for_internal(JobRange range, size_t grain_size, ParallelForTask* task);
+    void spawn_parallel_for_job(ParallelForTask& task, JobRange range, CompletionRecord& completion_record);
+    void execute_parallel_for_job(ParallelForTask& task, JobRange range, CompletionRecord& completion_record);
     void submit_job_record_internal(
         JobRecord& job_record,
         const JobDescription& job_desc,
-        std::span<JobHandle> dependencies);
+        std::span<const JobHandleRef> dependencies);
 
     void init_job_record(
         JobDescription& job,
@@ -416,15 +792,19 @@ class MIZU_CORE_API JobSystem
     void init_fiber_slot(FiberSlot& fiber_slot, JobRecord& job_record, const JobDescription& job_desc);
 
     void enqueue_job_record(const JobRecord& job_record);
+    JobTarget resolve_job_target(JobAffinity affinity) const;
 
     JobRecord* try_get_job_record(const JobRecordRef& job_record_ref);
     JobRecord& get_job_record(const JobRecordRef& job_record_ref);
-    CompletionRecord* try_get_job_handle_completion_record(const JobHandle& handle);
-    CompletionRecord& get_job_handle_completion_record(const JobHandle& handle);
+    CompletionRecord* try_get_job_handle_completion_record(const JobHandleRef& handle);
+    CompletionRecord& get_job_handle_completion_record(const JobHandleRef& handle);
     bool try_push_wait_node(CompletionRecord& completion_record, WaitNode& wait_node);
     FiberSlot* try_get_fiber_slot(FiberSlotPoolIndex index, StackSize stack_size);
     FiberSlot& get_fiber_slot(FiberSlotPoolIndex index, StackSize stack_size);
 
+    template <typename PoolT>
+    auto allocate_pool_index(PoolT& pool);
+
     JobRecord& allocate_job_record();
     CompletionRecord& allocate_completion_record();
     WaitNode& allocate_wait_node();
@@ -436,11 +816,15 @@ class MIZU_CORE_API JobSystem
     void free_fiber_slot(FiberSlot& fiber_slot);
 
     FiberSlotPool& get_fiber_slot_pool(StackSize stack_size);
+    const FiberSlotPool& get_fiber_slot_pool(StackSize stack_size) const;
     FiberStackMemoryPool& get_fiber_stack_memory_pool(StackSize stack_size);
+    const FiberStackMemoryPool& get_fiber_stack_memory_pool(StackSize stack_size) const;
 
     size_t get_stack_bytes(StackSize stack_size) const;
     bool is_valid_worker_id(uint32_t worker_id) const;
+    bool is_stealable_worker_id(uint32_t worker_id) const;
     WorkerInfo& get_thread_worker_info();
+    uint32_t get_thread_worker_id() const;
 
     friend struct JobHandle;
     friend class PendingJob;
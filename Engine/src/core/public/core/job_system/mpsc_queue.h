@@ -1,11 +1,21 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "base/debug/assert.h"
+
 namespace Mizu
 {
 
+// Bounded multi-producer single-consumer ring (Vyukov). When a producer finds the ring full it closes it and links a
+// new ring with double the capacity (up to `max_capacity`), the consumer moves to the new ring once the closed one is
+// drained. Rings are only released when the queue is destroyed, a producer may still be looking at a closed ring.
+//
+// `Capacity` is the default initial and maximum capacity, use `init` to configure a growable queue.
 template <typename T, size_t Capacity>
 class MpscQueue
 {
@@ -13,27 +23,62 @@ class MpscQueue
     static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
 
   public:
-    MpscQueue() : m_queue(Capacity), m_head(0), m_tail(0)
+    MpscQueue() { init(Capacity, Capacity); }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue() { release_rings(); }
+
+    // Not thread-safe, must be called before the queue is shared and discards all its contents
+    void init(size_t initial_capacity, size_t max_capacity)
     {
-        for (size_t i = 0; i < Capacity; ++i)
-        {
-            Slot& slot = m_queue[i];
-            slot.seq.store(i);
-        }
+        MIZU_ASSERT(
+            initial_capacity >= 2 && initial_capacity <= max_capacity, "Invalid MpscQueue capacity range");
+        MIZU_ASSERT(
+            (initial_capacity & (initial_capacity - 1)) == 0 && (max_capacity & (max_capacity - 1)) == 0,
+            "MpscQueue capacities must be a power of 2");
+
+        release_rings();
+
+        m_max_capacity = max_capacity;
+
+        m_head_ring = new Ring(initial_capacity, 0);
+        m_tail_ring.store(m_head_ring, std::memory_order_relaxed);
     }
 
     bool push(T value)
     {
-        size_t pos = m_tail.load(std::memory_order_relaxed);
+        Ring* ring = m_tail_ring.load(std::memory_order_acquire);
+        size_t pos = ring->tail.load(std::memory_order_relaxed);
 
         while (true)
         {
-            Slot& slot = m_queue[pos & ModuloMask];
+            if ((pos & ClosedBit) != 0)
+            {
+                // The ring is full and has been closed, move to the next one once it has been linked
+                Ring* next = ring->next.load(std::memory_order_acquire);
+                if (next != nullptr)
+                {
+                    Ring* expected = ring;
+                    m_tail_ring.compare_exchange_strong(expected, next, std::memory_order_acq_rel);
+                    ring = next;
+                }
+                else
+                {
+                    ring = m_tail_ring.load(std::memory_order_acquire);
+                }
+
+                pos = ring->tail.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            Slot& slot = ring->slots[pos & ring->mask];
             const size_t seq = slot.seq.load(std::memory_order_acquire);
 
             const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
             if (diff == 0
-                && m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+                && ring->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed))
             {
                 slot.value = value;
                 slot.seq.store(pos + 1, std::memory_order_release);
@@ -43,12 +88,25 @@ class MpscQueue
             else if (diff < 0)
             {
                 // Slot is behind consumer, queue is full
-                return false;
+                if (ring->capacity >= m_max_capacity)
+                    return false;
+
+                if (ring->tail.compare_exchange_weak(
+                        pos, pos | ClosedBit, std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    Ring* next = new Ring(std::min(ring->capacity * 2, m_max_capacity), 0);
+
+                    ring->next.store(next, std::memory_order_release);
+                    m_tail_ring.store(next, std::memory_order_release);
+
+                    ring = next;
+                    pos = 0;
+                }
             }
             else
             {
                 // Another producer advanced the tail, retry
-                pos = m_tail.load(std::memory_order_relaxed);
+                pos = ring->tail.load(std::memory_order_relaxed);
             }
         }
 
@@ -57,36 +115,132 @@ class MpscQueue
 
     bool pop(T& out)
     {
-        const size_t pos = m_head.load(std::memory_order_relaxed);
-        Slot& slot = m_queue[pos & ModuloMask];
-
-        // seq == pos+1 means published and ready
-        const size_t seq = slot.seq.load(std::memory_order_acquire);
-        if (seq != pos + 1)
-        {
-            // Queue is empty
+        Ring* ring = get_consumer_ring();
+        if (ring == nullptr)
             return false;
-        }
+
+        const size_t pos = ring->head;
+        Slot& slot = ring->slots[pos & ring->mask];
 
         out = std::move(slot.value);
 
-        slot.seq.store(pos + Capacity, std::memory_order_release);
-        m_head.store(pos + 1, std::memory_order_relaxed);
+        slot.seq.store(pos + ring->capacity, std::memory_order_release);
+        ring->head = pos + 1;
 
         return true;
     }
 
+    // Must only be called from the consumer thread.
+    bool empty() const
+    {
+        const Ring* ring = m_head_ring;
+        while (true)
+        {
+            const size_t pos = ring->head;
+            if (ring->slots[pos & ring->mask].seq.load(std::memory_order_acquire) == pos + 1)
+                return false;
+
+            if (!is_drained(*ring))
+                return true;
+
+            const Ring* next = ring->next.load(std::memory_order_acquire);
+            if (next == nullptr)
+                return true;
+
+            ring = next;
+        }
+    }
+
+    // Capacity of the ring producers are currently pushing to
+    size_t get_capacity() const { return m_tail_ring.load(std::memory_order_relaxed)->capacity; }
+
   private:
+    static constexpr size_t ClosedBit = size_t{1} << (sizeof(size_t) * 8 - 1);
+
     struct Slot
     {
         T value;
         std::atomic<size_t> seq;
     };
 
-    static constexpr size_t ModuloMask = Capacity - 1;
+    struct Ring
+    {
+        size_t capacity = 0;
+        size_t mask = 0;
+        std::unique_ptr<Slot[]> slots;
+
+        // Consumer only
+        size_t head = 0;
+        std::atomic<size_t> tail = 0;
+
+        std::atomic<Ring*> next = nullptr;
+
+        Ring(size_t capacity_, size_t start) : capacity(capacity_), mask(capacity_ - 1), slots(new Slot[capacity_])
+        {
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                slots[i].seq.store(start + i, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    size_t m_max_capacity = 0;
+
+    // m_head_ring is the first ring that still has to be consumed, all the rings from it are reachable through `next`
+    Ring* m_head_ring = nullptr;
+    std::atomic<Ring*> m_tail_ring = nullptr;
+
+    // Returns the ring that has the next published value, or nullptr if the queue is empty
+    Ring* get_consumer_ring()
+    {
+        while (true)
+        {
+            Ring* ring = m_head_ring;
+
+            const size_t pos = ring->head;
+            const Slot& slot = ring->slots[pos & ring->mask];
 
-    std::vector<Slot> m_queue;
-    std::atomic<size_t> m_head, m_tail;
+            // seq == pos+1 means published and ready
+            if (slot.seq.load(std::memory_order_acquire) == pos + 1)
+                return ring;
+
+            if (!is_drained(*ring))
+                return nullptr;
+
+            Ring* next = ring->next.load(std::memory_order_acquire);
+            if (next == nullptr)
+                return nullptr;
+
+            m_head_ring = next;
+            m_retired_rings.push_back(std::unique_ptr<Ring>(ring));
+        }
+    }
+
+    // A closed ring is done once every position claimed before closing it has been consumed
+    static bool is_drained(const Ring& ring)
+    {
+        const size_t tail = ring.tail.load(std::memory_order_acquire);
+        return (tail & ClosedBit) != 0 && (tail & ~ClosedBit) == ring.head;
+    }
+
+    // Drained rings can't be released yet, a producer may still be reading the tail of a closed ring
+    std::vector<std::unique_ptr<Ring>> m_retired_rings;
+
+    void release_rings()
+    {
+        m_retired_rings.clear();
+
+        Ring* ring = m_head_ring;
+        while (ring != nullptr)
+        {
+            Ring* next = ring->next.load(std::memory_order_relaxed);
+            delete ring;
+            ring = next;
+        }
+
+        m_head_ring = nullptr;
+        m_tail_ring.store(nullptr, std::memory_order_relaxed);
+    }
 };
 
 } // namespace Mizu
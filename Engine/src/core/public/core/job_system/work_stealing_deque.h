@@ -1,23 +1,40 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
 #include <vector>
 
+#include "base/debug/assert.h"
+
 namespace Mizu
 {
 
+// Chase-Lev deque, the owner pushes and pops from the bottom while other threads steal from the top.
+// When full, the owner grows the ring (doubling, up to `max_capacity`), previous rings are kept alive until destruction
+// because a thief may still be reading from them.
+//
+// `Capacity` is the default initial and maximum capacity, use `init` to configure a growable deque.
 template <typename T, size_t Capacity>
 class WorkStealingDeque
 {
     static_assert(Capacity > 0, "Can't create WorkStealingDeque with Capacity == 0");
     // TODO: static_assert(std::is_trivially_destructible_v<T>, "T must be trivially destructible");
 
-    static constexpr int64_t IntCapacity = static_cast<int64_t>(Capacity);
-
   public:
-    WorkStealingDeque()
+    WorkStealingDeque() { init(Capacity, Capacity); }
+
+    // Not thread-safe, must be called before the deque is shared and discards all its contents
+    void init(size_t initial_capacity, size_t max_capacity)
     {
-        m_queue.resize(Capacity);
+        MIZU_ASSERT(
+            initial_capacity > 0 && initial_capacity <= max_capacity, "Invalid WorkStealingDeque capacity range");
+
+        m_max_capacity = static_cast<int64_t>(max_capacity);
+
+        m_rings.clear();
+        m_rings.push_back(std::make_unique<Ring>(static_cast<int64_t>(initial_capacity)));
+        m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
 
         m_top.store(0);
         m_bottom.store(0);
@@ -28,12 +45,16 @@ class WorkStealingDeque
         const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
         const int64_t top = m_top.load(std::memory_order_acquire);
 
-        if (bottom - top > IntCapacity - 1)
+        Ring* ring = m_ring.load(std::memory_order_relaxed);
+        if (bottom - top > ring->capacity - 1)
         {
-            return false;
+            if (ring->capacity >= m_max_capacity)
+                return false;
+
+            ring = grow(ring, top, bottom);
         }
 
-        m_queue[static_cast<size_t>(bottom % IntCapacity)] = std::move(value);
+        ring->get(bottom) = std::move(value);
 
         std::atomic_thread_fence(std::memory_order_release);
         m_bottom.store(bottom + 1, std::memory_order_relaxed);
@@ -44,6 +65,7 @@ class WorkStealingDeque
     bool pop(T& out)
     {
         const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Ring* ring = m_ring.load(std::memory_order_relaxed);
         m_bottom.store(bottom, std::memory_order_relaxed);
 
         std::atomic_thread_fence(std::memory_order_seq_cst);
@@ -55,7 +77,7 @@ class WorkStealingDeque
         {
             // The queue is not empty
 
-            out = m_queue[static_cast<size_t>(bottom % IntCapacity)];
+            out = ring->get(bottom);
             if (top == bottom)
             {
                 // if top == bottom, we're accessing the last element in the queue. We have to make sure the
@@ -92,8 +114,10 @@ class WorkStealingDeque
         {
             // The queue is not empty
 
+            Ring* ring = m_ring.load(std::memory_order_acquire);
+
             valid = true;
-            out = m_queue[static_cast<size_t>(top % IntCapacity)];
+            out = ring->get(top);
 
             if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
             {
@@ -105,9 +129,60 @@ class WorkStealingDeque
         return valid;
     }
 
+    // Approximate check, the result may be stale by the time the caller uses it.
+    bool empty() const
+    {
+        const int64_t top = m_top.load(std::memory_order_acquire);
+        const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+        return bottom <= top;
+    }
+
+    // Must only be called from the owner thread. Thieves can only make room, so a false result stays valid until the
+    // next push.
+    bool full() const
+    {
+        const int64_t top = m_top.load(std::memory_order_acquire);
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+
+        return bottom - top >= m_max_capacity;
+    }
+
+    size_t get_capacity() const { return static_cast<size_t>(m_ring.load(std::memory_order_relaxed)->capacity); }
+
   private:
-    std::vector<T> m_queue;
+    struct Ring
+    {
+        int64_t capacity = 0;
+        std::vector<T> values;
+
+        explicit Ring(int64_t capacity_) : capacity(capacity_), values(static_cast<size_t>(capacity_)) {}
+
+        T& get(int64_t index) { return values[static_cast<size_t>(index % capacity)]; }
+    };
+
+    std::atomic<Ring*> m_ring = nullptr;
+    std::vector<std::unique_ptr<Ring>> m_rings;
+    int64_t m_max_capacity = 0;
+
     std::atomic<int64_t> m_top, m_bottom;
+
+    Ring* grow(Ring* ring, int64_t top, int64_t bottom)
+    {
+        const int64_t new_capacity = std::min(ring->capacity * 2, m_max_capacity);
+
+        std::unique_ptr<Ring> new_ring = std::make_unique<Ring>(new_capacity);
+        for (int64_t i = top; i < bottom; ++i)
+        {
+            new_ring->get(i) = ring->get(i);
+        }
+
+        Ring* new_ring_ptr = new_ring.get();
+        m_rings.push_back(std::move(new_ring));
+        m_ring.store(new_ring_ptr, std::memory_order_release);
+
+        return new_ring_ptr;
+    }
 };
 
 } // namespace Mizu
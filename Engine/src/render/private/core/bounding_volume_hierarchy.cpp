@@ -0,0 +1,477 @@
+#include "render/core/bounding_volume_hierarchy.h"
+
+#include <algorithm>
+#include <array>
+
+#include "base/debug/assert.h"
+#include "base/math/aabb.h"
+
+namespace Mizu
+{
+
+static float bvh_surface_area(glm::vec3 min, glm::vec3 max)
+{
+    const glm::vec3 size = max - min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+static float bvh_union_surface_area(glm::vec3 min_a, glm::vec3 max_a, glm::vec3 min_b, glm::vec3 max_b)
+{
+    return bvh_surface_area(glm::min(min_a, min_b), glm::max(max_a, max_b));
+}
+
+// Margin around the leaf bounds, so small movements don't change the tree
+static constexpr float BVH_FAT_MARGIN = 0.1f;
+// Fat bounds are also extended along the displacement of the leaf, predicting where it moves next
+static constexpr float BVH_DISPLACEMENT_MULTIPLIER = 2.0f;
+
+static void bvh_fatten(glm::vec3 min, glm::vec3 max, glm::vec3 displacement, glm::vec3& out_min, glm::vec3& out_max)
+{
+    const glm::vec3 extension = displacement * BVH_DISPLACEMENT_MULTIPLIER;
+
+    out_min = min - glm::vec3(BVH_FAT_MARGIN) + glm::min(extension, glm::vec3(0.0f));
+    out_max = max + glm::vec3(BVH_FAT_MARGIN) + glm::max(extension, glm::vec3(0.0f));
+}
+
+static bool bvh_contains(glm::vec3 outer_min, glm::vec3 outer_max, glm::vec3 inner_min, glm::vec3 inner_max)
+{
+    return outer_min.x <= inner_min.x && outer_min.y <= inner_min.y && outer_min.z <= inner_min.z
+           && inner_max.x <= outer_max.x && inner_max.y <= outer_max.y && inner_max.z <= outer_max.z;
+}
+
+uint32_t BoundingVolumeHierarchy::insert(const AABB& aabb, uint32_t user_data)
+{
+    const uint32_t leaf = allocate_node();
+
+    m_leaf_bounds[leaf] = LeafBounds{aabb.min(), aabb.max()};
+
+    Node& node = m_nodes[leaf];
+    node.user_data = user_data;
+    bvh_fatten(aabb.min(), aabb.max(), glm::vec3(0.0f), node.min, node.max);
+    node.height = 0;
+
+    insert_leaf(leaf);
+    m_num_leaves += 1;
+
+    return leaf;
+}
+
+void BoundingVolumeHierarchy::remove(uint32_t leaf)
+{
+    MIZU_ASSERT(leaf < m_nodes.size() && m_nodes[leaf].is_leaf() && m_nodes[leaf].height == 0, "Invalid leaf");
+
+    remove_leaf(leaf);
+    free_node(leaf);
+
+    m_num_leaves -= 1;
+}
+
+bool BoundingVolumeHierarchy::update(uint32_t leaf, const AABB& aabb)
+{
+    MIZU_ASSERT(leaf < m_nodes.size() && m_nodes[leaf].is_leaf() && m_nodes[leaf].height == 0, "Invalid leaf");
+
+    const Node& node = m_nodes[leaf];
+    LeafBounds& bounds = m_leaf_bounds[leaf];
+
+    const glm::vec3 min = aabb.min();
+    const glm::vec3 max = aabb.max();
+    const glm::vec3 displacement = (min + max - bounds.min - bounds.max) * 0.5f;
+
+    bounds = LeafBounds{min, max};
+
+    // The ancestors contain the fat bounds, so the tree is still valid
+    if (bvh_contains(node.min, node.max, min, max))
+        return false;
+
+    // Left its fat bounds, find a better place for it
+    remove_leaf(leaf);
+    bvh_fatten(min, max, displacement, m_nodes[leaf].min, m_nodes[leaf].max);
+    insert_leaf(leaf);
+
+    return true;
+}
+
+void BoundingVolumeHierarchy::clear()
+{
+    m_nodes.clear();
+    m_leaf_bounds.clear();
+    m_root = INVALID_NODE;
+    m_free_list = INVALID_NODE;
+    m_num_leaves = 0;
+}
+
+void BoundingVolumeHierarchy::set_user_data(uint32_t leaf, uint32_t user_data)
+{
+    MIZU_ASSERT(leaf < m_nodes.size() && m_nodes[leaf].height == 0, "Invalid leaf");
+    m_nodes[leaf].user_data = user_data;
+}
+
+uint32_t BoundingVolumeHierarchy::get_user_data(uint32_t leaf) const
+{
+    MIZU_ASSERT(leaf < m_nodes.size() && m_nodes[leaf].height == 0, "Invalid leaf");
+    return m_nodes[leaf].user_data;
+}
+
+AABB BoundingVolumeHierarchy::get_bounds(uint32_t leaf) const
+{
+    MIZU_ASSERT(leaf < m_nodes.size() && m_nodes[leaf].height == 0, "Invalid leaf");
+    return AABB(m_leaf_bounds[leaf].min, m_leaf_bounds[leaf].max);
+}
+
+void BoundingVolumeHierarchy::query(const Frustum& frustum, FrustumMask mask, std::vector<uint32_t>& out_user_data)
+    const
+{
+    QueryScratch scratch{};
+    query(frustum, mask, out_user_data, scratch);
+}
+
+void BoundingVolumeHierarchy::query(
+    const Frustum& frustum,
+    FrustumMask mask,
+    std::vector<uint32_t>& out_user_data,
+    QueryScratch& scratch) const
+{
+    if (m_root == INVALID_NODE)
+        return;
+
+    // Leaves that still have planes to test, tested together after the traversal
+    CullingBounds& leaf_bounds = scratch.leaf_bounds;
+    std::vector<uint32_t>& leaf_user_data = scratch.leaf_user_data;
+
+    leaf_bounds.clear();
+    leaf_user_data.clear();
+
+    std::array<Plane, 6> planes{};
+    uint32_t num_planes = 0;
+
+    // Same order as Frustum::is_inside_frustum
+    // clang-format off
+    if (mask.left)   planes[num_planes++] = frustum.left;
+    if (mask.right)  planes[num_planes++] = frustum.right;
+    if (mask.bottom) planes[num_planes++] = frustum.bottom;
+    if (mask.top)    planes[num_planes++] = frustum.top;
+    if (mask.near)   planes[num_planes++] = frustum.near;
+    if (mask.far)    planes[num_planes++] = frustum.far;
+    // clang-format on
+
+    // Balanced trees with billions of leaves are still shallower than this
+    constexpr size_t MAX_STACK_SIZE = 128;
+
+    // Planes that still need to be tested for the subtree, the children of a node that is fully inside a plane are
+    // also inside it
+    struct StackEntry
+    {
+        uint32_t node;
+        uint32_t active_planes;
+    };
+
+    std::array<StackEntry, MAX_STACK_SIZE> stack;
+    size_t stack_size = 0;
+
+    stack[stack_size++] = {m_root, (1u << num_planes) - 1};
+
+    while (stack_size > 0)
+    {
+        const StackEntry entry = stack[--stack_size];
+        const Node& node = m_nodes[entry.node];
+
+        uint32_t active_planes = entry.active_planes;
+
+        if (node.is_leaf())
+        {
+            // Leaves are tested with their exact bounds, the fat bounds are only for the tree
+            if (active_planes == 0)
+            {
+                out_user_data.push_back(node.user_data);
+            }
+            else
+            {
+                leaf_bounds.push_back(AABB(m_leaf_bounds[entry.node].min, m_leaf_bounds[entry.node].max));
+                leaf_user_data.push_back(node.user_data);
+            }
+
+            continue;
+        }
+
+        if (active_planes != 0)
+        {
+            const glm::vec3 center = (node.min + node.max) * 0.5f;
+            const glm::vec3 radius = glm::abs(node.max - node.min) * 0.5f;
+
+            bool outside = false;
+
+            for (uint32_t p = 0; p < num_planes && !outside; ++p)
+            {
+                if ((active_planes & (1u << p)) == 0)
+                    continue;
+
+                const float distance = glm::dot(planes[p].normal, center) + planes[p].distance;
+                const float projected_radius = glm::dot(glm::abs(planes[p].normal), radius);
+
+                outside = distance < -projected_radius;
+
+                if (distance >= projected_radius)
+                    active_planes &= ~(1u << p);
+            }
+
+            if (outside)
+                continue;
+        }
+
+        MIZU_ASSERT(stack_size + 2 <= MAX_STACK_SIZE, "BoundingVolumeHierarchy query stack overflow");
+
+        stack[stack_size++] = {node.children[1], active_planes};
+        stack[stack_size++] = {node.children[0], active_planes};
+    }
+
+    if (leaf_bounds.empty())
+        return;
+
+    // Planes that were already passed by an ancestor are passed by the leaf too, so testing all of them gives the same
+    // result
+    std::vector<uint64_t>& visibility_mask = scratch.visibility_mask;
+    visibility_mask.resize(get_visibility_mask_word_count(leaf_bounds.size()));
+
+    cull_frustums(std::span(&frustum, 1), std::span(&mask, 1), leaf_bounds, visibility_mask);
+
+    for (size_t i = 0; i < leaf_user_data.size(); ++i)
+    {
+        if (is_visible(visibility_mask, i))
+            out_user_data.push_back(leaf_user_data[i]);
+    }
+}
+
+uint32_t BoundingVolumeHierarchy::get_height() const
+{
+    if (m_root == INVALID_NODE)
+        return 0;
+
+    return static_cast<uint32_t>(m_nodes[m_root].height);
+}
+
+uint32_t BoundingVolumeHierarchy::allocate_node()
+{
+    if (m_free_list == INVALID_NODE)
+    {
+        m_nodes.emplace_back();
+        m_leaf_bounds.emplace_back();
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    const uint32_t node = m_free_list;
+    m_free_list = m_nodes[node].parent;
+
+    m_nodes[node] = Node{};
+
+    return node;
+}
+
+void BoundingVolumeHierarchy::free_node(uint32_t node)
+{
+    m_nodes[node] = Node{};
+    m_nodes[node].parent = m_free_list;
+
+    m_free_list = node;
+}
+
+void BoundingVolumeHierarchy::insert_leaf(uint32_t leaf)
+{
+    if (m_root == INVALID_NODE)
+    {
+        m_root = leaf;
+        m_nodes[leaf].parent = INVALID_NODE;
+        return;
+    }
+
+    const glm::vec3 leaf_min = m_nodes[leaf].min;
+    const glm::vec3 leaf_max = m_nodes[leaf].max;
+
+    // Descend to the sibling with the lowest surface area cost
+    uint32_t index = m_root;
+    while (!m_nodes[index].is_leaf())
+    {
+        const Node& node = m_nodes[index];
+
+        const float area = bvh_surface_area(node.min, node.max);
+        const float combined_area = bvh_union_surface_area(node.min, node.max, leaf_min, leaf_max);
+
+        // Cost of creating a new parent for this node and the leaf
+        const float cost = 2.0f * combined_area;
+        // Minimum cost of pushing the leaf further down the tree
+        const float inheritance_cost = 2.0f * (combined_area - area);
+
+        const auto child_cost = [&](uint32_t child_idx) -> float {
+            const Node& child = m_nodes[child_idx];
+
+            const float union_area = bvh_union_surface_area(child.min, child.max, leaf_min, leaf_max);
+            if (child.is_leaf())
+                return union_area + inheritance_cost;
+
+            return union_area - bvh_surface_area(child.min, child.max) + inheritance_cost;
+        };
+
+        const float cost_a = child_cost(node.children[0]);
+        const float cost_b = child_cost(node.children[1]);
+
+        if (cost < cost_a && cost < cost_b)
+            break;
+
+        index = cost_a < cost_b ? node.children[0] : node.children[1];
+    }
+
+    const uint32_t sibling = index;
+
+    // Allocating can reallocate the nodes, don't keep references before this point
+    const uint32_t new_parent = allocate_node();
+    const uint32_t old_parent = m_nodes[sibling].parent;
+
+    Node& parent_node = m_nodes[new_parent];
+    parent_node.parent = old_parent;
+    parent_node.min = glm::min(m_nodes[sibling].min, leaf_min);
+    parent_node.max = glm::max(m_nodes[sibling].max, leaf_max);
+    parent_node.height = m_nodes[sibling].height + 1;
+    parent_node.children[0] = sibling;
+    parent_node.children[1] = leaf;
+
+    if (old_parent != INVALID_NODE)
+    {
+        Node& old_parent_node = m_nodes[old_parent];
+        const uint32_t child_slot = old_parent_node.children[0] == sibling ? 0 : 1;
+        old_parent_node.children[child_slot] = new_parent;
+    }
+    else
+    {
+        m_root = new_parent;
+    }
+
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf].parent = new_parent;
+
+    rebalance_ancestors(m_nodes[leaf].parent);
+}
+
+void BoundingVolumeHierarchy::remove_leaf(uint32_t leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = INVALID_NODE;
+        return;
+    }
+
+    const uint32_t parent = m_nodes[leaf].parent;
+    const uint32_t grand_parent = m_nodes[parent].parent;
+    const uint32_t sibling =
+        m_nodes[parent].children[0] == leaf ? m_nodes[parent].children[1] : m_nodes[parent].children[0];
+
+    if (grand_parent != INVALID_NODE)
+    {
+        Node& grand_parent_node = m_nodes[grand_parent];
+        const uint32_t child_slot = grand_parent_node.children[0] == parent ? 0 : 1;
+        grand_parent_node.children[child_slot] = sibling;
+
+        m_nodes[sibling].parent = grand_parent;
+        free_node(parent);
+
+        rebalance_ancestors(grand_parent);
+    }
+    else
+    {
+        m_root = sibling;
+        m_nodes[sibling].parent = INVALID_NODE;
+        free_node(parent);
+    }
+
+    m_nodes[leaf].parent = INVALID_NODE;
+}
+
+void BoundingVolumeHierarchy::rebalance_ancestors(uint32_t node)
+{
+    uint32_t index = node;
+
+    while (index != INVALID_NODE)
+    {
+        index = balance(index);
+
+        Node& current = m_nodes[index];
+        const Node& child_a = m_nodes[current.children[0]];
+        const Node& child_b = m_nodes[current.children[1]];
+
+        current.height = 1 + std::max(child_a.height, child_b.height);
+        current.min = glm::min(child_a.min, child_b.min);
+        current.max = glm::max(child_a.max, child_b.max);
+
+        index = current.parent;
+    }
+}
+
+// Rotates the taller child of `a` up if the tree is unbalanced, returns the node that takes the place of `a`
+uint32_t BoundingVolumeHierarchy::balance(uint32_t a)
+{
+    Node& node_a = m_nodes[a];
+    if (node_a.is_leaf() || node_a.height < 2)
+        return a;
+
+    const uint32_t b = node_a.children[0];
+    const uint32_t c = node_a.children[1];
+
+    Node& node_b = m_nodes[b];
+    Node& node_c = m_nodes[c];
+
+    const int32_t balance_factor = node_c.height - node_b.height;
+
+    // Rotates `up` into the place of `a`, `keep` stays as a child of `a` in the slot `keep_slot`
+    const auto rotate = [&](uint32_t up, Node& node_up, uint32_t a_slot_of_up, const Node& node_keep) -> uint32_t {
+        const uint32_t f = node_up.children[0];
+        const uint32_t g = node_up.children[1];
+
+        Node& node_f = m_nodes[f];
+        Node& node_g = m_nodes[g];
+
+        node_up.children[0] = a;
+        node_up.parent = node_a.parent;
+        node_a.parent = up;
+
+        if (node_up.parent != INVALID_NODE)
+        {
+            Node& parent_node = m_nodes[node_up.parent];
+            const uint32_t child_slot = parent_node.children[0] == a ? 0 : 1;
+            parent_node.children[child_slot] = up;
+        }
+        else
+        {
+            m_root = up;
+        }
+
+        // The taller grandchild stays with `up`, the shorter one moves under `a`
+        const bool keep_f = node_f.height > node_g.height;
+        const uint32_t stay = keep_f ? f : g;
+        const uint32_t move = keep_f ? g : f;
+
+        Node& node_stay = m_nodes[stay];
+        Node& node_move = m_nodes[move];
+
+        node_up.children[1] = stay;
+        node_a.children[a_slot_of_up] = move;
+        node_move.parent = a;
+
+        node_a.min = glm::min(node_keep.min, node_move.min);
+        node_a.max = glm::max(node_keep.max, node_move.max);
+        node_a.height = 1 + std::max(node_keep.height, node_move.height);
+
+        node_up.min = glm::min(node_a.min, node_stay.min);
+        node_up.max = glm::max(node_a.max, node_stay.max);
+        node_up.height = 1 + std::max(node_a.height, node_stay.height);
+
+        return up;
+    };
+
+    if (balance_factor > 1)
+        return rotate(c, node_c, 1, node_b);
+
+    if (balance_factor < -1)
+        return rotate(b, node_b, 0, node_c);
+
+    return a;
+}
+
+} // namespace Mizu
@@ -0,0 +1,290 @@
+#include "render/core/frustum_culling.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#include "base/debug/assert.h"
+#include "base/math/aabb.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MIZU_FRUSTUM_CULLING_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <immintrin.h>
+#define MIZU_FRUSTUM_CULLING_SSE 1
+#endif
+
+namespace Mizu
+{
+
+//
+// CullingBounds
+//
+
+void CullingBounds::push_back(const AABB& aabb)
+{
+    const glm::vec3 center = (aabb.min() + aabb.max()) * 0.5f;
+    const glm::vec3 extent = glm::abs(aabb.max() - aabb.min()) * 0.5f;
+
+    m_center_x.push_back(center.x);
+    m_center_y.push_back(center.y);
+    m_center_z.push_back(center.z);
+    m_extent_x.push_back(extent.x);
+    m_extent_y.push_back(extent.y);
+    m_extent_z.push_back(extent.z);
+}
+
+void CullingBounds::set(size_t index, const AABB& aabb)
+{
+    MIZU_ASSERT(index < size(), "Index {} is out of range", index);
+
+    const glm::vec3 center = (aabb.min() + aabb.max()) * 0.5f;
+    const glm::vec3 extent = glm::abs(aabb.max() - aabb.min()) * 0.5f;
+
+    m_center_x[index] = center.x;
+    m_center_y[index] = center.y;
+    m_center_z[index] = center.z;
+    m_extent_x[index] = extent.x;
+    m_extent_y[index] = extent.y;
+    m_extent_z[index] = extent.z;
+}
+
+void CullingBounds::erase_swap_back(size_t index)
+{
+    MIZU_ASSERT(index < size(), "Index {} is out of range", index);
+
+    const auto erase = [index](std::vector<float>& values) {
+        values[index] = values.back();
+        values.pop_back();
+    };
+
+    erase(m_center_x);
+    erase(m_center_y);
+    erase(m_center_z);
+    erase(m_extent_x);
+    erase(m_extent_y);
+    erase(m_extent_z);
+}
+
+void CullingBounds::clear()
+{
+    m_center_x.clear();
+    m_center_y.clear();
+    m_center_z.clear();
+    m_extent_x.clear();
+    m_extent_y.clear();
+    m_extent_z.clear();
+}
+
+//
+// Culling
+//
+
+// Enabled planes of a frustum, the absolute value of the normals is used to project the extents
+struct CullingPlanes
+{
+    uint32_t count = 0;
+
+    std::array<float, 6> normal_x{}, normal_y{}, normal_z{}, distance{};
+    std::array<float, 6> abs_normal_x{}, abs_normal_y{}, abs_normal_z{};
+};
+
+static CullingPlanes get_culling_planes(const Frustum& frustum, FrustumMask mask)
+{
+    CullingPlanes planes{};
+
+    const auto add_plane = [&planes](const Plane& plane, bool enabled) {
+        if (!enabled)
+            return;
+
+        const uint32_t idx = planes.count++;
+
+        planes.normal_x[idx] = plane.normal.x;
+        planes.normal_y[idx] = plane.normal.y;
+        planes.normal_z[idx] = plane.normal.z;
+        planes.distance[idx] = plane.distance;
+        planes.abs_normal_x[idx] = glm::abs(plane.normal.x);
+        planes.abs_normal_y[idx] = glm::abs(plane.normal.y);
+        planes.abs_normal_z[idx] = glm::abs(plane.normal.z);
+    };
+
+    // Same order as Frustum::is_inside_frustum
+    add_plane(frustum.left, mask.left);
+    add_plane(frustum.right, mask.right);
+    add_plane(frustum.bottom, mask.bottom);
+    add_plane(frustum.top, mask.top);
+    add_plane(frustum.near, mask.near);
+    add_plane(frustum.far, mask.far);
+
+    return planes;
+}
+
+static bool is_inside_culling_planes(const CullingPlanes& planes, const CullingBounds& bounds, size_t idx)
+{
+    const float cx = bounds.center_x()[idx], cy = bounds.center_y()[idx], cz = bounds.center_z()[idx];
+    const float ex = bounds.extent_x()[idx], ey = bounds.extent_y()[idx], ez = bounds.extent_z()[idx];
+
+    for (uint32_t p = 0; p < planes.count; ++p)
+    {
+        const float distance =
+            planes.normal_x[p] * cx + planes.normal_y[p] * cy + planes.normal_z[p] * cz + planes.distance[p];
+        const float radius = planes.abs_normal_x[p] * ex + planes.abs_normal_y[p] * ey + planes.abs_normal_z[p] * ez;
+
+        if (!(distance >= -radius))
+            return false;
+    }
+
+    return true;
+}
+
+static constexpr size_t MAX_FRUSTUMS_PER_SWEEP = 16;
+
+static void cull_frustums_sweep(
+    std::span<const Frustum> frustums,
+    std::span<const FrustumMask> masks,
+    const CullingBounds& bounds,
+    std::span<uint64_t> out_visibility_masks)
+{
+    const size_t count = bounds.size();
+    const size_t word_count = get_visibility_mask_word_count(count);
+
+    std::fill_n(out_visibility_masks.begin(), frustums.size() * word_count, uint64_t{0});
+
+    std::array<CullingPlanes, MAX_FRUSTUMS_PER_SWEEP> frustum_planes{};
+    for (size_t f = 0; f < frustums.size(); ++f)
+    {
+        frustum_planes[f] = get_culling_planes(frustums[f], masks[f]);
+    }
+
+    size_t i = 0;
+
+#if MIZU_FRUSTUM_CULLING_AVX
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 cx = _mm256_loadu_ps(bounds.center_x() + i);
+        const __m256 cy = _mm256_loadu_ps(bounds.center_y() + i);
+        const __m256 cz = _mm256_loadu_ps(bounds.center_z() + i);
+        const __m256 ex = _mm256_loadu_ps(bounds.extent_x() + i);
+        const __m256 ey = _mm256_loadu_ps(bounds.extent_y() + i);
+        const __m256 ez = _mm256_loadu_ps(bounds.extent_z() + i);
+
+        for (size_t f = 0; f < frustums.size(); ++f)
+        {
+            const CullingPlanes& planes = frustum_planes[f];
+
+            int inside = 0xFF;
+            for (uint32_t p = 0; p < planes.count && inside != 0; ++p)
+            {
+                __m256 distance = _mm256_mul_ps(_mm256_set1_ps(planes.normal_x[p]), cx);
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.normal_y[p]), cy));
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.normal_z[p]), cz));
+                distance = _mm256_add_ps(distance, _mm256_set1_ps(planes.distance[p]));
+
+                __m256 radius = _mm256_mul_ps(_mm256_set1_ps(planes.abs_normal_x[p]), ex);
+                radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(planes.abs_normal_y[p]), ey));
+                radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(planes.abs_normal_z[p]), ez));
+
+                const __m256 neg_radius = _mm256_sub_ps(_mm256_setzero_ps(), radius);
+                inside &= _mm256_movemask_ps(_mm256_cmp_ps(distance, neg_radius, _CMP_GE_OQ));
+            }
+
+            out_visibility_masks[f * word_count + i / 64] |= static_cast<uint64_t>(inside) << (i % 64);
+        }
+    }
+#elif MIZU_FRUSTUM_CULLING_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 cx = _mm_loadu_ps(bounds.center_x() + i);
+        const __m128 cy = _mm_loadu_ps(bounds.center_y() + i);
+        const __m128 cz = _mm_loadu_ps(bounds.center_z() + i);
+        const __m128 ex = _mm_loadu_ps(bounds.extent_x() + i);
+        const __m128 ey = _mm_loadu_ps(bounds.extent_y() + i);
+        const __m128 ez = _mm_loadu_ps(bounds.extent_z() + i);
+
+        for (size_t f = 0; f < frustums.size(); ++f)
+        {
+            const CullingPlanes& planes = frustum_planes[f];
+
+            int inside = 0xF;
+            for (uint32_t p = 0; p < planes.count && inside != 0; ++p)
+            {
+                __m128 distance = _mm_mul_ps(_mm_set1_ps(planes.normal_x[p]), cx);
+                distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.normal_y[p]), cy));
+                distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.normal_z[p]), cz));
+                distance = _mm_add_ps(distance, _mm_set1_ps(planes.distance[p]));
+
+                __m128 radius = _mm_mul_ps(_mm_set1_ps(planes.abs_normal_x[p]), ex);
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(planes.abs_normal_y[p]), ey));
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(planes.abs_normal_z[p]), ez));
+
+                const __m128 neg_radius = _mm_sub_ps(_mm_setzero_ps(), radius);
+                inside &= _mm_movemask_ps(_mm_cmpge_ps(distance, neg_radius));
+            }
+
+            out_visibility_masks[f * word_count + i / 64] |= static_cast<uint64_t>(inside) << (i % 64);
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        for (size_t f = 0; f < frustums.size(); ++f)
+        {
+            if (is_inside_culling_planes(frustum_planes[f], bounds, i))
+                out_visibility_masks[f * word_count + i / 64] |= uint64_t{1} << (i % 64);
+        }
+    }
+}
+
+void cull_frustums(
+    std::span<const Frustum> frustums,
+    std::span<const FrustumMask> masks,
+    const CullingBounds& bounds,
+    std::span<uint64_t> out_visibility_masks)
+{
+    MIZU_ASSERT(frustums.size() == masks.size(), "Every frustum must have a mask");
+
+    const size_t word_count = get_visibility_mask_word_count(bounds.size());
+    MIZU_ASSERT(
+        out_visibility_masks.size() >= frustums.size() * word_count,
+        "Visibility masks size is too small ({} < {})",
+        out_visibility_masks.size(),
+        frustums.size() * word_count);
+
+    // The visibility of each frustum is independent, so bigger requests are split into several sweeps
+    for (size_t first = 0; first < frustums.size(); first += MAX_FRUSTUMS_PER_SWEEP)
+    {
+        const size_t num_frustums = std::min(frustums.size() - first, MAX_FRUSTUMS_PER_SWEEP);
+
+        cull_frustums_sweep(
+            frustums.subspan(first, num_frustums),
+            masks.subspan(first, num_frustums),
+            bounds,
+            out_visibility_masks.subspan(first * word_count, num_frustums * word_count));
+    }
+}
+
+size_t compact_visible_indices(std::span<const uint64_t> visibility_mask, std::span<uint32_t> out_indices)
+{
+    size_t num_visible = 0;
+
+    for (size_t word_idx = 0; word_idx < visibility_mask.size(); ++word_idx)
+    {
+        uint64_t bits = visibility_mask[word_idx];
+
+        while (bits != 0)
+        {
+            MIZU_ASSERT(num_visible < out_indices.size(), "Out indices can't hold every visible index");
+
+            const size_t bit = static_cast<size_t>(std::countr_zero(bits));
+            out_indices[num_visible++] = static_cast<uint32_t>(word_idx * 64 + bit);
+
+            bits &= bits - 1;
+        }
+    }
+
+    return num_visible;
+}
+
+} // namespace Mizu
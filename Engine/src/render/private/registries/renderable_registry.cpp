@@ -13,6 +13,8 @@ RenderableRegistry::RenderableRegistry()
     MIZU_ASSERT(
         g_static_mesh_state_manager != nullptr, "StaticMeshStateManager must be initialized before RenderableRegistry");
     g_static_mesh_state_manager->register_rend_consumer(this);
+
+    m_deltas.resize(g_static_mesh_state_manager->get_max_num_handles());
 }
 
 RenderableRegistry::~RenderableRegistry()
@@ -123,7 +125,7 @@ void RenderableRegistry::add_delta(RenderableRegistryDelta delta)
 {
     MIZU_ASSERT(
         m_deltas_size < m_deltas.size(),
-        "Renderable registry delta buffer overflow. Consider increasing StaticMeshConfig::MaxNumHandles.");
+        "Renderable registry delta buffer overflow. Consider increasing RendererSettings::max_static_meshes.");
 
     if (m_deltas_size == m_deltas.size())
         return;
@@ -1,9 +1,7 @@
 #pragma once
 
-#include <array>
 #include <span>
-
-#include "base/containers/inplace_vector.h"
+#include <vector>
 
 #include "render/state_manager/static_mesh_state_manager.h"
 
@@ -55,9 +53,10 @@ class RenderableRegistry : public StaticMeshStateManagerConsumer
     void rend_on_destroy(StaticMeshHandle handle) override;
 
   private:
-    inplace_vector<RenderableRegistryEntry, StaticMeshConfig::MaxNumHandles> m_entries{};
+    std::vector<RenderableRegistryEntry> m_entries{};
 
-    std::array<RenderableRegistryDelta, StaticMeshConfig::MaxNumHandles> m_deltas{};
+    // Ring buffer sized to the max number of static meshes
+    std::vector<RenderableRegistryDelta> m_deltas{};
     size_t m_deltas_head = 0;
     size_t m_deltas_tail = 0;
     size_t m_deltas_size = 0;
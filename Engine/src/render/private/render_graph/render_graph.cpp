@@ -4,8 +4,13 @@
 #include <variant>
 
 #include "base/debug/profiling.h"
+#include "core/job_system/job_system.h"
+#include "core/runtime.h"
+#include "render_core/rhi/command_buffer.h"
+#include "render_core/rhi/device.h"
 
 #include "render/render_graph/render_graph_builder.h"
+#include "render/runtime/renderer.h"
 
 namespace Mizu
 {
@@ -16,6 +21,12 @@ void RenderGraph::execute(const CommandBufferSubmitInfo& submit_info)
 
     insert_external_submit_info(submit_info);
 
+    if (!m_command_lists.empty())
+    {
+        execute_parallel();
+        return;
+    }
+
     for (const CommandBufferBatch& batch : m_command_buffer_batches)
     {
         auto& command_buffer = batch.command_buffer;
@@ -47,6 +58,7 @@ void RenderGraph::reset()
 
     m_command_buffer_batches.clear();
     m_pass_resources.clear();
+    m_command_lists.clear();
 }
 
 void RenderGraph::insert_external_submit_info(const CommandBufferSubmitInfo& submit_info)
@@ -89,6 +101,129 @@ void RenderGraph::insert_external_submit_info(const CommandBufferSubmitInfo& sub
     }
 }
 
+size_t RenderGraph::build_command_lists()
+{
+    m_command_lists.clear();
+
+    size_t num_parallel_command_lists = 0;
+
+    for (size_t batch_idx = 0; batch_idx < m_command_buffer_batches.size(); ++batch_idx)
+    {
+        const CommandBufferBatch& batch = m_command_buffer_batches[batch_idx];
+        const size_t batch_first_list_idx = m_command_lists.size();
+        size_t first_cmd_idx = 0;
+
+        for (size_t cmd_idx = 0; cmd_idx < batch.commands.size(); ++cmd_idx)
+        {
+            const PassExecuteCmd* pass_cmd = std::get_if<PassExecuteCmd>(&batch.commands[cmd_idx]);
+            if (pass_cmd == nullptr)
+                continue;
+
+            // Each pass is recorded with the transitions that precede it, consecutive serial passes share a list
+            const bool parallel = pass_cmd->allow_parallel_recording;
+            if (!parallel && m_command_lists.size() > batch_first_list_idx && !m_command_lists.back().parallel)
+            {
+                m_command_lists.back().end_cmd_idx = cmd_idx + 1;
+            }
+            else
+            {
+                m_command_lists.push_back(RenderGraphCommandList{
+                    .batch_idx = batch_idx,
+                    .first_cmd_idx = first_cmd_idx,
+                    .end_cmd_idx = cmd_idx + 1,
+                    .parallel = parallel,
+                });
+                num_parallel_command_lists += parallel ? 1 : 0;
+            }
+
+            first_cmd_idx = cmd_idx + 1;
+        }
+
+        if (m_command_lists.size() == batch_first_list_idx)
+        {
+            m_command_lists.push_back(RenderGraphCommandList{
+                .batch_idx = batch_idx,
+                .first_cmd_idx = 0,
+                .end_cmd_idx = batch.commands.size(),
+                .parallel = false,
+            });
+        }
+        else
+        {
+            // Trailing transitions go with the last pass of the batch
+            m_command_lists.back().end_cmd_idx = batch.commands.size();
+        }
+    }
+
+    // Without parallel passes every batch is recorded into its own command buffer
+    if (num_parallel_command_lists == 0)
+        m_command_lists.clear();
+
+    return num_parallel_command_lists;
+}
+
+void RenderGraph::execute_parallel()
+{
+    MIZU_PROFILE_SCOPED;
+
+    // Passes that don't allow parallel recording are recorded first and in order, they can write CPU state that other
+    // passes read while recording
+    std::vector<size_t> parallel_command_lists;
+
+    for (size_t list_idx = 0; list_idx < m_command_lists.size(); ++list_idx)
+    {
+        RenderGraphCommandList& command_list = m_command_lists[list_idx];
+
+        if (command_list.parallel)
+            parallel_command_lists.push_back(list_idx);
+        else
+            record_command_list(command_list);
+    }
+
+    const JobHandle record_job =
+        g_job_system->parallel_for(JobRange{0, parallel_command_lists.size()}, 1, [&](size_t idx) {
+            record_command_list(m_command_lists[parallel_command_lists[idx]]);
+        });
+    g_job_system->wait_for(record_job);
+
+    std::vector<const CommandBuffer*> batch_command_buffers;
+    size_t list_idx = 0;
+
+    for (size_t batch_idx = 0; batch_idx < m_command_buffer_batches.size(); ++batch_idx)
+    {
+        batch_command_buffers.clear();
+
+        for (; list_idx < m_command_lists.size() && m_command_lists[list_idx].batch_idx == batch_idx; ++list_idx)
+        {
+            batch_command_buffers.push_back(m_command_lists[list_idx].command_buffer.get());
+        }
+
+        CommandBuffer::submit_ordered(batch_command_buffers, m_command_buffer_batches[batch_idx].submit_info);
+    }
+}
+
+void RenderGraph::record_command_list(RenderGraphCommandList& command_list)
+{
+    MIZU_PROFILE_SCOPED;
+
+    const CommandBufferBatch& batch = m_command_buffer_batches[command_list.batch_idx];
+
+    // Created on the recording thread, backends allocate command buffers from per-thread pools
+    command_list.command_buffer = g_render_device->create_command_buffer(batch.type);
+
+    CommandBuffer& command_buffer = *command_list.command_buffer;
+    command_buffer.begin();
+
+    for (size_t cmd_idx = command_list.first_cmd_idx; cmd_idx < command_list.end_cmd_idx; ++cmd_idx)
+    {
+        std::visit(
+            [&](const auto& concrete_cmd) { execute_internal(command_buffer, concrete_cmd); },
+            batch.commands[cmd_idx]);
+    }
+
+    command_buffer.end();
+}
+
 void RenderGraph::execute_internal(CommandBuffer& command, const BufferTransitionCmd& cmd)
 {
     const BufferTransitionInfo transition_info{
@@ -124,8 +259,22 @@ void RenderGraph::execute_internal(CommandBuffer& command, const AccelStructTran
     command.transition_resource(cmd.resource, transition_info);
 }
 
+void RenderGraph::execute_internal(CommandBuffer& command, const ResourceBarrierCmd& cmd)
+{
+    const ResourceTransitionBatch batch{
+        .buffers = cmd.buffer_transitions,
+        .images = cmd.image_transitions,
+        .accel_structs = cmd.accel_struct_transitions,
+    };
+
+    command.transition_resources(batch);
+}
+
 void RenderGraph::execute_internal(CommandBuffer& command, const PassExecuteCmd& cmd)
 {
+    MIZU_PROFILE_SCOPED;
+    MIZU_PROFILE_ZONE_NAME(cmd.name.data(), cmd.name.size());
+
     command.begin_gpu_marker(cmd.name);
     cmd.func(command, m_pass_resources[cmd.pass_resources_idx]);
     command.end_gpu_marker();
@@ -2,17 +2,22 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <map>
 #include <queue>
 #include <ranges>
+#include <type_traits>
 
 #include "base/debug/profiling.h"
+#include "base/utils/hash.h"
+#include "core/runtime.h"
 #include "render_core/rhi/command_buffer.h"
 #include "render_core/rhi/device_memory_allocator.h"
 
 #include "render/render_graph/render_graph.h"
 #include "render/render_graph/render_graph_resource_registry.h"
 #include "render/runtime/renderer.h"
+#include "render_graph/render_graph_compile_cache.h"
 #include "render_graph/render_graph_resource_aliasing.h"
 
 namespace Mizu
@@ -37,6 +42,240 @@ inline static bool render_graph_is_output_resource_usage(RenderGraphResourceUsag
     // clang-format on
 }
 
+static uint64_t render_graph_elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+// Records the transitions added to `batch` since `first_cmd_idx`, so they can be replayed on a compile cache hit
+static void render_graph_record_transitions(
+    const CommandBufferBatch& batch,
+    size_t first_cmd_idx,
+    RenderGraphResource resource,
+    std::vector<RenderGraphCompiledCmd>& compiled_commands)
+{
+    for (size_t cmd_idx = first_cmd_idx; cmd_idx < batch.commands.size(); ++cmd_idx)
+    {
+        std::visit(
+            [&](const auto& cmd) {
+                using CmdT = std::decay_t<decltype(cmd)>;
+
+                if constexpr (std::is_same_v<CmdT, PassExecuteCmd>)
+                {
+                    MIZU_UNREACHABLE("Pass execute commands are not transitions");
+                }
+                else if constexpr (std::is_same_v<CmdT, ResourceBarrierCmd>)
+                {
+                    MIZU_UNREACHABLE("Transitions are batched after being recorded");
+                }
+                else
+                {
+                    compiled_commands.push_back(RenderGraphCompiledTransition<decltype(cmd.initial)>{
+                        .resource = resource,
+                        .initial = cmd.initial,
+                        .final = cmd.final,
+                        .src_queue_type = cmd.src_queue_type,
+                        .dst_queue_type = cmd.dst_queue_type,
+                        .transition_mode = cmd.transition_mode,
+                    });
+                }
+            },
+            batch.commands[cmd_idx]);
+    }
+}
+
+static BufferTransition render_graph_get_transition(const BufferTransitionCmd& cmd, ResourceTransitionSplit split)
+{
+    BufferTransitionInfo info{
+        cmd.initial,
+        cmd.final,
+        cmd.resource.get_size(),
+        0,
+        cmd.src_queue_type,
+        cmd.dst_queue_type,
+        cmd.transition_mode};
+    info.split = split;
+
+    return BufferTransition{&cmd.resource, info};
+}
+
+static ImageTransition render_graph_get_transition(const ImageTransitionCmd& cmd, ResourceTransitionSplit split)
+{
+    ImageTransitionInfo info{
+        cmd.initial,
+        cmd.final,
+        ImageResourceViewDescription{},
+        cmd.src_queue_type,
+        cmd.dst_queue_type,
+        cmd.transition_mode};
+    info.split = split;
+
+    return ImageTransition{&cmd.resource, info};
+}
+
+static AccelerationStructureTransition render_graph_get_transition(
+    const AccelStructTransitionCmd& cmd,
+    ResourceTransitionSplit split)
+{
+    AccelerationStructureTransitionInfo info{
+        cmd.initial, cmd.final, cmd.src_queue_type, cmd.dst_queue_type, cmd.transition_mode};
+    info.split = split;
+
+    return AccelerationStructureTransition{&cmd.resource, info};
+}
+
+static void render_graph_add_transition(ResourceBarrierCmd& barrier, const BufferTransition& transition)
+{
+    barrier.buffer_transitions.push_back(transition);
+}
+
+static void render_graph_add_transition(ResourceBarrierCmd& barrier, const ImageTransition& transition)
+{
+    barrier.image_transitions.push_back(transition);
+}
+
+static void render_graph_add_transition(ResourceBarrierCmd& barrier, const AccelerationStructureTransition& transition)
+{
+    barrier.accel_struct_transitions.push_back(transition);
+}
+
+// Replaces the transitions between two passes of `batch` with a single barrier. `compiled_commands` holds the resource
+// of each transition and the pass of each execute command of the batch.
+//
+// A transition is split when the resource is not accessed by the passes between its previous access and the pass that
+// needs the transition. It begins after the previous access and ends before the pass, in the same command buffer.
+static void render_graph_batch_transitions(
+    CommandBufferBatch& batch,
+    std::span<const RenderGraphCompiledCmd> compiled_commands,
+    std::span<const RenderGraphPassBuilder> passes,
+    const RenderGraphBuilderConfig& config,
+    RenderGraphCompileStats& stats)
+{
+    MIZU_ASSERT(
+        batch.commands.size() == compiled_commands.size(), "Batch commands don't match the compiled commands");
+
+    // num_parallel_passes[i] is the number of passes that allow parallel recording in [0, i)
+    std::vector<size_t> batch_pass_indices;
+    std::vector<size_t> num_parallel_passes{0};
+
+    for (size_t cmd_idx = 0; cmd_idx < batch.commands.size(); ++cmd_idx)
+    {
+        const PassExecuteCmd* pass_cmd = std::get_if<PassExecuteCmd>(&batch.commands[cmd_idx]);
+        if (pass_cmd == nullptr)
+            continue;
+
+        const bool parallel = config.parallel_recording && pass_cmd->allow_parallel_recording;
+
+        batch_pass_indices.push_back(std::get<RenderGraphCompiledPass>(compiled_commands[cmd_idx]).pass_idx);
+        num_parallel_passes.push_back(num_parallel_passes.back() + (parallel ? 1 : 0));
+    }
+
+    // barriers[i] is recorded before the i-th pass of the batch, and the last one after all of them
+    std::vector<ResourceBarrierCmd> barriers(batch_pass_indices.size() + 1);
+    // Index of the last pass of the batch that accessed each resource
+    std::unordered_map<RenderGraphResource, size_t> last_access_pass;
+
+    size_t barrier_idx = 0;
+
+    const auto count_pass_accesses = [&](size_t batch_pass_idx, RenderGraphResource resource) {
+        const auto accesses = passes[batch_pass_indices[batch_pass_idx]].get_access_records();
+        return std::count_if(accesses.begin(), accesses.end(), [&](const RenderGraphAccessRecord& access) {
+            return access.resource == resource;
+        });
+    };
+
+    const auto can_split_transition = [&](size_t begin_barrier_idx, RenderGraphResource resource) {
+        // At least one pass between both halves
+        if (begin_barrier_idx >= barrier_idx)
+            return false;
+
+        // Passes that allow parallel recording are recorded into their own command buffer
+        if (num_parallel_passes[barrier_idx + 1] != num_parallel_passes[begin_barrier_idx])
+            return false;
+
+        // Consecutive transitions of the same resource can't overlap
+        return count_pass_accesses(barrier_idx, resource) == 1;
+    };
+
+    for (size_t cmd_idx = 0; cmd_idx < batch.commands.size(); ++cmd_idx)
+    {
+        std::visit(
+            [&](const auto& cmd) {
+                using CmdT = std::decay_t<decltype(cmd)>;
+
+                if constexpr (std::is_same_v<CmdT, PassExecuteCmd>)
+                {
+                    for (const RenderGraphAccessRecord& access :
+                         passes[batch_pass_indices[barrier_idx]].get_access_records())
+                    {
+                        last_access_pass[access.resource] = barrier_idx;
+                    }
+
+                    barrier_idx += 1;
+                }
+                else if constexpr (std::is_same_v<CmdT, ResourceBarrierCmd>)
+                {
+                    MIZU_UNREACHABLE("Transitions have already been batched");
+                }
+                else
+                {
+                    const RenderGraphResource resource =
+                        std::get<RenderGraphCompiledTransition<decltype(cmd.initial)>>(compiled_commands[cmd_idx])
+                            .resource;
+
+                    stats.num_transitions += 1;
+
+                    const auto it = last_access_pass.find(resource);
+                    if (config.split_transitions && cmd.transition_mode == ResourceTransitionMode::Normal
+                        && it != last_access_pass.end() && can_split_transition(it->second + 1, resource))
+                    {
+                        render_graph_add_transition(
+                            barriers[it->second + 1], render_graph_get_transition(cmd, ResourceTransitionSplit::Begin));
+                        render_graph_add_transition(
+                            barriers[barrier_idx], render_graph_get_transition(cmd, ResourceTransitionSplit::End));
+
+                        stats.num_split_transitions += 1;
+                    }
+                    else
+                    {
+                        render_graph_add_transition(
+                            barriers[barrier_idx], render_graph_get_transition(cmd, ResourceTransitionSplit::None));
+                    }
+                }
+            },
+            batch.commands[cmd_idx]);
+    }
+
+    std::vector<RenderGraphCmd> commands;
+    commands.reserve(batch_pass_indices.size() + barriers.size());
+
+    barrier_idx = 0;
+
+    for (RenderGraphCmd& cmd : batch.commands)
+    {
+        if (!std::holds_alternative<PassExecuteCmd>(cmd))
+            continue;
+
+        if (!barriers[barrier_idx].empty())
+        {
+            commands.push_back(std::move(barriers[barrier_idx]));
+            stats.num_barriers += 1;
+        }
+
+        commands.push_back(std::move(cmd));
+        barrier_idx += 1;
+    }
+
+    if (!barriers[barrier_idx].empty())
+    {
+        commands.push_back(std::move(barriers[barrier_idx]));
+        stats.num_barriers += 1;
+    }
+
+    batch.commands = std::move(commands);
+}
+
 //
 // RenderGraphPassResources
 //
@@ -137,6 +376,9 @@ RenderGraphPassBuilder::RenderGraphPassBuilder(RenderGraphBuilder& builder, std:
     , m_name(name)
     , m_pass_idx(pass_idx)
     , m_has_outputs(false)
+    , m_has_side_effects(false)
+    , m_allow_parallel_recording(false)
+    , m_culled(false)
 {
 }
 
@@ -154,6 +396,16 @@ void RenderGraphPassBuilder::set_hint(RenderGraphPassHint hint)
     }
 }
 
+void RenderGraphPassBuilder::set_has_side_effects(bool has_side_effects)
+{
+    m_has_side_effects = has_side_effects;
+}
+
+void RenderGraphPassBuilder::set_allow_parallel_recording(bool allow_parallel_recording)
+{
+    m_allow_parallel_recording = allow_parallel_recording;
+}
+
 RenderGraphResource RenderGraphPassBuilder::read(RenderGraphResource resource)
 {
     return add_resource_access(resource, RenderGraphResourceUsageBits::Read);
@@ -308,17 +560,25 @@ void RenderGraphPassBuilder::populate_dependency_info(
 // RenderGraphBuilder
 //
 
-RenderGraphBuilder::RenderGraphBuilder(RenderGraphBuilderConfig config) : m_config(std::move(config))
+RenderGraphBuilder::RenderGraphBuilder(RenderGraphBuilderConfig config)
+    : m_config(std::move(config))
+    , m_compile_cache(std::make_unique<RenderGraphCompileCache>())
 {
     constexpr size_t PASSES_TO_RESERVE = 120;
     m_passes.reserve(PASSES_TO_RESERVE);
 }
 
+RenderGraphBuilder::~RenderGraphBuilder() = default;
+
 void RenderGraphBuilder::reset()
 {
     m_resources.clear();
     m_external_resources.clear();
     m_passes.clear();
+
+    m_passes_culled = false;
+    m_num_culled_passes = 0;
+    m_num_culled_resources = 0;
 }
 
 RenderGraphResource RenderGraphBuilder::create_buffer(BufferDescription desc)
@@ -480,25 +740,140 @@ const ImageDescription& RenderGraphBuilder::get_image_desc(RenderGraphResource r
     return std::get<ImageDescription>(desc.desc);
 }
 
-void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCompileOptions& options)
+void RenderGraphBuilder::cull_passes()
 {
     MIZU_PROFILE_SCOPED;
 
-    graph.reset();
+    if (m_passes_culled)
+        return;
 
-    MIZU_ASSERT(!m_passes.empty(), "Can't compile RenderGraph without passes");
+    m_passes_culled = true;
 
-    const DeviceProperties& device_props = g_render_device->get_properties();
+    if (!m_config.cull_unused_passes)
+        return;
 
-    // Only use async compute if the device supports it
-    m_config.async_compute_enabled = m_config.async_compute_enabled && device_props.async_compute;
+    // A pass is referenced by each pass that depends on it, and by itself if it writes an external resource or has
+    // side effects. Passes that end up without references are culled, releasing the references to their inputs.
+    std::vector<uint32_t> ref_counts(m_passes.size(), 0);
+    std::vector<size_t> unreferenced_passes;
 
-    TransientMemoryPool& transient_pool = options.transient_pool;
-    RenderGraphResourceRegistry& resource_registry = options.resource_registry;
+    for (const RenderGraphPassBuilder& pass_info : m_passes)
+    {
+        uint32_t ref_count = static_cast<uint32_t>(pass_info.m_pass_outputs.size());
 
-    //
-    // Graph analysis
-    //
+        if (pass_info.m_has_side_effects)
+            ref_count += 1;
+
+        for (const RenderGraphAccessRecord& access : pass_info.m_accesses)
+        {
+            if (render_graph_is_output_resource_usage(access.usage) && get_resource_desc(access.resource).is_external())
+            {
+                ref_count += 1;
+                break;
+            }
+        }
+
+        ref_counts[pass_info.m_pass_idx] = ref_count;
+
+        if (ref_count == 0)
+            unreferenced_passes.push_back(pass_info.m_pass_idx);
+    }
+
+    while (!unreferenced_passes.empty())
+    {
+        const size_t pass_idx = unreferenced_passes.back();
+        unreferenced_passes.pop_back();
+
+        RenderGraphPassBuilder& pass_info = m_passes[pass_idx];
+        pass_info.m_culled = true;
+        m_num_culled_passes += 1;
+
+        MIZU_PROFILE_ZONE_TEXT(pass_info.m_name.data(), pass_info.m_name.size());
+
+        for (size_t input_idx : pass_info.m_pass_inputs)
+        {
+            if (--ref_counts[input_idx] == 0)
+                unreferenced_passes.push_back(input_idx);
+        }
+    }
+
+    if (m_num_culled_passes == 0)
+        return;
+
+    // Remove the culled passes from the dependencies and relink the access records of each resource, so the transitions
+    // and lifetimes only take into account the passes that are executed
+    std::vector<bool> had_accesses(m_resources.size(), false);
+    std::vector<RenderGraphAccessRecord::Link> last_accesses(m_resources.size());
+
+    for (RenderGraphResourceDescription& resource_desc : m_resources)
+    {
+        had_accesses[resource_desc.resource.id] = resource_desc.usage != RenderGraphResourceUsageBits::None;
+
+        resource_desc.usage = RenderGraphResourceUsageBits::None;
+        resource_desc.first_pass_idx = std::numeric_limits<size_t>::max();
+        resource_desc.last_pass_idx = std::numeric_limits<size_t>::min();
+    }
+
+    for (RenderGraphPassBuilder& pass_info : m_passes)
+    {
+        if (pass_info.m_culled)
+            continue;
+
+        pass_info.m_pass_outputs.erase(
+            std::remove_if(
+                pass_info.m_pass_outputs.begin(),
+                pass_info.m_pass_outputs.end(),
+                [&](size_t output_idx) { return m_passes[output_idx].m_culled; }),
+            pass_info.m_pass_outputs.end());
+
+        for (size_t access_idx = 0; access_idx < pass_info.m_accesses.size(); ++access_idx)
+        {
+            RenderGraphAccessRecord& access = pass_info.m_accesses[access_idx];
+            RenderGraphAccessRecord::Link& last_access = last_accesses[access.resource.id];
+
+            access.prev = last_access;
+            access.next = {};
+
+            if (last_access.is_valid())
+                get_access_record(last_access).next = {pass_info.m_pass_idx, access_idx};
+
+            last_access = {pass_info.m_pass_idx, access_idx};
+
+            RenderGraphResourceDescription& resource_desc = get_resource_desc(access.resource);
+            resource_desc.usage |= access.usage;
+            resource_desc.first_pass_idx = std::min(resource_desc.first_pass_idx, pass_info.m_pass_idx);
+            resource_desc.last_pass_idx = std::max(resource_desc.last_pass_idx, pass_info.m_pass_idx);
+        }
+    }
+
+    for (RenderGraphResourceDescription& resource_desc : m_resources)
+    {
+        resource_desc.culled =
+            had_accesses[resource_desc.resource.id] && resource_desc.usage == RenderGraphResourceUsageBits::None;
+        m_num_culled_resources += resource_desc.culled ? 1 : 0;
+    }
+}
+
+bool RenderGraphBuilder::is_pass_culled(std::string_view name) const
+{
+    for (const RenderGraphPassBuilder& pass_info : m_passes)
+    {
+        if (pass_info.m_name == name)
+            return pass_info.m_culled;
+    }
+
+    MIZU_UNREACHABLE("No pass with name '{}' found in the RenderGraphBuilder", name);
+    return false;
+}
+
+bool RenderGraphBuilder::is_resource_culled(RenderGraphResource resource) const
+{
+    return get_resource_desc(resource).culled;
+}
+
+void RenderGraphBuilder::analyze_graph(std::vector<CommandBufferBatch>& batches, std::vector<size_t>& pass_to_batch)
+{
+    MIZU_PROFILE_SCOPED;
 
     const auto topology_sort_cmp = [&](size_t a, size_t b) -> bool {
         const RenderGraphPassBuilder& pass_a = m_passes[a];
@@ -545,8 +920,10 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
         return (bits[i / BITSET_SIZE] >> (i % BITSET_SIZE)) & 1;
     };
 
-    const auto union_bits = [&](std::vector<uint64_t>& dst, const std::vector<uint64_t>& src) {
-        for (size_t w = 0; w < words; ++w)
+    // Used for both pass and batch bitsets, which have different sizes
+    const auto union_bits = [](std::vector<uint64_t>& dst, const std::vector<uint64_t>& src) {
+        MIZU_ASSERT(dst.size() == src.size(), "Bitsets have different sizes");
+        for (size_t w = 0; w < dst.size(); ++w)
             dst[w] |= src[w];
     };
 
@@ -563,12 +940,17 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
 
     MIZU_PROFILE_ZONE_BEGIN_NAME(topological_sort_ctx, "Topological Sort");
 
+    auto stage_start = std::chrono::steady_clock::now();
+
     std::vector<uint32_t> in_degree(m_passes.size(), 0);
     std::vector<bool> has_cross_queue_dep(m_passes.size(), false);
     std::vector<bool> has_cross_queue_out(m_passes.size(), false);
 
     for (const RenderGraphPassBuilder& pass_info : m_passes)
     {
+        if (pass_info.m_culled)
+            continue;
+
         const CommandBufferType pass_type = pass_hint_to_command_buffer_type(pass_info.m_hint);
 
         for (size_t output_idx : pass_info.m_pass_outputs)
@@ -589,12 +971,14 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
     std::priority_queue<size_t, std::vector<size_t>, decltype(topology_sort_cmp)> priority_queue(topology_sort_cmp);
     for (size_t i = 0; i < m_passes.size(); ++i)
     {
-        if (in_degree[i] == 0)
+        if (!m_passes[i].m_culled && in_degree[i] == 0)
             priority_queue.push(i);
     }
 
+    const size_t num_live_passes = m_passes.size() - m_num_culled_passes;
+
     std::vector<size_t> sorted_topology;
-    sorted_topology.reserve(m_passes.size());
+    sorted_topology.reserve(num_live_passes);
 
     while (!priority_queue.empty())
     {
@@ -612,15 +996,19 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
         }
     }
 
-    MIZU_ASSERT(sorted_topology.size() == m_passes.size(), "A cycle was detected in the RenderGraph");
+    MIZU_ASSERT(sorted_topology.size() == num_live_passes, "A cycle was detected in the RenderGraph");
 
     MIZU_PROFILE_ZONE_END(topological_sort_ctx);
 
+    m_compile_stats.topological_sort_ns = render_graph_elapsed_ns(stage_start);
+
     // Transitive reduction
 
     MIZU_PROFILE_ZONE_BEGIN_NAME(transitive_reduction_ctx, "Transitive Reduction");
 
-    std::vector<std::vector<uint64_t>> reachable_vec(sorted_topology.size(), std::vector<uint64_t>(words, 0));
+    stage_start = std::chrono::steady_clock::now();
+
+    std::vector<std::vector<uint64_t>> reachable_vec(m_passes.size(), std::vector<uint64_t>(words, 0));
 
     for (size_t pass_idx : sorted_topology | std::views::reverse)
     {
@@ -660,14 +1048,17 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
 
     MIZU_PROFILE_ZONE_END(transitive_reduction_ctx);
 
+    m_compile_stats.transitive_reduction_ns = render_graph_elapsed_ns(stage_start);
+
     // Merge passes
 
     MIZU_PROFILE_ZONE_BEGIN_NAME(merge_passes_ctx, "Merge Passes");
 
-    std::vector<CommandBufferBatch>& batches = graph.m_command_buffer_batches;
-    batches.reserve(m_passes.size());
+    stage_start = std::chrono::steady_clock::now();
+
+    batches.reserve(num_live_passes);
 
-    std::vector<size_t> pass_to_batch(m_passes.size(), std::numeric_limits<size_t>::max());
+    pass_to_batch.assign(m_passes.size(), std::numeric_limits<size_t>::max());
 
     constexpr size_t INVALID_BATCH_IDX = std::numeric_limits<size_t>::max();
     std::array<size_t, meta::enum_count_v<CommandBufferType>> last_unsealed = {
@@ -741,10 +1132,14 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
 
     MIZU_PROFILE_ZONE_END(merge_passes_ctx);
 
+    m_compile_stats.merge_passes_ns = render_graph_elapsed_ns(stage_start);
+
     // Resource sharing info
 
     MIZU_PROFILE_ZONE_BEGIN_NAME(resource_sharing_ctx, "Resource Sharing");
 
+    stage_start = std::chrono::steady_clock::now();
+
     const size_t batch_words = (batches.size() + BITSET_SIZE - 1) / BITSET_SIZE;
     std::vector<std::vector<uint64_t>> batch_reachable(batches.size(), std::vector<uint64_t>(batch_words, 0));
 
@@ -762,6 +1157,9 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
     for (size_t pass_idx = 0; pass_idx < m_passes.size(); ++pass_idx)
     {
         const RenderGraphPassBuilder& pass_info = m_passes[pass_idx];
+        if (pass_info.m_culled)
+            continue;
+
         const size_t batch_idx = pass_to_batch[pass_idx];
 
         for (const RenderGraphAccessRecord& access : pass_info.m_accesses)
@@ -820,12 +1218,223 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
 
     MIZU_PROFILE_ZONE_END(resource_sharing_ctx);
 
+    m_compile_stats.resource_sharing_ns = render_graph_elapsed_ns(stage_start);
+}
+
+template <typename T>
+static uint64_t render_graph_topology_word(T value)
+{
+    if constexpr (std::is_enum_v<T>)
+        return static_cast<uint64_t>(static_cast<std::underlying_type_t<T>>(value));
+    else
+        return static_cast<uint64_t>(value);
+}
+
+template <typename... Args>
+static void render_graph_append_key(RenderGraphTopologyKey& key, const Args&... values)
+{
+    (key.append(render_graph_topology_word(values)), ...);
+}
+
+void RenderGraphBuilder::build_topology_key(RenderGraphTopologyKey& out_key) const
+{
+    MIZU_PROFILE_SCOPED;
+
+    out_key.clear();
+
+    render_graph_append_key(
+        out_key, m_config.async_compute_enabled, m_config.async_copy_enabled, m_config.cull_unused_passes);
+    render_graph_append_key(
+        out_key, m_config.aliasing_heuristic, m_config.separate_buffer_texture_heaps, m_config.separate_queue_heaps);
+    render_graph_append_key(out_key, m_resources.size(), m_passes.size());
+
+    for (const RenderGraphResourceDescription& resource_desc : m_resources)
+    {
+        render_graph_append_key(out_key, resource_desc.type, resource_desc.is_external());
+
+        // External resources are bound every frame, only their states (and the format of images, which decides the
+        // attachment state) are part of the compiled transitions
+        if (resource_desc.is_external())
+        {
+            const RenderGraphExternalResourceDescription& external_desc =
+                m_external_resources[resource_desc.external_index];
+
+            switch (resource_desc.type)
+            {
+            case RenderGraphResourceType::Buffer: {
+                const RenderGraphExternalBufferState state = external_desc.buffer_state();
+                render_graph_append_key(out_key, state.initial_state, state.final_state);
+                break;
+            }
+            case RenderGraphResourceType::Texture: {
+                const RenderGraphExternalImageState state = external_desc.image_state();
+                render_graph_append_key(
+                    out_key, state.initial_state, state.final_state, external_desc.image()->get_format());
+                break;
+            }
+            case RenderGraphResourceType::AccelerationStructure: {
+                const RenderGraphExternalAccelStructState state = external_desc.acceleration_structure_state();
+                render_graph_append_key(out_key, state.initial_state, state.final_state);
+                break;
+            }
+            }
+
+            continue;
+        }
+
+        switch (resource_desc.type)
+        {
+        case RenderGraphResourceType::Buffer: {
+            const BufferDescription& desc = resource_desc.buffer();
+            render_graph_append_key(
+                out_key, desc.size, desc.stride, desc.usage, desc.sharing_mode, desc.queue_families.to_ulong());
+            break;
+        }
+        case RenderGraphResourceType::Texture: {
+            const ImageDescription& desc = resource_desc.image();
+            render_graph_append_key(
+                out_key, desc.width, desc.height, desc.depth, desc.type, desc.format, desc.usage, desc.flags);
+            render_graph_append_key(
+                out_key, desc.sharing_mode, desc.queue_families.to_ulong(), desc.num_mips, desc.num_layers);
+            break;
+        }
+        case RenderGraphResourceType::AccelerationStructure:
+            break;
+        }
+    }
+
+    for (const RenderGraphPassBuilder& pass_info : m_passes)
+    {
+        render_graph_append_key(out_key, pass_info.m_hint, pass_info.m_has_side_effects, pass_info.m_accesses.size());
+
+        for (const RenderGraphAccessRecord& access : pass_info.m_accesses)
+        {
+            render_graph_append_key(out_key, access.resource.id, access.usage);
+        }
+    }
+}
+
+void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCompileOptions& options)
+{
+    MIZU_PROFILE_SCOPED;
+
+    const auto compile_start = std::chrono::steady_clock::now();
+
+    graph.reset();
+
+    MIZU_ASSERT(!m_passes.empty(), "Can't compile RenderGraph without passes");
+
+    const DeviceProperties& device_props = g_render_device->get_properties();
+
+    // Only use async compute if the device supports it
+    m_config.async_compute_enabled = m_config.async_compute_enabled && device_props.async_compute;
+
+    TransientMemoryPool& transient_pool = options.transient_pool;
+    RenderGraphResourceRegistry& resource_registry = options.resource_registry;
+
+    RenderGraphCompileStats& stats = m_compile_stats;
+    stats = RenderGraphCompileStats{
+        .num_cache_hits = stats.num_cache_hits,
+        .num_cache_misses = stats.num_cache_misses,
+    };
+
+    //
+    // Pass culling
+    //
+
+    auto stage_start = std::chrono::steady_clock::now();
+
+    cull_passes();
+
+    stats.num_culled_passes = m_num_culled_passes;
+    stats.num_culled_resources = m_num_culled_resources;
+    stats.cull_passes_ns = render_graph_elapsed_ns(stage_start);
+
+    //
+    // Compile cache
+    //
+
+    stage_start = std::chrono::steady_clock::now();
+
+    // Always holds the output of the last cache miss, but it's only reused when caching is enabled
+    RenderGraphCompileCache& cache = *m_compile_cache;
+
+    if (m_config.cache_compiled_topology)
+    {
+        build_topology_key(m_topology_key);
+    }
+
+    const bool cache_hit = m_config.cache_compiled_topology && cache.valid && cache.topology_key == m_topology_key;
+
+    if (m_config.cache_compiled_topology)
+    {
+        stats.num_cache_hits += cache_hit ? 1 : 0;
+        stats.num_cache_misses += cache_hit ? 0 : 1;
+    }
+
+    if (!cache_hit)
+    {
+        cache.invalidate();
+    }
+
+    stats.hash_topology_ns = render_graph_elapsed_ns(stage_start);
+
+    //
+    // Graph analysis
+    //
+
+    std::vector<CommandBufferBatch>& batches = graph.m_command_buffer_batches;
+    const std::vector<size_t>& pass_to_batch = cache.pass_to_batch;
+
+    if (cache_hit)
+    {
+        MIZU_ASSERT(
+            cache.resources.size() == m_resources.size() && cache.pass_to_batch.size() == m_passes.size(),
+            "Compile cache doesn't match the graph ({} resources, {} passes)",
+            m_resources.size(),
+            m_passes.size());
+
+        // Copy constructed one by one, CommandBufferBatch can't be copy assigned
+        batches.reserve(cache.batches.size());
+        for (const CommandBufferBatch& batch : cache.batches)
+        {
+            batches.push_back(batch);
+        }
+
+        for (size_t res_idx = 0; res_idx < m_resources.size(); ++res_idx)
+        {
+            m_resources[res_idx].used_queue_types = cache.resources[res_idx].used_queue_types;
+            m_resources[res_idx].concurrent_usage = cache.resources[res_idx].concurrent_usage;
+        }
+    }
+    else
+    {
+        analyze_graph(batches, cache.pass_to_batch);
+
+        cache.batches.reserve(batches.size());
+        for (const CommandBufferBatch& batch : batches)
+        {
+            cache.batches.push_back(batch);
+        }
+
+        cache.resources.reserve(m_resources.size());
+        for (const RenderGraphResourceDescription& resource_desc : m_resources)
+        {
+            cache.resources.push_back(RenderGraphCompiledResource{
+                .used_queue_types = resource_desc.used_queue_types,
+                .concurrent_usage = resource_desc.concurrent_usage,
+            });
+        }
+    }
+
     //
     // Create resources
     //
 
     MIZU_PROFILE_ZONE_BEGIN_NAME(create_resources_ctx, "Create Resources");
 
+    stage_start = std::chrono::steady_clock::now();
+
     std::unordered_map<RenderGraphResource, std::shared_ptr<BufferResource>> buffer_resources_map;
     buffer_resources_map.reserve(m_resources.size());
     std::unordered_map<RenderGraphResource, std::shared_ptr<ImageResource>> image_resources_map;
@@ -834,17 +1443,24 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
         acceleration_structure_resources_map;
     acceleration_structure_resources_map.reserve(m_resources.size());
 
-    std::vector<AliasingResource> aliasing_resources;
-    aliasing_resources.reserve(m_resources.size());
+    std::vector<AliasingResource>& aliasing_resources = cache.aliasing_resources;
+    if (!cache_hit)
+    {
+        aliasing_resources.reserve(m_resources.size());
+    }
 
     for (RenderGraphResourceDescription& resource_desc : m_resources)
     {
         if (resource_desc.usage == RenderGraphResourceUsageBits::None)
         {
-            MIZU_LOG_WARNING(
-                "Resource with id {} and name {} does not have any usages, ignoring",
-                resource_desc.resource.id,
-                std::visit([&](const auto& value) -> std::string_view { return value.name; }, resource_desc.desc));
+            if (!cache_hit && !resource_desc.culled)
+            {
+                MIZU_LOG_WARNING(
+                    "Resource with id {} and name {} does not have any usages, ignoring",
+                    resource_desc.resource.id,
+                    std::visit(
+                        [&](const auto& value) -> std::string_view { return value.name; }, resource_desc.desc));
+            }
             continue;
         }
 
@@ -878,6 +1494,7 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
 
         MemoryRequirements memory_reqs{};
 
+        // The final descriptions are also needed on a cache hit, to find the resources in the registry
         switch (resource_desc.type)
         {
         case RenderGraphResourceType::Buffer: {
@@ -891,7 +1508,10 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
                 desc.queue_families = resource_desc.used_queue_types;
             }
 
-            memory_reqs = g_render_device->get_buffer_memory_requirements(desc);
+            if (!cache_hit)
+            {
+                memory_reqs = g_render_device->get_buffer_memory_requirements(desc);
+            }
 
             break;
         }
@@ -906,7 +1526,10 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
                 desc.queue_families = resource_desc.used_queue_types;
             }
 
-            memory_reqs = g_render_device->get_image_memory_requirements(desc);
+            if (!cache_hit)
+            {
+                memory_reqs = g_render_device->get_image_memory_requirements(desc);
+            }
 
             break;
         }
@@ -917,23 +1540,42 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
         }
         }
 
+        if (cache_hit)
+            continue;
+
         AliasingResource aliasing_resource{};
         aliasing_resource.resource = resource_desc.resource;
         aliasing_resource.begin = resource_desc.first_pass_idx;
         aliasing_resource.end = resource_desc.last_pass_idx;
         aliasing_resource.size = memory_reqs.size;
         aliasing_resource.alignment = memory_reqs.alignment;
+        aliasing_resource.heap = get_transient_heap(resource_desc);
 
         aliasing_resources.push_back(aliasing_resource);
     }
 
-    uint64_t total_size = 0;
-    render_graph_alias_resources(aliasing_resources, total_size);
+    if (!cache_hit)
+    {
+        cache.aliasing_result = render_graph_alias_resources(aliasing_resources, m_config.aliasing_heuristic);
+    }
 
-    if (transient_pool.get_committed_size() < total_size)
+    const uint64_t total_size = cache.aliasing_result.total_size;
+
+    stats.num_transient_resources = aliasing_resources.size();
+    stats.num_transient_heaps = cache.aliasing_result.num_heaps;
+    stats.transient_memory_size = total_size;
+    stats.transient_memory_unaliased_size = cache.aliasing_result.unaliased_size;
+    stats.transient_memory_lower_bound = cache.aliasing_result.lower_bound_size;
+
+    const uint64_t committed_size = transient_pool.get_committed_size();
+    if (committed_size < total_size)
     {
+        // The pool keeps its high-water mark, growing it over the required size so graphs that grow a bit every frame
+        // don't drop the pool and the cached resources each time
         transient_pool.reset();
         resource_registry.reset();
+
+        transient_pool.reserve(std::max(total_size, committed_size + committed_size / 2));
     }
 
     for (const AliasingResource& resource : aliasing_resources)
@@ -966,22 +1608,125 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
         transient_pool.get_committed_size() >= total_size,
         "Transient memory pool committed less memory than the total size of resources");
 
+    stats.transient_memory_committed_size = transient_pool.get_committed_size();
+
     resource_registry.purge();
 
     MIZU_PROFILE_ZONE_END(create_resources_ctx);
 
+    stats.create_resources_ns = render_graph_elapsed_ns(stage_start);
+
     //
     // Create passes
     //
 
     MIZU_PROFILE_ZONE_BEGIN_NAME(create_passes_ctx, "Create Passes");
 
+    stage_start = std::chrono::steady_clock::now();
+
+    // Binds the frame's resources and execute functions to a command compiled by a previous frame
+    const auto replay_compiled_cmd = [&](CommandBufferBatch& batch, const RenderGraphCompiledCmd& compiled_cmd) {
+        std::visit(
+            [&](const auto& cmd) {
+                using CmdT = std::decay_t<decltype(cmd)>;
+
+                if constexpr (std::is_same_v<CmdT, RenderGraphCompiledPass>)
+                {
+                    MIZU_ASSERT(cmd.pass_idx < m_passes.size(), "Compiled pass {} is out of range", cmd.pass_idx);
+                    const RenderGraphPassBuilder& pass_info = m_passes[cmd.pass_idx];
+
+                    const size_t pass_resources_idx = graph.m_pass_resources.size();
+                    RenderGraphPassResources& pass_resources = graph.m_pass_resources.emplace_back();
+
+                    for (const RenderGraphAccessRecord& access : pass_info.get_access_records())
+                    {
+                        const RenderGraphResource resource = access.resource;
+
+                        switch (get_resource_desc(resource).type)
+                        {
+                        case RenderGraphResourceType::Buffer:
+                            pass_resources.add_resource(resource, buffer_resources_map.at(resource), access.usage);
+                            break;
+                        case RenderGraphResourceType::Texture:
+                            pass_resources.add_resource(resource, image_resources_map.at(resource), access.usage);
+                            break;
+                        case RenderGraphResourceType::AccelerationStructure:
+                            pass_resources.add_resource(
+                                resource, acceleration_structure_resources_map.at(resource), access.usage);
+                            break;
+                        }
+                    }
+
+                    const PassExecuteCmd execute_cmd{
+                        pass_info.m_name,
+                        std::move(pass_info.m_execute_func),
+                        pass_resources_idx,
+                        pass_info.m_allow_parallel_recording};
+                    batch.commands.push_back(execute_cmd);
+                }
+                else if constexpr (std::is_same_v<CmdT, RenderGraphCompiledTransition<BufferResourceState>>)
+                {
+                    const BufferTransitionCmd transition_cmd{
+                        *buffer_resources_map.at(cmd.resource),
+                        cmd.initial,
+                        cmd.final,
+                        cmd.src_queue_type,
+                        cmd.dst_queue_type,
+                        cmd.transition_mode};
+                    batch.commands.push_back(transition_cmd);
+                }
+                else if constexpr (std::is_same_v<CmdT, RenderGraphCompiledTransition<ImageResourceState>>)
+                {
+                    const ImageTransitionCmd transition_cmd{
+                        *image_resources_map.at(cmd.resource),
+                        cmd.initial,
+                        cmd.final,
+                        cmd.src_queue_type,
+                        cmd.dst_queue_type,
+                        cmd.transition_mode};
+                    batch.commands.push_back(transition_cmd);
+                }
+                else
+                {
+                    const AccelStructTransitionCmd transition_cmd{
+                        *acceleration_structure_resources_map.at(cmd.resource),
+                        cmd.initial,
+                        cmd.final,
+                        cmd.src_queue_type,
+                        cmd.dst_queue_type,
+                        cmd.transition_mode};
+                    batch.commands.push_back(transition_cmd);
+                }
+            },
+            compiled_cmd);
+    };
+
+    if (!cache_hit)
+    {
+        cache.batch_commands.resize(batches.size());
+    }
+
+    const auto batch_transitions = [&](CommandBufferBatch& batch) {
+        if (m_config.batch_transitions)
+        {
+            render_graph_batch_transitions(batch, cache.batch_commands[batch.idx], m_passes, m_config, stats);
+            return;
+        }
+
+        for (const RenderGraphCmd& cmd : batch.commands)
+        {
+            if (std::holds_alternative<PassExecuteCmd>(cmd))
+                continue;
+
+            stats.num_transitions += 1;
+            stats.num_barriers += 1;
+        }
+    };
+
     std::map<std::pair<size_t, size_t>, std::shared_ptr<Semaphore>> cross_queue_barriers_map;
 
     for (CommandBufferBatch& batch : batches)
     {
-        batch.command_buffer = g_render_device->create_command_buffer(batch.type);
-
         for (size_t output_batch_idx : batch.outgoing_batch_indices)
         {
             // If the output batch is on the same queue, no need for semaphore
@@ -1018,6 +1763,21 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
             batch.submit_info.wait_semaphores.push_back(it->second);
         }
 
+        if (cache_hit)
+        {
+            MIZU_ASSERT(batch.idx < cache.batch_commands.size(), "Compiled batch {} is out of range", batch.idx);
+
+            for (const RenderGraphCompiledCmd& compiled_cmd : cache.batch_commands[batch.idx])
+            {
+                replay_compiled_cmd(batch, compiled_cmd);
+            }
+
+            batch_transitions(batch);
+            continue;
+        }
+
+        std::vector<RenderGraphCompiledCmd>& compiled_commands = cache.batch_commands[batch.idx];
+
         for (size_t pass_idx : batch.pass_indices)
         {
             const RenderGraphPassBuilder& pass_info = m_passes[pass_idx];
@@ -1034,6 +1794,7 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
             for (const RenderGraphAccessRecord& access : pass_info.get_access_records())
             {
                 const RenderGraphResourceDescription& resource_desc = get_resource_desc(access.resource);
+                const size_t first_cmd_idx = batch.commands.size();
 
                 switch (resource_desc.type)
                 {
@@ -1067,16 +1828,25 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
                     break;
                 }
                 }
+
+                render_graph_record_transitions(batch, first_cmd_idx, access.resource, compiled_commands);
             }
 
             // Add pass execution function
-            const PassExecuteCmd cmd{pass_info.m_name, std::move(pass_info.m_execute_func), pass_resources_idx};
+            const PassExecuteCmd cmd{
+                pass_info.m_name,
+                std::move(pass_info.m_execute_func),
+                pass_resources_idx,
+                pass_info.m_allow_parallel_recording};
             batch.commands.push_back(cmd);
 
+            compiled_commands.push_back(RenderGraphCompiledPass{pass_idx});
+
             // Check if any release barriers or external resource transitions are needed and add them
             for (const RenderGraphAccessRecord& access : pass_info.get_access_records())
             {
                 const RenderGraphResourceDescription& resource_desc = get_resource_desc(access.resource);
+                const size_t first_cmd_idx = batch.commands.size();
 
                 switch (resource_desc.type)
                 {
@@ -1097,11 +1867,38 @@ void RenderGraphBuilder::compile(RenderGraph& graph, const RenderGraphBuilderCom
                     break;
                 }
                 }
+
+                render_graph_record_transitions(batch, first_cmd_idx, access.resource, compiled_commands);
             }
         }
+
+        batch_transitions(batch);
     }
 
     MIZU_PROFILE_ZONE_END(create_passes_ctx);
+
+    // Command lists create their command buffers on the recording threads, so batches only need one when the graph
+    // is recorded serially
+    const bool record_command_lists =
+        m_config.parallel_recording && g_job_system != nullptr && graph.build_command_lists() > 0;
+
+    if (!record_command_lists)
+    {
+        for (CommandBufferBatch& batch : batches)
+        {
+            batch.command_buffer = g_render_device->create_command_buffer(batch.type);
+        }
+    }
+
+    stats.create_passes_ns = render_graph_elapsed_ns(stage_start);
+
+    if (!cache_hit)
+    {
+        cache.topology_key = m_topology_key;
+        cache.valid = m_config.cache_compiled_topology;
+    }
+
+    stats.total_ns = render_graph_elapsed_ns(compile_start);
 }
 
 const RenderGraphAccessRecord& RenderGraphBuilder::get_access_record(RenderGraphAccessRecord::Link link) const
@@ -1489,7 +2286,7 @@ void RenderGraphBuilder::add_accel_struct_release_transition(
 
 bool RenderGraphBuilder::validate_render_pass_builder(const RenderGraphPassBuilder& pass)
 {
-    if (!pass.m_has_outputs)
+    if (!pass.m_has_outputs && !pass.m_has_side_effects)
     {
         MIZU_LOG_WARNING("Pass '{}' has no outputs, culling", pass.m_name);
         return false;
@@ -1498,6 +2295,23 @@ bool RenderGraphBuilder::validate_render_pass_builder(const RenderGraphPassBuild
     return true;
 }
 
+size_t RenderGraphBuilder::get_transient_heap(const RenderGraphResourceDescription& resource_desc) const
+{
+    size_t heap = 0;
+
+    if (m_config.separate_queue_heaps)
+    {
+        heap = resource_desc.used_queue_types.to_ulong() << 1;
+    }
+
+    if (m_config.separate_buffer_texture_heaps && resource_desc.type == RenderGraphResourceType::Texture)
+    {
+        heap |= 1;
+    }
+
+    return heap;
+}
+
 BufferUsageBits RenderGraphBuilder::get_buffer_usage_bits(RenderGraphResourceUsageBits usage)
 {
     BufferUsageBits usage_bits = BufferUsageBits::None;
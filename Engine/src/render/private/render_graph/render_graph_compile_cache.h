@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include "render/render_graph/render_graph_builder.h"
+#include "render_graph/render_graph_resource_aliasing.h"
+
+namespace Mizu
+{
+
+// Transition with the resource stored as a RenderGraphResource, resolved to the frame's resource when replayed
+template <typename StateT>
+struct RenderGraphCompiledTransition
+{
+    RenderGraphResource resource{};
+    StateT initial{};
+    StateT final{};
+
+    std::optional<CommandBufferType> src_queue_type;
+    std::optional<CommandBufferType> dst_queue_type;
+    ResourceTransitionMode transition_mode = ResourceTransitionMode::Normal;
+};
+
+struct RenderGraphCompiledPass
+{
+    size_t pass_idx = 0;
+};
+
+using RenderGraphCompiledCmd = std::variant<
+    RenderGraphCompiledTransition<BufferResourceState>,
+    RenderGraphCompiledTransition<ImageResourceState>,
+    RenderGraphCompiledTransition<AccelerationStructureResourceState>,
+    RenderGraphCompiledPass>;
+
+struct RenderGraphCompiledResource
+{
+    typed_bitset<CommandBufferType> used_queue_types{};
+    bool concurrent_usage = false;
+};
+
+// Output of RenderGraphBuilder::compile that only depends on the declared topology. While the topology doesn't change,
+// compile reuses it and only binds the frame's resources and execute functions.
+struct RenderGraphCompileCache
+{
+    RenderGraphTopologyKey topology_key;
+    bool valid = false;
+
+    // Batches without commands, command buffers or submit info
+    std::vector<CommandBufferBatch> batches;
+    std::vector<size_t> pass_to_batch;
+
+    std::vector<RenderGraphCompiledResource> resources;
+    std::vector<AliasingResource> aliasing_resources;
+    AliasingResult aliasing_result{};
+
+    // Indexed by batch
+    std::vector<std::vector<RenderGraphCompiledCmd>> batch_commands;
+
+    void invalidate()
+    {
+        valid = false;
+
+        topology_key.clear();
+        batches.clear();
+        pass_to_batch.clear();
+        resources.clear();
+        aliasing_resources.clear();
+        aliasing_result = AliasingResult{};
+        batch_commands.clear();
+    }
+};
+
+} // namespace Mizu
@@ -1,9 +1,15 @@
 #include "render_graph/render_graph_resource_aliasing.h"
 
 #include <algorithm>
+#include <limits>
+#include <numeric>
 #include <set>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "base/debug/assert.h"
+#include "base/debug/logging.h"
 #include "base/debug/profiling.h"
 
 namespace Mizu
@@ -20,10 +26,14 @@ static inline uint64_t align_up(uint64_t value, uint64_t align)
     return (value + align - 1) & ~(align - 1);
 }
 
-void render_graph_alias_resources(std::vector<AliasingResource>& resources, uint64_t& out_total_size)
+static inline bool lifetimes_overlap(const AliasingResource& a, const AliasingResource& b)
 {
-    MIZU_PROFILE_SCOPED;
+    return a.begin <= b.end && b.begin <= a.end;
+}
 
+// Sweeps the resources by first use, releasing the memory of the resources that are no longer used into a free list
+static uint64_t alias_resources_free_list(std::span<AliasingResource> resources, bool best_fit)
+{
     std::sort(resources.begin(), resources.end(), [](const AliasingResource& a, const AliasingResource& b) {
         if (a.begin != b.begin)
             return a.begin < b.begin;
@@ -47,13 +57,15 @@ void render_graph_alias_resources(std::vector<AliasingResource>& resources, uint
         while (!active_allocations.empty() && active_allocations.begin()->end < resource.begin)
         {
             const auto expired_it = active_allocations.begin();
-            const AliasingResource& expired = *expired_it;
 
             FreeBlock free_block = FreeBlock{
-                .offset = expired.offset,
-                .size = expired.size,
+                .offset = expired_it->offset,
+                .size = expired_it->size,
             };
 
+            // Erase by iterator, erasing by key would also erase the other allocations that end in the same pass
+            active_allocations.erase(expired_it);
+
             auto free_blocks_it = std::lower_bound(
                 free_blocks.begin(), free_blocks.end(), free_block, [](const FreeBlock& a, const FreeBlock& b) {
                     return a.offset < b.offset;
@@ -84,47 +96,243 @@ void render_graph_alias_resources(std::vector<AliasingResource>& resources, uint
             {
                 free_blocks.insert(free_blocks_it, free_block);
             }
-
-            active_allocations.erase(expired);
         }
 
-        bool allocated_from_free_block = false;
+        auto selected_it = free_blocks.end();
+        uint64_t selected_waste = std::numeric_limits<uint64_t>::max();
+
         for (auto it = free_blocks.begin(); it != free_blocks.end(); ++it)
         {
-            const uint64_t aligned_start = align_up(it->offset, resource.alignment);
-            const uint64_t allocation_end = aligned_start + resource.size;
+            const uint64_t allocation_end = align_up(it->offset, resource.alignment) + resource.size;
             const uint64_t block_end = it->offset + it->size;
 
-            if (allocation_end <= block_end)
-            {
-                resource.offset = aligned_start;
+            if (allocation_end > block_end)
+                continue;
 
-                if (allocation_end < block_end)
-                {
-                    it->offset = allocation_end;
-                    it->size = block_end - allocation_end;
-                }
-                else
-                {
-                    free_blocks.erase(it);
-                }
+            const uint64_t waste = block_end - allocation_end;
+            if (waste < selected_waste)
+            {
+                selected_it = it;
+                selected_waste = waste;
+            }
 
-                allocated_from_free_block = true;
+            if (!best_fit || waste == 0)
                 break;
-            }
         }
 
-        if (!allocated_from_free_block)
+        if (selected_it != free_blocks.end())
         {
-            const uint64_t aligned_start = align_up(total_size, resource.alignment);
+            const uint64_t aligned_start = align_up(selected_it->offset, resource.alignment);
+            const uint64_t allocation_end = aligned_start + resource.size;
+            const uint64_t block_end = selected_it->offset + selected_it->size;
+
             resource.offset = aligned_start;
-            total_size = aligned_start + resource.size;
+
+            if (allocation_end < block_end)
+            {
+                selected_it->offset = allocation_end;
+                selected_it->size = block_end - allocation_end;
+            }
+            else
+            {
+                free_blocks.erase(selected_it);
+            }
+        }
+        else if (best_fit && !free_blocks.empty() && free_blocks.back().offset + free_blocks.back().size == total_size)
+        {
+            // Grow the last free block instead of leaving it unused
+            resource.offset = align_up(free_blocks.back().offset, resource.alignment);
+            total_size = resource.offset + resource.size;
+
+            free_blocks.pop_back();
+        }
+        else
+        {
+            resource.offset = align_up(total_size, resource.alignment);
+            total_size = resource.offset + resource.size;
         }
 
         active_allocations.insert(resource);
     }
 
-    out_total_size = total_size;
+    return total_size;
+}
+
+// Builds the interference graph, where resources are connected when their lifetimes overlap, and places the largest
+// resources first at the offset that best fits between the neighbours that have already been placed
+static uint64_t alias_resources_interference_graph(std::span<AliasingResource> resources)
+{
+    std::vector<size_t> order(resources.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return resources[a].begin < resources[b].begin; });
+
+    std::vector<std::vector<size_t>> interferences(resources.size());
+    std::vector<size_t> active;
+
+    for (const size_t idx : order)
+    {
+        const AliasingResource& resource = resources[idx];
+
+        std::erase_if(active, [&](size_t active_idx) { return resources[active_idx].end < resource.begin; });
+
+        for (const size_t active_idx : active)
+        {
+            interferences[idx].push_back(active_idx);
+            interferences[active_idx].push_back(idx);
+        }
+
+        active.push_back(idx);
+    }
+
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const AliasingResource& resource_a = resources[a];
+        const AliasingResource& resource_b = resources[b];
+
+        if (resource_a.size != resource_b.size)
+            return resource_a.size > resource_b.size;
+
+        return resource_a.end - resource_a.begin > resource_b.end - resource_b.begin;
+    });
+
+    std::vector<bool> placed(resources.size(), false);
+    std::vector<std::pair<uint64_t, uint64_t>> used_ranges;
+
+    uint64_t total_size = 0;
+
+    for (const size_t idx : order)
+    {
+        AliasingResource& resource = resources[idx];
+
+        used_ranges.clear();
+        for (const size_t neighbour_idx : interferences[idx])
+        {
+            if (!placed[neighbour_idx])
+                continue;
+
+            const AliasingResource& neighbour = resources[neighbour_idx];
+            MIZU_ASSERT(
+                lifetimes_overlap(resource, neighbour), "Interfering resources must have overlapping lifetimes");
+
+            used_ranges.emplace_back(neighbour.offset, neighbour.offset + neighbour.size);
+        }
+
+        std::sort(used_ranges.begin(), used_ranges.end());
+
+        uint64_t selected_offset = std::numeric_limits<uint64_t>::max();
+        uint64_t selected_waste = std::numeric_limits<uint64_t>::max();
+        uint64_t gap_start = 0;
+
+        for (const auto& [range_begin, range_end] : used_ranges)
+        {
+            const uint64_t aligned_start = align_up(gap_start, resource.alignment);
+            if (range_begin >= aligned_start + resource.size)
+            {
+                const uint64_t waste = range_begin - gap_start - resource.size;
+                if (waste < selected_waste)
+                {
+                    selected_offset = aligned_start;
+                    selected_waste = waste;
+                }
+            }
+
+            gap_start = std::max(gap_start, range_end);
+        }
+
+        if (selected_offset == std::numeric_limits<uint64_t>::max())
+        {
+            selected_offset = align_up(gap_start, resource.alignment);
+        }
+
+        resource.offset = selected_offset;
+        placed[idx] = true;
+
+        total_size = std::max(total_size, resource.offset + resource.size);
+    }
+
+    return total_size;
+}
+
+// Peak of the sum of the sizes of the resources alive at the same time
+static uint64_t get_peak_live_size(std::span<const AliasingResource> resources)
+{
+    // Resources are alive in [begin, end], so they are released at end + 1, before the ones that begin there
+    std::vector<std::pair<size_t, int64_t>> events;
+    events.reserve(resources.size() * 2);
+
+    for (const AliasingResource& resource : resources)
+    {
+        events.emplace_back(resource.begin, static_cast<int64_t>(resource.size));
+        events.emplace_back(resource.end + 1, -static_cast<int64_t>(resource.size));
+    }
+
+    std::sort(events.begin(), events.end());
+
+    int64_t live_size = 0;
+    int64_t peak_size = 0;
+
+    for (const auto& [pass_idx, size_delta] : events)
+    {
+        live_size += size_delta;
+        peak_size = std::max(peak_size, live_size);
+    }
+
+    return static_cast<uint64_t>(peak_size);
+}
+
+AliasingResult render_graph_alias_resources(
+    std::vector<AliasingResource>& resources,
+    RenderGraphAliasingHeuristic heuristic)
+{
+    MIZU_PROFILE_SCOPED;
+
+    std::sort(resources.begin(), resources.end(), [](const AliasingResource& a, const AliasingResource& b) {
+        return a.heap < b.heap;
+    });
+
+    AliasingResult result{};
+
+    for (auto heap_begin = resources.begin(); heap_begin != resources.end();)
+    {
+        const auto heap_end = std::find_if(heap_begin, resources.end(), [&](const AliasingResource& resource) {
+            return resource.heap != heap_begin->heap;
+        });
+
+        const std::span<AliasingResource> heap_resources(heap_begin, heap_end);
+
+        uint64_t heap_size = 0;
+        switch (heuristic)
+        {
+        case RenderGraphAliasingHeuristic::FirstFit:
+            heap_size = alias_resources_free_list(heap_resources, false);
+            break;
+        case RenderGraphAliasingHeuristic::BestFit:
+            heap_size = alias_resources_free_list(heap_resources, true);
+            break;
+        case RenderGraphAliasingHeuristic::InterferenceGraph:
+            heap_size = alias_resources_interference_graph(heap_resources);
+            break;
+        }
+
+        uint64_t heap_alignment = 1;
+        for (const AliasingResource& resource : heap_resources)
+        {
+            heap_alignment = std::max(heap_alignment, resource.alignment);
+            result.unaliased_size += resource.size;
+        }
+
+        const uint64_t heap_offset = align_up(result.total_size, heap_alignment);
+        for (AliasingResource& resource : heap_resources)
+        {
+            resource.offset += heap_offset;
+        }
+
+        result.total_size = heap_offset + heap_size;
+        result.lower_bound_size += get_peak_live_size(heap_resources);
+        result.num_heaps += 1;
+
+        heap_begin = heap_end;
+    }
 
 #if RENDER_GRAPH_RESOURCE_ALIASING_DEBUG
     std::vector<AliasingResource> debug_view = resources;
@@ -134,7 +342,7 @@ void render_graph_alias_resources(std::vector<AliasingResource>& resources, uint
         return a.size > b.size;
     });
 
-    MIZU_LOG_INFO("--- Resource Aliasing Map (Total: {:.2f} MB) ---", out_total_size / (1024.0 * 1024.0));
+    MIZU_LOG_INFO("--- Resource Aliasing Map (Total: {:.2f} MB) ---", result.total_size / (1024.0 * 1024.0));
 
     std::vector<uint64_t> nesting_stack;
     const int base_label_width = 20;
@@ -167,6 +375,8 @@ void render_graph_alias_resources(std::vector<AliasingResource>& resources, uint
     }
     MIZU_LOG_INFO("----------------------------------------------");
 #endif
+
+    return result;
 }
 
 } // namespace Mizu
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "render/render_graph/render_graph_builder.h"
 #include "render/render_graph/render_graph_types.h"
 
 namespace Mizu
@@ -13,8 +14,22 @@ struct AliasingResource
     RenderGraphResource resource;
     size_t begin, end;
     uint64_t size, alignment, offset;
+    // Resources only alias with resources of the same heap
+    size_t heap;
 };
 
-void render_graph_alias_resources(std::vector<AliasingResource>& resources, uint64_t& out_total_size);
+struct AliasingResult
+{
+    uint64_t total_size = 0;
+    uint64_t unaliased_size = 0;
+    // Sum of the peak size of the resources alive at the same time of each heap
+    uint64_t lower_bound_size = 0;
+    size_t num_heaps = 0;
+};
+
+// Sets the offset of each resource, heaps are placed one after the other
+AliasingResult render_graph_alias_resources(
+    std::vector<AliasingResource>& resources,
+    RenderGraphAliasingHeuristic heuristic);
 
-} // namespace Mizu
\ No newline at end of file
+} // namespace Mizu
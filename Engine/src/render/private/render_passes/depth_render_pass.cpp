@@ -33,12 +33,14 @@ void add_depth_prepass(RenderGraphBuilder& builder, RenderGraphBlackboard& black
         "DepthPrepass",
         [&](RenderGraphPassBuilder& pass, PassData& data) {
             pass.set_hint(RenderGraphPassHint::Raster);
+            pass.set_allow_parallel_recording(true);
 
             data.depth = pass.attachment(depth_data.depth);
             data.draw_list_handle = create_draw_list({
                 .raster_pass = get_DepthPrepassRasterPass(),
                 .pass_builder = pass,
                 .frustum = view_data.data.frustum,
+                .sort_mode = DrawListSortMode::FrontToBack,
             });
         },
         [=](CommandBuffer& command, const PassData& data, const RenderGraphPassResources& resources) {
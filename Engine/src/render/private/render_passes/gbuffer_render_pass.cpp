@@ -51,6 +51,7 @@ void add_gbuffer_pass(RenderGraphBuilder& builder, RenderGraphBlackboard& blackb
         "GbufferPass",
         [&](RenderGraphPassBuilder& pass, PassData& data) {
             pass.set_hint(RenderGraphPassHint::Raster);
+            pass.set_allow_parallel_recording(true);
 
             data.gbuffer0 = pass.attachment(gbuffer_data.gbuffer0);
             data.gbuffer1 = pass.attachment(gbuffer_data.gbuffer1);
@@ -61,6 +62,8 @@ void add_gbuffer_pass(RenderGraphBuilder& builder, RenderGraphBlackboard& blackb
                 .raster_pass = get_GBufferRasterPass(),
                 .pass_builder = pass,
                 .frustum = view_data.data.frustum,
+                // With the depth prepass, the depth is already resolved so group the draws by state instead
+                .sort_mode = depth_data.depth_prepass_enabled ? DrawListSortMode::State : DrawListSortMode::FrontToBack,
             });
         },
         [=](CommandBuffer& command, const PassData& data, const RenderGraphPassResources& resources) {
@@ -181,6 +181,7 @@ void add_cascaded_shadow_pass(RenderGraphBuilder& builder, RenderGraphBlackboard
         "CascadedShadowMapping",
         [&](RenderGraphPassBuilder& pass, CascadedShadowPassData& data) {
             pass.set_hint(RenderGraphPassHint::Raster);
+            pass.set_allow_parallel_recording(true);
 
             const RenderSystemsData& systems_data = blackboard.get<RenderSystemsData>();
 
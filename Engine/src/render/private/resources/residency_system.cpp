@@ -7,6 +7,7 @@
 #include "base/debug/profiling.h"
 #include "render_core/rhi/buffer_resource.h"
 
+#include "render/state_manager/static_mesh_state_manager.h"
 #include "render/utils/image_utils.h"
 #include "resources/cpu_loading_pool.h"
 #include "resources/gpu_pools.h"
@@ -648,13 +649,16 @@ MaterialResidencySystem::MaterialResidencySystem(
     , m_request_queue(request_queue)
     , m_texture_residency_system(texture_residency_system)
 {
-    m_pending_records.reserve(StaticMeshConfig::MaxNumHandles);
+    // Every static mesh references a single material
+    const uint64_t max_num_materials = g_static_mesh_state_manager->get_max_num_handles();
 
-    m_free_material_buffer_slots.resize(StaticMeshConfig::MaxNumHandles);
+    m_pending_records.reserve(max_num_materials);
+
+    m_free_material_buffer_slots.resize(max_num_materials);
     std::iota(m_free_material_buffer_slots.rbegin(), m_free_material_buffer_slots.rend(), 0);
 
     BufferDescription material_buffer_desc{};
-    material_buffer_desc.size = StaticMeshConfig::MaxNumHandles * sizeof(uint32_t) * MAX_TEXTURES_PER_MATERIAL;
+    material_buffer_desc.size = max_num_materials * sizeof(uint32_t) * MAX_TEXTURES_PER_MATERIAL;
     material_buffer_desc.stride = sizeof(uint32_t);
     material_buffer_desc.usage = BufferUsageBits::ShaderResource | BufferUsageBits::HostVisible;
     material_buffer_desc.name = "MaterialResidencySystem_MaterialBuffer";
@@ -40,6 +40,7 @@
 #include "resources/streaming_planner.h"
 #include "runtime/swapchain_manager.h"
 #include "scene/scene_system.h"
+#include "state_manager/state_manager_coordinator.h"
 
 namespace Mizu
 {
@@ -159,6 +160,9 @@ JobHandle GameRenderer::create_update_jobs(const JobHandle& wait_job)
                                                  .name("BuildRenderGraph")
                                                  .submit();
 
+    // Render modules may return the same handle several times, release them together
+    g_job_system->release_handles(update_job_handles);
+
     const JobHandle compile_render_graph_prepare_draw_lists_batch =
         g_job_system->schedule_batch()
             .add(JobDescription::create(&GameRenderer::compile_render_graph_job, this).name("CompileRenderGraph"))
@@ -235,11 +239,11 @@ void GameRenderer::get_render_module_update_job_handles(
 
         update_context.label = static_cast<RenderModuleLabel>(label_idx);
 
-        const JobHandle job = module->create_update_jobs(update_context);
+        JobHandle job = module->create_update_jobs(update_context);
 
         if (job != wait_job)
         {
-            out_update_jobs.push_back(job);
+            out_update_jobs.push_back(std::move(job));
         }
     }
 }
@@ -354,6 +358,9 @@ bool GameRenderer::init_render_device(const GameRendererDescription& desc)
             .instance_extensions = vulkan_instance_extensions,
         };
         break;
+    case GraphicsApi::Null:
+        specific_config = NullSpecificConfiguration{};
+        break;
     }
 
     DeviceCreationDescription config{};
@@ -477,7 +484,9 @@ bool GameRenderer::init_state_managers()
 {
     MIZU_ASSERT(g_state_manager_coordinator != nullptr, "StateManagerCoordinator must be initialized");
 
-    g_transform_state_manager = new TransformStateManager{};
+    const RendererSettings& settings = get_setting<RendererSettings>();
+
+    g_transform_state_manager = new TransformStateManager{settings.max_transforms};
     g_state_manager_coordinator->register_state_manager(
         StateManagerRegistrationBuilder::begin(g_transform_state_manager));
 
@@ -490,13 +499,16 @@ bool GameRenderer::init_state_managers()
         StateManagerRegistrationBuilder::begin(g_render_settings_layer_state_manager)
             .depends_on(g_render_view_state_manager));
 
+    // Depends on the layer state manager because both are consumed by the RenderSettingsRegistry, so they can't be
+    // applied at the same time
     g_render_settings_volume_state_manager = new RenderSettingsVolumeStateManager{};
     g_state_manager_coordinator->register_state_manager(
         StateManagerRegistrationBuilder::begin(g_render_settings_volume_state_manager)
             .depends_on(g_transform_state_manager)
-            .depends_on(g_render_view_state_manager));
+            .depends_on(g_render_view_state_manager)
+            .depends_on(g_render_settings_layer_state_manager));
 
-    g_static_mesh_state_manager = new StaticMeshStateManager{};
+    g_static_mesh_state_manager = new StaticMeshStateManager{settings.max_static_meshes};
     g_state_manager_coordinator->register_state_manager(
         StateManagerRegistrationBuilder::begin(g_static_mesh_state_manager).depends_on(g_transform_state_manager));
 
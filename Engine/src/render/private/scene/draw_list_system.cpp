@@ -1,7 +1,8 @@
 #include "render/scene/draw_list_system.h"
 
 #include <algorithm>
-#include <glm/gtc/matrix_transform.hpp>
+#include <bit>
+#include <numeric>
 #include <span>
 
 #include "asset/asset_handle.h"
@@ -10,7 +11,9 @@
 #include "base/debug/logging.h"
 #include "base/debug/profiling.h"
 #include "base/math/aabb.h"
+#include "base/reflection/enum_traits.h"
 #include "base/utils/hash.h"
+#include "base/utils/radix_sort.h"
 #include "core/game_context.h"
 #include "core/runtime.h"
 #include "render_core/rhi/buffer_resource.h"
@@ -21,18 +24,12 @@
 #include "render.pipeline/scene_shaders.h"
 #include "render/runtime/renderer_settings.h"
 #include "render/state_manager/static_mesh_state_manager.h"
-#include "render/state_manager/transform_state_manager.h"
 #include "render/systems/pipeline_cache.h"
 #include "resources/gpu_pools.h"
-#include "scene/scene_system.h"
 
 namespace Mizu
 {
 
-static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
-static constexpr size_t DRAW_ELEMENTS_STRIDE =
-    (StaticMeshConfig::MaxNumHandles + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
-
 static constexpr uint64_t MAX_DRAW_INDIRECT_COMMANDS = 1000;
 
 struct DrawElement
@@ -47,7 +44,7 @@ struct DrawElement
     uint32_t transform_buffer_offset = std::numeric_limits<uint32_t>::max();
     uint32_t draw_index = std::numeric_limits<uint32_t>::max();
 
-    size_t sort_key = 0;
+    size_t instancing_key = 0;
     size_t pipeline_hash = 0;
 
 #if MIZU_DEBUG
@@ -88,15 +85,14 @@ struct GpuCullParams
 // We need this here so that we can keep `DrawElement` and `GpuDrawData` in the cpp.
 DrawListSystem::~DrawListSystem() = default;
 
-DrawListSystem::DrawListSystem(SceneSystem& scene_system, GpuMeshPool& gpu_mesh_pool)
-    : m_scene_system(scene_system)
-    , m_gpu_mesh_pool(gpu_mesh_pool)
+DrawListSystem::DrawListSystem(
+    IDrawListScene& scene,
+    std::shared_ptr<BufferResource> vertex_buffer,
+    std::shared_ptr<BufferResource> index_buffer)
+    : m_scene(scene)
+    , m_vertex_buffer(std::move(vertex_buffer))
+    , m_index_buffer(std::move(index_buffer))
 {
-    constexpr size_t DRAW_ELEMENTS_SIZE = MAX_NUM_COMPILE_LISTS * DRAW_ELEMENTS_STRIDE;
-
-    m_draw_elements.resize(DRAW_ELEMENTS_SIZE);
-    m_draw_data.resize(DRAW_ELEMENTS_SIZE);
-
     const RendererSettings& settings = get_setting<RendererSettings>();
     m_gpu_driven_rendering_enabled = settings.gpu_driven_rendering_enabled;
 }
@@ -121,6 +117,14 @@ void DrawListSystem::reset()
 
     const RendererSettings& settings = get_setting<RendererSettings>();
     m_gpu_driven_rendering_enabled = settings.gpu_driven_rendering_enabled;
+
+    // Caches survive while a view keeps requesting them every frame, they are not kept up to date while the draw lists
+    // are compiled on the gpu
+    for (CompileListCache& cache : m_compile_list_caches)
+    {
+        cache.is_valid = cache.is_valid && cache.is_used && !m_gpu_driven_rendering_enabled;
+        cache.is_used = false;
+    }
 }
 
 void DrawListSystem::build_frame_resources(FrameLinearAllocator& linear_allocator)
@@ -142,8 +146,9 @@ void DrawListSystem::build_frame_resources(FrameLinearAllocator& linear_allocato
             continue;
         }
 
+        const CompileListCache& cache = m_compile_list_caches[compile_list.cache_idx];
         const std::span<const GpuDrawData> draw_data_span =
-            std::span(m_draw_data.data() + compile_list.draw_elements_offset, compile_list.num_draw_data);
+            std::span(cache.draw_data.data(), compile_list.num_draw_data);
 
         const FrameAllocation draw_data_allocation =
             linear_allocator.allocate_structured<GpuDrawData>(compile_list.num_draw_data);
@@ -168,12 +173,15 @@ static size_t hash_frustum(const Frustum& frustum)
     return h;
 }
 
-static size_t hash_compiled_draw_list(const DrawListRequest& request)
+// Identifies the view of a compile list across frames, the frustum is left out so a moving camera keeps its cache
+static size_t hash_compile_list_identity(const DrawListRequest& request)
 {
-    size_t h = 0;
+    return hash_compute(hash_frustum_mask(request.frustum_mask), request.sort_mode, request.frustum.has_value());
+}
 
-    hash_combine(h, hash_frustum_mask(request.frustum_mask));
-    hash_combine(h, request.frustum.has_value());
+static size_t hash_compiled_draw_list(const DrawListRequest& request)
+{
+    size_t h = hash_compile_list_identity(request);
 
     if (request.frustum.has_value())
     {
@@ -241,6 +249,9 @@ DrawListHandle DrawListSystem::create_draw_list(const DrawListRequest& request)
         CompileListRecord& compile_list = m_compile_list_records[compile_idx];
         compile_list.frustum = request.frustum;
         compile_list.frustum_mask = request.frustum_mask;
+        compile_list.sort_mode = request.sort_mode;
+        compile_list.cache_idx = claim_compile_list_cache(
+            hash_compile_list_identity(request), request.frustum, compile_list.rebuild_reason);
 
         m_compile_list_cache.insert({compiled_hash, compile_idx});
     }
@@ -267,24 +278,87 @@ DrawListHandle DrawListSystem::create_draw_list(const DrawListRequest& request)
     return handle;
 }
 
-void DrawListSystem::compile_draw_lists()
+uint32_t DrawListSystem::claim_compile_list_cache(
+    size_t identity_hash,
+    const std::optional<Frustum>& frustum,
+    DrawListRebuildReason& out_rebuild_reason)
 {
-    if (m_gpu_driven_rendering_enabled)
-        return;
+    constexpr uint32_t INVALID_CACHE_IDX = std::numeric_limits<uint32_t>::max();
 
-    const uint32_t num_compile_lists = m_num_compile_lists.load(std::memory_order_relaxed);
-    if (num_compile_lists == 0)
-        return;
+    // Prefer the cache of the same view with the same frustum, then the same view with a different frustum, then a free
+    // cache. Views with the same identity claim their caches in request order.
+    uint32_t same_frustum_idx = INVALID_CACHE_IDX;
+    uint32_t same_identity_idx = INVALID_CACHE_IDX;
+    uint32_t free_idx = INVALID_CACHE_IDX;
 
-    PendingBatch compile_batch = g_job_system->schedule_batch();
+    for (uint32_t i = 0; i < MAX_NUM_COMPILE_LISTS; ++i)
+    {
+        const CompileListCache& cache = m_compile_list_caches[i];
+        if (cache.is_used)
+            continue;
 
-    for (uint32_t i = 0; i < num_compile_lists; ++i)
+        if (cache.is_valid && cache.identity_hash == identity_hash)
+        {
+            if (cache.frustum == frustum)
+            {
+                same_frustum_idx = i;
+                break;
+            }
+
+            if (same_identity_idx == INVALID_CACHE_IDX)
+                same_identity_idx = i;
+        }
+        else if (free_idx == INVALID_CACHE_IDX || (!cache.is_valid && m_compile_list_caches[free_idx].is_valid))
+        {
+            // Invalid caches go first, so valid caches of views that are not requested yet this frame are kept
+            free_idx = i;
+        }
+    }
+
+    uint32_t cache_idx;
+    if (same_frustum_idx != INVALID_CACHE_IDX)
     {
-        compile_batch.add(&DrawListSystem::compile_draw_list_job, this, i);
+        cache_idx = same_frustum_idx;
+        out_rebuild_reason = DrawListRebuildReason::None;
     }
+    else if (same_identity_idx != INVALID_CACHE_IDX)
+    {
+        cache_idx = same_identity_idx;
+        out_rebuild_reason = DrawListRebuildReason::FrustumChanged;
+    }
+    else
+    {
+        cache_idx = free_idx;
+        out_rebuild_reason = DrawListRebuildReason::NewList;
+    }
+
+    // There is a cache for every compile list, so one is always available
+    MIZU_ASSERT(cache_idx != INVALID_CACHE_IDX, "No compile list cache available");
+
+    CompileListCache& cache = m_compile_list_caches[cache_idx];
+    cache.is_used = true;
+    cache.is_valid = cache.is_valid && out_rebuild_reason == DrawListRebuildReason::None;
+    cache.identity_hash = identity_hash;
+    cache.frustum = frustum;
 
-    const JobHandle compile_job_handle = compile_batch.submit();
-    g_job_system->wait_for(compile_job_handle);
+    return cache_idx;
+}
+
+void DrawListSystem::compile_draw_lists()
+{
+    const uint32_t num_compile_lists = m_num_compile_lists.load(std::memory_order_relaxed);
+
+    if (!m_gpu_driven_rendering_enabled && num_compile_lists > 0)
+    {
+        const JobHandle compile_job_handle =
+            g_job_system->parallel_for(JobRange{0, num_compile_lists}, 1, [this](size_t compile_list_idx) {
+                compile_draw_list_job(static_cast<uint32_t>(compile_list_idx));
+            });
+        g_job_system->wait_for(compile_job_handle);
+    }
+
+    // Every cache in use has consumed the changes, caches not in use are invalidated on the next reset
+    m_scene.clear_dirty_renderables();
 }
 
 void DrawListSystem::add_compile_draw_lists_pass(RenderGraphBuilder& builder, FrameLinearAllocator& frame_allocator)
@@ -292,7 +366,7 @@ void DrawListSystem::add_compile_draw_lists_pass(RenderGraphBuilder& builder, Fr
     if (!m_gpu_driven_rendering_enabled)
         return;
 
-    const std::span<const SceneDrawableInfo> drawables = m_scene_system.get_drawables();
+    const std::span<const SceneDrawableInfo> drawables = m_scene.get_drawables();
     if (drawables.empty())
         return;
 
@@ -444,7 +518,7 @@ void DrawListSystem::add_compile_draw_lists_pass(RenderGraphBuilder& builder, Fr
             const std::array writes = {
                 WriteDescriptor::StructuredBufferSrv(0, data.gpu_drawables_allocation.view),
                 WriteDescriptor::StructuredBufferSrv(
-                    1, BufferResourceView::create(m_scene_system.get_transform_info_buffer())),
+                    1, BufferResourceView::create(m_scene.get_transform_info_buffer())),
                 WriteDescriptor::StructuredBufferSrv(2, gpu_cull_params_allocation.view),
                 WriteDescriptor::StructuredBufferUav(0, BufferResourceView::create(visible_indices_buffer)),
                 WriteDescriptor::StructuredBufferUav(
@@ -609,11 +683,81 @@ void DrawListSystem::dispatch_draw_list(
     }
 }
 
-static size_t create_sort_key(size_t pipeline_hash, MeshAssetHandle mesh_handle, MaterialAssetHandle material_handle)
+std::span<const uint32_t> DrawListSystem::get_draw_list_renderables(DrawListHandle handle) const
+{
+    MIZU_ASSERT(handle.is_valid(), "Invalid draw list handle");
+    MIZU_ASSERT(
+        handle.index < m_num_draw_lists.load(std::memory_order_relaxed), "Draw list handle index is out of range");
+
+    const DrawListRecord& record = m_draw_list_records[handle.index];
+    const CompileListRecord& compile_list = m_compile_list_records[record.compiled_draw_list_idx];
+
+    if (!compile_list.is_compiled || m_gpu_driven_rendering_enabled)
+        return {};
+
+    const CompileListCache& cache = m_compile_list_caches[compile_list.cache_idx];
+    return std::span(cache.renderable_ids.data(), compile_list.num_draw_data);
+}
+
+// Draws with the same instancing key are merged into a single instanced draw
+static size_t create_instancing_key(
+    size_t pipeline_hash,
+    MeshAssetHandle mesh_handle,
+    MaterialAssetHandle material_handle)
 {
     return hash_compute(pipeline_hash, mesh_handle.get_id(), material_handle.get_id());
 }
 
+static constexpr uint32_t DRAW_SORT_KEY_PIPELINE_BITS = 8;
+static constexpr uint32_t DRAW_SORT_KEY_MATERIAL_BITS = 20;
+static constexpr uint32_t DRAW_SORT_KEY_MESH_BITS = 20;
+static constexpr uint32_t DRAW_SORT_KEY_DEPTH_BITS = 16;
+
+static_assert(
+    DRAW_SORT_KEY_PIPELINE_BITS + DRAW_SORT_KEY_MATERIAL_BITS + DRAW_SORT_KEY_MESH_BITS + DRAW_SORT_KEY_DEPTH_BITS
+        == 64,
+    "Draw sort key fields must fill 64 bits");
+
+static uint64_t quantize_sort_depth(float distance)
+{
+    // The bits of a positive float are ordered like the float itself, keeping the highest bits gives a quantization
+    // that is more precise close to the camera
+    return std::bit_cast<uint32_t>(std::max(distance, 0.0f)) >> (32 - DRAW_SORT_KEY_DEPTH_BITS);
+}
+
+// Packs the fields used to order the draws of a compile list. Fields are truncated to fit, a collision only makes the
+// order slightly worse because draws are merged using the full `create_instancing_key`.
+static uint64_t create_draw_sort_key(
+    DrawListSortMode sort_mode,
+    size_t pipeline_hash,
+    uint32_t material_buffer_offset,
+    MeshAssetHandle mesh_handle,
+    uint64_t depth)
+{
+    const auto field = [](uint64_t value, uint32_t bits) { return value & ((uint64_t{1} << bits) - 1); };
+
+    const uint64_t pipeline = field(pipeline_hash, DRAW_SORT_KEY_PIPELINE_BITS);
+    const uint64_t material = field(material_buffer_offset, DRAW_SORT_KEY_MATERIAL_BITS);
+    const uint64_t mesh = field(mesh_handle.get_id(), DRAW_SORT_KEY_MESH_BITS);
+
+    switch (sort_mode)
+    {
+    case DrawListSortMode::State:
+        // pipeline | material | mesh | depth
+        return (pipeline << (64 - DRAW_SORT_KEY_PIPELINE_BITS))
+               | (material << (DRAW_SORT_KEY_MESH_BITS + DRAW_SORT_KEY_DEPTH_BITS))
+               | (mesh << DRAW_SORT_KEY_DEPTH_BITS) | depth;
+    case DrawListSortMode::FrontToBack:
+        // pipeline | depth | material | mesh
+        return (pipeline << (64 - DRAW_SORT_KEY_PIPELINE_BITS))
+               | (depth << (DRAW_SORT_KEY_MATERIAL_BITS + DRAW_SORT_KEY_MESH_BITS))
+               | (material << DRAW_SORT_KEY_MESH_BITS) | mesh;
+    }
+
+    MIZU_UNREACHABLE("Invalid DrawListSortMode");
+    return 0;
+}
+
 static size_t create_pipeline_hash(const ShaderInstance& vertex_instance, const ShaderInstance& fragment_instance)
 {
     const auto shader_hash = [](const ShaderInstance& instance) -> size_t {
@@ -624,6 +768,43 @@ static size_t create_pipeline_hash(const ShaderInstance& vertex_instance, const
     return hash_compute(shader_hash(vertex_instance), shader_hash(fragment_instance));
 }
 
+// Drawables that can't be drawn are logged and left out of the compile lists
+static bool is_valid_drawable(const SceneDrawableInfo& drawable)
+{
+    if (!drawable.gpu_mesh_record.allocation.handle.is_valid())
+    {
+        MIZU_LOG_ERROR("Drawable with invalid Gpu mesh allocation handle, skipping.");
+        return false;
+    }
+
+    if (drawable.material_buffer_offset == std::numeric_limits<uint32_t>::max())
+    {
+        MIZU_LOG_ERROR("Drawable with invalid Material buffer offset, skipping.");
+        return false;
+    }
+
+    return true;
+}
+
+static uint64_t create_drawable_sort_key(
+    const IDrawListScene& scene,
+    uint32_t drawable_idx,
+    const std::optional<Frustum>& frustum,
+    DrawListSortMode sort_mode,
+    size_t pipeline_hash)
+{
+    const SceneDrawableInfo& drawable = scene.get_drawables()[drawable_idx];
+
+    uint64_t depth = 0;
+    if (frustum.has_value())
+    {
+        const AABB bounds = scene.get_drawable_world_bounds(drawable_idx);
+        depth = quantize_sort_depth(glm::distance((bounds.min() + bounds.max()) * 0.5f, frustum->center));
+    }
+
+    return create_draw_sort_key(sort_mode, pipeline_hash, drawable.material_buffer_offset, drawable.mesh_handle, depth);
+}
+
 void DrawListSystem::compile_draw_list_job(uint32_t compile_list_idx)
 {
     MIZU_PROFILE_SCOPED;
@@ -632,154 +813,303 @@ void DrawListSystem::compile_draw_list_job(uint32_t compile_list_idx)
         compile_list_idx < m_num_compile_lists.load(std::memory_order_relaxed), "Compile list index is out of range");
 
     CompileListRecord& compile_list = m_compile_list_records[compile_list_idx];
-    const std::optional<Frustum>& frustum = compile_list.frustum;
-    const FrustumMask& frustum_mask = compile_list.frustum_mask;
-
-    const std::span<const SceneDrawableInfo> drawables = m_scene_system.get_drawables();
-
-    uint32_t num_draw_elements = 0;
-    const uint32_t draw_elements_offset = compile_list_idx * DRAW_ELEMENTS_STRIDE;
+    const CompileListCache& cache = m_compile_list_caches[compile_list.cache_idx];
 
     // TODO: Hardcoding the shaders here until we have material instances as assets
     PbrOpaqueMaterialShaderVS vertex_shader{};
     PbrOpaqueMaterialShaderFS fragment_shader{};
 
-    for (const SceneDrawableInfo& drawable : drawables)
+    DrawItem draw_item{
+        .vertex_instance = vertex_shader.get_instance(),
+        .fragment_instance = fragment_shader.get_instance(),
+    };
+    draw_item.pipeline_hash = create_pipeline_hash(draw_item.vertex_instance, draw_item.fragment_instance);
+
+    const std::span<const uint32_t> dirty_renderables = m_scene.get_dirty_renderables();
+
+    // Patching walks the previous result and culls the dirty drawables in batches with cull_frustums, past a point
+    // culling everything with the hierarchy is cheaper
+    if (compile_list.rebuild_reason == DrawListRebuildReason::None
+        && dirty_renderables.size() * 4 > m_scene.get_drawables().size())
     {
-        if (!drawable.gpu_mesh_record.allocation.handle.is_valid())
-        {
-            MIZU_LOG_ERROR("Drawable with invalid Gpu mesh allocation handle, skipping.");
-            continue;
-        }
+        compile_list.rebuild_reason = DrawListRebuildReason::TooManyDirtyDrawables;
+    }
 
-        if (drawable.material_buffer_offset == std::numeric_limits<uint32_t>::max())
-        {
-            MIZU_LOG_ERROR("Drawable with invalid Material buffer offset, skipping.");
-            continue;
-        }
+    uint32_t num_dirty_drawables = 0;
 
-        if (frustum.has_value())
-        {
-            const AABB& local_aabb = drawable.gpu_mesh_record.payload.bounding_box;
+    if (compile_list.rebuild_reason != DrawListRebuildReason::None)
+    {
+        rebuild_compile_list(compile_list_idx, draw_item.pipeline_hash);
+        gather_compile_list(compile_list_idx, draw_item);
+    }
+    else if (!dirty_renderables.empty())
+    {
+        update_compile_list(compile_list_idx, draw_item.pipeline_hash, dirty_renderables);
+        gather_compile_list(compile_list_idx, draw_item);
 
-            const TransformDynamicState& ts =
-                g_transform_state_manager->rend_get_dynamic_state(drawable.transform_handle);
+        num_dirty_drawables = static_cast<uint32_t>(dirty_renderables.size());
+    }
 
-            glm::mat4 world_transform{1.0f};
-            world_transform = glm::translate(world_transform, ts.translation);
-            world_transform = glm::rotate(world_transform, ts.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-            world_transform = glm::rotate(world_transform, ts.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-            world_transform = glm::rotate(world_transform, ts.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
-            world_transform = glm::scale(world_transform, ts.scale);
+    // Without changes, the draw elements and draw data of the previous frame are still in place
 
-            const AABB world_aabb = transform_aabb(local_aabb, world_transform);
+    compile_list.is_compiled = true;
+    compile_list.num_draw_elements = cache.num_draw_elements;
+    compile_list.num_draw_data = static_cast<uint32_t>(cache.renderable_ids.size());
+
+    m_compile_stats[compile_list_idx] = DrawListCompileStats{
+        .rebuild_reason = compile_list.rebuild_reason,
+        .num_dirty_drawables = num_dirty_drawables,
+        .num_visible_drawables = compile_list.num_draw_data,
+        .num_draw_elements = compile_list.num_draw_elements,
+    };
 
-            if (!frustum->is_inside_frustum(world_aabb, frustum_mask))
-                continue;
-        }
+    MIZU_PROFILE_ZONE_TEXT(
+        meta::enum_name(compile_list.rebuild_reason).data(), meta::enum_name(compile_list.rebuild_reason).size());
+}
 
-        const size_t pipeline_hash = create_pipeline_hash(vertex_shader.get_instance(), fragment_shader.get_instance());
-        const size_t sort_key = create_sort_key(pipeline_hash, drawable.mesh_handle, drawable.material_handle);
+void DrawListSystem::rebuild_compile_list(uint32_t compile_list_idx, size_t pipeline_hash)
+{
+    MIZU_PROFILE_SCOPED;
 
-#if MIZU_DEBUG
-        const AssetRegistry& asset_registry = g_game_context->get_asset_registry();
+    const CompileListRecord& compile_list = m_compile_list_records[compile_list_idx];
+    CompileListCache& cache = m_compile_list_caches[compile_list.cache_idx];
 
-        std::string_view debug_name = asset_registry.get_virtual_path(drawable.mesh_handle);
-        if (debug_name.empty())
-            debug_name = "Mesh";
-#endif
+    const std::optional<Frustum>& frustum = compile_list.frustum;
+    const std::span<const SceneDrawableInfo> drawables = m_scene.get_drawables();
 
-        m_draw_elements[draw_elements_offset + num_draw_elements] = DrawElement{
-            .mesh_draw = drawable.gpu_mesh_draw,
-            .vertex_instance = vertex_shader.get_instance(),
-            .fragment_instance = fragment_shader.get_instance(),
-            .instance_count = 1,
-            .material_buffer_offset = drawable.material_buffer_offset,
-            .transform_buffer_offset = drawable.transform_slot_index,
-            .draw_index = 0,
-            .sort_key = sort_key,
-            .pipeline_hash = pipeline_hash,
-#if MIZU_DEBUG
-            .debug_name = debug_name,
-#endif
-        };
+    std::vector<uint32_t>& visible_drawables = cache.visible_drawables;
+    visible_drawables.clear();
 
-        num_draw_elements += 1;
+    if (frustum.has_value())
+    {
+        // Whole groups of drawables are culled at once, so the cost scales with the visible drawables
+        m_scene.get_drawable_bvh().query(
+            *frustum, compile_list.frustum_mask, visible_drawables, cache.bvh_query_scratch);
     }
+    else
+    {
+        visible_drawables.resize(drawables.size());
+        std::iota(visible_drawables.begin(), visible_drawables.end(), 0u);
+    }
+
+    cache.sort_keys.clear();
+    cache.renderable_ids.clear();
 
-    if (num_draw_elements == 0)
+    for (const uint32_t drawable_idx : visible_drawables)
     {
-        compile_list = CompileListRecord{
-            .is_compiled = true,
-            .frustum = frustum,
-            .frustum_mask = frustum_mask,
-            .num_draw_elements = 0,
-            .num_draw_data = 0,
-            .draw_elements_offset = draw_elements_offset,
-        };
+        const SceneDrawableInfo& drawable = drawables[drawable_idx];
+        if (!is_valid_drawable(drawable))
+            continue;
 
-        return;
+        cache.sort_keys.push_back(
+            create_drawable_sort_key(m_scene, drawable_idx, frustum, compile_list.sort_mode, pipeline_hash));
+        cache.renderable_ids.push_back(static_cast<uint32_t>(drawable.static_mesh_handle.get_internal_id()));
     }
 
-    auto begin = m_draw_elements.begin() + draw_elements_offset;
-    auto end = begin + num_draw_elements;
+    // Only the keys and renderable ids are sorted, draw elements are built once in the final order
+    cache.tmp_sort_keys.resize(cache.sort_keys.size());
+    cache.tmp_renderable_ids.resize(cache.renderable_ids.size());
 
-    std::sort(begin, end, [](const DrawElement& a, const DrawElement& b) {
-        if (a.pipeline_hash != b.pipeline_hash)
-            return a.pipeline_hash < b.pipeline_hash;
+    radix_sort(cache.sort_keys, cache.renderable_ids, cache.tmp_sort_keys, cache.tmp_renderable_ids);
 
-        if (a.material_buffer_offset != b.material_buffer_offset)
-            return a.material_buffer_offset < b.material_buffer_offset;
+    cache.is_valid = true;
+}
 
-        return a.sort_key < b.sort_key;
-    });
+void DrawListSystem::update_compile_list(
+    uint32_t compile_list_idx,
+    size_t pipeline_hash,
+    std::span<const uint32_t> dirty_renderables)
+{
+    MIZU_PROFILE_SCOPED;
 
-    size_t current_sort_key = begin[0].sort_key;
-    uint32_t current_instance_offset = 0;
-    uint32_t move_backwards_offset = 0;
+    const CompileListRecord& compile_list = m_compile_list_records[compile_list_idx];
+    CompileListCache& cache = m_compile_list_caches[compile_list.cache_idx];
 
-    DrawElement& first = begin[0];
+    MIZU_ASSERT(cache.is_valid, "Can't update a compile list cache that has not been built");
 
-    m_draw_data[draw_elements_offset] = GpuDrawData{
-        .transform_slot = first.transform_buffer_offset,
-        .material_offset = first.material_buffer_offset,
-    };
-    first.draw_index = 0;
+    const std::optional<Frustum>& frustum = compile_list.frustum;
+    const std::span<const SceneDrawableInfo> drawables = m_scene.get_drawables();
 
-    const uint32_t num_draw_data = num_draw_elements;
+    // Remove the previous entries of the dirty renderables, the rest stay sorted
+    size_t num_kept = 0;
+    for (size_t i = 0; i < cache.renderable_ids.size(); ++i)
+    {
+        if (m_scene.is_renderable_dirty(cache.renderable_ids[i]))
+            continue;
 
-    for (uint32_t i = 1; i < num_draw_data; ++i)
+        cache.sort_keys[num_kept] = cache.sort_keys[i];
+        cache.renderable_ids[num_kept] = cache.renderable_ids[i];
+        num_kept += 1;
+    }
+
+    // Cull and sort the dirty renderables that are still drawable
+    std::vector<uint32_t>& dirty_drawables = cache.dirty_drawables;
+    dirty_drawables.clear();
+
+    for (const uint32_t renderable_id : dirty_renderables)
     {
-        DrawElement& element = begin[i];
+        const uint32_t drawable_idx = m_scene.get_drawable_index(renderable_id);
+        if (drawable_idx == IDrawListScene::INVALID_DRAWABLE_INDEX)
+            continue;
 
-        // Elements merged into the same run share a material, `sort_key` includes the material handle, so writing the
-        // element's own offset for every entry of the run is correct.
-        m_draw_data[draw_elements_offset + i] = GpuDrawData{
-            .transform_slot = element.transform_buffer_offset,
-            .material_offset = element.material_buffer_offset,
-        };
+        if (!is_valid_drawable(drawables[drawable_idx]))
+            continue;
 
-        if (element.sort_key == current_sort_key)
-        {
-            begin[current_instance_offset].instance_count += 1;
-            move_backwards_offset += 1;
+        dirty_drawables.push_back(drawable_idx);
+    }
+
+    // The dirty drawables are culled together, so the kernel can test several boxes at once
+    if (frustum.has_value())
+    {
+        cache.dirty_bounds.clear();
+        for (const uint32_t drawable_idx : dirty_drawables)
+            cache.dirty_bounds.push_back(m_scene.get_drawable_world_bounds(drawable_idx));
+
+        cache.dirty_visibility_mask.resize(get_visibility_mask_word_count(dirty_drawables.size()));
+
+        cull_frustums(
+            std::span(&*frustum, 1),
+            std::span(&compile_list.frustum_mask, 1),
+            cache.dirty_bounds,
+            cache.dirty_visibility_mask);
+    }
+
+    std::vector<uint64_t>& dirty_sort_keys = cache.dirty_sort_keys;
+    std::vector<uint32_t>& dirty_renderable_ids = cache.dirty_renderable_ids;
+
+    dirty_sort_keys.clear();
+    dirty_renderable_ids.clear();
+
+    for (size_t i = 0; i < dirty_drawables.size(); ++i)
+    {
+        if (frustum.has_value() && !is_visible(cache.dirty_visibility_mask, i))
+            continue;
+
+        const uint32_t drawable_idx = dirty_drawables[i];
+        const uint32_t renderable_id =
+            static_cast<uint32_t>(drawables[drawable_idx].static_mesh_handle.get_internal_id());
+
+        dirty_sort_keys.push_back(
+            create_drawable_sort_key(m_scene, drawable_idx, frustum, compile_list.sort_mode, pipeline_hash));
+        dirty_renderable_ids.push_back(renderable_id);
+    }
+
+    const size_t num_dirty = dirty_sort_keys.size();
+    const size_t num_merged = num_kept + num_dirty;
+
+    cache.tmp_sort_keys.resize(std::max(num_merged, cache.tmp_sort_keys.size()));
+    cache.tmp_renderable_ids.resize(std::max(num_merged, cache.tmp_renderable_ids.size()));
+
+    radix_sort(dirty_sort_keys, dirty_renderable_ids, cache.tmp_sort_keys, cache.tmp_renderable_ids);
 
-            num_draw_elements -= 1;
+    // Merge the kept and dirty entries, kept entries go first on equal keys
+    size_t kept_idx = 0;
+    size_t dirty_idx = 0;
+
+    for (size_t i = 0; i < num_merged; ++i)
+    {
+        const bool take_dirty = dirty_idx < num_dirty
+                                && (kept_idx == num_kept || dirty_sort_keys[dirty_idx] < cache.sort_keys[kept_idx]);
+
+        if (take_dirty)
+        {
+            cache.tmp_sort_keys[i] = dirty_sort_keys[dirty_idx];
+            cache.tmp_renderable_ids[i] = dirty_renderable_ids[dirty_idx];
+            dirty_idx += 1;
         }
         else
         {
-            current_sort_key = element.sort_key;
-            current_instance_offset = i - move_backwards_offset;
+            cache.tmp_sort_keys[i] = cache.sort_keys[kept_idx];
+            cache.tmp_renderable_ids[i] = cache.renderable_ids[kept_idx];
+            kept_idx += 1;
+        }
+    }
+
+    cache.tmp_sort_keys.resize(num_merged);
+    cache.tmp_renderable_ids.resize(num_merged);
+
+    std::swap(cache.sort_keys, cache.tmp_sort_keys);
+    std::swap(cache.renderable_ids, cache.tmp_renderable_ids);
+}
+
+void DrawListSystem::gather_compile_list(uint32_t compile_list_idx, const DrawItem& draw_item)
+{
+    MIZU_PROFILE_SCOPED;
+
+    const CompileListRecord& compile_list = m_compile_list_records[compile_list_idx];
+    CompileListCache& cache = m_compile_list_caches[compile_list.cache_idx];
+
+    const std::span<const SceneDrawableInfo> drawables = m_scene.get_drawables();
+
+    const uint32_t num_draw_data = static_cast<uint32_t>(cache.renderable_ids.size());
+
+    // Only grows, shrinking would destroy elements that the next frames can reuse
+    if (cache.draw_elements.size() < num_draw_data)
+    {
+        cache.draw_elements.resize(num_draw_data);
+        cache.draw_data.resize(num_draw_data);
+    }
+
+    // Consecutive drawables with the same instancing key are merged into one draw element
+    const auto begin = cache.draw_elements.begin();
+
+    uint32_t num_draw_elements = 0;
+    size_t current_instancing_key = 0;
+
+    for (uint32_t i = 0; i < num_draw_data; ++i)
+    {
+        const uint32_t drawable_idx = m_scene.get_drawable_index(cache.renderable_ids[i]);
+        MIZU_ASSERT(
+            drawable_idx != IDrawListScene::INVALID_DRAWABLE_INDEX,
+            "Compile list references renderable {} which is not drawable",
+            cache.renderable_ids[i]);
+
+        const SceneDrawableInfo& drawable = drawables[drawable_idx];
+
+        // Elements merged into the same run share a material, `instancing_key` includes the material handle, so
+        // writing the drawable's own offset for every entry of the run is correct.
+        cache.draw_data[i] = GpuDrawData{
+            .transform_slot = drawable.transform_slot_index,
+            .material_offset = drawable.material_buffer_offset,
+        };
+
+        const size_t instancing_key =
+            create_instancing_key(draw_item.pipeline_hash, drawable.mesh_handle, drawable.material_handle);
 
-            begin[i - move_backwards_offset] = element;
-            begin[i - move_backwards_offset].draw_index = i;
+        if (num_draw_elements > 0 && instancing_key == current_instancing_key)
+        {
+            begin[num_draw_elements - 1].instance_count += 1;
+            continue;
         }
+
+#if MIZU_DEBUG
+        std::string_view debug_name{};
+        if (g_game_context != nullptr)
+            debug_name = g_game_context->get_asset_registry().get_virtual_path(drawable.mesh_handle);
+        if (debug_name.empty())
+            debug_name = "Mesh";
+#endif
+
+        begin[num_draw_elements] = DrawElement{
+            .mesh_draw = drawable.gpu_mesh_draw,
+            .vertex_instance = draw_item.vertex_instance,
+            .fragment_instance = draw_item.fragment_instance,
+            .instance_count = 1,
+            .material_buffer_offset = drawable.material_buffer_offset,
+            .transform_buffer_offset = drawable.transform_slot_index,
+            .draw_index = i,
+            .instancing_key = instancing_key,
+            .pipeline_hash = draw_item.pipeline_hash,
+#if MIZU_DEBUG
+            .debug_name = debug_name,
+#endif
+        };
+
+        current_instancing_key = instancing_key;
+        num_draw_elements += 1;
     }
 
-    compile_list.is_compiled = true;
-    compile_list.num_draw_elements = num_draw_elements;
-    compile_list.num_draw_data = num_draw_data;
-    compile_list.draw_elements_offset = draw_elements_offset;
+    cache.num_draw_elements = num_draw_elements;
 }
 
 void DrawListSystem::dispatch_draw_list_cpu(
@@ -801,13 +1131,10 @@ void DrawListSystem::dispatch_draw_list_cpu(
         return;
     }
 
-    const BufferResource& vertex_buffer = *m_gpu_mesh_pool.get_vertex_buffer();
-    const BufferResource& index_buffer = *m_gpu_mesh_pool.get_index_buffer();
+    command.bind_vertex_buffer(*m_vertex_buffer);
+    command.bind_index_buffer(*m_index_buffer);
 
-    command.bind_vertex_buffer(vertex_buffer);
-    command.bind_index_buffer(index_buffer);
-
-    const auto draw_elements_begin = m_draw_elements.begin() + compile_list.draw_elements_offset;
+    const auto draw_elements_begin = m_compile_list_caches[compile_list.cache_idx].draw_elements.begin();
 
     bool pipeline_bound = false;
     size_t last_pipeline_hash = 0;
@@ -891,11 +1218,8 @@ void DrawListSystem::dispatch_draw_list_gpu(
     if (!compile_list.is_compiled)
         return;
 
-    const BufferResource& vertex_buffer = *m_gpu_mesh_pool.get_vertex_buffer();
-    const BufferResource& index_buffer = *m_gpu_mesh_pool.get_index_buffer();
-
-    command.bind_vertex_buffer(vertex_buffer);
-    command.bind_index_buffer(index_buffer);
+    command.bind_vertex_buffer(*m_vertex_buffer);
+    command.bind_index_buffer(*m_index_buffer);
 
     // TODO: For the moment supposing a single pipeline, like we do in `compile_draw_list_job`.
     PbrOpaqueMaterialShaderVS vertex_shader{};
@@ -978,7 +1302,7 @@ void DrawListSystem::bind_resources(CommandBuffer& command, DrawListHandle handl
     // clang-format on
 
     const std::array writes = {
-        WriteDescriptor::StructuredBufferSrv(0, BufferResourceView::create(m_scene_system.get_transform_info_buffer())),
+        WriteDescriptor::StructuredBufferSrv(0, BufferResourceView::create(m_scene.get_transform_info_buffer())),
         WriteDescriptor::StructuredBufferSrv(1, draw_data_view),
     };
 
@@ -1007,10 +1331,11 @@ void DrawListSystem::bind_draw_index_push_constant(CommandBuffer& command, uint3
 
 static DrawListSystem* s_draw_list_system = nullptr;
 
-void draw_list_system_init(SceneSystem& scene_system, GpuMeshPool& gpu_mesh_pool)
+void draw_list_system_init(IDrawListScene& scene, const GpuMeshPool& gpu_mesh_pool)
 {
     MIZU_ASSERT(s_draw_list_system == nullptr, "DrawListSystem has already been initialized");
-    s_draw_list_system = new DrawListSystem{scene_system, gpu_mesh_pool};
+    s_draw_list_system =
+        new DrawListSystem{scene, gpu_mesh_pool.get_vertex_buffer(), gpu_mesh_pool.get_index_buffer()};
 }
 
 void draw_list_system_shutdown()
@@ -1045,6 +1370,12 @@ void draw_list_system_reset()
     return s_draw_list_system->reset();
 }
 
+std::span<const DrawListCompileStats> draw_list_system_get_compile_stats()
+{
+    MIZU_ASSERT(s_draw_list_system != nullptr, "DrawListSystem has not been initialized");
+    return s_draw_list_system->get_compile_stats();
+}
+
 DrawListHandle create_draw_list(const DrawListRequest& request)
 {
     MIZU_ASSERT(s_draw_list_system != nullptr, "DrawListSystem has not been initialized");
@@ -24,17 +24,18 @@ SceneSystem::SceneSystem(MeshResidencySystem& mesh_residency_system, MaterialRes
 {
     g_transform_state_manager->register_rend_consumer(this);
 
-    constexpr uint32_t TRANSFORM_INFO_BUFFER_NUM = TransformConfig::MaxNumHandles * 2;
+    // Destroyed transform slots are kept alive for a few frames, so leave room for one full set of transforms waiting
+    // to be evicted
+    const uint32_t num_transform_infos = static_cast<uint32_t>(g_transform_state_manager->get_max_num_handles() * 2);
 
-    m_transform_infos.resize(TRANSFORM_INFO_BUFFER_NUM);
+    m_transform_infos.resize(num_transform_infos);
+    m_transform_drawable_indices.resize(num_transform_infos, INVALID_SLOT);
 
-    for (uint32_t i = 0; i < TRANSFORM_INFO_BUFFER_NUM; ++i)
-        m_free_transform_slots.push(TRANSFORM_INFO_BUFFER_NUM - i - 1);
-
-    std::fill(m_transform_slot_indices.begin(), m_transform_slot_indices.end(), INVALID_SLOT_U32);
+    for (uint32_t i = 0; i < num_transform_infos; ++i)
+        m_free_transform_slots.push(num_transform_infos - i - 1);
 
     BufferDescription transform_info_buffer_desc{};
-    transform_info_buffer_desc.size = sizeof(TransformInfo) * TRANSFORM_INFO_BUFFER_NUM;
+    transform_info_buffer_desc.size = sizeof(TransformInfo) * num_transform_infos;
     transform_info_buffer_desc.stride = sizeof(TransformInfo);
     transform_info_buffer_desc.usage = BufferUsageBits::ShaderResource | BufferUsageBits::UnorderedAccess;
     transform_info_buffer_desc.name = "SceneSystem::TransformInfoBuffer";
@@ -216,6 +217,9 @@ void SceneSystem::handle_renderable_create_event(const RenderableEvent& event)
 {
     const uint64_t handle_id = event.static_mesh_handle.get_internal_id();
 
+    if (handle_id >= m_slots.size())
+        m_slots.resize(handle_id + 1);
+
     RenderableSlot& slot = m_slots[handle_id];
     MIZU_ASSERT(!slot.occupied, "Trying to create a renderable on an already occupied slot");
 
@@ -233,10 +237,14 @@ void SceneSystem::handle_renderable_create_event(const RenderableEvent& event)
         .material_resident = is_material_resident(event.material_handle),
     };
 
+    const uint32_t transform_slot = slot.drawable_info.transform_slot_index;
+
     const TransformDynamicState& ds = g_transform_state_manager->rend_get_dynamic_state(event.transform_handle);
+    m_transform_infos[transform_slot] = build_transform_info(ds);
+
     m_pending_transform_updates.push_back({
-        .new_transform = build_transform_info(ds),
-        .dst_slot = slot.drawable_info.transform_slot_index,
+        .new_transform = m_transform_infos[transform_slot],
+        .dst_slot = transform_slot,
     });
 
     if (!slot.mesh_resident)
@@ -412,6 +420,23 @@ bool SceneSystem::is_material_resident(const MaterialAssetHandle& handle) const
 size_t SceneSystem::allocate_drawable_slot(SceneDrawableInfo info)
 {
     const size_t index = m_drawable_slots.size();
+
+    const uint32_t transform_slot = info.transform_slot_index;
+    MIZU_ASSERT(transform_slot < m_transform_infos.size(), "Drawable with invalid transform slot {}", transform_slot);
+
+    m_transform_drawable_indices[transform_slot] = index;
+
+    const uint32_t renderable_id = static_cast<uint32_t>(info.static_mesh_handle.get_internal_id());
+    if (renderable_id >= m_renderable_drawable_indices.size())
+        m_renderable_drawable_indices.resize(renderable_id + 1, INVALID_DRAWABLE_INDEX);
+
+    m_renderable_drawable_indices[renderable_id] = static_cast<uint32_t>(index);
+    mark_renderable_dirty(renderable_id);
+
+    const AABB world_bounds =
+        transform_aabb(info.gpu_mesh_record.payload.bounding_box, m_transform_infos[transform_slot].transform);
+    m_drawable_bvh_leaves.push_back(m_drawable_bvh.insert(world_bounds, static_cast<uint32_t>(index)));
+
     m_drawable_slots.push_back(std::move(info));
 
     return index;
@@ -421,23 +446,71 @@ void SceneSystem::free_drawable_slot(size_t index)
 {
     MIZU_ASSERT(index < m_drawable_slots.size(), "Drawable index {} is out of range", index);
 
+    m_transform_drawable_indices[m_drawable_slots[index].transform_slot_index] = INVALID_SLOT;
+    m_drawable_bvh.remove(m_drawable_bvh_leaves[index]);
+
+    const uint32_t renderable_id = static_cast<uint32_t>(m_drawable_slots[index].static_mesh_handle.get_internal_id());
+    m_renderable_drawable_indices[renderable_id] = INVALID_DRAWABLE_INDEX;
+    mark_renderable_dirty(renderable_id);
+
     const size_t last_index = m_drawable_slots.size() - 1;
     if (index != last_index)
     {
         const SceneDrawableInfo moved = m_drawable_slots[last_index];
         m_drawable_slots[index] = moved;
+        m_transform_drawable_indices[moved.transform_slot_index] = index;
+
+        m_drawable_bvh_leaves[index] = m_drawable_bvh_leaves[last_index];
+        m_drawable_bvh.set_user_data(m_drawable_bvh_leaves[index], static_cast<uint32_t>(index));
 
         const uint64_t moved_handle_id = moved.static_mesh_handle.get_internal_id();
         MIZU_ASSERT(moved_handle_id < m_slots.size(), "Moved drawable handle id {} out of range", moved_handle_id);
 
+        // Only the index changes, the renderable id used by the draw lists is the same
+        m_renderable_drawable_indices[moved_handle_id] = static_cast<uint32_t>(index);
+
         RenderableSlot& moved_slot = m_slots[moved_handle_id];
         MIZU_ASSERT(moved_slot.occupied, "Moved drawable slot must be occupied");
         moved_slot.drawable_slot_index = index;
     }
 
-    const auto diff_last = static_cast<std::ptrdiff_t>(last_index);
-    m_drawable_slots.erase(
-        std::next(m_drawable_slots.begin(), diff_last), std::next(m_drawable_slots.begin(), diff_last + 1));
+    m_drawable_slots.pop_back();
+    m_drawable_bvh_leaves.pop_back();
+}
+
+void SceneSystem::mark_renderable_dirty(uint32_t renderable_id)
+{
+    if (renderable_id >= m_renderable_dirty_flags.size())
+        m_renderable_dirty_flags.resize(renderable_id + 1, false);
+
+    if (m_renderable_dirty_flags[renderable_id])
+        return;
+
+    m_renderable_dirty_flags[renderable_id] = true;
+    m_dirty_renderables.push_back(renderable_id);
+}
+
+uint32_t SceneSystem::get_drawable_index(uint32_t renderable_id) const
+{
+    if (renderable_id >= m_renderable_drawable_indices.size())
+        return INVALID_DRAWABLE_INDEX;
+
+    return m_renderable_drawable_indices[renderable_id];
+}
+
+bool SceneSystem::is_renderable_dirty(uint32_t renderable_id) const
+{
+    return renderable_id < m_renderable_dirty_flags.size() && m_renderable_dirty_flags[renderable_id];
+}
+
+void SceneSystem::clear_dirty_renderables()
+{
+    for (const uint32_t renderable_id : m_dirty_renderables)
+    {
+        m_renderable_dirty_flags[renderable_id] = false;
+    }
+
+    m_dirty_renderables.clear();
 }
 
 uint32_t SceneSystem::allocate_transform_slot(const TransformHandle& handle)
@@ -451,7 +524,11 @@ uint32_t SceneSystem::allocate_transform_slot(const TransformHandle& handle)
     const uint32_t slot = m_free_transform_slots.top();
     m_free_transform_slots.pop();
 
-    m_transform_slot_indices[handle.get_internal_id()] = slot;
+    const uint64_t handle_id = handle.get_internal_id();
+    if (handle_id >= m_transform_slot_indices.size())
+        m_transform_slot_indices.resize(handle_id + 1, INVALID_SLOT_U32);
+
+    m_transform_slot_indices[handle_id] = slot;
 
     return slot;
 }
@@ -463,19 +540,48 @@ void SceneSystem::free_transform_slot(uint32_t slot)
 
 void SceneSystem::rend_on_update(TransformHandle handle, const TransformDynamicState& ds)
 {
-    const uint32_t slot = m_transform_slot_indices[handle.get_internal_id()];
+    rend_on_update_batch(std::span(&handle, 1), std::span(&ds, 1));
+}
 
-    // If it's not a registered transform (has valid slot index) ignore
-    if (slot == INVALID_SLOT_U32)
-        return;
+void SceneSystem::rend_on_update_batch(
+    std::span<const TransformHandle> handles,
+    std::span<const TransformDynamicState> dss)
+{
+    MIZU_PROFILE_SCOPED;
+
+    for (size_t i = 0; i < handles.size(); ++i)
+    {
+        const uint64_t handle_id = handles[i].get_internal_id();
 
-    // TODO: Should probably check if the transform ds has changed, though the state manager works with the assumption
-    // that we only send updates through it if a dynamic state has changed.
+        // If it's not a registered transform (has valid slot index) ignore
+        if (handle_id >= m_transform_slot_indices.size() || m_transform_slot_indices[handle_id] == INVALID_SLOT_U32)
+            continue;
 
-    m_pending_transform_updates.push_back({
-        .new_transform = build_transform_info(ds),
-        .dst_slot = slot,
-    });
+        // TODO: Should probably check if the transform ds has changed, though the state manager works with the
+        // assumption that we only send updates through it if a dynamic state has changed.
+
+        const uint32_t transform_slot = m_transform_slot_indices[handle_id];
+        m_transform_infos[transform_slot] = build_transform_info(dss[i]);
+
+        // Keep the world bounds of the drawable in sync, so culling doesn't need to rebuild the transform every view
+        const size_t drawable_idx = m_transform_drawable_indices[transform_slot];
+        if (drawable_idx != INVALID_SLOT)
+        {
+            const SceneDrawableInfo& drawable = m_drawable_slots[drawable_idx];
+
+            const AABB& local_bounds = drawable.gpu_mesh_record.payload.bounding_box;
+            m_drawable_bvh.update(
+                m_drawable_bvh_leaves[drawable_idx],
+                transform_aabb(local_bounds, m_transform_infos[transform_slot].transform));
+
+            mark_renderable_dirty(static_cast<uint32_t>(drawable.static_mesh_handle.get_internal_id()));
+        }
+
+        m_pending_transform_updates.push_back({
+            .new_transform = m_transform_infos[transform_slot],
+            .dst_slot = transform_slot,
+        });
+    }
 }
 
 TransformInfo SceneSystem::build_transform_info(const TransformDynamicState& ds)
@@ -10,10 +10,12 @@
 #include <vector>
 
 #include "asset/asset_handle.h"
-#include "base/containers/inplace_vector.h"
+#include "base/math/aabb.h"
 
+#include "render/core/bounding_volume_hierarchy.h"
 #include "render/render_graph/render_graph_builder.h"
 #include "render/resources/gpu_resource_types.h"
+#include "render/scene/draw_list_scene.h"
 #include "render/state_manager/static_mesh_state_manager.h"
 #include "render/state_manager/transform_state_manager.h"
 #include "render/systems/frame_linear_allocator.h"
@@ -29,21 +31,7 @@ class ImageResource;
 class MaterialResidencySystem;
 class MeshResidencySystem;
 
-struct SceneDrawableInfo
-{
-    StaticMeshHandle static_mesh_handle{};
-    TransformHandle transform_handle{};
-
-    MeshAssetHandle mesh_handle{};
-    MaterialAssetHandle material_handle{};
-
-    GpuMeshResidentRecord gpu_mesh_record{};
-    GpuMeshDrawPayload gpu_mesh_draw{};
-    uint32_t material_buffer_offset = std::numeric_limits<uint32_t>::max();
-    uint32_t transform_slot_index = std::numeric_limits<uint32_t>::max();
-};
-
-class SceneSystem : public TransformStateManagerConsumer
+class SceneSystem : public TransformStateManagerConsumer, public IDrawListScene
 {
   public:
     SceneSystem(MeshResidencySystem& mesh_residency_system, MaterialResidencySystem& material_residency_system);
@@ -52,8 +40,19 @@ class SceneSystem : public TransformStateManagerConsumer
     void update(const ResourceEventStream& stream, uint64_t frame_num);
     void add_transform_publish_pass(RenderGraphBuilder& builder, FrameLinearAllocator& linear_allocator);
 
-    std::span<const SceneDrawableInfo> get_drawables() const { return m_drawable_slots; }
-    std::shared_ptr<BufferResource> get_transform_info_buffer() const { return m_transform_info_buffer; }
+    std::span<const SceneDrawableInfo> get_drawables() const override { return m_drawable_slots; }
+    const BoundingVolumeHierarchy& get_drawable_bvh() const override { return m_drawable_bvh; }
+    AABB get_drawable_world_bounds(size_t drawable_idx) const override
+    {
+        return m_drawable_bvh.get_bounds(m_drawable_bvh_leaves[drawable_idx]);
+    }
+    std::shared_ptr<BufferResource> get_transform_info_buffer() const override { return m_transform_info_buffer; }
+
+    uint32_t get_drawable_index(uint32_t renderable_id) const override;
+
+    std::span<const uint32_t> get_dirty_renderables() const override { return m_dirty_renderables; }
+    bool is_renderable_dirty(uint32_t renderable_id) const override;
+    void clear_dirty_renderables() override;
 
   private:
     static constexpr size_t INVALID_SLOT = std::numeric_limits<size_t>::max();
@@ -83,11 +82,25 @@ class SceneSystem : public TransformStateManagerConsumer
         size_t drawable_slot_index = INVALID_SLOT;
     };
 
-    std::array<RenderableSlot, StaticMeshConfig::MaxNumHandles> m_slots{};
-    inplace_vector<SceneDrawableInfo, StaticMeshConfig::MaxNumHandles> m_drawable_slots{};
+    // Indexed by static mesh handle id, grows as handles are created
+    std::vector<RenderableSlot> m_slots{};
+    std::vector<SceneDrawableInfo> m_drawable_slots{};
+    BoundingVolumeHierarchy m_drawable_bvh{};
+    // Leaf of each drawable in `m_drawable_bvh`, same indexing as `m_drawable_slots`
+    std::vector<uint32_t> m_drawable_bvh_leaves{};
+    // Indexed by renderable id, drawable slot of the renderable or INVALID_DRAWABLE_INDEX
+    std::vector<uint32_t> m_renderable_drawable_indices{};
+
+    std::vector<uint32_t> m_dirty_renderables{};
+    // Indexed by renderable id, avoids duplicates in `m_dirty_renderables`
+    std::vector<bool> m_renderable_dirty_flags{};
 
+    // Cpu copy of the world transforms, indexed by transform slot
     std::vector<TransformInfo> m_transform_infos{};
-    std::array<uint32_t, TransformConfig::MaxNumHandles> m_transform_slot_indices{};
+    // Indexed by transform slot, drawable slot using the transform or INVALID_SLOT if it's not drawable
+    std::vector<size_t> m_transform_drawable_indices{};
+    // Indexed by transform handle id, grows as transform slots are allocated
+    std::vector<uint32_t> m_transform_slot_indices{};
     std::stack<uint32_t> m_free_transform_slots{};
 
     struct PendingTransformUpdate
@@ -133,12 +146,16 @@ class SceneSystem : public TransformStateManagerConsumer
 
     size_t allocate_drawable_slot(SceneDrawableInfo info);
     void free_drawable_slot(size_t index);
+    void mark_renderable_dirty(uint32_t renderable_id);
 
     uint32_t allocate_transform_slot(const TransformHandle& handle);
     void free_transform_slot(uint32_t slot);
 
     void rend_on_create(TransformHandle, const TransformStaticState&, const TransformDynamicState&) override {}
     void rend_on_update(TransformHandle handle, const TransformDynamicState& ds) override;
+    void rend_on_update_batch(
+        std::span<const TransformHandle> handles,
+        std::span<const TransformDynamicState> dss) override;
     void rend_on_destroy(TransformHandle) override {}
 
     TransformInfo build_transform_info(const TransformDynamicState& ds);
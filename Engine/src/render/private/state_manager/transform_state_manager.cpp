@@ -1,10 +1,52 @@
 #include "render/state_manager/transform_state_manager.h"
 
+#include <immintrin.h>
+
+#include "base/debug/assert.h"
 #include "state_manager/base_state_manager.inl.cpp"
 
 namespace Mizu
 {
 
+// Every member is interpolated the same way, so a batch of transforms is processed as a flat stream of floats
+static_assert(sizeof(TransformDynamicState) == 9 * sizeof(float), "TransformDynamicState must only contain floats");
+
+void TransformDynamicState::interpolate_batch(
+    std::span<const TransformDynamicState> from,
+    std::span<const TransformDynamicState> to,
+    double alpha,
+    std::span<TransformDynamicState> out)
+{
+    MIZU_ASSERT(from.size() == to.size() && from.size() == out.size(), "Batch spans must have the same size");
+
+    const float* from_values = reinterpret_cast<const float*>(from.data());
+    const float* to_values = reinterpret_cast<const float*>(to.data());
+    float* out_values = reinterpret_cast<float*>(out.data());
+
+    const size_t num_values = out.size() * 9;
+
+    // Same formula as glm::mix so the result matches TransformDynamicState::interpolate
+    const float falpha = static_cast<float>(alpha);
+    const float fbeta = 1.0f - falpha;
+
+    const __m128 alpha4 = _mm_set1_ps(falpha);
+    const __m128 beta4 = _mm_set1_ps(fbeta);
+
+    size_t i = 0;
+    for (; i + 4 <= num_values; i += 4)
+    {
+        const __m128 from4 = _mm_loadu_ps(from_values + i);
+        const __m128 to4 = _mm_loadu_ps(to_values + i);
+
+        _mm_storeu_ps(out_values + i, _mm_add_ps(_mm_mul_ps(from4, beta4), _mm_mul_ps(to4, alpha4)));
+    }
+
+    for (; i < num_values; ++i)
+    {
+        out_values[i] = from_values[i] * fbeta + to_values[i] * falpha;
+    }
+}
+
 TransformStateManager* g_transform_state_manager;
 
 template class MIZU_RENDER_API
@@ -18,24 +18,21 @@ PipelineCache& PipelineCache::get()
 
 void PipelineCache::reset()
 {
+    const std::lock_guard lock{m_mutex};
     m_cache.clear();
 }
 
-void PipelineCache::insert(size_t hash, std::shared_ptr<Pipeline> pipeline)
+std::shared_ptr<Pipeline> PipelineCache::insert(size_t hash, std::shared_ptr<Pipeline> pipeline)
 {
-    MIZU_ASSERT(!contains(hash), "Pipeline with hash {} already exists");
-    m_cache.emplace(hash, std::move(pipeline));
+    const std::lock_guard lock{m_mutex};
+    return m_cache.try_emplace(hash, std::move(pipeline)).first->second;
 }
 
-std::shared_ptr<Pipeline> PipelineCache::get(size_t hash) const
+std::shared_ptr<Pipeline> PipelineCache::find(size_t hash) const
 {
-    MIZU_ASSERT(contains(hash), "Pipeline with hash {} does not exist");
-    return m_cache.find(hash)->second;
-}
-
-bool PipelineCache::contains(size_t hash) const
-{
-    return m_cache.find(hash) != m_cache.end();
+    const std::lock_guard lock{m_mutex};
+    const auto it = m_cache.find(hash);
+    return it != m_cache.end() ? it->second : nullptr;
 }
 
 size_t PipelineCache::get_graphics_pipeline_hash(
@@ -319,9 +316,10 @@ std::shared_ptr<Pipeline> get_graphics_pipeline(
         vertex_hash, fragment_hash, raster, depth_stencil, color_blend, framebuffer_info);
 
     PipelineCache& cache = PipelineCache::get();
-    if (cache.contains(pipeline_hash))
+
+    if (std::shared_ptr<Pipeline> cached = cache.find(pipeline_hash))
     {
-        return cache.get(pipeline_hash);
+        return cached;
     }
 
     const SlangReflection& vertex_reflection = get_shader_instance_reflection(vertex);
@@ -347,10 +345,7 @@ std::shared_ptr<Pipeline> get_graphics_pipeline(
     desc.layout = builder.create_pipeline_layout_handle();
     desc.framebuffer_info = std::move(framebuffer_info);
 
-    const auto pipeline = g_render_device->create_pipeline(desc);
-    cache.insert(pipeline_hash, pipeline);
-
-    return pipeline;
+    return cache.insert(pipeline_hash, g_render_device->create_pipeline(desc));
 }
 
 std::shared_ptr<Pipeline> get_compute_pipeline(const ShaderDeclaration& compute_shader)
@@ -365,9 +360,10 @@ std::shared_ptr<Pipeline> get_compute_pipeline(const ShaderInstance& compute)
     const size_t pipeline_hash = PipelineCache::get_compute_pipeline_hash(get_shader_instance_hash(compute));
 
     PipelineCache& cache = PipelineCache::get();
-    if (cache.contains(pipeline_hash))
+
+    if (std::shared_ptr<Pipeline> cached = cache.find(pipeline_hash))
     {
-        return cache.get(pipeline_hash);
+        return cached;
     }
 
     const SlangReflection& compute_reflection = get_shader_instance_reflection(compute);
@@ -379,10 +375,7 @@ std::shared_ptr<Pipeline> get_compute_pipeline(const ShaderInstance& compute)
     desc.compute_shader = get_shader(compute);
     desc.layout = builder.create_pipeline_layout_handle();
 
-    const auto pipeline = g_render_device->create_pipeline(desc);
-    cache.insert(pipeline_hash, pipeline);
-
-    return pipeline;
+    return cache.insert(pipeline_hash, g_render_device->create_pipeline(desc));
 }
 
 // std::shared_ptr<Pipeline> get_ray_tracing_pipeline(
@@ -446,9 +439,10 @@ std::shared_ptr<Pipeline> get_ray_tracing_pipeline(
         PipelineCache::get_ray_tracing_pipeline_hash(raygen_hash, miss_hash, closest_hit_hash, max_ray_recursion_depth);
 
     PipelineCache& cache = PipelineCache::get();
-    if (cache.contains(pipeline_hash))
+
+    if (std::shared_ptr<Pipeline> cached = cache.find(pipeline_hash))
     {
-        return cache.get(pipeline_hash);
+        return cached;
     }
 
     PipelineLayoutBuilder builder{};
@@ -486,10 +480,7 @@ std::shared_ptr<Pipeline> get_ray_tracing_pipeline(
     desc.layout = builder.create_pipeline_layout_handle();
     desc.max_ray_recursion_depth = max_ray_recursion_depth;
 
-    const auto pipeline = g_render_device->create_pipeline(desc);
-    cache.insert(pipeline_hash, pipeline);
-
-    return pipeline;
+    return cache.insert(pipeline_hash, g_render_device->create_pipeline(desc));
 }
 
 } // namespace Mizu
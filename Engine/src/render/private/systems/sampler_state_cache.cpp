@@ -16,6 +16,7 @@ SamplerStateCache& SamplerStateCache::get()
 
 void SamplerStateCache::reset()
 {
+    const std::lock_guard lock{m_mutex};
     m_cache.clear();
 }
 
@@ -23,6 +24,8 @@ std::shared_ptr<SamplerState> SamplerStateCache::get_sampler_state(const Sampler
 {
     const size_t h = hash(options);
 
+    const std::lock_guard lock{m_mutex};
+
     const auto it = m_cache.find(h);
     if (it != m_cache.end())
     {
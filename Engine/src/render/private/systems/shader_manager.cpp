@@ -20,6 +20,8 @@ ShaderManager& ShaderManager::get()
 
 void ShaderManager::reset()
 {
+    const std::lock_guard lock{m_cache_mutex};
+
     m_path_mappings.clear();
     m_shader_cache.clear();
     m_reflection_cache.clear();
@@ -61,6 +63,8 @@ std::shared_ptr<Shader> ShaderManager::get_shader(
 {
     const size_t hash = get_shader_hash(virtual_path, entry_point, type, environment);
 
+    const std::lock_guard lock{m_cache_mutex};
+
     const auto it = m_shader_cache.find(hash);
     if (it != m_shader_cache.end())
     {
@@ -98,6 +102,8 @@ const SlangReflection& ShaderManager::get_reflection(
 {
     const size_t hash = get_shader_hash(virtual_path, entry_point, type, environment);
 
+    const std::lock_guard lock{m_cache_mutex};
+
     const auto it = m_reflection_cache.find(hash);
     if (it != m_reflection_cache.end())
     {
@@ -240,6 +246,9 @@ ShaderBytecodeTarget ShaderManager::get_shader_bytecode_target_for_graphics_api(
         return ShaderBytecodeTarget::Dxil;
     case GraphicsApi::Vulkan:
         return ShaderBytecodeTarget::Spirv;
+    case GraphicsApi::Null:
+        // The bytecode is never loaded, but the path must resolve to a target compiled on every platform
+        return ShaderBytecodeTarget::Spirv;
     }
 }
 
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+#include <vector>
+
+#include "render/core/camera.h"
+#include "render/core/frustum_culling.h"
+
+#include "mizu_render_module.h"
+
+namespace Mizu
+{
+
+class AABB;
+
+// Dynamic bounding volume hierarchy. Leaves are inserted next to the sibling that grows the surface area the least and
+// the tree is kept balanced with rotations, so queries can accept or reject whole subtrees with a single test.
+//
+// The tree is built from fat leaf bounds, a margin around the box that is also extended along the last movement, so
+// moving objects only change the tree when they leave their fat bounds. Queries and `get_bounds` use the exact box.
+class MIZU_RENDER_API BoundingVolumeHierarchy
+{
+  public:
+    static constexpr uint32_t INVALID_NODE = std::numeric_limits<uint32_t>::max();
+
+    // Memory of a query, reuse it between queries to avoid allocations. Queries running at the same time need their
+    // own scratch.
+    struct QueryScratch
+    {
+        CullingBounds leaf_bounds{};
+        std::vector<uint32_t> leaf_user_data{};
+        std::vector<uint64_t> visibility_mask{};
+    };
+
+    // Returns the leaf node, which stays valid until it's removed
+    uint32_t insert(const AABB& aabb, uint32_t user_data);
+    void remove(uint32_t leaf);
+    // Only reinserts the leaf if the box is not inside its fat bounds anymore, returns whether it was reinserted
+    bool update(uint32_t leaf, const AABB& aabb);
+    void clear();
+
+    void set_user_data(uint32_t leaf, uint32_t user_data);
+    uint32_t get_user_data(uint32_t leaf) const;
+    AABB get_bounds(uint32_t leaf) const;
+
+    // Appends the user data of the leaves inside the frustum, same results as testing every leaf with
+    // `Frustum::is_inside_frustum`. Leaves of subtrees that cross the frustum are tested together with `cull_frustums`.
+    void query(const Frustum& frustum, FrustumMask mask, std::vector<uint32_t>& out_user_data) const;
+    void query(const Frustum& frustum, FrustumMask mask, std::vector<uint32_t>& out_user_data, QueryScratch& scratch)
+        const;
+
+    uint32_t get_num_leaves() const { return m_num_leaves; }
+    uint32_t get_height() const;
+
+  private:
+    struct Node
+    {
+        // Fat bounds for leaves
+        glm::vec3 min{};
+        glm::vec3 max{};
+
+        uint32_t parent = INVALID_NODE;
+        uint32_t children[2] = {INVALID_NODE, INVALID_NODE};
+        uint32_t user_data = 0;
+
+        // 0 for leaves, -1 for free nodes
+        int32_t height = -1;
+
+        bool is_leaf() const { return children[0] == INVALID_NODE; }
+    };
+
+    struct LeafBounds
+    {
+        glm::vec3 min{};
+        glm::vec3 max{};
+    };
+
+    std::vector<Node> m_nodes{};
+    // Exact bounds of the leaves, indexed like `m_nodes`. Kept apart so the nodes stay small for the traversal.
+    std::vector<LeafBounds> m_leaf_bounds{};
+    uint32_t m_root = INVALID_NODE;
+    // Free nodes are chained through `Node::parent`
+    uint32_t m_free_list = INVALID_NODE;
+    uint32_t m_num_leaves = 0;
+
+    uint32_t allocate_node();
+    void free_node(uint32_t node);
+
+    void insert_leaf(uint32_t leaf);
+    void remove_leaf(uint32_t leaf);
+
+    void rebalance_ancestors(uint32_t node);
+    uint32_t balance(uint32_t node);
+};
+
+} // namespace Mizu
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "render/core/camera.h"
+
+#include "mizu_render_module.h"
+
+namespace Mizu
+{
+
+class AABB;
+
+// Structure of arrays bounds, so the culling kernels can test several boxes per instruction
+class MIZU_RENDER_API CullingBounds
+{
+  public:
+    void push_back(const AABB& aabb);
+    void set(size_t index, const AABB& aabb);
+    // Moves the last element into `index` and removes the last element
+    void erase_swap_back(size_t index);
+    void clear();
+
+    size_t size() const { return m_center_x.size(); }
+    bool empty() const { return m_center_x.empty(); }
+
+    const float* center_x() const { return m_center_x.data(); }
+    const float* center_y() const { return m_center_y.data(); }
+    const float* center_z() const { return m_center_z.data(); }
+    const float* extent_x() const { return m_extent_x.data(); }
+    const float* extent_y() const { return m_extent_y.data(); }
+    const float* extent_z() const { return m_extent_z.data(); }
+
+  private:
+    std::vector<float> m_center_x{}, m_center_y{}, m_center_z{};
+    std::vector<float> m_extent_x{}, m_extent_y{}, m_extent_z{};
+};
+
+constexpr size_t get_visibility_mask_word_count(size_t count)
+{
+    return (count + 63) / 64;
+}
+
+inline bool is_visible(std::span<const uint64_t> visibility_mask, size_t index)
+{
+    return (visibility_mask[index / 64] >> (index % 64)) & 1u;
+}
+
+// Tests every box against every frustum in a single sweep over the bounds, each box is loaded once for all frustums.
+// The visibility mask of frustum `i` is written to the `get_visibility_mask_word_count(bounds.size())` words starting
+// at `i * get_visibility_mask_word_count(bounds.size())`, bit `j` is set if box `j` is inside the frustum. Same
+// results as `Frustum::is_inside_frustum`.
+MIZU_RENDER_API void cull_frustums(
+    std::span<const Frustum> frustums,
+    std::span<const FrustumMask> masks,
+    const CullingBounds& bounds,
+    std::span<uint64_t> out_visibility_masks);
+
+// Writes the indices of the visible elements in `visibility_mask`, in ascending order, and returns the number of
+// visible elements. `out_indices` must be able to hold every visible index.
+MIZU_RENDER_API size_t compact_visible_indices(
+    std::span<const uint64_t> visibility_mask,
+    std::span<uint32_t> out_indices);
+
+} // namespace Mizu
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "mizu_render_module.h"
@@ -12,6 +13,18 @@ namespace Mizu
 class CommandBuffer;
 struct CommandBufferSubmitInfo;
 
+// Range of commands of a batch recorded into its own command buffer. The command lists of a batch are submitted in
+// order, so they can be recorded on different threads.
+struct RenderGraphCommandList
+{
+    size_t batch_idx = 0;
+    size_t first_cmd_idx = 0;
+    size_t end_cmd_idx = 0;
+    bool parallel = false;
+
+    std::shared_ptr<CommandBuffer> command_buffer{};
+};
+
 class MIZU_RENDER_API RenderGraph
 {
   public:
@@ -33,13 +46,22 @@ class MIZU_RENDER_API RenderGraph
 
     void insert_external_submit_info(const CommandBufferSubmitInfo& submit_info);
 
+    // Splits the batches in command lists when any pass allows parallel recording, returns the number of parallel lists
+    size_t build_command_lists();
+    void execute_parallel();
+    void record_command_list(RenderGraphCommandList& command_list);
+
     void execute_internal(CommandBuffer& command, const BufferTransitionCmd& cmd);
     void execute_internal(CommandBuffer& command, const ImageTransitionCmd& cmd);
     void execute_internal(CommandBuffer& command, const AccelStructTransitionCmd& cmd);
+    void execute_internal(CommandBuffer& command, const ResourceBarrierCmd& cmd);
     void execute_internal(CommandBuffer& command, const PassExecuteCmd& cmd);
 
     std::vector<CommandBufferBatch> m_command_buffer_batches;
     std::vector<RenderGraphPassResources> m_pass_resources;
+
+    // Empty when the batches are recorded serially into their own command buffer
+    std::vector<RenderGraphCommandList> m_command_lists;
 };
 
 } // namespace Mizu
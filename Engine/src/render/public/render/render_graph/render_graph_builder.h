@@ -12,8 +12,10 @@
 #include "base/containers/inplace_vector.h"
 #include "base/debug/assert.h"
 #include "base/utils/enum_utils.h"
+#include "base/utils/hash.h"
 #include "render_core/rhi/acceleration_structure.h"
 #include "render_core/rhi/buffer_resource.h"
+#include "render_core/rhi/command_buffer.h"
 #include "render_core/rhi/device_memory_allocator.h"
 #include "render_core/rhi/image_resource.h"
 #include "render_core/rhi/render_pass.h"
@@ -30,6 +32,7 @@ class CommandBuffer;
 class RenderGraph;
 class TransientMemoryPool;
 class RenderGraphResourceRegistry;
+struct RenderGraphCompileCache;
 
 enum class RenderGraphPassHint
 {
@@ -81,6 +84,9 @@ struct RenderGraphResourceDescription
     size_t first_pass_idx = std::numeric_limits<size_t>::max();
     size_t last_pass_idx = std::numeric_limits<size_t>::min();
 
+    // Only accessed by culled passes, it's not created
+    bool culled = false;
+
     std::variant<BufferDescription, ImageDescription, AccelerationStructureDescription> desc{};
 
 #define MIZU_IMPLEMENT_RENDER_GRAPH_RESOURCE_DESC_GETTER(_name, _type, _data)                  \
@@ -300,6 +306,19 @@ struct AccelStructTransitionCmd
     }
 };
 
+// Transitions between two passes, recorded with CommandBuffer::transition_resources
+struct ResourceBarrierCmd
+{
+    std::vector<BufferTransition> buffer_transitions;
+    std::vector<ImageTransition> image_transitions;
+    std::vector<AccelerationStructureTransition> accel_struct_transitions;
+
+    bool empty() const
+    {
+        return buffer_transitions.empty() && image_transitions.empty() && accel_struct_transitions.empty();
+    }
+};
+
 class RenderGraphPassResources;
 
 struct PassExecuteCmd
@@ -307,19 +326,27 @@ struct PassExecuteCmd
     std::string_view name;
     std::function<void(CommandBuffer&, const RenderGraphPassResources&)> func;
     size_t pass_resources_idx;
+    bool allow_parallel_recording;
 
     PassExecuteCmd(
         std::string_view name_,
         std::function<void(CommandBuffer&, const RenderGraphPassResources&)> func_,
-        size_t pass_resources_idx_)
+        size_t pass_resources_idx_,
+        bool allow_parallel_recording_ = false)
         : name(name_)
         , func(std::move(func_))
         , pass_resources_idx(pass_resources_idx_)
+        , allow_parallel_recording(allow_parallel_recording_)
     {
     }
 };
 
-using RenderGraphCmd = std::variant<BufferTransitionCmd, ImageTransitionCmd, AccelStructTransitionCmd, PassExecuteCmd>;
+using RenderGraphCmd = std::variant<
+    BufferTransitionCmd,
+    ImageTransitionCmd,
+    AccelStructTransitionCmd,
+    ResourceBarrierCmd,
+    PassExecuteCmd>;
 
 struct CommandBufferBatch
 {
@@ -397,6 +424,11 @@ class MIZU_RENDER_API RenderGraphPassBuilder
     RenderGraphPassBuilder(RenderGraphBuilder& builder, std::string_view name, size_t pass_idx);
 
     void set_hint(RenderGraphPassHint hint);
+    // Passes with side effects are never culled, even if none of their outputs are used
+    void set_has_side_effects(bool has_side_effects);
+    // The execute function can be recorded on a worker thread, concurrently with other passes and after the passes
+    // that don't allow it. It must not modify state read by other execute functions.
+    void set_allow_parallel_recording(bool allow_parallel_recording);
 
     RenderGraphResource read(RenderGraphResource resource);
     RenderGraphResource write(RenderGraphResource resource);
@@ -414,6 +446,9 @@ class MIZU_RENDER_API RenderGraphPassBuilder
     std::string_view m_name;
     size_t m_pass_idx;
     bool m_has_outputs;
+    bool m_has_side_effects;
+    bool m_allow_parallel_recording;
+    bool m_culled;
 
     inplace_vector<size_t, RENDER_GRAPH_MAX_PASS_DEPENDENCIES> m_pass_outputs;
     inplace_vector<size_t, RENDER_GRAPH_MAX_PASS_DEPENDENCIES> m_pass_inputs;
@@ -450,10 +485,97 @@ using RenderGraphSetupFunc = std::function<void(RenderGraphPassBuilder&, DataT&
 template <typename DataT>
 using RenderGraphExecuteFunc = std::function<void(CommandBuffer&, const DataT&, const RenderGraphPassResources&)>;
 
+enum class RenderGraphAliasingHeuristic
+{
+    // Places the resources by first use in the first free block that fits
+    FirstFit,
+    // Places the resources by first use in the free block that leaves the least memory unused
+    BestFit,
+    // Places the largest resources first, at the lowest offset not used by a resource with an overlapping lifetime
+    InterferenceGraph,
+};
+
 struct RenderGraphBuilderConfig
 {
     bool async_compute_enabled = true;
     bool async_copy_enabled = false;
+
+    // Reuse the previous compile output when the declared passes, accesses and resources didn't change
+    bool cache_compiled_topology = true;
+    // Cull the passes that don't contribute to an external resource or a pass with side effects
+    bool cull_unused_passes = true;
+    // Record the passes that allow parallel recording on JobSystem workers
+    bool parallel_recording = true;
+    // Record the transitions between two passes with a single barrier
+    bool batch_transitions = true;
+    // Begin a transition after the last access in the old state when there are passes before the next access
+    bool split_transitions = true;
+
+    RenderGraphAliasingHeuristic aliasing_heuristic = RenderGraphAliasingHeuristic::BestFit;
+    // Place buffers and textures in separate heaps, for devices that can't alias them
+    bool separate_buffer_texture_heaps = false;
+    // Place resources used by different sets of queues in separate heaps. Lifetimes are measured in passes, which
+    // doesn't account for passes of different queues running at the same time.
+    bool separate_queue_heaps = true;
+};
+
+// Every field the compiled output depends on, flattened into words. Graphs with the same key compile to the same
+// schedule. The hash rejects most changes, the words are only compared on a hash match so collisions can't reuse a
+// stale schedule.
+struct RenderGraphTopologyKey
+{
+    size_t hash = 0;
+    std::vector<uint64_t> words;
+
+    void clear()
+    {
+        hash = 0;
+        words.clear();
+    }
+
+    void append(uint64_t word)
+    {
+        words.push_back(word);
+        hash_combine(hash, word);
+    }
+
+    bool operator==(const RenderGraphTopologyKey& other) const { return hash == other.hash && words == other.words; }
+};
+
+struct RenderGraphCompileStats
+{
+    uint64_t num_cache_hits = 0;
+    uint64_t num_cache_misses = 0;
+
+    uint64_t num_culled_passes = 0;
+    uint64_t num_culled_resources = 0;
+
+    uint64_t num_transitions = 0;
+    // Barriers recorded per execution, each one with all the transitions between two passes when they are batched
+    uint64_t num_barriers = 0;
+    uint64_t num_split_transitions = 0;
+
+    uint64_t num_transient_resources = 0;
+    uint64_t num_transient_heaps = 0;
+    // Size of the transient memory needed by the aliased transient resources
+    uint64_t transient_memory_size = 0;
+    // Size of the transient memory without aliasing
+    uint64_t transient_memory_unaliased_size = 0;
+    // Peak size of the transient resources alive at the same time, no aliasing needs less memory
+    uint64_t transient_memory_lower_bound = 0;
+    // Size of the transient memory pool, which only grows
+    uint64_t transient_memory_committed_size = 0;
+
+    // CPU time of the last compile per stage, stages skipped by a cache hit are 0
+    uint64_t cull_passes_ns = 0;
+    uint64_t hash_topology_ns = 0;
+    uint64_t topological_sort_ns = 0;
+    uint64_t transitive_reduction_ns = 0;
+    uint64_t merge_passes_ns = 0;
+    uint64_t resource_sharing_ns = 0;
+    uint64_t create_resources_ns = 0;
+    uint64_t create_passes_ns = 0;
+    uint64_t total_ns = 0;
 };
 
 struct RenderGraphBuilderCompileOptions
@@ -474,6 +596,7 @@ class MIZU_RENDER_API RenderGraphBuilder
 {
   public:
     RenderGraphBuilder(RenderGraphBuilderConfig config = {});
+    ~RenderGraphBuilder();
 
     RenderGraphBuilder(const RenderGraphBuilder& other) = delete;
     RenderGraphBuilder& operator=(const RenderGraphBuilder& other) = delete;
@@ -519,6 +642,8 @@ class MIZU_RENDER_API RenderGraphBuilder
         const RenderGraphSetupFunc<DataT>& setup_func,
         RenderGraphExecuteFunc<DataT> execute_func)
     {
+        MIZU_ASSERT(!m_passes_culled, "Can't add passes to a RenderGraphBuilder after culling its passes");
+
         RenderGraphPassBuilder& pass_builder = m_passes.emplace_back(*this, name, m_passes.size());
 
         DataT& pass_data = pass_builder.create_pass_data_wrapper<DataT>();
@@ -530,8 +655,18 @@ class MIZU_RENDER_API RenderGraphBuilder
             });
     }
 
+    // Culls the passes whose outputs don't reach an external resource or a pass with side effects, and the resources
+    // only they use. Called by compile, exposed to inspect the result before compiling.
+    void cull_passes();
+    bool is_pass_culled(std::string_view name) const;
+    bool is_resource_culled(RenderGraphResource resource) const;
+
     void compile(RenderGraph& graph, const RenderGraphBuilderCompileOptions& options);
 
+    const RenderGraphCompileStats& get_compile_stats() const { return m_compile_stats; }
+
+    void build_topology_key(RenderGraphTopologyKey& out_key) const;
+
   private:
     RenderGraphBuilderConfig m_config;
     std::vector<RenderGraphResourceDescription> m_resources;
@@ -539,6 +674,17 @@ class MIZU_RENDER_API RenderGraphBuilder
 
     std::vector<RenderGraphExternalResourceDescription> m_external_resources;
 
+    std::unique_ptr<RenderGraphCompileCache> m_compile_cache;
+    RenderGraphCompileStats m_compile_stats{};
+    // Topology key of the graph being compiled, kept between compiles to reuse the allocation
+    RenderGraphTopologyKey m_topology_key{};
+
+    bool m_passes_culled = false;
+    size_t m_num_culled_passes = 0;
+    size_t m_num_culled_resources = 0;
+
+    void analyze_graph(std::vector<CommandBufferBatch>& batches, std::vector<size_t>& pass_to_batch);
+
     template <typename ResourceT>
     void add_resource_acquire_transition(
         CommandBufferBatch& batch,
@@ -599,6 +745,8 @@ class MIZU_RENDER_API RenderGraphBuilder
     static BufferUsageBits get_buffer_usage_bits(RenderGraphResourceUsageBits usage);
     static ImageUsageBits get_image_usage_bits(RenderGraphResourceUsageBits usage);
 
+    size_t get_transient_heap(const RenderGraphResourceDescription& resource_desc) const;
+
     const RenderGraphAccessRecord& get_access_record(RenderGraphAccessRecord::Link link) const;
     RenderGraphAccessRecord& get_access_record(RenderGraphAccessRecord::Link link);
 
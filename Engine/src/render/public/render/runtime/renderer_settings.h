@@ -6,11 +6,14 @@
 namespace Mizu
 {
 
+// max_transforms and max_static_meshes are only read when the renderer is initialized
 #define MIZU_RENDERER_SETTINGS_MEMBERS(X)             \
     X(GraphicsApi, graphics_api, GraphicsApi::Vulkan) \
     X(bool, validations_enabled, true)                \
     X(uint32_t, frames_in_flight, 2)                  \
-    X(bool, gpu_driven_rendering_enabled, true)
+    X(bool, gpu_driven_rendering_enabled, true)       \
+    X(uint32_t, max_transforms, 1000)                 \
+    X(uint32_t, max_static_meshes, 100)
 
 MIZU_CREATE_SETTING(RendererSettings, MIZU_RENDERER_SETTINGS_MEMBERS);
 
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+
+#include "asset/asset_handle.h"
+#include "base/math/aabb.h"
+
+#include "render/core/bounding_volume_hierarchy.h"
+#include "render/resources/gpu_resource_types.h"
+#include "render/state_manager/static_mesh_state_manager.h"
+#include "render/state_manager/transform_state_manager.h"
+
+namespace Mizu
+{
+
+class BufferResource;
+
+struct SceneDrawableInfo
+{
+    StaticMeshHandle static_mesh_handle{};
+    TransformHandle transform_handle{};
+
+    MeshAssetHandle mesh_handle{};
+    MaterialAssetHandle material_handle{};
+
+    GpuMeshResidentRecord gpu_mesh_record{};
+    GpuMeshDrawPayload gpu_mesh_draw{};
+    uint32_t material_buffer_offset = std::numeric_limits<uint32_t>::max();
+    uint32_t transform_slot_index = std::numeric_limits<uint32_t>::max();
+};
+
+// Drawables the DrawListSystem compiles its draw lists from, implemented by SceneSystem
+class IDrawListScene
+{
+  public:
+    static constexpr uint32_t INVALID_DRAWABLE_INDEX = std::numeric_limits<uint32_t>::max();
+
+    virtual ~IDrawListScene() = default;
+
+    virtual std::span<const SceneDrawableInfo> get_drawables() const = 0;
+    // Hierarchy over the world space bounds of the drawables, the user data of each leaf is the drawable index
+    virtual const BoundingVolumeHierarchy& get_drawable_bvh() const = 0;
+    virtual AABB get_drawable_world_bounds(size_t drawable_idx) const = 0;
+    virtual std::shared_ptr<BufferResource> get_transform_info_buffer() const = 0;
+
+    // Renderables are identified by the internal id of their static mesh handle, which doesn't change while they exist
+    // (drawable indices do, as drawables are swap removed). Returns INVALID_DRAWABLE_INDEX if it's not drawable.
+    virtual uint32_t get_drawable_index(uint32_t renderable_id) const = 0;
+
+    // Renderables whose drawable was created, destroyed or transformed since the last `clear_dirty_renderables`
+    virtual std::span<const uint32_t> get_dirty_renderables() const = 0;
+    virtual bool is_renderable_dirty(uint32_t renderable_id) const = 0;
+    virtual void clear_dirty_renderables() = 0;
+};
+
+} // namespace Mizu
@@ -6,15 +6,20 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
+#include "render/core/bounding_volume_hierarchy.h"
 #include "render/core/camera.h"
 #include "render/render_graph/render_graph_builder.h"
 #include "render/scene/draw_list_raster_pass.h"
+#include "render/scene/draw_list_scene.h"
 #include "render/scene/draw_list_system_types.h"
 #include "render/systems/frame_linear_allocator.h"
 
+#include "mizu_render_module.h"
+
 namespace Mizu
 {
 
@@ -23,10 +28,18 @@ class CommandBuffer;
 class DescriptorSet;
 class GpuMeshPool;
 class Pipeline;
-class SceneSystem;
 struct DrawElement;
 struct GpuDrawData;
 
+enum class DrawListSortMode
+{
+    // Groups draws by pipeline, material and mesh, to reduce state changes and instance as many draws as possible
+    State,
+    // Draws closer to the frustum center go first, so opaque passes can reject hidden fragments early at the cost of
+    // less instancing. Lists without a frustum are sorted as `State`.
+    FrontToBack,
+};
+
 struct DrawListRequest
 {
     DrawListRasterPass* raster_pass = nullptr;
@@ -35,6 +48,29 @@ struct DrawListRequest
     std::optional<Frustum> frustum{};
     FrustumMask frustum_mask{};
     uint32_t view_count = 1;
+
+    DrawListSortMode sort_mode = DrawListSortMode::State;
+};
+
+enum class DrawListRebuildReason
+{
+    // The result of the previous frame was reused, only the dirty drawables were culled and sorted again
+    None,
+    // First frame the view requests the compile list
+    NewList,
+    // The frustum changed, so the visibility and depth of every drawable is outdated
+    FrustumChanged,
+    // Too many dirty drawables, a full rebuild is cheaper than patching the previous result
+    TooManyDirtyDrawables,
+};
+
+struct DrawListCompileStats
+{
+    DrawListRebuildReason rebuild_reason = DrawListRebuildReason::None;
+    // Drawables culled and sorted again by an incremental update, 0 on a full rebuild
+    uint32_t num_dirty_drawables = 0;
+    uint32_t num_visible_drawables = 0;
+    uint32_t num_draw_elements = 0;
 };
 
 struct DrawListHandle
@@ -46,10 +82,14 @@ struct DrawListHandle
     bool is_valid() const { return index != INVALID_INDEX; }
 };
 
-class DrawListSystem
+class MIZU_RENDER_API DrawListSystem
 {
   public:
-    DrawListSystem(SceneSystem& scene_system, GpuMeshPool& gpu_mesh_pool);
+    // The vertex and index buffers are the ones of the GpuMeshPool, where the meshes of the drawables live
+    DrawListSystem(
+        IDrawListScene& scene,
+        std::shared_ptr<BufferResource> vertex_buffer,
+        std::shared_ptr<BufferResource> index_buffer);
     ~DrawListSystem();
 
     void reset();
@@ -62,9 +102,19 @@ class DrawListSystem
 
     void dispatch_draw_list(CommandBuffer& command, DrawListHandle handle, const DrawListRasterPassInfo& info);
 
+    // Indexed like the compile lists of the current frame, only filled when draw lists are compiled on the cpu
+    std::span<const DrawListCompileStats> get_compile_stats() const
+    {
+        return std::span(m_compile_stats.data(), m_num_compile_lists.load(std::memory_order_relaxed));
+    }
+
+    // Renderables drawn by the draw list in draw order, only filled when draw lists are compiled on the cpu
+    std::span<const uint32_t> get_draw_list_renderables(DrawListHandle handle) const;
+
   private:
-    SceneSystem& m_scene_system;
-    GpuMeshPool& m_gpu_mesh_pool;
+    IDrawListScene& m_scene;
+    std::shared_ptr<BufferResource> m_vertex_buffer;
+    std::shared_ptr<BufferResource> m_index_buffer;
 
     std::unordered_map<size_t, DrawListHandle> m_draw_list_cache{};
     std::unordered_map<size_t, uint32_t> m_compile_list_cache{};
@@ -86,10 +136,13 @@ class DrawListSystem
 
         std::optional<Frustum> frustum{};
         FrustumMask frustum_mask{};
+        DrawListSortMode sort_mode = DrawListSortMode::State;
+
+        uint32_t cache_idx = std::numeric_limits<uint32_t>::max();
+        DrawListRebuildReason rebuild_reason = DrawListRebuildReason::None;
 
         uint32_t num_draw_elements = 0;
         uint32_t num_draw_data = 0;
-        uint32_t draw_elements_offset = 0;
 
         FrameAllocation draw_data_allocation{};
     };
@@ -103,9 +156,43 @@ class DrawListSystem
     std::array<DrawListRecord, MAX_NUM_DRAW_LISTS> m_draw_list_records{};
     std::array<CompileListRecord, MAX_NUM_COMPILE_LISTS> m_compile_list_records{};
 
-    // Keep without initialization ({} braces) so that we can keep `DrawElement` and `GpuDrawData` defined in the cpp.
-    std::vector<DrawElement> m_draw_elements;
-    std::vector<GpuDrawData> m_draw_data;
+    // Result of a compile list kept between frames, so that the next frame with the same view only has to cull and sort
+    // the dirty drawables
+    struct CompileListCache
+    {
+        bool is_valid = false;
+        // Claimed by a compile list this frame, caches not claimed for a frame are invalidated
+        bool is_used = false;
+
+        // Everything that identifies the view except the frustum itself
+        size_t identity_hash = 0;
+        std::optional<Frustum> frustum{};
+
+        // Visible renderables sorted by their key
+        std::vector<uint64_t> sort_keys{};
+        std::vector<uint32_t> renderable_ids{};
+
+        // Keep without initialization ({} braces) so that we can keep `DrawElement` and `GpuDrawData` defined in the
+        // cpp. Grown on demand, so the memory follows the number of visible drawables.
+        std::vector<DrawElement> draw_elements;
+        std::vector<GpuDrawData> draw_data;
+        uint32_t num_draw_elements = 0;
+
+        // Scratch memory, kept between frames to reuse the allocations
+        std::vector<uint32_t> visible_drawables{};
+        BoundingVolumeHierarchy::QueryScratch bvh_query_scratch{};
+        std::vector<uint32_t> dirty_drawables{};
+        CullingBounds dirty_bounds{};
+        std::vector<uint64_t> dirty_visibility_mask{};
+        std::vector<uint64_t> dirty_sort_keys{};
+        std::vector<uint32_t> dirty_renderable_ids{};
+        std::vector<uint64_t> tmp_sort_keys{};
+        std::vector<uint32_t> tmp_renderable_ids{};
+    };
+
+    // Keep without initialization ({} braces), it would need the destructor of `DrawElement` outside of the cpp
+    std::array<CompileListCache, MAX_NUM_COMPILE_LISTS> m_compile_list_caches;
+    std::array<DrawListCompileStats, MAX_NUM_COMPILE_LISTS> m_compile_stats{};
 
     struct TransientGpuDrivenRenderingResources
     {
@@ -121,7 +208,18 @@ class DrawListSystem
     bool m_gpu_driven_rendering_enabled = false;
     TransientGpuDrivenRenderingResources m_transient_gpu_driven_rendering_resources{};
 
+    uint32_t claim_compile_list_cache(
+        size_t identity_hash,
+        const std::optional<Frustum>& frustum,
+        DrawListRebuildReason& out_rebuild_reason);
+
     void compile_draw_list_job(uint32_t compile_list_idx);
+    void rebuild_compile_list(uint32_t compile_list_idx, size_t pipeline_hash);
+    void update_compile_list(
+        uint32_t compile_list_idx,
+        size_t pipeline_hash,
+        std::span<const uint32_t> dirty_renderables);
+    void gather_compile_list(uint32_t compile_list_idx, const DrawItem& draw_item);
 
     void dispatch_draw_list_cpu(CommandBuffer& command, DrawListHandle handle, const DrawListRasterPassInfo& info);
     void dispatch_draw_list_gpu(CommandBuffer& command, DrawListHandle handle, const DrawListRasterPassInfo& info);
@@ -130,12 +228,13 @@ class DrawListSystem
     void bind_draw_index_push_constant(CommandBuffer& command, uint32_t draw_index) const;
 };
 
-void draw_list_system_init(SceneSystem& scene_system, GpuMeshPool& gpu_mesh_pool);
+void draw_list_system_init(IDrawListScene& scene, const GpuMeshPool& gpu_mesh_pool);
 void draw_list_system_shutdown();
 void draw_list_system_compile_draw_lists();
 void draw_list_system_add_compile_draw_lists_pass(RenderGraphBuilder& builder, FrameLinearAllocator& frame_allocator);
 void draw_list_system_build_frame_resources(FrameLinearAllocator& linear_allocator);
 void draw_list_system_reset();
+std::span<const DrawListCompileStats> draw_list_system_get_compile_stats();
 
 DrawListHandle create_draw_list(const DrawListRequest& request);
 void dispatch_draw_list(CommandBuffer& command, DrawListHandle handle, const DrawListRasterPassInfo& info);
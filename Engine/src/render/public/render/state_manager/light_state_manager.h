@@ -65,6 +65,8 @@ MIZU_STATE_MANAGER_CREATE_HANDLE(LightHandle);
 
 struct LightConfig : BaseStateManagerConfig
 {
+    static constexpr bool SuppressUnchangedUpdates = true;
+
     static constexpr std::string_view Identifier = "LightStateManager";
 };
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/epsilon.hpp>
@@ -23,7 +25,11 @@ struct TransformDynamicState
 
     bool has_changed(const TransformDynamicState& previous) const
     {
-        constexpr float epsilon = glm::epsilon<float>();
+        return has_changed(previous, glm::epsilon<float>());
+    }
+
+    bool has_changed(const TransformDynamicState& previous, float epsilon) const
+    {
         constexpr float pi = glm::pi<float>();
 
         const auto vec3_equal = [&](const glm::vec3& a, const glm::vec3& b, float eps) {
@@ -62,6 +68,13 @@ struct TransformDynamicState
 
         return ds;
     }
+
+    // SIMD version of interpolate, used by the state manager to interpolate all the updates of a tick at once
+    MIZU_RENDER_API static void interpolate_batch(
+        std::span<const TransformDynamicState> from,
+        std::span<const TransformDynamicState> to,
+        double alpha,
+        std::span<TransformDynamicState> out);
 };
 
 MIZU_STATE_MANAGER_CREATE_HANDLE(TransformHandle);
@@ -70,6 +83,8 @@ struct TransformConfig : BaseStateManagerConfig
 {
     static constexpr uint64_t MaxNumHandles = 1000;
     static constexpr bool Interpolate = true;
+    // Gameplay code usually writes every transform every tick, even if it did not move
+    static constexpr bool SuppressUnchangedUpdates = true;
 
     static constexpr std::string_view Identifier = "TransformStateManager";
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string_view>
 #include <unordered_map>
 
@@ -22,9 +23,10 @@ class MIZU_RENDER_API PipelineCache
 
     void reset();
 
-    void insert(size_t hash, std::shared_ptr<Pipeline> pipeline);
-    std::shared_ptr<Pipeline> get(size_t hash) const;
-    bool contains(size_t hash) const;
+    // Passes can be recorded on several threads. Pipelines are created outside of the lock, if two threads create
+    // the same pipeline the first one inserted is kept and returned to both
+    std::shared_ptr<Pipeline> insert(size_t hash, std::shared_ptr<Pipeline> pipeline);
+    std::shared_ptr<Pipeline> find(size_t hash) const;
 
     static size_t get_graphics_pipeline_hash(
         size_t vertex_hash,
@@ -43,6 +45,7 @@ class MIZU_RENDER_API PipelineCache
         uint32_t max_ray_recursion_depth);
 
   private:
+    mutable std::mutex m_mutex;
     std::unordered_map<size_t, std::shared_ptr<Pipeline>> m_cache;
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include "render_core/rhi/sampler_state.h"
@@ -21,6 +22,7 @@ class MIZU_RENDER_API SamplerStateCache
     std::shared_ptr<SamplerState> get_sampler_state(const SamplerStateDescription& options);
 
   private:
+    std::mutex m_mutex;
     std::unordered_map<size_t, std::shared_ptr<SamplerState>> m_cache;
 
     size_t hash(const SamplerStateDescription& options) const;
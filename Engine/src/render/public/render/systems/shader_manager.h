@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -68,6 +69,8 @@ class MIZU_RENDER_API ShaderManager
 
   private:
     std::unordered_map<std::string, std::filesystem::path> m_path_mappings;
+    // Shaders and reflections can be requested by passes recorded on different threads
+    std::mutex m_cache_mutex;
     std::unordered_map<size_t, std::shared_ptr<Shader>> m_shader_cache;
     std::unordered_map<size_t, SlangReflection> m_reflection_cache;
 };
@@ -1,5 +1,8 @@
 #include "dx12_command_buffer.h"
 
+#include <array>
+#include <vector>
+
 #include "base/debug/assert.h"
 #include "base/debug/logging.h"
 
@@ -21,12 +24,13 @@ static_assert(
 
 Dx12CommandBuffer::Dx12CommandBuffer(CommandBufferType type) : m_type(type)
 {
-    m_command_list = Dx12Context.device->allocate_command_list(m_type, Dx12Context.current_frame_in_flight_idx);
+    m_command_list = Dx12Context.device->allocate_command_list(
+        m_type, Dx12Context.current_frame_in_flight_idx, m_command_info_idx);
 }
 
 Dx12CommandBuffer::~Dx12CommandBuffer()
 {
-    Dx12Context.device->free_command_list(m_command_list, m_type);
+    Dx12Context.device->free_command_list(m_command_list, m_type, m_command_info_idx);
 }
 
 void Dx12CommandBuffer::begin()
@@ -58,14 +62,32 @@ void Dx12CommandBuffer::end()
 
 void Dx12CommandBuffer::submit(const CommandBufferSubmitInfo& info) const
 {
+    const CommandBuffer* command_buffer = this;
+    submit_ordered_internal(std::span(&command_buffer, 1), info);
+}
+
+void Dx12CommandBuffer::submit_ordered_internal(
+    std::span<const CommandBuffer* const> command_buffers,
+    const CommandBufferSubmitInfo& info) const
+{
+    std::vector<ID3D12CommandList*> command_lists;
+    command_lists.reserve(command_buffers.size());
+
+    for (const CommandBuffer* command_buffer : command_buffers)
+    {
+        const Dx12CommandBuffer& native_command_buffer = static_cast<const Dx12CommandBuffer&>(*command_buffer);
+        MIZU_ASSERT(native_command_buffer.m_type == m_type, "All submitted command buffers must have the same type");
+
+        command_lists.push_back(native_command_buffer.m_command_list);
+    }
+
     for (const std::shared_ptr<Semaphore>& semaphore : info.wait_semaphores)
     {
         Dx12Semaphore& native_semaphore = static_cast<Dx12Semaphore&>(*semaphore);
         native_semaphore.wait(get_queue());
     }
 
-    ID3D12CommandList* command_lists[] = {m_command_list};
-    get_queue()->ExecuteCommandLists(_countof(command_lists), command_lists);
+    get_queue()->ExecuteCommandLists(static_cast<UINT>(command_lists.size()), command_lists.data());
 
     if (info.signal_fence != nullptr)
     {
@@ -611,18 +633,17 @@ void Dx12CommandBuffer::trace_rays(glm::uvec3 dimensions) const
     MIZU_UNREACHABLE("Not implemented");
 }
 
-void Dx12CommandBuffer::transition_resource(const BufferResource& buffer, const BufferTransitionInfo& info) const
+// Returns false if the transition doesn't need a barrier
+static bool get_dx12_buffer_transition_barrier(
+    CommandBufferType type,
+    const BufferResource& buffer,
+    const BufferTransitionInfo& info,
+    D3D12_BUFFER_BARRIER& buffer_barrier)
 {
-    if (info.old_state == info.new_state)
-    {
-        MIZU_LOG_WARNING("Old state and New state are the same");
-        return;
-    }
-
     // In D3D12, cross-queue ownership transfer is handled by fences, not paired barriers.
     // The release side performs the full layout transition; the acquire side is a no-op.
     if (info.transition_mode == ResourceTransitionMode::Acquire)
-        return;
+        return false;
 
     const Dx12BufferResource& native_buffer = static_cast<const Dx12BufferResource&>(buffer);
 
@@ -632,13 +653,13 @@ void Dx12CommandBuffer::transition_resource(const BufferResource& buffer, const
         case BufferResourceState::Undefined:
             return D3D12_BARRIER_SYNC_NONE;
         case BufferResourceState::ShaderReadOnly:
-            if (m_type == CommandBufferType::Graphics)
+            if (type == CommandBufferType::Graphics)
                 return D3D12_BARRIER_SYNC_PIXEL_SHADING | D3D12_BARRIER_SYNC_COMPUTE_SHADING;
             else
                 return D3D12_BARRIER_SYNC_COMPUTE_SHADING;
         case BufferResourceState::UnorderedAccess:
             // In d3d12, it's valid to write into a uav from a pixel shader.
-            if (m_type == CommandBufferType::Graphics)
+            if (type == CommandBufferType::Graphics)
                 return D3D12_BARRIER_SYNC_PIXEL_SHADING | D3D12_BARRIER_SYNC_COMPUTE_SHADING;
             else
                 return D3D12_BARRIER_SYNC_COMPUTE_SHADING;
@@ -686,37 +707,23 @@ void Dx12CommandBuffer::transition_resource(const BufferResource& buffer, const
         }
     };
 
-    const D3D12_BARRIER_SYNC sync_before = get_dx12_barrier_sync(info.old_state);
-    const D3D12_BARRIER_SYNC sync_after = get_dx12_barrier_sync(info.new_state);
-
-    const D3D12_BARRIER_ACCESS access_before = get_dx12_barrier_access(info.old_state);
-    const D3D12_BARRIER_ACCESS access_after = get_dx12_barrier_access(info.new_state);
-
-    D3D12_BUFFER_BARRIER buffer_barrier{};
-    buffer_barrier.SyncBefore = sync_before;
-    buffer_barrier.SyncAfter = sync_after;
-    buffer_barrier.AccessBefore = access_before;
-    buffer_barrier.AccessAfter = access_after;
+    buffer_barrier = {};
+    buffer_barrier.SyncBefore = get_dx12_barrier_sync(info.old_state);
+    buffer_barrier.SyncAfter = get_dx12_barrier_sync(info.new_state);
+    buffer_barrier.AccessBefore = get_dx12_barrier_access(info.old_state);
+    buffer_barrier.AccessAfter = get_dx12_barrier_access(info.new_state);
     buffer_barrier.pResource = native_buffer.handle();
     buffer_barrier.Offset = 0;
     buffer_barrier.Size = UINT64_MAX;
 
-    D3D12_BARRIER_GROUP barrier_group{};
-    barrier_group.Type = D3D12_BARRIER_TYPE_BUFFER;
-    barrier_group.NumBarriers = 1;
-    barrier_group.pBufferBarriers = &buffer_barrier;
-
-    m_command_list->Barrier(1, &barrier_group);
+    return true;
 }
 
-void Dx12CommandBuffer::transition_resource(const ImageResource& image, const ImageTransitionInfo& info) const
+static D3D12_TEXTURE_BARRIER get_dx12_image_transition_barrier(
+    CommandBufferType type,
+    const ImageResource& image,
+    const ImageTransitionInfo& info)
 {
-    if (info.old_state == info.new_state)
-    {
-        MIZU_LOG_WARNING("Old state and New state are the same");
-        return;
-    }
-
     const Dx12ImageResource& native_image = static_cast<const Dx12ImageResource&>(image);
 
     const auto get_dx12_barrier_sync = [&](ImageResourceState state) -> D3D12_BARRIER_SYNC {
@@ -725,13 +732,13 @@ void Dx12CommandBuffer::transition_resource(const ImageResource& image, const Im
         case ImageResourceState::Undefined:
             return D3D12_BARRIER_SYNC_NONE;
         case ImageResourceState::ShaderReadOnly:
-            if (m_type == CommandBufferType::Graphics)
+            if (type == CommandBufferType::Graphics)
                 return D3D12_BARRIER_SYNC_PIXEL_SHADING | D3D12_BARRIER_SYNC_COMPUTE_SHADING;
             else
                 return D3D12_BARRIER_SYNC_COMPUTE_SHADING;
         case ImageResourceState::UnorderedAccess:
             // In d3d12, it's valid to write into a uav from a pixel shader.
-            if (m_type == CommandBufferType::Graphics)
+            if (type == CommandBufferType::Graphics)
                 return D3D12_BARRIER_SYNC_PIXEL_SHADING | D3D12_BARRIER_SYNC_COMPUTE_SHADING;
             else
                 return D3D12_BARRIER_SYNC_COMPUTE_SHADING;
@@ -811,12 +818,36 @@ void Dx12CommandBuffer::transition_resource(const ImageResource& image, const Im
     texture_barrier.Subresources = subresource_range;
     texture_barrier.Flags = D3D12_TEXTURE_BARRIER_FLAG_NONE;
 
-    D3D12_BARRIER_GROUP barrier_group{};
-    barrier_group.Type = D3D12_BARRIER_TYPE_TEXTURE;
-    barrier_group.NumBarriers = 1;
-    barrier_group.pTextureBarriers = &texture_barrier;
+    return texture_barrier;
+}
+
+// Both halves of a split barrier have the same layouts and accesses, the sync between them is D3D12_BARRIER_SYNC_SPLIT
+template <typename BarrierT>
+static void set_dx12_barrier_split(BarrierT& barrier, ResourceTransitionSplit split)
+{
+    switch (split)
+    {
+    case ResourceTransitionSplit::None:
+        break;
+    case ResourceTransitionSplit::Begin:
+        barrier.SyncAfter = D3D12_BARRIER_SYNC_SPLIT;
+        break;
+    case ResourceTransitionSplit::End:
+        barrier.SyncBefore = D3D12_BARRIER_SYNC_SPLIT;
+        break;
+    }
+}
+
+void Dx12CommandBuffer::transition_resource(const BufferResource& buffer, const BufferTransitionInfo& info) const
+{
+    const BufferTransition transition{&buffer, info};
+    transition_resources(ResourceTransitionBatch{.buffers = std::span(&transition, 1)});
+}
 
-    m_command_list->Barrier(1, &barrier_group);
+void Dx12CommandBuffer::transition_resource(const ImageResource& image, const ImageTransitionInfo& info) const
+{
+    const ImageTransition transition{&image, info};
+    transition_resources(ResourceTransitionBatch{.images = std::span(&transition, 1)});
 }
 
 void Dx12CommandBuffer::transition_resource(
@@ -828,6 +859,72 @@ void Dx12CommandBuffer::transition_resource(
     MIZU_UNREACHABLE("Not implemented");
 }
 
+void Dx12CommandBuffer::transition_resources(const ResourceTransitionBatch& batch) const
+{
+    MIZU_ASSERT(batch.accel_structs.empty(), "Acceleration structure transitions are not implemented");
+
+    std::vector<D3D12_BUFFER_BARRIER> buffer_barriers;
+    buffer_barriers.reserve(batch.buffers.size());
+
+    for (const BufferTransition& transition : batch.buffers)
+    {
+        if (transition.info.old_state == transition.info.new_state)
+        {
+            MIZU_LOG_WARNING("Old state and New state are the same");
+            continue;
+        }
+
+        D3D12_BUFFER_BARRIER buffer_barrier{};
+        if (!get_dx12_buffer_transition_barrier(m_type, *transition.buffer, transition.info, buffer_barrier))
+            continue;
+
+        set_dx12_barrier_split(buffer_barrier, transition.info.split);
+        buffer_barriers.push_back(buffer_barrier);
+    }
+
+    std::vector<D3D12_TEXTURE_BARRIER> texture_barriers;
+    texture_barriers.reserve(batch.images.size());
+
+    for (const ImageTransition& transition : batch.images)
+    {
+        if (transition.info.old_state == transition.info.new_state)
+        {
+            MIZU_LOG_WARNING("Old state and New state are the same");
+            continue;
+        }
+
+        D3D12_TEXTURE_BARRIER texture_barrier =
+            get_dx12_image_transition_barrier(m_type, *transition.image, transition.info);
+
+        set_dx12_barrier_split(texture_barrier, transition.info.split);
+        texture_barriers.push_back(texture_barrier);
+    }
+
+    std::array<D3D12_BARRIER_GROUP, 2> barrier_groups{};
+    uint32_t num_barrier_groups = 0;
+
+    if (!buffer_barriers.empty())
+    {
+        D3D12_BARRIER_GROUP& barrier_group = barrier_groups[num_barrier_groups++];
+        barrier_group.Type = D3D12_BARRIER_TYPE_BUFFER;
+        barrier_group.NumBarriers = static_cast<UINT32>(buffer_barriers.size());
+        barrier_group.pBufferBarriers = buffer_barriers.data();
+    }
+
+    if (!texture_barriers.empty())
+    {
+        D3D12_BARRIER_GROUP& barrier_group = barrier_groups[num_barrier_groups++];
+        barrier_group.Type = D3D12_BARRIER_TYPE_TEXTURE;
+        barrier_group.NumBarriers = static_cast<UINT32>(texture_barriers.size());
+        barrier_group.pTextureBarriers = texture_barriers.data();
+    }
+
+    if (num_barrier_groups > 0)
+    {
+        m_command_list->Barrier(num_barrier_groups, barrier_groups.data());
+    }
+}
+
 static uint32_t align_up(uint32_t value, uint32_t alignment)
 {
     return (value + alignment - 1) & ~(alignment - 1);
@@ -70,6 +70,7 @@ class Dx12CommandBuffer : public CommandBuffer
     void transition_resource(const ImageResource& image, const ImageTransitionInfo& info) const override;
     void transition_resource(const AccelerationStructure& accel_struct, const AccelerationStructureTransitionInfo& info)
         const override;
+    void transition_resources(const ResourceTransitionBatch& batch) const override;
 
     void copy_buffer_to_buffer(
         const BufferResource& source,
@@ -101,10 +102,16 @@ class Dx12CommandBuffer : public CommandBuffer
     void begin_gpu_marker(std::string_view label) const override;
     void end_gpu_marker() const override;
 
+  protected:
+    void submit_ordered_internal(
+        std::span<const CommandBuffer* const> command_buffers,
+        const CommandBufferSubmitInfo& info) const override;
+
   private:
     ID3D12GraphicsCommandList7* m_command_list;
     ID3D12CommandAllocator* m_command_allocator;
     CommandBufferType m_type;
+    uint32_t m_command_info_idx = 0;
 
     bool m_render_pass_active = false;
     std::shared_ptr<Dx12Pipeline> m_bound_pipeline = nullptr;
@@ -285,6 +285,8 @@ uint32_t Dx12TransientDescriptorManager::allocate(uint32_t count)
     if (count == 0)
         return 0;
 
+    const std::lock_guard lock(m_mutex);
+
     MIZU_ASSERT(
         m_current_head + count <= m_pool_end,
         "Can't allocate {} descriptors, head would be at {} which exceeds current pool end {}",
@@ -305,6 +307,8 @@ void Dx12TransientDescriptorManager::reset(uint32_t pool_idx)
         pool_idx,
         m_num_pools);
 
+    const std::lock_guard lock(m_mutex);
+
     m_current_head = m_offset + pool_idx * m_count_per_pool;
     m_pool_end = m_current_head + m_count_per_pool;
 }
@@ -550,6 +554,8 @@ std::shared_ptr<Dx12DescriptorSet> Dx12DescriptorManager::allocate_transient(Des
 void Dx12DescriptorManager::reset_transient(uint32_t pool_idx)
 {
 #if MIZU_DX12_VALIDATIONS_ENABLED
+    const std::lock_guard lock(m_tracked_transient_resources_mutex);
+
     if (!m_tracked_transient_resources[pool_idx].empty())
     {
         for (const Dx12DescriptorSet* ds : m_tracked_transient_resources[pool_idx])
@@ -704,11 +710,15 @@ void Dx12DescriptorManager::get_num_descriptors(
 
 void Dx12DescriptorManager::transient_descriptor_set_created(Dx12DescriptorSet* descriptor_set)
 {
+    const std::lock_guard lock(m_tracked_transient_resources_mutex);
+
     m_tracked_transient_resources[m_current_transient_pool_idx].insert(descriptor_set);
 }
 
 void Dx12DescriptorManager::transient_descriptor_set_freed(Dx12DescriptorSet* descriptor_set)
 {
+    const std::lock_guard lock(m_tracked_transient_resources_mutex);
+
     MIZU_ASSERT(
         m_tracked_transient_resources[m_current_transient_pool_idx].contains(descriptor_set),
         "Trying to free descriptor set that is not tracked with address '{}' and current transient pool '{}'",
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <unordered_set>
 
 #include "render_core/rhi/descriptors.h"
@@ -79,6 +80,9 @@ class Dx12TransientDescriptorManager
     uint32_t get_num_pools() const;
 
   private:
+    // Transient descriptors are allocated by passes recorded on different threads
+    std::mutex m_mutex;
+
     uint32_t m_offset;
     uint32_t m_current_head;
 
@@ -174,6 +178,7 @@ class Dx12DescriptorManager
     void get_num_descriptors(DescriptorSetLayoutHandle layout, uint32_t& resource_count, uint32_t& sampler_count) const;
 
 #if MIZU_DX12_VALIDATIONS_ENABLED
+    std::mutex m_tracked_transient_resources_mutex;
     std::vector<std::unordered_set<Dx12DescriptorSet*>> m_tracked_transient_resources;
 
     void transient_descriptor_set_created(Dx12DescriptorSet* descriptor_set);
@@ -295,9 +295,16 @@ ID3D12CommandQueue* Dx12Device::get_queue(CommandBufferType type) const
     }
 }
 
-ID3D12GraphicsCommandList7* Dx12Device::allocate_command_list(CommandBufferType type, uint32_t frame_in_flight_idx)
+ID3D12GraphicsCommandList7* Dx12Device::allocate_command_list(
+    CommandBufferType type,
+    uint32_t frame_in_flight_idx,
+    uint32_t& out_command_info_idx)
 {
-    ThreadCommandInfo::Type& thread_info = get_thread_command_info(std::this_thread::get_id(), type);
+    const std::lock_guard lock(m_assign_thread_info_mutex);
+
+    out_command_info_idx = get_thread_command_info_idx(std::this_thread::get_id());
+
+    ThreadCommandInfo::Type& thread_info = m_per_thread_command_info[out_command_info_idx].get_type(type);
     MIZU_ASSERT(!thread_info.command_allocators.empty(), "Could not select command allocator");
 
     if (!thread_info.available_command_buffers.empty())
@@ -334,11 +341,16 @@ ID3D12GraphicsCommandList7* Dx12Device::allocate_command_list(CommandBufferType
     return command_list;
 }
 
-void Dx12Device::free_command_list(ID3D12GraphicsCommandList7* command_list, CommandBufferType type)
+void Dx12Device::free_command_list(
+    ID3D12GraphicsCommandList7* command_list,
+    CommandBufferType type,
+    uint32_t command_info_idx)
 {
-    const std::thread::id thread_id = std::this_thread::get_id();
+    const std::lock_guard lock(m_assign_thread_info_mutex);
 
-    ThreadCommandInfo::Type& thread_info = get_thread_command_info(thread_id, type);
+    ThreadCommandInfo& info = m_per_thread_command_info[command_info_idx];
+
+    ThreadCommandInfo::Type& thread_info = info.get_type(type);
     MIZU_ASSERT(!thread_info.command_allocators.empty(), "Could not select command allocator");
 
     MIZU_ASSERT(command_list != nullptr, "command_list can't be nullptr");
@@ -346,20 +358,20 @@ void Dx12Device::free_command_list(ID3D12GraphicsCommandList7* command_list, Com
     thread_info.available_command_buffers.push(command_list);
     thread_info.command_buffers_in_usage--;
 
-    if (thread_info.command_buffers_in_usage == 0)
+    if (info.command_buffers_in_usage() == 0)
     {
-        const std::lock_guard lock(m_assign_thread_info_mutex);
-
-        const auto it = m_thread_to_command_info_map.find(thread_id);
-        m_available_per_thread_command_info_idx.push(it->second);
-        m_thread_to_command_info_map.erase(it);
+        const auto it = m_thread_to_command_info_map.find(info.thread_id);
+        if (it != m_thread_to_command_info_map.end() && it->second == command_info_idx)
+        {
+            m_available_per_thread_command_info_idx.push(command_info_idx);
+            m_thread_to_command_info_map.erase(it);
+        }
     }
 }
 
 void Dx12Device::create_per_thread_command_info()
 {
     const uint32_t num_threads = std::thread::hardware_concurrency();
-    m_per_thread_command_info.reserve(num_threads);
 
     for (uint32_t i = 0; i < num_threads; ++i)
     {
@@ -406,13 +418,11 @@ Dx12Device::ThreadCommandInfo Dx12Device::create_thread_command_info()
     return info;
 }
 
-Dx12Device::ThreadCommandInfo::Type& Dx12Device::get_thread_command_info(std::thread::id id, CommandBufferType type)
+uint32_t Dx12Device::get_thread_command_info_idx(std::thread::id id)
 {
     auto it = m_thread_to_command_info_map.find(id);
     if (it == m_thread_to_command_info_map.end())
     {
-        const std::lock_guard lock(m_assign_thread_info_mutex);
-
         if (m_available_per_thread_command_info_idx.empty())
         {
             m_per_thread_command_info.push_back(create_thread_command_info());
@@ -422,17 +432,19 @@ Dx12Device::ThreadCommandInfo::Type& Dx12Device::get_thread_command_info(std::th
         const uint32_t next_idx = m_available_per_thread_command_info_idx.top();
         m_available_per_thread_command_info_idx.pop();
 
+        m_per_thread_command_info[next_idx].thread_id = id;
         it = m_thread_to_command_info_map.insert({id, next_idx}).first;
     }
 
-    ThreadCommandInfo& info = m_per_thread_command_info[it->second];
-    return info.get_type(type);
+    return it->second;
 }
 
 ID3D12CommandAllocator* Dx12Device::get_thread_command_allocator(CommandBufferType type, uint32_t frame_in_flight_idx)
 {
-    ThreadCommandInfo::Type& thread_info = get_thread_command_info(std::this_thread::get_id(), type);
-    return thread_info.command_allocators[frame_in_flight_idx];
+    const std::lock_guard lock(m_assign_thread_info_mutex);
+
+    const uint32_t command_info_idx = get_thread_command_info_idx(std::this_thread::get_id());
+    return m_per_thread_command_info[command_info_idx].get_type(type).command_allocators[frame_in_flight_idx];
 }
 
 void Dx12Device::create_queues()
@@ -510,6 +522,7 @@ void Dx12Device::prepare_frame(uint32_t frame_in_flight_idx)
 {
     Dx12Context.current_frame_in_flight_idx = frame_in_flight_idx;
 
+    const std::lock_guard lock(m_assign_thread_info_mutex);
     for (ThreadCommandInfo& info : m_per_thread_command_info)
     {
         info.graphics.command_allocators[frame_in_flight_idx]->Reset();
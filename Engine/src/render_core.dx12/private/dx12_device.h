@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <stack>
@@ -30,8 +31,12 @@ class Dx12Device : public Device
     ID3D12CommandQueue* get_compute_queue() const { return m_compute_queue; }
     ID3D12CommandQueue* get_transfer_queue() const { return m_transfer_queue; }
 
-    ID3D12GraphicsCommandList7* allocate_command_list(CommandBufferType type, uint32_t frame_in_flight_idx);
-    void free_command_list(ID3D12GraphicsCommandList7* command_list, CommandBufferType type);
+    // Command lists must be freed with the returned command info index, they can be freed from any thread
+    ID3D12GraphicsCommandList7* allocate_command_list(
+        CommandBufferType type,
+        uint32_t frame_in_flight_idx,
+        uint32_t& out_command_info_idx);
+    void free_command_list(ID3D12GraphicsCommandList7* command_list, CommandBufferType type, uint32_t command_info_idx);
 
     ID3D12CommandAllocator* get_thread_command_allocator(CommandBufferType type, uint32_t frame_in_flight_idx);
 
@@ -101,6 +106,14 @@ class Dx12Device : public Device
         Type compute;
         Type transfer;
 
+        std::thread::id thread_id{};
+
+        uint32_t command_buffers_in_usage() const
+        {
+            return graphics.command_buffers_in_usage + compute.command_buffers_in_usage
+                   + transfer.command_buffers_in_usage;
+        }
+
         Type& get_type(CommandBufferType type)
         {
             switch (type)
@@ -117,7 +130,8 @@ class Dx12Device : public Device
         }
     };
 
-    std::vector<ThreadCommandInfo> m_per_thread_command_info;
+    // Deque so the infos don't move when a new thread needs one
+    std::deque<ThreadCommandInfo> m_per_thread_command_info;
     std::stack<uint32_t> m_available_per_thread_command_info_idx;
     std::unordered_map<std::thread::id, uint32_t> m_thread_to_command_info_map;
     std::mutex m_assign_thread_info_mutex;
@@ -125,7 +139,8 @@ class Dx12Device : public Device
     void create_queues();
     void create_per_thread_command_info();
     ThreadCommandInfo create_thread_command_info();
-    ThreadCommandInfo::Type& get_thread_command_info(std::thread::id id, CommandBufferType type);
+    // Requires m_assign_thread_info_mutex to be locked
+    uint32_t get_thread_command_info_idx(std::thread::id id);
     void retrieve_device_capabilities();
 };
 
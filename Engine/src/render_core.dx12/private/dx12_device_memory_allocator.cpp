@@ -1,5 +1,7 @@
 #include "dx12_device_memory_allocator.h"
 
+#include <algorithm>
+
 #include "base/debug/logging.h"
 #include "base/debug/profiling.h"
 
@@ -147,6 +149,11 @@ void Dx12TransientMemoryPool::place_image(ImageResource& image, size_t offset)
     m_image_infos.emplace_back(native_image, native_image.get_memory_requirements().size, offset);
 }
 
+void Dx12TransientMemoryPool::reserve(size_t size)
+{
+    m_reserved_size = std::max(static_cast<uint64_t>(size), m_reserved_size);
+}
+
 void Dx12TransientMemoryPool::commit()
 {
     MIZU_PROFILE_SCOPED;
@@ -168,7 +175,9 @@ void Dx12TransientMemoryPool::commit()
         max_size = std::max(info.offset + info.size, max_size);
     }
 
-    if (max_size > m_size)
+    max_size = std::max(m_reserved_size, max_size);
+
+    if (m_heap == nullptr || max_size > m_size)
     {
         m_size = max_size;
 
@@ -187,6 +196,7 @@ void Dx12TransientMemoryPool::reset()
     Dx12Context.device->wait_idle();
 
     free_if_allocated();
+    m_reserved_size = 0;
 
     m_buffer_infos.clear();
     m_image_infos.clear();
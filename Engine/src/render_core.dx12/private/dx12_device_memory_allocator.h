@@ -37,6 +37,8 @@ class Dx12TransientMemoryPool : public TransientMemoryPool
     void place_buffer(BufferResource& buffer, size_t offset) override;
     void place_image(ImageResource& image, size_t offset) override;
 
+    void reserve(size_t size) override;
+
     void commit() override;
     void reset() override;
 
@@ -47,6 +49,7 @@ class Dx12TransientMemoryPool : public TransientMemoryPool
 
     ID3D12Heap* m_heap = nullptr;
     uint64_t m_size = 0;
+    uint64_t m_reserved_size = 0;
 
     struct MemoryInfo
     {
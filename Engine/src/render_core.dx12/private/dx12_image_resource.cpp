@@ -80,6 +80,8 @@ Dx12ImageResourceView Dx12ImageResource::as_rtv(const ImageResourceViewDescripti
 
     const size_t hash = hash_compute(desc.hash(), ResourceViewType::RenderTargetView);
 
+    const std::lock_guard lock{m_resource_views_mutex};
+
     const auto it = m_resource_views.find(hash);
     if (it != m_resource_views.end())
         return it->second;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 
 #include "render_core/rhi/device_memory_allocator.h"
@@ -52,6 +53,8 @@ class Dx12ImageResource : public ImageResource
     ID3D12Resource* m_resource = nullptr;
     D3D12_RESOURCE_DESC m_image_resource_description{};
 
+    // Views are requested by passes recorded on different threads
+    std::mutex m_resource_views_mutex;
     std::unordered_map<size_t, Dx12ImageResourceView> m_resource_views;
 
     ImageDescription m_description;
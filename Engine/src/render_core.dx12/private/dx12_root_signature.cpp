@@ -36,7 +36,9 @@ DescriptorSetLayoutHandle Dx12DescriptorSetLayoutCache::create(const DescriptorS
 
     const DescriptorSetLayoutHandle handle = DescriptorSetLayoutHandle{hash};
 
-    if (contains(handle))
+    const std::lock_guard lock{m_mutex};
+
+    if (m_cache.contains(handle))
     {
         return handle;
     }
@@ -69,13 +71,17 @@ DescriptorSetLayoutHandle Dx12DescriptorSetLayoutCache::create(const DescriptorS
 
 const Dx12DescriptorSetLayoutInfo& Dx12DescriptorSetLayoutCache::get(DescriptorSetLayoutHandle handle) const
 {
-    MIZU_ASSERT(contains(handle), "Dx12DescriptorSetLayoutCache does not contain handle {}", handle.id);
-    return m_cache.find(handle)->second;
+    const std::lock_guard lock{m_mutex};
+
+    const auto it = m_cache.find(handle);
+    MIZU_ASSERT(it != m_cache.end(), "Dx12DescriptorSetLayoutCache does not contain handle {}", handle.id);
+    return it->second;
 }
 
 bool Dx12DescriptorSetLayoutCache::contains(DescriptorSetLayoutHandle handle) const
 {
-    return m_cache.find(handle) != m_cache.end();
+    const std::lock_guard lock{m_mutex};
+    return m_cache.contains(handle);
 }
 
 //
@@ -111,7 +117,9 @@ PipelineLayoutHandle Dx12PipelineLayoutCache::create(const PipelineLayoutDescrip
 
     const PipelineLayoutHandle handle = PipelineLayoutHandle{hash};
 
-    if (contains(handle))
+    const std::lock_guard lock{m_mutex};
+
+    if (m_cache.contains(handle))
     {
         MIZU_LOG_WARNING("Pipeline layout with handle '{}' has already been created", hash);
         return handle;
@@ -319,22 +327,35 @@ PipelineLayoutHandle Dx12PipelineLayoutCache::create(const PipelineLayoutDescrip
 
 ID3D12RootSignature* Dx12PipelineLayoutCache::get(PipelineLayoutHandle handle) const
 {
-    MIZU_ASSERT(contains(handle), "Dx12PipelineLayoutCache does not contain handle {}", handle.id);
-    return m_cache.find(handle)->second;
+    const std::lock_guard lock{m_mutex};
+
+    const auto it = m_cache.find(handle);
+    MIZU_ASSERT(it != m_cache.end(), "Dx12PipelineLayoutCache does not contain handle {}", handle.id);
+    return it->second;
 }
 
 bool Dx12PipelineLayoutCache::contains(PipelineLayoutHandle handle) const
 {
-    return m_cache.find(handle) != m_cache.end();
+    const std::lock_guard lock{m_mutex};
+    return m_cache.contains(handle);
 }
 
 ID3D12CommandSignature* Dx12PipelineLayoutCache::get_draw_indirect_command_signature(PipelineLayoutHandle handle)
 {
+    const std::lock_guard lock{m_mutex};
+
     const auto it = m_draw_indirect_command_signature_cache.find(handle);
     if (it != m_draw_indirect_command_signature_cache.end())
         return it->second;
 
-    const Dx12RootSignatureInfo& root_signature_info = get_root_signature_info(handle);
+    const auto root_signature_it = m_cache.find(handle);
+    const auto root_signature_info_it = m_root_signature_info_cache.find(handle);
+    MIZU_ASSERT(
+        root_signature_it != m_cache.end() && root_signature_info_it != m_root_signature_info_cache.end(),
+        "Dx12PipelineLayoutCache does not contain handle {}",
+        handle.id);
+
+    const Dx12RootSignatureInfo& root_signature_info = root_signature_info_it->second;
 
     std::array<D3D12_INDIRECT_ARGUMENT_DESC, 2> argument_descs{};
     argument_descs[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
@@ -351,7 +372,7 @@ ID3D12CommandSignature* Dx12PipelineLayoutCache::get_draw_indirect_command_signa
 
     ID3D12CommandSignature* command_signature = nullptr;
     DX12_CHECK(Dx12Context.device->handle()->CreateCommandSignature(
-        &command_signature_desc, get(handle), IID_PPV_ARGS(&command_signature)));
+        &command_signature_desc, root_signature_it->second, IID_PPV_ARGS(&command_signature)));
 
     m_draw_indirect_command_signature_cache.insert({handle, command_signature});
 
@@ -360,6 +381,8 @@ ID3D12CommandSignature* Dx12PipelineLayoutCache::get_draw_indirect_command_signa
 
 const Dx12RootSignatureInfo& Dx12PipelineLayoutCache::get_root_signature_info(PipelineLayoutHandle handle) const
 {
+    const std::lock_guard lock{m_mutex};
+
     const auto it = m_root_signature_info_cache.find(handle);
     MIZU_ASSERT(
         it != m_root_signature_info_cache.end(), "Dx12PipelineLayoutCache does not contain handle {}", handle.id);
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <limits>
+#include <mutex>
 #include <unordered_map>
 
 #include "base/containers/inplace_vector.h"
@@ -29,6 +30,8 @@ class Dx12DescriptorSetLayoutCache
     bool contains(DescriptorSetLayoutHandle handle) const;
 
   private:
+    // Layouts are created and looked up by passes recorded on different threads
+    mutable std::mutex m_mutex;
     std::unordered_map<DescriptorSetLayoutHandle, Dx12DescriptorSetLayoutInfo> m_cache;
 };
 
@@ -65,6 +68,7 @@ class Dx12PipelineLayoutCache
     const Dx12RootSignatureInfo& get_root_signature_info(PipelineLayoutHandle handle) const;
 
   private:
+    mutable std::mutex m_mutex;
     std::unordered_map<PipelineLayoutHandle, ID3D12RootSignature*> m_cache;
     std::unordered_map<PipelineLayoutHandle, Dx12RootSignatureInfo> m_root_signature_info_cache;
     std::unordered_map<PipelineLayoutHandle, ID3D12CommandSignature*> m_draw_indirect_command_signature_cache;
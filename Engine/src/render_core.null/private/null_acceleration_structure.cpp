@@ -0,0 +1,47 @@
+#include "null_acceleration_structure.h"
+
+#include <algorithm>
+
+#include "base/debug/assert.h"
+#include "render_core/rhi/buffer_resource.h"
+
+#include "null_core.h"
+
+namespace Mizu::Null
+{
+
+// Size of D3D12_RAYTRACING_INSTANCE_DESC and VkAccelerationStructureInstanceKHR
+static constexpr uint64_t NULL_ACCELERATION_STRUCTURE_INSTANCE_SIZE = 64;
+
+NullAccelerationStructure::NullAccelerationStructure(AccelerationStructureDescription desc)
+    : m_description(std::move(desc))
+{
+    MIZU_ASSERT(
+        m_description.geometry.has_value(),
+        "Failed to create acceleration structure '{}', it has no geometry",
+        m_description.name);
+
+    // The sizes only need to be plausible, they are proportional to the size of the input geometry
+    uint64_t input_size = 0;
+    if (m_description.geometry.is_type<AccelerationStructureGeometry::TrianglesDescription>())
+    {
+        const auto& triangles = m_description.geometry.as_type<AccelerationStructureGeometry::TrianglesDescription>();
+
+        input_size = triangles.vertex_buffer->get_size();
+        if (triangles.index_buffer != nullptr)
+            input_size += triangles.index_buffer->get_size();
+    }
+    else
+    {
+        const auto& instances = m_description.geometry.as_type<AccelerationStructureGeometry::InstancesDescription>();
+        input_size = instances.max_instances * NULL_ACCELERATION_STRUCTURE_INSTANCE_SIZE;
+    }
+
+    const uint64_t size = null_align_up(std::max(input_size, uint64_t{1}), NULL_BUFFER_ALIGNMENT);
+
+    m_build_sizes.acceleration_structure_size = size;
+    m_build_sizes.build_scratch_size = size;
+    m_build_sizes.update_scratch_size = size;
+}
+
+} // namespace Mizu::Null
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "render_core/rhi/acceleration_structure.h"
+
+namespace Mizu::Null
+{
+
+class NullAccelerationStructure : public AccelerationStructure
+{
+  public:
+    NullAccelerationStructure(AccelerationStructureDescription desc);
+
+    AccelerationStructureBuildSizes get_build_sizes() const override { return m_build_sizes; }
+    AccelerationStructureType get_type() const override { return m_description.type; }
+
+  private:
+    AccelerationStructureDescription m_description{};
+    AccelerationStructureBuildSizes m_build_sizes{};
+};
+
+} // namespace Mizu::Null
@@ -0,0 +1,62 @@
+#include "null_buffer_resource.h"
+
+#include "base/debug/assert.h"
+
+#include "null_core.h"
+
+namespace Mizu::Null
+{
+
+NullBufferResource::NullBufferResource(const BufferDescription& desc) : m_description(desc)
+{
+    MIZU_ASSERT(m_description.size > 0, "Failed to create buffer '{}', size must be greater than 0", desc.name);
+
+    if (!m_description.is_virtual)
+    {
+        // Not value-initialized so the pages are only touched when the buffer is written
+        m_owned_memory = std::make_unique_for_overwrite<uint8_t[]>(m_description.size);
+        m_memory = m_owned_memory.get();
+
+        if (m_description.usage & BufferUsageBits::HostVisible)
+        {
+            map();
+        }
+    }
+}
+
+NullBufferResource::~NullBufferResource()
+{
+    unmap();
+}
+
+MemoryRequirements NullBufferResource::get_memory_requirements() const
+{
+    return get_null_buffer_memory_requirements(m_description);
+}
+
+uint8_t* NullBufferResource::map()
+{
+    MIZU_ASSERT(
+        m_description.usage & BufferUsageBits::HostVisible,
+        "Can't map buffer that does not have the HostVisible usage");
+    MIZU_ASSERT(m_memory != nullptr, "Can't map buffer '{}' that is not bound to memory", m_description.name);
+
+    m_mapped_data = m_memory;
+    return m_mapped_data;
+}
+
+void NullBufferResource::unmap()
+{
+    m_mapped_data = nullptr;
+}
+
+MemoryRequirements get_null_buffer_memory_requirements(const BufferDescription& desc)
+{
+    MemoryRequirements reqs{};
+    reqs.size = null_align_up(desc.size, NULL_BUFFER_ALIGNMENT);
+    reqs.alignment = NULL_BUFFER_ALIGNMENT;
+
+    return reqs;
+}
+
+} // namespace Mizu::Null
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+
+#include "render_core/rhi/buffer_resource.h"
+
+namespace Mizu::Null
+{
+
+class NullBufferResource : public BufferResource
+{
+  public:
+    NullBufferResource(const BufferDescription& desc);
+    ~NullBufferResource() override;
+
+    MemoryRequirements get_memory_requirements() const override;
+
+    using BufferResource::set_data;
+
+    uint8_t* get_mapped_data() const override { return m_mapped_data; }
+    uint8_t* map() override;
+    void unmap() override;
+
+    const BufferDescription& get_description() const override { return m_description; }
+
+    // CPU memory backing the buffer, nullptr if it's virtual and has not been placed in a committed pool yet
+    uint8_t* get_memory() const { return m_memory; }
+    void bind_memory(uint8_t* memory) { m_memory = memory; }
+
+  private:
+    BufferDescription m_description{};
+
+    std::unique_ptr<uint8_t[]> m_owned_memory;
+    uint8_t* m_memory = nullptr;
+    uint8_t* m_mapped_data = nullptr;
+};
+
+MemoryRequirements get_null_buffer_memory_requirements(const BufferDescription& desc);
+
+} // namespace Mizu::Null
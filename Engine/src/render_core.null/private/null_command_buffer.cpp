@@ -0,0 +1,394 @@
+#include "render_core.null/null_command_buffer.h"
+
+#include <cstring>
+
+#include "base/debug/assert.h"
+#include "base/debug/profiling.h"
+#include "render_core/rhi/acceleration_structure.h"
+#include "render_core/rhi/buffer_resource.h"
+#include "render_core/rhi/image_resource.h"
+
+#include "null_buffer_resource.h"
+#include "null_synchronization.h"
+
+namespace Mizu::Null
+{
+
+NullCommandBuffer::NullCommandBuffer(CommandBufferType type) : m_type(type) {}
+
+void NullCommandBuffer::begin()
+{
+    MIZU_ASSERT(!m_recording, "Command buffer is already recording");
+
+    m_commands.clear();
+    m_recording = true;
+}
+
+void NullCommandBuffer::end()
+{
+    MIZU_ASSERT(m_recording, "Command buffer is not recording");
+    MIZU_ASSERT(!m_render_pass_active, "Command buffer has a RenderPass that has not ended");
+
+    m_recording = false;
+}
+
+void NullCommandBuffer::submit(const CommandBufferSubmitInfo& info) const
+{
+    const CommandBuffer* command_buffer = this;
+    submit_ordered_internal(std::span(&command_buffer, 1), info);
+}
+
+void NullCommandBuffer::submit_ordered_internal(
+    std::span<const CommandBuffer* const> command_buffers,
+    const CommandBufferSubmitInfo& info) const
+{
+    MIZU_PROFILE_SCOPED;
+
+    // The submission runs to completion before returning, so the semaphores are already satisfied
+    for (const CommandBuffer* command_buffer : command_buffers)
+    {
+        const NullCommandBuffer& native_command_buffer = static_cast<const NullCommandBuffer&>(*command_buffer);
+        MIZU_ASSERT(native_command_buffer.m_type == m_type, "All submitted command buffers must have the same type");
+        MIZU_ASSERT(!native_command_buffer.m_recording, "Can't submit a command buffer that is still recording");
+
+        native_command_buffer.execute();
+    }
+
+    if (info.signal_fence != nullptr)
+    {
+        std::static_pointer_cast<NullFence>(info.signal_fence)->signal();
+    }
+}
+
+void NullCommandBuffer::bind_descriptor_set(std::shared_ptr<DescriptorSet> descriptor_set, uint32_t set)
+{
+    record(NullBindDescriptorSetCmd{.descriptor_set = descriptor_set.get(), .set = set});
+}
+
+void NullCommandBuffer::push_constant(uint32_t size, const void* data) const
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    record(NullPushConstantCmd{.data = std::vector<uint8_t>(bytes, bytes + size)});
+}
+
+void NullCommandBuffer::begin_render_pass(const RenderPassInfo& info)
+{
+    MIZU_ASSERT(!m_render_pass_active, "Can't begin a RenderPass while another one is active");
+
+    m_render_pass_active = true;
+    record(NullBeginRenderPassCmd{.info = info});
+}
+
+void NullCommandBuffer::end_render_pass()
+{
+    MIZU_ASSERT(m_render_pass_active, "Can't end a RenderPass because no RenderPass is active");
+
+    m_render_pass_active = false;
+    record(NullEndRenderPassCmd{});
+}
+
+void NullCommandBuffer::bind_pipeline(std::shared_ptr<Pipeline> pipeline)
+{
+    record(NullBindPipelineCmd{.pipeline = pipeline.get()});
+}
+
+void NullCommandBuffer::bind_vertex_buffer(const BufferResource& vertex_buffer, uint64_t offset)
+{
+    record(NullBindVertexBufferCmd{.buffer = &vertex_buffer, .offset = offset});
+}
+
+void NullCommandBuffer::bind_index_buffer(const BufferResource& index_buffer, IndexBufferFormat format, uint64_t offset)
+{
+    record(NullBindIndexBufferCmd{.buffer = &index_buffer, .format = format, .offset = offset});
+}
+
+void NullCommandBuffer::draw(
+    uint32_t vertex_count,
+    uint32_t first_vertex,
+    uint32_t instance_count,
+    uint32_t first_instance)
+{
+    MIZU_ASSERT(m_render_pass_active, "Can't draw because no RenderPass is active");
+
+    record(NullDrawCmd{
+        .vertex_count = vertex_count,
+        .first_vertex = first_vertex,
+        .instance_count = instance_count,
+        .first_instance = first_instance,
+    });
+}
+
+void NullCommandBuffer::draw_indexed(
+    uint32_t index_count,
+    uint32_t first_index,
+    uint32_t first_vertex,
+    uint32_t instance_count,
+    uint32_t first_instance)
+{
+    MIZU_ASSERT(m_render_pass_active, "Can't draw_indexed because no RenderPass is active");
+
+    record(NullDrawIndexedCmd{
+        .index_count = index_count,
+        .first_index = first_index,
+        .first_vertex = first_vertex,
+        .instance_count = instance_count,
+        .first_instance = first_instance,
+    });
+}
+
+void NullCommandBuffer::draw(const BufferResource& vertex) const
+{
+    draw_instanced(vertex, 1);
+}
+
+void NullCommandBuffer::draw_indexed(const BufferResource& vertex, const BufferResource& index) const
+{
+    draw_indexed_instanced(vertex, index, 1);
+}
+
+void NullCommandBuffer::draw_instanced(const BufferResource& vertex, uint32_t instance_count) const
+{
+    MIZU_ASSERT(m_render_pass_active, "Can't draw_instanced because no RenderPass is active");
+
+    const uint32_t vertex_count = static_cast<uint32_t>(vertex.get_size() / vertex.get_stride());
+
+    record(NullBindVertexBufferCmd{.buffer = &vertex, .offset = 0});
+    record(NullDrawCmd{
+        .vertex_count = vertex_count,
+        .first_vertex = 0,
+        .instance_count = instance_count,
+        .first_instance = 0,
+    });
+}
+
+void NullCommandBuffer::draw_indexed_instanced(
+    const BufferResource& vertex,
+    const BufferResource& index,
+    uint32_t instance_count) const
+{
+    MIZU_ASSERT(m_render_pass_active, "Can't draw_indexed_instanced because no RenderPass is active");
+
+    const uint32_t index_count = static_cast<uint32_t>(index.get_size() / sizeof(uint32_t));
+
+    record(NullBindVertexBufferCmd{.buffer = &vertex, .offset = 0});
+    record(NullBindIndexBufferCmd{.buffer = &index, .format = IndexBufferFormat::UInt32, .offset = 0});
+    record(NullDrawIndexedCmd{
+        .index_count = index_count,
+        .first_index = 0,
+        .first_vertex = 0,
+        .instance_count = instance_count,
+        .first_instance = 0,
+    });
+}
+
+void NullCommandBuffer::draw_indexed_indirect(
+    const BufferResource& buffer,
+    uint64_t offset,
+    uint32_t draw_count,
+    uint32_t stride) const
+{
+    MIZU_ASSERT(m_render_pass_active, "Can't draw_indexed_indirect because no RenderPass is active");
+
+    record(NullDrawIndexedIndirectCmd{
+        .buffer = &buffer,
+        .offset = offset,
+        .count_buffer = nullptr,
+        .count_buffer_offset = 0,
+        .max_draw_count = draw_count,
+        .stride = stride,
+    });
+}
+
+void NullCommandBuffer::draw_indexed_indirect_count(
+    const BufferResource& buffer,
+    uint64_t offset,
+    const BufferResource& count_buffer,
+    uint64_t count_buffer_offset,
+    uint32_t max_draw_count,
+    uint32_t stride) const
+{
+    MIZU_ASSERT(m_render_pass_active, "Can't draw_indexed_indirect_count because no RenderPass is active");
+
+    record(NullDrawIndexedIndirectCmd{
+        .buffer = &buffer,
+        .offset = offset,
+        .count_buffer = &count_buffer,
+        .count_buffer_offset = count_buffer_offset,
+        .max_draw_count = max_draw_count,
+        .stride = stride,
+    });
+}
+
+void NullCommandBuffer::dispatch(glm::uvec3 group_count) const
+{
+    MIZU_ASSERT(!m_render_pass_active, "Can't dispatch while a RenderPass is active");
+
+    record(NullDispatchCmd{.group_count = group_count});
+}
+
+void NullCommandBuffer::trace_rays(glm::uvec3 dimensions) const
+{
+    record(NullTraceRaysCmd{.dimensions = dimensions});
+}
+
+void NullCommandBuffer::transition_resource(const BufferResource& buffer, const BufferTransitionInfo& info) const
+{
+    const BufferTransition transition{.buffer = &buffer, .info = info};
+    transition_resources(ResourceTransitionBatch{.buffers = std::span(&transition, 1)});
+}
+
+void NullCommandBuffer::transition_resource(const ImageResource& image, const ImageTransitionInfo& info) const
+{
+    const ImageTransition transition{.image = &image, .info = info};
+    transition_resources(ResourceTransitionBatch{.images = std::span(&transition, 1)});
+}
+
+void NullCommandBuffer::transition_resource(
+    const AccelerationStructure& accel_struct,
+    const AccelerationStructureTransitionInfo& info) const
+{
+    const AccelerationStructureTransition transition{.accel_struct = &accel_struct, .info = info};
+    transition_resources(ResourceTransitionBatch{.accel_structs = std::span(&transition, 1)});
+}
+
+void NullCommandBuffer::transition_resources(const ResourceTransitionBatch& batch) const
+{
+    if (batch.size() == 0)
+        return;
+
+    record(NullBarrierCmd{
+        .buffer_transitions = std::vector(batch.buffers.begin(), batch.buffers.end()),
+        .image_transitions = std::vector(batch.images.begin(), batch.images.end()),
+        .accel_struct_transitions = std::vector(batch.accel_structs.begin(), batch.accel_structs.end()),
+    });
+}
+
+void NullCommandBuffer::copy_buffer_to_buffer(
+    const BufferResource& source,
+    const BufferResource& dest,
+    const CopyBufferToBufferInfo& info) const
+{
+    MIZU_ASSERT(info.src_offset + info.size <= source.get_size(), "Copy is out of the bounds of the source buffer");
+    MIZU_ASSERT(info.dst_offset + info.size <= dest.get_size(), "Copy is out of the bounds of the destination buffer");
+
+    record(NullCopyBufferToBufferCmd{.source = &source, .dest = &dest, .info = info});
+}
+
+void NullCommandBuffer::copy_image_to_image(
+    const ImageResource& source,
+    const ImageResource& dest,
+    const CopyImageToImageInfo& info) const
+{
+    record(NullCopyImageToImageCmd{.source = &source, .dest = &dest, .info = info});
+}
+
+void NullCommandBuffer::copy_buffer_to_image(
+    const BufferResource& buffer,
+    const ImageResource& image,
+    const CopyBufferToImageInfo& info) const
+{
+    record(NullCopyBufferToImageCmd{.buffer = &buffer, .image = &image, .info = info});
+}
+
+void NullCommandBuffer::copy_image_to_buffer(
+    const ImageResource& image,
+    const BufferResource& buffer,
+    const CopyImageToBufferInfo& info) const
+{
+    record(NullCopyImageToBufferCmd{.image = &image, .buffer = &buffer, .info = info});
+}
+
+void NullCommandBuffer::build_blas(const AccelerationStructure& blas, const BufferResource& scratch_buffer) const
+{
+    MIZU_ASSERT(blas.get_type() == AccelerationStructureType::BottomLevel, "Acceleration structure is not a BLAS");
+
+    record(NullBuildAccelerationStructureCmd{
+        .accel_struct = &blas,
+        .scratch_buffer = &scratch_buffer,
+        .num_instances = 0,
+        .update = false,
+    });
+}
+
+void NullCommandBuffer::build_tlas(
+    const AccelerationStructure& tlas,
+    std::span<AccelerationStructureInstanceData> instances,
+    const BufferResource& scratch_buffer) const
+{
+    MIZU_ASSERT(tlas.get_type() == AccelerationStructureType::TopLevel, "Acceleration structure is not a TLAS");
+
+    record(NullBuildAccelerationStructureCmd{
+        .accel_struct = &tlas,
+        .scratch_buffer = &scratch_buffer,
+        .num_instances = static_cast<uint32_t>(instances.size()),
+        .update = false,
+    });
+}
+
+void NullCommandBuffer::update_tlas(
+    const AccelerationStructure& tlas,
+    std::span<AccelerationStructureInstanceData> instances,
+    const BufferResource& scratch_buffer) const
+{
+    MIZU_ASSERT(tlas.get_type() == AccelerationStructureType::TopLevel, "Acceleration structure is not a TLAS");
+
+    record(NullBuildAccelerationStructureCmd{
+        .accel_struct = &tlas,
+        .scratch_buffer = &scratch_buffer,
+        .num_instances = static_cast<uint32_t>(instances.size()),
+        .update = true,
+    });
+}
+
+void NullCommandBuffer::fill_buffer(const BufferResource& buffer, uint64_t size, uint64_t offset, uint32_t data) const
+{
+    MIZU_ASSERT(offset + size <= buffer.get_size(), "Fill is out of the bounds of the buffer");
+    MIZU_ASSERT(size % sizeof(uint32_t) == 0, "Fill size must be a multiple of 4");
+
+    record(NullFillBufferCmd{.buffer = &buffer, .size = size, .offset = offset, .data = data});
+}
+
+void NullCommandBuffer::begin_gpu_marker(std::string_view label) const
+{
+    record(NullBeginGpuMarkerCmd{.label = std::string{label}});
+}
+
+void NullCommandBuffer::end_gpu_marker() const
+{
+    record(NullEndGpuMarkerCmd{});
+}
+
+void NullCommandBuffer::record(NullCommand command) const
+{
+    MIZU_ASSERT(m_recording, "Can't record commands into a command buffer that is not recording");
+    m_commands.push_back(std::move(command));
+}
+
+void NullCommandBuffer::execute() const
+{
+    m_num_submissions += 1;
+
+    for (const NullCommand& command : m_commands)
+    {
+        if (const auto* copy = std::get_if<NullCopyBufferToBufferCmd>(&command))
+        {
+            const uint8_t* source = static_cast<const NullBufferResource&>(*copy->source).get_memory();
+            uint8_t* dest = static_cast<const NullBufferResource&>(*copy->dest).get_memory();
+            MIZU_ASSERT(source != nullptr && dest != nullptr, "Copying between buffers that are not bound to memory");
+
+            std::memmove(dest + copy->info.dst_offset, source + copy->info.src_offset, copy->info.size);
+        }
+        else if (const auto* fill = std::get_if<NullFillBufferCmd>(&command))
+        {
+            uint8_t* dest = static_cast<const NullBufferResource&>(*fill->buffer).get_memory();
+            MIZU_ASSERT(dest != nullptr, "Filling a buffer that is not bound to memory");
+
+            for (uint64_t offset = 0; offset < fill->size; offset += sizeof(uint32_t))
+            {
+                std::memcpy(dest + fill->offset + offset, &fill->data, sizeof(uint32_t));
+            }
+        }
+    }
+}
+
+} // namespace Mizu::Null
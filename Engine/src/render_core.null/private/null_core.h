@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Mizu::Null
+{
+
+inline constexpr uint64_t NULL_BUFFER_ALIGNMENT = 256;
+// Matches the default placement alignment of D3D12 textures
+inline constexpr uint64_t NULL_IMAGE_ALIGNMENT = 64 * 1024;
+
+inline uint64_t null_align_up(uint64_t value, uint64_t alignment)
+{
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+} // namespace Mizu::Null
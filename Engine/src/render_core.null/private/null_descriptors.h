@@ -0,0 +1,32 @@
+#pragma once
+
+#include "render_core/rhi/descriptors.h"
+
+namespace Mizu::Null
+{
+
+class NullDescriptorSet : public DescriptorSet
+{
+  public:
+    NullDescriptorSet(DescriptorSetLayoutHandle layout, DescriptorSetAllocationType type)
+        : m_layout(layout)
+        , m_type(type)
+    {
+    }
+
+    void update(std::span<const WriteDescriptor> writes, [[maybe_unused]] uint32_t array_offset = 0) override
+    {
+        m_num_writes += writes.size();
+    }
+
+    DescriptorSetLayoutHandle get_layout() const { return m_layout; }
+    DescriptorSetAllocationType get_allocation_type() const { return m_type; }
+    size_t get_num_writes() const { return m_num_writes; }
+
+  private:
+    DescriptorSetLayoutHandle m_layout;
+    DescriptorSetAllocationType m_type;
+    size_t m_num_writes = 0;
+};
+
+} // namespace Mizu::Null
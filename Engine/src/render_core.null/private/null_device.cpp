@@ -0,0 +1,179 @@
+#include "null_device.h"
+
+#include "base/debug/assert.h"
+#include "base/utils/hash.h"
+#include "render_core/rhi/pipeline.h"
+
+#include "mizu_render_core_null_module.h"
+#include "null_acceleration_structure.h"
+#include "null_buffer_resource.h"
+#include "null_core.h"
+#include "null_descriptors.h"
+#include "null_device_memory_allocator.h"
+#include "null_image_resource.h"
+#include "null_pipeline.h"
+#include "null_sampler_state.h"
+#include "null_shader.h"
+#include "null_swapchain.h"
+#include "null_synchronization.h"
+#include "render_core.null/null_command_buffer.h"
+
+namespace Mizu::Null
+{
+
+NullDevice::NullDevice(const DeviceCreationDescription& desc)
+{
+    NullSpecificConfiguration config{};
+    if (std::holds_alternative<NullSpecificConfiguration>(desc.specific_config))
+    {
+        config = std::get<NullSpecificConfiguration>(desc.specific_config);
+    }
+
+    m_properties.name = "Null Device";
+    m_properties.depth_clamp_enabled = true;
+    m_properties.async_compute = config.async_compute;
+    m_properties.async_transfer = config.async_transfer;
+    m_properties.ray_tracing_hardware = config.ray_tracing_hardware;
+    m_properties.min_constant_buffer_offset_alignment = NULL_BUFFER_ALIGNMENT;
+    m_properties.min_raw_buffer_offset_alignment = 16;
+}
+
+//
+// Operations
+//
+
+void NullDevice::prepare_frame([[maybe_unused]] uint32_t frame_in_flight_idx) {}
+
+void NullDevice::wait_idle() const {}
+
+//
+// Creation functions
+//
+
+std::shared_ptr<BufferResource> NullDevice::create_buffer(const BufferDescription& desc) const
+{
+    return std::make_shared<NullBufferResource>(desc);
+}
+
+std::shared_ptr<ImageResource> NullDevice::create_image(const ImageDescription& desc) const
+{
+    return std::make_shared<NullImageResource>(desc);
+}
+
+std::shared_ptr<AccelerationStructure> NullDevice::create_acceleration_structure(
+    const AccelerationStructureDescription& desc) const
+{
+    return std::make_shared<NullAccelerationStructure>(desc);
+}
+
+std::shared_ptr<CommandBuffer> NullDevice::create_command_buffer(CommandBufferType type) const
+{
+    return std::make_shared<NullCommandBuffer>(type);
+}
+
+std::shared_ptr<Shader> NullDevice::create_shader(const ShaderDescription& desc) const
+{
+    return std::make_shared<NullShader>(desc);
+}
+
+std::shared_ptr<SamplerState> NullDevice::create_sampler_state(const SamplerStateDescription& desc) const
+{
+    return std::make_shared<NullSamplerState>(desc);
+}
+
+std::shared_ptr<Pipeline> NullDevice::create_pipeline(const GraphicsPipelineDescription& desc) const
+{
+    MIZU_ASSERT(
+        desc.vertex_shader != nullptr && desc.fragment_shader != nullptr,
+        "Graphics pipeline requires a vertex and a fragment shader");
+    return std::make_shared<NullPipeline>(PipelineType::Graphics, desc.layout);
+}
+
+std::shared_ptr<Pipeline> NullDevice::create_pipeline(const ComputePipelineDescription& desc) const
+{
+    MIZU_ASSERT(desc.compute_shader != nullptr, "Compute pipeline requires a compute shader");
+    return std::make_shared<NullPipeline>(PipelineType::Compute, desc.layout);
+}
+
+std::shared_ptr<Pipeline> NullDevice::create_pipeline(const RayTracingPipelineDescription& desc) const
+{
+    MIZU_ASSERT(desc.raygen_shader != nullptr, "Ray tracing pipeline requires a raygen shader");
+    return std::make_shared<NullPipeline>(PipelineType::RayTracing, desc.layout);
+}
+
+// Like the other backends, layouts are identified by the hash of their description
+DescriptorSetLayoutHandle NullDevice::create_descriptor_set_layout(const DescriptorSetLayoutDescription& desc) const
+{
+    size_t hash = 0;
+    for (const DescriptorItem& item : desc.layout)
+    {
+        hash_combine(hash, item.hash());
+    }
+
+    return DescriptorSetLayoutHandle{hash};
+}
+
+PipelineLayoutHandle NullDevice::create_pipeline_layout(const PipelineLayoutDescription& desc) const
+{
+    size_t hash = 0;
+    for (const DescriptorSetLayoutHandle& set_layout : desc.set_layouts)
+    {
+        hash_combine(hash, set_layout.id);
+    }
+
+    if (desc.push_constant.has_value())
+    {
+        hash_combine(hash, desc.push_constant->hash());
+    }
+
+    return PipelineLayoutHandle{hash};
+}
+
+std::shared_ptr<DescriptorSet> NullDevice::allocate_descriptor_set(
+    DescriptorSetLayoutHandle layout,
+    DescriptorSetAllocationType type,
+    [[maybe_unused]] uint32_t variable_count) const
+{
+    return std::make_shared<NullDescriptorSet>(layout, type);
+}
+
+std::shared_ptr<Semaphore> NullDevice::create_semaphore() const
+{
+    return std::make_shared<NullSemaphore>();
+}
+
+std::shared_ptr<Fence> NullDevice::create_fence(bool signaled) const
+{
+    return std::make_shared<NullFence>(signaled);
+}
+
+std::shared_ptr<Swapchain> NullDevice::create_swapchain(const SwapchainDescription& desc) const
+{
+    return std::make_shared<NullSwapchain>(desc);
+}
+
+std::shared_ptr<TransientMemoryPool> NullDevice::create_transient_memory_pool(std::string_view name) const
+{
+    return std::make_shared<NullTransientMemoryPool>(name);
+}
+
+//
+// Other
+//
+
+MemoryRequirements NullDevice::get_buffer_memory_requirements(const BufferDescription& desc) const
+{
+    return get_null_buffer_memory_requirements(desc);
+}
+
+MemoryRequirements NullDevice::get_image_memory_requirements(const ImageDescription& desc) const
+{
+    return get_null_image_memory_requirements(desc);
+}
+
+} // namespace Mizu::Null
+
+extern "C" MIZU_RENDER_CORE_NULL_API Mizu::Device* create_rhi_device(const Mizu::DeviceCreationDescription& desc)
+{
+    return new Mizu::Null::NullDevice{desc};
+}
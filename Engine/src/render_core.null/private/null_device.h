@@ -0,0 +1,60 @@
+#pragma once
+
+#include "render_core/rhi/device.h"
+
+namespace Mizu::Null
+{
+
+class NullDevice : public Device
+{
+  public:
+    NullDevice(const DeviceCreationDescription& desc);
+
+    GraphicsApi get_api() const override { return GraphicsApi::Null; }
+    const DeviceProperties& get_properties() const override { return m_properties; }
+
+    // Operations
+
+    void prepare_frame(uint32_t frame_in_flight_idx) override;
+    void wait_idle() const override;
+
+    // Creation functions
+
+    std::shared_ptr<BufferResource> create_buffer(const BufferDescription& desc) const override;
+    std::shared_ptr<ImageResource> create_image(const ImageDescription& desc) const override;
+    std::shared_ptr<AccelerationStructure> create_acceleration_structure(
+        const AccelerationStructureDescription& desc) const override;
+
+    std::shared_ptr<CommandBuffer> create_command_buffer(CommandBufferType type) const override;
+    std::shared_ptr<Shader> create_shader(const ShaderDescription& desc) const override;
+    std::shared_ptr<SamplerState> create_sampler_state(const SamplerStateDescription& desc) const override;
+
+    std::shared_ptr<Pipeline> create_pipeline(const GraphicsPipelineDescription& desc) const override;
+    std::shared_ptr<Pipeline> create_pipeline(const ComputePipelineDescription& desc) const override;
+    std::shared_ptr<Pipeline> create_pipeline(const RayTracingPipelineDescription& desc) const override;
+
+    DescriptorSetLayoutHandle create_descriptor_set_layout(const DescriptorSetLayoutDescription& desc) const override;
+    PipelineLayoutHandle create_pipeline_layout(const PipelineLayoutDescription& desc) const override;
+
+    std::shared_ptr<DescriptorSet> allocate_descriptor_set(
+        DescriptorSetLayoutHandle layout,
+        DescriptorSetAllocationType type,
+        uint32_t variable_count = 0) const override;
+
+    std::shared_ptr<Semaphore> create_semaphore() const override;
+    std::shared_ptr<Fence> create_fence(bool signaled) const override;
+
+    std::shared_ptr<Swapchain> create_swapchain(const SwapchainDescription& desc) const override;
+
+    std::shared_ptr<TransientMemoryPool> create_transient_memory_pool(std::string_view name = "") const override;
+
+    // Other
+
+    MemoryRequirements get_buffer_memory_requirements(const BufferDescription& desc) const override;
+    MemoryRequirements get_image_memory_requirements(const ImageDescription& desc) const override;
+
+  private:
+    DeviceProperties m_properties{};
+};
+
+} // namespace Mizu::Null
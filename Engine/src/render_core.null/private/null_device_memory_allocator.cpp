@@ -0,0 +1,73 @@
+#include "null_device_memory_allocator.h"
+
+#include <algorithm>
+
+#include "base/debug/profiling.h"
+
+#include "null_buffer_resource.h"
+#include "null_image_resource.h"
+
+namespace Mizu::Null
+{
+
+NullTransientMemoryPool::NullTransientMemoryPool(std::string_view name) : m_name(name) {}
+
+void NullTransientMemoryPool::place_buffer(BufferResource& buffer, size_t offset)
+{
+    NullBufferResource& native_buffer = static_cast<NullBufferResource&>(buffer);
+
+    const MemoryRequirements reqs = native_buffer.get_memory_requirements();
+    m_required_size = std::max(offset + reqs.size, m_required_size);
+
+    m_buffer_infos.push_back(BufferInfo{native_buffer, offset});
+}
+
+void NullTransientMemoryPool::place_image(ImageResource& image, size_t offset)
+{
+    const MemoryRequirements reqs = image.get_memory_requirements();
+    m_required_size = std::max(offset + reqs.size, m_required_size);
+}
+
+void NullTransientMemoryPool::reserve(size_t size)
+{
+    m_reserved_size = std::max(size, m_reserved_size);
+}
+
+void NullTransientMemoryPool::commit()
+{
+    MIZU_PROFILE_SCOPED;
+
+    if (m_required_size == 0)
+    {
+        return;
+    }
+
+    const size_t size = std::max(m_reserved_size, m_required_size);
+
+    if (m_memory == nullptr || size > m_size)
+    {
+        m_size = size;
+        m_memory = std::make_unique_for_overwrite<uint8_t[]>(m_size);
+    }
+
+    // Always rebind, the memory may have been reallocated since the buffer was last placed
+    for (const BufferInfo& info : m_buffer_infos)
+    {
+        info.buffer.bind_memory(m_memory.get() + info.offset);
+    }
+
+    m_buffer_infos.clear();
+    m_required_size = 0;
+}
+
+void NullTransientMemoryPool::reset()
+{
+    m_memory = nullptr;
+    m_size = 0;
+    m_reserved_size = 0;
+
+    m_buffer_infos.clear();
+    m_required_size = 0;
+}
+
+} // namespace Mizu::Null
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "render_core/rhi/device_memory_allocator.h"
+
+namespace Mizu::Null
+{
+
+// Forward declarations
+class NullBufferResource;
+
+// Placed buffers alias the CPU memory of the pool, so writes to overlapping resources are visible to each other
+class NullTransientMemoryPool : public TransientMemoryPool
+{
+  public:
+    NullTransientMemoryPool(std::string_view name = "");
+
+    void place_buffer(BufferResource& buffer, size_t offset) override;
+    void place_image(ImageResource& image, size_t offset) override;
+
+    void reserve(size_t size) override;
+
+    void commit() override;
+    void reset() override;
+
+    size_t get_committed_size() const override { return m_size; }
+
+    std::string_view get_name() const { return m_name; }
+
+  private:
+    std::unique_ptr<uint8_t[]> m_memory;
+    size_t m_size = 0;
+    size_t m_reserved_size = 0;
+    std::string m_name;
+
+    struct BufferInfo
+    {
+        NullBufferResource& buffer;
+        size_t offset;
+    };
+
+    std::vector<BufferInfo> m_buffer_infos;
+    // Only the size of the placed images is tracked, they don't have CPU memory
+    size_t m_required_size = 0;
+};
+
+} // namespace Mizu::Null
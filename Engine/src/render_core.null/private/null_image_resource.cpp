@@ -0,0 +1,57 @@
+#include "null_image_resource.h"
+
+#include <algorithm>
+
+#include "base/debug/assert.h"
+
+#include "null_core.h"
+
+namespace Mizu::Null
+{
+
+NullImageResource::NullImageResource(const ImageDescription& desc) : m_description(desc)
+{
+    MIZU_ASSERT(
+        m_description.width > 0 && m_description.height > 0 && m_description.depth > 0,
+        "Failed to create image '{}', all dimensions must be greater than 0",
+        m_description.name);
+    MIZU_ASSERT(m_description.num_mips > 0, "Failed to create image '{}', it must have at least one mip", desc.name);
+}
+
+MemoryRequirements NullImageResource::get_memory_requirements() const
+{
+    return get_null_image_memory_requirements(m_description);
+}
+
+ImageMemoryRequirements NullImageResource::get_image_memory_requirements() const
+{
+    ImageMemoryRequirements reqs{};
+    reqs.size = get_memory_requirements().size;
+    reqs.offset = 0;
+    reqs.row_pitch = static_cast<size_t>(m_description.width) * get_image_format_size(m_description.format);
+
+    return reqs;
+}
+
+MemoryRequirements get_null_image_memory_requirements(const ImageDescription& desc)
+{
+    const uint64_t texel_size = get_image_format_size(desc.format);
+
+    uint64_t size = 0;
+    for (uint32_t mip = 0; mip < desc.num_mips; ++mip)
+    {
+        const uint64_t width = std::max(desc.width >> mip, 1u);
+        const uint64_t height = std::max(desc.height >> mip, 1u);
+        const uint64_t depth = std::max(desc.depth >> mip, 1u);
+
+        size += width * height * depth * texel_size;
+    }
+
+    MemoryRequirements reqs{};
+    reqs.size = null_align_up(size * desc.num_layers, NULL_IMAGE_ALIGNMENT);
+    reqs.alignment = NULL_IMAGE_ALIGNMENT;
+
+    return reqs;
+}
+
+} // namespace Mizu::Null
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "render_core/rhi/image_resource.h"
+
+namespace Mizu::Null
+{
+
+// Images don't have CPU memory, only their memory requirements are emulated
+class NullImageResource : public ImageResource
+{
+  public:
+    NullImageResource(const ImageDescription& desc);
+
+    MemoryRequirements get_memory_requirements() const override;
+    ImageMemoryRequirements get_image_memory_requirements() const override;
+
+    const ImageDescription& get_description() const override { return m_description; }
+
+  private:
+    ImageDescription m_description{};
+};
+
+MemoryRequirements get_null_image_memory_requirements(const ImageDescription& desc);
+
+} // namespace Mizu::Null
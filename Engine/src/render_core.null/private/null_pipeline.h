@@ -0,0 +1,21 @@
+#pragma once
+
+#include "render_core/rhi/pipeline.h"
+
+namespace Mizu::Null
+{
+
+class NullPipeline : public Pipeline
+{
+  public:
+    NullPipeline(PipelineType type, PipelineLayoutHandle layout) : m_type(type), m_layout(layout) {}
+
+    PipelineType get_pipeline_type() const override { return m_type; }
+    PipelineLayoutHandle get_layout() const { return m_layout; }
+
+  private:
+    PipelineType m_type;
+    PipelineLayoutHandle m_layout;
+};
+
+} // namespace Mizu::Null
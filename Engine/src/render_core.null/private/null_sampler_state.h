@@ -0,0 +1,19 @@
+#pragma once
+
+#include "render_core/rhi/sampler_state.h"
+
+namespace Mizu::Null
+{
+
+class NullSamplerState : public SamplerState
+{
+  public:
+    NullSamplerState(SamplerStateDescription desc) : m_description(desc) {}
+
+    const SamplerStateDescription& get_description() const { return m_description; }
+
+  private:
+    SamplerStateDescription m_description{};
+};
+
+} // namespace Mizu::Null
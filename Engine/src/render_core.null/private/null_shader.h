@@ -0,0 +1,21 @@
+#pragma once
+
+#include "render_core/rhi/shader.h"
+
+namespace Mizu::Null
+{
+
+// The bytecode is never loaded, so the path doesn't need to exist
+class NullShader : public Shader
+{
+  public:
+    NullShader(ShaderDescription desc) : m_description(std::move(desc)) {}
+
+    const std::string& get_entry_point() const override { return m_description.entry_point; }
+    ShaderType get_type() const override { return m_description.type; }
+
+  private:
+    ShaderDescription m_description{};
+};
+
+} // namespace Mizu::Null
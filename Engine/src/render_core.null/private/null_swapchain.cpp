@@ -0,0 +1,61 @@
+#include "null_swapchain.h"
+
+#include <format>
+
+#include "base/debug/assert.h"
+#include "render_core/definitions/rhi_window.h"
+
+#include "null_image_resource.h"
+#include "null_synchronization.h"
+
+namespace Mizu::Null
+{
+
+static constexpr uint32_t NULL_SWAPCHAIN_DEFAULT_IMAGE_COUNT = 3;
+
+NullSwapchain::NullSwapchain(SwapchainDescription desc) : m_description(std::move(desc))
+{
+    const uint32_t width = m_description.window != nullptr ? m_description.window->get_width() : 1;
+    const uint32_t height = m_description.window != nullptr ? m_description.window->get_height() : 1;
+
+    const uint32_t image_count = m_description.desired_image_count != 0 ? m_description.desired_image_count
+                                                                        : NULL_SWAPCHAIN_DEFAULT_IMAGE_COUNT;
+
+    for (uint32_t i = 0; i < image_count; ++i)
+    {
+        ImageDescription image_desc{};
+        image_desc.width = width;
+        image_desc.height = height;
+        image_desc.type = ImageType::Image2D;
+        image_desc.format = m_description.format;
+        image_desc.usage = m_description.usage;
+        image_desc.name = std::format("SwapchainImage_{}", i);
+
+        m_images.push_back(std::make_shared<NullImageResource>(image_desc));
+    }
+
+    // The first acquire returns the first image
+    m_current_image_idx = image_count - 1;
+}
+
+void NullSwapchain::acquire_next_image(
+    [[maybe_unused]] std::shared_ptr<Semaphore> signal_semaphore,
+    std::shared_ptr<Fence> signal_fence)
+{
+    m_current_image_idx = (m_current_image_idx + 1) % get_num_images();
+
+    if (signal_fence != nullptr)
+    {
+        std::static_pointer_cast<NullFence>(signal_fence)->signal();
+    }
+}
+
+void NullSwapchain::present([[maybe_unused]] std::span<std::shared_ptr<Semaphore>> wait_semaphores) {}
+
+std::shared_ptr<ImageResource> NullSwapchain::get_image(uint32_t idx) const
+{
+    MIZU_ASSERT(idx < m_images.size(), "Swapchain image index out of bounds ({} >= {})", idx, m_images.size());
+    return m_images[idx];
+}
+
+} // namespace Mizu::Null
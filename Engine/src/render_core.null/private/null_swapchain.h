@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "render_core/rhi/swapchain.h"
+
+namespace Mizu::Null
+{
+
+// Forward declarations
+class NullImageResource;
+
+class NullSwapchain : public Swapchain
+{
+  public:
+    NullSwapchain(SwapchainDescription desc);
+
+    void acquire_next_image(std::shared_ptr<Semaphore> signal_semaphore, std::shared_ptr<Fence> signal_fence) override;
+    void present(std::span<std::shared_ptr<Semaphore>> wait_semaphores) override;
+
+    std::shared_ptr<ImageResource> get_image(uint32_t idx) const override;
+    uint32_t get_num_images() const override { return static_cast<uint32_t>(m_images.size()); }
+    uint32_t get_current_image_idx() const override { return m_current_image_idx; }
+
+  private:
+    SwapchainDescription m_description{};
+    uint32_t m_current_image_idx = 0;
+
+    std::vector<std::shared_ptr<NullImageResource>> m_images;
+};
+
+} // namespace Mizu::Null
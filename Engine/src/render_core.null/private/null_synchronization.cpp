@@ -0,0 +1,20 @@
+#include "null_synchronization.h"
+
+#include "base/debug/assert.h"
+
+namespace Mizu::Null
+{
+
+//
+// NullFence
+//
+
+NullFence::NullFence(bool signaled) : m_signaled(signaled) {}
+
+void NullFence::wait_for()
+{
+    MIZU_ASSERT(m_signaled, "Waiting for a fence that has not been submitted, it would never be signaled");
+    m_signaled = false;
+}
+
+} // namespace Mizu::Null
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "render_core/rhi/synchronization.h"
+
+namespace Mizu::Null
+{
+
+// Submissions execute immediately, so the fence is signaled by the time submit returns
+class NullFence : public Fence
+{
+  public:
+    NullFence(bool signaled);
+
+    void wait_for() override;
+
+    void signal() { m_signaled = true; }
+    bool is_signaled() const { return m_signaled; }
+
+  private:
+    bool m_signaled = false;
+};
+
+class NullSemaphore : public Semaphore
+{
+};
+
+} // namespace Mizu::Null
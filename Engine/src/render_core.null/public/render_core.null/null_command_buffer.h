@@ -0,0 +1,300 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "render_core/rhi/command_buffer.h"
+#include "render_core/rhi/render_pass.h"
+
+#include "mizu_render_core_null_module.h"
+
+namespace Mizu::Null
+{
+
+//
+// Recorded commands
+//
+
+struct NullBarrierCmd
+{
+    std::vector<BufferTransition> buffer_transitions;
+    std::vector<ImageTransition> image_transitions;
+    std::vector<AccelerationStructureTransition> accel_struct_transitions;
+};
+
+struct NullBeginRenderPassCmd
+{
+    RenderPassInfo info;
+};
+
+struct NullEndRenderPassCmd
+{
+};
+
+struct NullBindPipelineCmd
+{
+    const Pipeline* pipeline;
+};
+
+struct NullBindDescriptorSetCmd
+{
+    const DescriptorSet* descriptor_set;
+    uint32_t set;
+};
+
+struct NullPushConstantCmd
+{
+    std::vector<uint8_t> data;
+};
+
+struct NullBindVertexBufferCmd
+{
+    const BufferResource* buffer;
+    uint64_t offset;
+};
+
+struct NullBindIndexBufferCmd
+{
+    const BufferResource* buffer;
+    IndexBufferFormat format;
+    uint64_t offset;
+};
+
+struct NullDrawCmd
+{
+    uint32_t vertex_count;
+    uint32_t first_vertex;
+    uint32_t instance_count;
+    uint32_t first_instance;
+};
+
+struct NullDrawIndexedCmd
+{
+    uint32_t index_count;
+    uint32_t first_index;
+    uint32_t first_vertex;
+    uint32_t instance_count;
+    uint32_t first_instance;
+};
+
+// count_buffer is nullptr when the draw count is not read from a buffer
+struct NullDrawIndexedIndirectCmd
+{
+    const BufferResource* buffer;
+    uint64_t offset;
+    const BufferResource* count_buffer;
+    uint64_t count_buffer_offset;
+    uint32_t max_draw_count;
+    uint32_t stride;
+};
+
+struct NullDispatchCmd
+{
+    glm::uvec3 group_count;
+};
+
+struct NullTraceRaysCmd
+{
+    glm::uvec3 dimensions;
+};
+
+struct NullCopyBufferToBufferCmd
+{
+    const BufferResource* source;
+    const BufferResource* dest;
+    CopyBufferToBufferInfo info;
+};
+
+struct NullCopyImageToImageCmd
+{
+    const ImageResource* source;
+    const ImageResource* dest;
+    CopyImageToImageInfo info;
+};
+
+struct NullCopyBufferToImageCmd
+{
+    const BufferResource* buffer;
+    const ImageResource* image;
+    CopyBufferToImageInfo info;
+};
+
+struct NullCopyImageToBufferCmd
+{
+    const ImageResource* image;
+    const BufferResource* buffer;
+    CopyImageToBufferInfo info;
+};
+
+struct NullBuildAccelerationStructureCmd
+{
+    const AccelerationStructure* accel_struct;
+    const BufferResource* scratch_buffer;
+    uint32_t num_instances;
+    bool update;
+};
+
+struct NullFillBufferCmd
+{
+    const BufferResource* buffer;
+    uint64_t size;
+    uint64_t offset;
+    uint32_t data;
+};
+
+struct NullBeginGpuMarkerCmd
+{
+    std::string label;
+};
+
+struct NullEndGpuMarkerCmd
+{
+};
+
+using NullCommand = std::variant<
+    NullBarrierCmd,
+    NullBeginRenderPassCmd,
+    NullEndRenderPassCmd,
+    NullBindPipelineCmd,
+    NullBindDescriptorSetCmd,
+    NullPushConstantCmd,
+    NullBindVertexBufferCmd,
+    NullBindIndexBufferCmd,
+    NullDrawCmd,
+    NullDrawIndexedCmd,
+    NullDrawIndexedIndirectCmd,
+    NullDispatchCmd,
+    NullTraceRaysCmd,
+    NullCopyBufferToBufferCmd,
+    NullCopyImageToImageCmd,
+    NullCopyBufferToImageCmd,
+    NullCopyImageToBufferCmd,
+    NullBuildAccelerationStructureCmd,
+    NullFillBufferCmd,
+    NullBeginGpuMarkerCmd,
+    NullEndGpuMarkerCmd>;
+
+//
+// NullCommandBuffer
+//
+
+// Records the commands into a list that can be inspected after recording. Submitting executes the buffer copies and
+// fills on the CPU memory of the buffers and signals the fence, everything else is only recorded.
+class MIZU_RENDER_CORE_NULL_API NullCommandBuffer : public CommandBuffer
+{
+  public:
+    NullCommandBuffer(CommandBufferType type);
+
+    void begin() override;
+    void end() override;
+
+    void submit(const CommandBufferSubmitInfo& info) const override;
+
+    void bind_descriptor_set(std::shared_ptr<DescriptorSet> descriptor_set, uint32_t set) override;
+    void push_constant(uint32_t size, const void* data) const override;
+
+    void begin_render_pass(const RenderPassInfo& info) override;
+    void end_render_pass() override;
+    bool is_render_pass_active() const override { return m_render_pass_active; }
+
+    void bind_pipeline(std::shared_ptr<Pipeline> pipeline) override;
+
+    void bind_vertex_buffer(const BufferResource& vertex_buffer, uint64_t offset = 0) override;
+    void bind_index_buffer(const BufferResource& index_buffer, IndexBufferFormat format, uint64_t offset = 0) override;
+
+    void draw(uint32_t vertex_count, uint32_t first_vertex, uint32_t instance_count = 1, uint32_t first_instance = 0)
+        override;
+    void draw_indexed(
+        uint32_t index_count,
+        uint32_t first_index,
+        uint32_t first_vertex,
+        uint32_t instance_count = 1,
+        uint32_t first_instance = 0) override;
+
+    void draw(const BufferResource& vertex) const override;
+    void draw_indexed(const BufferResource& vertex, const BufferResource& index) const override;
+
+    void draw_instanced(const BufferResource& vertex, uint32_t instance_count) const override;
+    void draw_indexed_instanced(const BufferResource& vertex, const BufferResource& index, uint32_t instance_count)
+        const override;
+
+    void draw_indexed_indirect(const BufferResource& buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+        const override;
+    void draw_indexed_indirect_count(
+        const BufferResource& buffer,
+        uint64_t offset,
+        const BufferResource& count_buffer,
+        uint64_t count_buffer_offset,
+        uint32_t max_draw_count,
+        uint32_t stride) const override;
+
+    void dispatch(glm::uvec3 group_count) const override;
+
+    void trace_rays(glm::uvec3 dimensions) const override;
+
+    void transition_resource(const BufferResource& buffer, const BufferTransitionInfo& info) const override;
+    void transition_resource(const ImageResource& image, const ImageTransitionInfo& info) const override;
+    void transition_resource(const AccelerationStructure& accel_struct, const AccelerationStructureTransitionInfo& info)
+        const override;
+    void transition_resources(const ResourceTransitionBatch& batch) const override;
+
+    void copy_buffer_to_buffer(
+        const BufferResource& source,
+        const BufferResource& dest,
+        const CopyBufferToBufferInfo& info) const override;
+    void copy_image_to_image(const ImageResource& source, const ImageResource& dest, const CopyImageToImageInfo& info)
+        const override;
+    void copy_buffer_to_image(
+        const BufferResource& buffer,
+        const ImageResource& image,
+        const CopyBufferToImageInfo& info) const override;
+    void copy_image_to_buffer(
+        const ImageResource& image,
+        const BufferResource& buffer,
+        const CopyImageToBufferInfo& info) const override;
+
+    void build_blas(const AccelerationStructure& blas, const BufferResource& scratch_buffer) const override;
+    void build_tlas(
+        const AccelerationStructure& tlas,
+        std::span<AccelerationStructureInstanceData> instances,
+        const BufferResource& scratch_buffer) const override;
+    void update_tlas(
+        const AccelerationStructure& tlas,
+        std::span<AccelerationStructureInstanceData> instances,
+        const BufferResource& scratch_buffer) const override;
+
+    void fill_buffer(const BufferResource& buffer, uint64_t size, uint64_t offset, uint32_t data) const override;
+
+    void begin_gpu_marker(std::string_view label) const override;
+    void end_gpu_marker() const override;
+
+    CommandBufferType get_type() const { return m_type; }
+    bool is_recording() const { return m_recording; }
+
+    // Commands recorded since the last begin()
+    std::span<const NullCommand> get_commands() const { return m_commands; }
+    // Number of times the command buffer has been submitted
+    uint64_t get_num_submissions() const { return m_num_submissions; }
+
+  protected:
+    void submit_ordered_internal(
+        std::span<const CommandBuffer* const> command_buffers,
+        const CommandBufferSubmitInfo& info) const override;
+
+  private:
+    CommandBufferType m_type;
+
+    bool m_recording = false;
+    bool m_render_pass_active = false;
+
+    mutable std::vector<NullCommand> m_commands;
+    mutable uint64_t m_num_submissions = 0;
+
+    void record(NullCommand command) const;
+    void execute() const;
+};
+
+} // namespace Mizu::Null
@@ -2,6 +2,8 @@
 
 #include <array>
 #include <cstddef>
+#include <type_traits>
+#include <vector>
 
 #include "base/debug/assert.h"
 #include "base/debug/logging.h"
@@ -30,19 +32,21 @@ static_assert(
 
 VulkanCommandBuffer::VulkanCommandBuffer(CommandBufferType type) : m_type(type)
 {
-    m_command_buffer = VulkanContext.device->allocate_command_buffer(m_type);
+    m_command_buffer = VulkanContext.device->allocate_command_buffer(m_type, m_command_info_idx);
     MIZU_ASSERT(m_command_buffer != VK_NULL_HANDLE, "Error allocating command buffers");
 }
 
 VulkanCommandBuffer::~VulkanCommandBuffer()
 {
-    VulkanContext.device->free_command_buffer(m_command_buffer, m_type);
+    VulkanContext.device->free_command_buffer(m_command_buffer, m_type, m_command_info_idx);
 }
 
 void VulkanCommandBuffer::begin()
 {
     VK_CHECK(vkResetCommandBuffer(m_command_buffer, 0));
 
+    m_pending_split_transitions.clear();
+
 #if MIZU_VULKAN_VALIDATIONS_ENABLED
     m_debug_bound_vertex_buffer = {};
     m_debug_bound_index_buffer = {};
@@ -56,6 +60,8 @@ void VulkanCommandBuffer::begin()
 
 void VulkanCommandBuffer::end()
 {
+    MIZU_ASSERT(m_pending_split_transitions.empty(), "Command buffer has split transitions that have not ended");
+
 #if MIZU_VULKAN_VALIDATIONS_ENABLED
     m_debug_bound_vertex_buffer = {};
     m_debug_bound_index_buffer = {};
@@ -66,6 +72,25 @@ void VulkanCommandBuffer::end()
 
 void VulkanCommandBuffer::submit(const CommandBufferSubmitInfo& info) const
 {
+    const CommandBuffer* command_buffer = this;
+    submit_ordered_internal(std::span(&command_buffer, 1), info);
+}
+
+void VulkanCommandBuffer::submit_ordered_internal(
+    std::span<const CommandBuffer* const> command_buffers,
+    const CommandBufferSubmitInfo& info) const
+{
+    std::vector<VkCommandBuffer> native_command_buffers;
+    native_command_buffers.reserve(command_buffers.size());
+
+    for (const CommandBuffer* command_buffer : command_buffers)
+    {
+        const VulkanCommandBuffer& native_command_buffer = static_cast<const VulkanCommandBuffer&>(*command_buffer);
+        MIZU_ASSERT(native_command_buffer.m_type == m_type, "All submitted command buffers must have the same type");
+
+        native_command_buffers.push_back(native_command_buffer.m_command_buffer);
+    }
+
     inplace_vector<VkSemaphore, CommandBufferSubmitInfo::MAX_SEMAPHORES> native_wait_semaphores;
     inplace_vector<VkPipelineStageFlags, CommandBufferSubmitInfo::MAX_SEMAPHORES> native_wait_dst_stage_masks;
 
@@ -104,8 +129,8 @@ void VulkanCommandBuffer::submit(const CommandBufferSubmitInfo& info) const
     submit_info.waitSemaphoreCount = static_cast<uint32_t>(native_wait_semaphores.size());
     submit_info.pWaitSemaphores = native_wait_semaphores.data();
     submit_info.pWaitDstStageMask = native_wait_dst_stage_masks.data();
-    submit_info.commandBufferCount = 1;
-    submit_info.pCommandBuffers = &m_command_buffer;
+    submit_info.commandBufferCount = static_cast<uint32_t>(native_command_buffers.size());
+    submit_info.pCommandBuffers = native_command_buffers.data();
     submit_info.signalSemaphoreCount = static_cast<uint32_t>(signal_semaphores.size());
     submit_info.pSignalSemaphores = signal_semaphores.data();
 
@@ -613,14 +638,19 @@ static uint32_t get_vulkan_transition_queue_family_index(const std::optional<Com
     return VulkanContext.device->get_queue(*type)->family();
 }
 
-void VulkanCommandBuffer::transition_resource(const BufferResource& buffer, const BufferTransitionInfo& info) const
+template <typename BarrierT>
+struct VulkanTransitionBarrier
 {
-    if (info.old_state == info.new_state)
-    {
-        MIZU_LOG_WARNING("Old state and New state are the same");
-        return;
-    }
+    BarrierT barrier{};
+    VkPipelineStageFlags src_stage = 0;
+    VkPipelineStageFlags dst_stage = 0;
+};
 
+static VulkanTransitionBarrier<VkBufferMemoryBarrier> get_vulkan_buffer_transition_barrier(
+    CommandBufferType type,
+    const BufferResource& buffer,
+    const BufferTransitionInfo& info)
+{
     // In vulkan buffers have no layout, so a state change never requires a layout transition. It does still require a
     // memory dependency, so that writes performed in the old state are visible to the accesses in the new state.
     // Release and acquire modes additionally carry the queue family ownership transfer.
@@ -637,7 +667,9 @@ void VulkanCommandBuffer::transition_resource(const BufferResource& buffer, cons
             "Specifying source of destination queue family when resource has ResourceSharingMode::Concurrent");
     }
 
-    VkBufferMemoryBarrier barrier{};
+    VulkanTransitionBarrier<VkBufferMemoryBarrier> transition{};
+
+    VkBufferMemoryBarrier& barrier = transition.barrier;
     barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
     barrier.srcQueueFamilyIndex = src_queue_family;
     barrier.dstQueueFamilyIndex = dst_queue_family;
@@ -673,7 +705,7 @@ void VulkanCommandBuffer::transition_resource(const BufferResource& buffer, cons
         case BufferResourceState::Undefined:
             return VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
         case BufferResourceState::ShaderReadOnly:
-            if (m_type == CommandBufferType::Graphics)
+            if (type == CommandBufferType::Graphics)
             {
                 return VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
                        | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
@@ -699,31 +731,28 @@ void VulkanCommandBuffer::transition_resource(const BufferResource& buffer, cons
     barrier.srcAccessMask = get_vulkan_access_mask(info.old_state);
     barrier.dstAccessMask = get_vulkan_access_mask(info.new_state);
 
-    VkPipelineStageFlags src_stage = get_vulkan_pipeline_stage_flags(info.old_state);
-    VkPipelineStageFlags dst_stage = get_vulkan_pipeline_stage_flags(info.new_state);
+    transition.src_stage = get_vulkan_pipeline_stage_flags(info.old_state);
+    transition.dst_stage = get_vulkan_pipeline_stage_flags(info.new_state);
 
     if (info.transition_mode == ResourceTransitionMode::Release)
     {
         barrier.dstAccessMask = 0;
-        dst_stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        transition.dst_stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
     }
     else if (info.transition_mode == ResourceTransitionMode::Acquire)
     {
         barrier.srcAccessMask = 0;
-        src_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        transition.src_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
     }
 
-    vkCmdPipelineBarrier(m_command_buffer, src_stage, dst_stage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    return transition;
 }
 
-void VulkanCommandBuffer::transition_resource(const ImageResource& image, const ImageTransitionInfo& info) const
+static VulkanTransitionBarrier<VkImageMemoryBarrier> get_vulkan_image_transition_barrier(
+    CommandBufferType type,
+    const ImageResource& image,
+    const ImageTransitionInfo& info)
 {
-    if (info.old_state == info.new_state)
-    {
-        MIZU_LOG_WARNING("Old state and New state are the same");
-        return;
-    }
-
     const VulkanImageResource& native_image = static_cast<const VulkanImageResource&>(image);
 
     const VkImageLayout old_layout = get_vulkan_image_resource_state(info.old_state);
@@ -739,7 +768,9 @@ void VulkanCommandBuffer::transition_resource(const ImageResource& image, const
             "Specifying source of destination queue family when resource has ResourceSharingMode::Concurrent");
     }
 
-    VkImageMemoryBarrier barrier{};
+    VulkanTransitionBarrier<VkImageMemoryBarrier> transition{};
+
+    VkImageMemoryBarrier& barrier = transition.barrier;
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.oldLayout = old_layout;
     barrier.newLayout = new_layout;
@@ -781,7 +812,7 @@ void VulkanCommandBuffer::transition_resource(const ImageResource& image, const
         case ImageResourceState::Undefined:
             return VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
         case ImageResourceState::ShaderReadOnly:
-            if (m_type == CommandBufferType::Graphics)
+            if (type == CommandBufferType::Graphics)
             {
                 return VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
                        | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
@@ -808,33 +839,27 @@ void VulkanCommandBuffer::transition_resource(const ImageResource& image, const
     barrier.srcAccessMask = get_vulkan_access_mask(info.old_state);
     barrier.dstAccessMask = get_vulkan_access_mask(info.new_state);
 
-    VkPipelineStageFlags src_stage = get_vulkan_pipeline_stage_flags(info.old_state);
-    VkPipelineStageFlags dst_stage = get_vulkan_pipeline_stage_flags(info.new_state);
+    transition.src_stage = get_vulkan_pipeline_stage_flags(info.old_state);
+    transition.dst_stage = get_vulkan_pipeline_stage_flags(info.new_state);
 
     if (info.transition_mode == ResourceTransitionMode::Release)
     {
         barrier.dstAccessMask = 0;
-        dst_stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        transition.dst_stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
     }
     else if (info.transition_mode == ResourceTransitionMode::Acquire)
     {
         barrier.srcAccessMask = 0;
-        src_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        transition.src_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
     }
 
-    vkCmdPipelineBarrier(m_command_buffer, src_stage, dst_stage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    return transition;
 }
 
-void VulkanCommandBuffer::transition_resource(
+static VulkanTransitionBarrier<VkBufferMemoryBarrier> get_vulkan_accel_struct_transition_barrier(
     const AccelerationStructure& accel_struct,
-    const AccelerationStructureTransitionInfo& info) const
+    const AccelerationStructureTransitionInfo& info)
 {
-    if (info.old_state == info.new_state)
-    {
-        MIZU_LOG_WARNING("Old state and New state are the same");
-        return;
-    }
-
     const VulkanAccelerationStructure& native_as = static_cast<const VulkanAccelerationStructure&>(accel_struct);
 
     const auto get_vulkan_access_mask = [](AccelerationStructureResourceState state) -> VkAccessFlags {
@@ -871,7 +896,9 @@ void VulkanCommandBuffer::transition_resource(
     const uint32_t src_queue_family = get_vulkan_transition_queue_family_index(info.src_queue_family);
     const uint32_t dst_queue_family = get_vulkan_transition_queue_family_index(info.dst_queue_family);
 
-    VkBufferMemoryBarrier barrier{};
+    VulkanTransitionBarrier<VkBufferMemoryBarrier> transition{};
+
+    VkBufferMemoryBarrier& barrier = transition.barrier;
     barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
     barrier.srcQueueFamilyIndex = src_queue_family;
     barrier.dstQueueFamilyIndex = dst_queue_family;
@@ -886,10 +913,180 @@ void VulkanCommandBuffer::transition_resource(
     else if (info.transition_mode == ResourceTransitionMode::Acquire)
         barrier.srcAccessMask = 0;
 
-    const VkPipelineStageFlags src_stage = get_vulkan_pipeline_stage_flags(info.old_state);
-    const VkPipelineStageFlags dst_stage = get_vulkan_pipeline_stage_flags(info.new_state);
+    transition.src_stage = get_vulkan_pipeline_stage_flags(info.old_state);
+    transition.dst_stage = get_vulkan_pipeline_stage_flags(info.new_state);
+
+    return transition;
+}
+
+void VulkanCommandBuffer::transition_resource(const BufferResource& buffer, const BufferTransitionInfo& info) const
+{
+    const BufferTransition transition{&buffer, info};
+    transition_resources(ResourceTransitionBatch{.buffers = std::span(&transition, 1)});
+}
+
+void VulkanCommandBuffer::transition_resource(const ImageResource& image, const ImageTransitionInfo& info) const
+{
+    const ImageTransition transition{&image, info};
+    transition_resources(ResourceTransitionBatch{.images = std::span(&transition, 1)});
+}
+
+void VulkanCommandBuffer::transition_resource(
+    const AccelerationStructure& accel_struct,
+    const AccelerationStructureTransitionInfo& info) const
+{
+    const AccelerationStructureTransition transition{&accel_struct, info};
+    transition_resources(ResourceTransitionBatch{.accel_structs = std::span(&transition, 1)});
+}
+
+void VulkanCommandBuffer::transition_resources(const ResourceTransitionBatch& batch) const
+{
+    // Transitions that are not split are recorded with a single pipeline barrier. The beginning of a split transition
+    // sets an event, and its barrier is recorded when waiting for the event at the end of the transition.
+    struct BarrierGroup
+    {
+        std::vector<VkBufferMemoryBarrier> buffer_barriers;
+        std::vector<VkImageMemoryBarrier> image_barriers;
+        VkPipelineStageFlags src_stage = 0;
+        VkPipelineStageFlags dst_stage = 0;
+
+        bool empty() const { return buffer_barriers.empty() && image_barriers.empty(); }
+    };
+
+    BarrierGroup barrier_group{};
+    BarrierGroup split_end_group{};
+
+    std::vector<VkEvent> split_end_events;
+    std::vector<std::pair<VkEvent, VkPipelineStageFlags>> split_begin_events;
+
+    const auto add_transition = [&]<typename BarrierT>(
+                                    const void* resource,
+                                    const ResourceTransitionInfo& info,
+                                    const VulkanTransitionBarrier<BarrierT>& transition) {
+        BarrierGroup* group = &barrier_group;
+
+        switch (info.split)
+        {
+        case ResourceTransitionSplit::None:
+            break;
+        case ResourceTransitionSplit::Begin:
+            MIZU_ASSERT(
+                info.transition_mode == ResourceTransitionMode::Normal, "Split transitions can't transfer ownership");
+            split_begin_events.emplace_back(begin_split_transition(resource), transition.src_stage);
+            return;
+        case ResourceTransitionSplit::End:
+            split_end_events.push_back(end_split_transition(resource));
+            group = &split_end_group;
+            break;
+        }
+
+        group->src_stage |= transition.src_stage;
+        group->dst_stage |= transition.dst_stage;
+
+        if constexpr (std::is_same_v<BarrierT, VkImageMemoryBarrier>)
+            group->image_barriers.push_back(transition.barrier);
+        else
+            group->buffer_barriers.push_back(transition.barrier);
+    };
+
+    for (const BufferTransition& transition : batch.buffers)
+    {
+        if (transition.info.old_state == transition.info.new_state)
+        {
+            MIZU_LOG_WARNING("Old state and New state are the same");
+            continue;
+        }
+
+        add_transition(
+            transition.buffer,
+            transition.info,
+            get_vulkan_buffer_transition_barrier(m_type, *transition.buffer, transition.info));
+    }
+
+    for (const ImageTransition& transition : batch.images)
+    {
+        if (transition.info.old_state == transition.info.new_state)
+        {
+            MIZU_LOG_WARNING("Old state and New state are the same");
+            continue;
+        }
+
+        add_transition(
+            transition.image,
+            transition.info,
+            get_vulkan_image_transition_barrier(m_type, *transition.image, transition.info));
+    }
+
+    for (const AccelerationStructureTransition& transition : batch.accel_structs)
+    {
+        if (transition.info.old_state == transition.info.new_state)
+        {
+            MIZU_LOG_WARNING("Old state and New state are the same");
+            continue;
+        }
+
+        add_transition(
+            transition.accel_struct,
+            transition.info,
+            get_vulkan_accel_struct_transition_barrier(*transition.accel_struct, transition.info));
+    }
+
+    if (!split_end_events.empty())
+    {
+        vkCmdWaitEvents(
+            m_command_buffer,
+            static_cast<uint32_t>(split_end_events.size()),
+            split_end_events.data(),
+            split_end_group.src_stage,
+            split_end_group.dst_stage,
+            0,
+            nullptr,
+            static_cast<uint32_t>(split_end_group.buffer_barriers.size()),
+            split_end_group.buffer_barriers.data(),
+            static_cast<uint32_t>(split_end_group.image_barriers.size()),
+            split_end_group.image_barriers.data());
+    }
+
+    if (!barrier_group.empty())
+    {
+        vkCmdPipelineBarrier(
+            m_command_buffer,
+            barrier_group.src_stage,
+            barrier_group.dst_stage,
+            0,
+            0,
+            nullptr,
+            static_cast<uint32_t>(barrier_group.buffer_barriers.size()),
+            barrier_group.buffer_barriers.data(),
+            static_cast<uint32_t>(barrier_group.image_barriers.size()),
+            barrier_group.image_barriers.data());
+    }
+
+    for (const auto& [event, src_stage] : split_begin_events)
+    {
+        vkCmdSetEvent(m_command_buffer, event, src_stage);
+    }
+}
+
+VkEvent VulkanCommandBuffer::begin_split_transition(const void* resource) const
+{
+    const VkEvent event = VulkanContext.device->acquire_split_transition_event();
+
+    const bool inserted = m_pending_split_transitions.insert({resource, event}).second;
+    MIZU_ASSERT(inserted, "Resource already has a split transition in progress");
+
+    return event;
+}
+
+VkEvent VulkanCommandBuffer::end_split_transition(const void* resource) const
+{
+    const auto it = m_pending_split_transitions.find(resource);
+    MIZU_ASSERT(it != m_pending_split_transitions.end(), "Ending a split transition that has not begun");
+
+    const VkEvent event = it->second;
+    m_pending_split_transitions.erase(it);
 
-    vkCmdPipelineBarrier(m_command_buffer, src_stage, dst_stage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    return event;
 }
 
 static VkImageSubresourceLayers get_vulkan_image_subresource_layers(
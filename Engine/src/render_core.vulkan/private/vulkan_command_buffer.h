@@ -1,5 +1,8 @@
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "render_core/rhi/command_buffer.h"
 #include "render_core/rhi/render_pass.h"
 
@@ -69,6 +72,7 @@ class VulkanCommandBuffer : public CommandBuffer
     void transition_resource(const ImageResource& image, const ImageTransitionInfo& info) const override;
     void transition_resource(const AccelerationStructure& accel_struct, const AccelerationStructureTransitionInfo& info)
         const override;
+    void transition_resources(const ResourceTransitionBatch& batch) const override;
 
     void copy_buffer_to_buffer(
         const BufferResource& source,
@@ -100,14 +104,24 @@ class VulkanCommandBuffer : public CommandBuffer
     void begin_gpu_marker(std::string_view label) const override;
     void end_gpu_marker() const override;
 
+  protected:
+    void submit_ordered_internal(
+        std::span<const CommandBuffer* const> command_buffers,
+        const CommandBufferSubmitInfo& info) const override;
+
   private:
     VkCommandBuffer m_command_buffer{VK_NULL_HANDLE};
     CommandBufferType m_type;
+    // Command pool of the thread that allocated the command buffer
+    uint32_t m_command_info_idx = 0;
 
     bool m_render_pass_active = false;
 
     std::shared_ptr<VulkanPipeline> m_bound_pipeline{nullptr};
 
+    // Events of the split transitions in progress, keyed by resource. Acquired from the device pool
+    mutable std::unordered_map<const void*, VkEvent> m_pending_split_transitions;
+
 #if MIZU_VULKAN_VALIDATIONS_ENABLED
     struct DebugBoundVertexBuffer
     {
@@ -133,6 +147,9 @@ class VulkanCommandBuffer : public CommandBuffer
 #endif
 
     std::shared_ptr<VulkanQueue> get_queue() const;
+
+    VkEvent begin_split_transition(const void* resource) const;
+    VkEvent end_split_transition(const void* resource) const;
 };
 
 } // namespace Mizu::Vulkan
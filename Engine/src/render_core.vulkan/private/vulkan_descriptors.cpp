@@ -328,6 +328,8 @@ std::shared_ptr<DescriptorSet> VulkanDescriptorManager::allocate_transient(Descr
 {
     const VkDescriptorSetLayout descriptor_set_layout = VulkanContext.descriptor_set_layout_cache->get(layout);
 
+    const std::lock_guard lock{m_transient_mutex};
+
     VkDescriptorSetAllocateInfo allocate_info{};
     allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocate_info.pNext = nullptr;
@@ -350,6 +352,8 @@ std::shared_ptr<DescriptorSet> VulkanDescriptorManager::allocate_transient(Descr
 
 void VulkanDescriptorManager::reset_transient(uint32_t pool_idx)
 {
+    const std::lock_guard lock{m_transient_mutex};
+
 #if MIZU_VULKAN_VALIDATIONS_ENABLED
     if (!m_tracked_transient_resources.empty())
     {
@@ -434,6 +438,8 @@ void VulkanDescriptorManager::transient_descriptor_set_created(VulkanDescriptorS
 
 void VulkanDescriptorManager::transient_descriptor_set_freed(VulkanDescriptorSet* descriptor_set)
 {
+    const std::lock_guard lock{m_transient_mutex};
+
     MIZU_ASSERT(
         m_tracked_transient_resources[m_current_transient_pool_idx].contains(descriptor_set),
         "Trying to free descriptor set that is not tracked with address '{}' and current transient pool '{}'",
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 
@@ -60,11 +61,16 @@ class VulkanDescriptorManager
     VkDescriptorPool m_bindless_descriptor_pool{VK_NULL_HANDLE};
 
     uint32_t m_current_transient_pool_idx = 0;
+    // Transient sets are allocated by passes recorded on different threads, the pools need external synchronization
+    std::mutex m_transient_mutex;
 
 #if MIZU_VULKAN_VALIDATIONS_ENABLED
     std::vector<std::unordered_set<VulkanDescriptorSet*>> m_tracked_transient_resources;
 
+
+    // Requires m_transient_mutex to be locked
     void transient_descriptor_set_created(VulkanDescriptorSet* descriptor_set);
+    // Locks m_transient_mutex, transient sets can be destroyed on any thread
     void transient_descriptor_set_freed(VulkanDescriptorSet* descriptor_set);
 #endif
 
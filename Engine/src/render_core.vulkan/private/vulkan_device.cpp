@@ -186,6 +186,9 @@ VulkanDevice::VulkanDevice(const DeviceCreationDescription& desc)
     descriptor_manager_desc.num_transient_pools = desc.frames_in_flight;
     VulkanContext.descriptor_manager = std::make_unique<VulkanDescriptorManager>(descriptor_manager_desc);
 
+    MIZU_ASSERT(desc.frames_in_flight >= 1, "Minimum one frame in flight is needed");
+    m_split_transition_event_pools.resize(desc.frames_in_flight);
+
     if (m_properties.ray_tracing_hardware)
     {
         initialize_rtx(m_device, m_physical_device);
@@ -201,6 +204,14 @@ VulkanDevice::~VulkanDevice()
     VulkanContext.descriptor_manager.reset();
     VulkanContext.default_device_allocator.reset();
 
+    for (const SplitTransitionEventPool& pool : m_split_transition_event_pools)
+    {
+        for (VkEvent event : pool.events)
+        {
+            vkDestroyEvent(m_device, event, nullptr);
+        }
+    }
+
     // Doing this strange stuff to prevent the same command pool from being destroyed twice, if two
     // "command pool types" use the same queue.
     std::unordered_set<VkCommandPool> command_pools;
@@ -220,14 +231,21 @@ VulkanDevice::~VulkanDevice()
     vkDestroyInstance(m_instance, nullptr);
 }
 
-VkCommandBuffer VulkanDevice::allocate_command_buffer(CommandBufferType type)
+VkCommandBuffer VulkanDevice::allocate_command_buffer(CommandBufferType type, uint32_t& out_command_info_idx)
 {
-    return allocate_command_buffers(1, type)[0];
+    return allocate_command_buffers(1, type, out_command_info_idx)[0];
 }
 
-std::vector<VkCommandBuffer> VulkanDevice::allocate_command_buffers(uint32_t count, CommandBufferType type)
+std::vector<VkCommandBuffer> VulkanDevice::allocate_command_buffers(
+    uint32_t count,
+    CommandBufferType type,
+    uint32_t& out_command_info_idx)
 {
-    ThreadCommandInfo::Type& thread_info = get_thread_command_info(std::this_thread::get_id(), type);
+    const std::lock_guard lock(m_assign_thread_info_mutex);
+
+    out_command_info_idx = get_thread_command_info_idx(std::this_thread::get_id());
+
+    ThreadCommandInfo::Type& thread_info = m_per_thread_command_info[out_command_info_idx].get_type(type);
     MIZU_ASSERT(thread_info.command_pool != VK_NULL_HANDLE, "Could not select command pool");
 
     if (thread_info.available_command_buffers.size() >= count)
@@ -257,17 +275,25 @@ std::vector<VkCommandBuffer> VulkanDevice::allocate_command_buffers(uint32_t cou
     return command_buffers;
 }
 
-void VulkanDevice::free_command_buffer(VkCommandBuffer command_buffer, CommandBufferType type)
+void VulkanDevice::free_command_buffer(
+    VkCommandBuffer command_buffer,
+    CommandBufferType type,
+    uint32_t command_info_idx)
 {
     std::span command_buffers{&command_buffer, 1};
-    free_command_buffers(command_buffers, type);
+    free_command_buffers(command_buffers, type, command_info_idx);
 }
 
-void VulkanDevice::free_command_buffers(std::span<VkCommandBuffer> command_buffers, CommandBufferType type)
+void VulkanDevice::free_command_buffers(
+    std::span<VkCommandBuffer> command_buffers,
+    CommandBufferType type,
+    uint32_t command_info_idx)
 {
-    const std::thread::id thread_id = std::this_thread::get_id();
+    const std::lock_guard lock(m_assign_thread_info_mutex);
 
-    ThreadCommandInfo::Type& thread_info = get_thread_command_info(thread_id, type);
+    ThreadCommandInfo& info = m_per_thread_command_info[command_info_idx];
+
+    ThreadCommandInfo::Type& thread_info = info.get_type(type);
     MIZU_ASSERT(thread_info.command_pool != VK_NULL_HANDLE, "Could not select command pool");
 
     for (const VkCommandBuffer& command_buffer : command_buffers)
@@ -276,17 +302,38 @@ void VulkanDevice::free_command_buffers(std::span<VkCommandBuffer> command_buffe
         thread_info.command_buffers_in_usage--;
     }
 
-    if (thread_info.command_buffers_in_usage == 0)
+    if (info.command_buffers_in_usage() == 0)
     {
-        const std::lock_guard lock(m_assign_thread_info_mutex);
+        // If the owner thread doesn't have command buffers in usage, release this Thread Command info structure to be
+        // used by another thread
+        const auto it = m_thread_to_command_info_map.find(info.thread_id);
+        if (it != m_thread_to_command_info_map.end() && it->second == command_info_idx)
+        {
+            m_available_per_thread_command_info_idx.push(command_info_idx);
+            m_thread_to_command_info_map.erase(it);
+        }
+    }
+}
+VkEvent VulkanDevice::acquire_split_transition_event()
+{
+    const std::lock_guard lock(m_split_transition_event_mutex);
+
+    SplitTransitionEventPool& pool = m_split_transition_event_pools[m_current_split_transition_event_pool_idx];
 
-        // If the number of command buffers in usage in a specific thread is 0, release this Thread Command info
-        // structure to be used by another thread
-        const auto it = m_thread_to_command_info_map.find(thread_id);
-        m_available_per_thread_command_info_idx.push(it->second);
-        m_thread_to_command_info_map.erase(it);
+    if (pool.num_used_events == pool.events.size())
+    {
+        VkEventCreateInfo create_info{};
+        create_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+
+        VkEvent event{VK_NULL_HANDLE};
+        VK_CHECK(vkCreateEvent(m_device, &create_info, nullptr, &event));
+
+        pool.events.push_back(event);
     }
+
+    return pool.events[pool.num_used_events++];
 }
+
 std::optional<uint32_t> VulkanDevice::find_memory_type(uint32_t filter, VkMemoryPropertyFlags properties) const
 {
     VkPhysicalDeviceMemoryProperties memory_properties;
@@ -683,7 +730,6 @@ void VulkanDevice::create_device(std::span<const char*> instance_extensions)
 
     // Create command pools
     const uint32_t num_threads = std::thread::hardware_concurrency();
-    m_per_thread_command_info.reserve(num_threads);
 
     for (uint32_t i = 0; i < num_threads; ++i)
     {
@@ -747,13 +793,11 @@ VulkanDevice::ThreadCommandInfo VulkanDevice::create_thread_command_info()
     return info;
 }
 
-VulkanDevice::ThreadCommandInfo::Type& VulkanDevice::get_thread_command_info(std::thread::id id, CommandBufferType type)
+uint32_t VulkanDevice::get_thread_command_info_idx(std::thread::id id)
 {
     auto it = m_thread_to_command_info_map.find(id);
     if (it == m_thread_to_command_info_map.end())
     {
-        const std::lock_guard lock(m_assign_thread_info_mutex);
-
         if (m_available_per_thread_command_info_idx.empty())
         {
             m_per_thread_command_info.push_back(create_thread_command_info());
@@ -763,11 +807,11 @@ VulkanDevice::ThreadCommandInfo::Type& VulkanDevice::get_thread_command_info(std
         const uint32_t next_idx = m_available_per_thread_command_info_idx.top();
         m_available_per_thread_command_info_idx.pop();
 
+        m_per_thread_command_info[next_idx].thread_id = id;
         it = m_thread_to_command_info_map.insert({id, next_idx}).first;
     }
 
-    ThreadCommandInfo& info = m_per_thread_command_info[it->second];
-    return info.get_type(type);
+    return it->second;
 }
 
 //
@@ -777,6 +821,27 @@ VulkanDevice::ThreadCommandInfo::Type& VulkanDevice::get_thread_command_info(std
 void VulkanDevice::prepare_frame(uint32_t frame_in_flight_idx)
 {
     VulkanContext.descriptor_manager->reset_transient(frame_in_flight_idx);
+
+    {
+        const std::lock_guard lock(m_split_transition_event_mutex);
+
+        MIZU_ASSERT(
+            frame_in_flight_idx < m_split_transition_event_pools.size(),
+            "Invalid frame in flight idx {} when number of frames in flight is {}",
+            frame_in_flight_idx,
+            m_split_transition_event_pools.size());
+
+        // The command buffers of this frame in flight have finished executing, so its events can be reset from the
+        // host and reused
+        SplitTransitionEventPool& pool = m_split_transition_event_pools[frame_in_flight_idx];
+        for (size_t i = 0; i < pool.num_used_events; ++i)
+        {
+            VK_CHECK(vkResetEvent(m_device, pool.events[i]));
+        }
+
+        pool.num_used_events = 0;
+        m_current_split_transition_event_pool_idx = frame_in_flight_idx;
+    }
 }
 
 void VulkanDevice::wait_idle() const
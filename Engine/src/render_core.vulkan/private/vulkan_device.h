@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <mutex>
 #include <optional>
 #include <stack>
@@ -22,11 +23,23 @@ class VulkanDevice : public Device
     GraphicsApi get_api() const override { return GraphicsApi::Vulkan; }
     const DeviceProperties& get_properties() const override { return m_properties; }
 
-    VkCommandBuffer allocate_command_buffer(CommandBufferType type);
-    std::vector<VkCommandBuffer> allocate_command_buffers(uint32_t count, CommandBufferType type);
+    // Command buffers are allocated from the command pool of the calling thread, and must be freed with the returned
+    // command info index. They can be freed from any thread.
+    VkCommandBuffer allocate_command_buffer(CommandBufferType type, uint32_t& out_command_info_idx);
+    std::vector<VkCommandBuffer> allocate_command_buffers(
+        uint32_t count,
+        CommandBufferType type,
+        uint32_t& out_command_info_idx);
 
-    void free_command_buffer(VkCommandBuffer command_buffer, CommandBufferType type);
-    void free_command_buffers(std::span<VkCommandBuffer> command_buffers, CommandBufferType type);
+    void free_command_buffer(VkCommandBuffer command_buffer, CommandBufferType type, uint32_t command_info_idx);
+    void free_command_buffers(
+        std::span<VkCommandBuffer> command_buffers,
+        CommandBufferType type,
+        uint32_t command_info_idx);
+
+    // Events used by split transitions, pooled per frame in flight. They are reset when the frame in flight is
+    // prepared again, so they must only be used by command buffers that have finished executing by then. Thread-safe.
+    VkEvent acquire_split_transition_event();
 
     std::optional<uint32_t> find_memory_type(uint32_t filter, VkMemoryPropertyFlags properties) const;
 
@@ -114,6 +127,14 @@ class VulkanDevice : public Device
         Type compute;
         Type transfer;
 
+        std::thread::id thread_id{};
+
+        uint32_t command_buffers_in_usage() const
+        {
+            return graphics.command_buffers_in_usage + compute.command_buffers_in_usage
+                   + transfer.command_buffers_in_usage;
+        }
+
         Type& get_type(CommandBufferType type)
         {
             switch (type)
@@ -130,18 +151,30 @@ class VulkanDevice : public Device
         }
     };
 
-    std::vector<ThreadCommandInfo> m_per_thread_command_info;
+    // Deque so the infos don't move when a new thread needs one
+    std::deque<ThreadCommandInfo> m_per_thread_command_info;
 
     std::stack<uint32_t> m_available_per_thread_command_info_idx;
     std::unordered_map<std::thread::id, uint32_t> m_thread_to_command_info_map;
     std::mutex m_assign_thread_info_mutex;
 
+    struct SplitTransitionEventPool
+    {
+        std::vector<VkEvent> events;
+        size_t num_used_events = 0;
+    };
+
+    std::vector<SplitTransitionEventPool> m_split_transition_event_pools;
+    uint32_t m_current_split_transition_event_pool_idx = 0;
+    std::mutex m_split_transition_event_mutex;
+
     void create_instance(const DeviceCreationDescription& desc, std::span<const char*> extensions);
     void select_physical_device();
     void create_device(std::span<const char*> instance_extensions);
 
     ThreadCommandInfo create_thread_command_info();
-    ThreadCommandInfo::Type& get_thread_command_info(std::thread::id id, CommandBufferType type);
+    // Requires m_assign_thread_info_mutex to be locked
+    uint32_t get_thread_command_info_idx(std::thread::id id);
 };
 
 } // namespace Mizu::Vulkan
@@ -1,5 +1,7 @@
 #include "vulkan_device_memory_allocator.h"
 
+#include <algorithm>
+
 #include "base/debug/assert.h"
 #include "base/debug/logging.h"
 #include "base/debug/profiling.h"
@@ -173,6 +175,11 @@ void VulkanTransientMemoryPool::place_image(ImageResource& image, size_t offset)
     m_image_infos.emplace_back(native_image, reqs.size, offset, reqs.memoryTypeBits);
 }
 
+void VulkanTransientMemoryPool::reserve(size_t size)
+{
+    m_reserved_size = std::max(size, m_reserved_size);
+}
+
 void VulkanTransientMemoryPool::commit()
 {
     MIZU_PROFILE_SCOPED;
@@ -204,6 +211,8 @@ void VulkanTransientMemoryPool::commit()
         max_size = std::max(info.offset + info.size, max_size);
     }
 
+    max_size = std::max(m_reserved_size, max_size);
+
     const auto memory_index =
         VulkanContext.device->find_memory_type(memory_type_bits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     MIZU_ASSERT(
@@ -229,6 +238,7 @@ void VulkanTransientMemoryPool::reset()
     VulkanContext.device->wait_idle();
 
     free_if_allocated();
+    m_reserved_size = 0;
 
     m_buffer_infos.clear();
     m_image_infos.clear();
@@ -38,6 +38,8 @@ class VulkanTransientMemoryPool : public TransientMemoryPool
     void place_buffer(BufferResource& buffer, size_t offset) override;
     void place_image(ImageResource& image, size_t offset) override;
 
+    void reserve(size_t size) override;
+
     void commit() override;
     void reset() override;
 
@@ -46,6 +48,7 @@ class VulkanTransientMemoryPool : public TransientMemoryPool
   private:
     VkDeviceMemory m_memory{VK_NULL_HANDLE};
     size_t m_size = 0;
+    size_t m_reserved_size = 0;
     std::string m_name;
 
     uint32_t m_memory_type_index = 0;
@@ -107,6 +107,8 @@ VulkanImageResourceView VulkanImageResource::get_or_create_resource_view(
 
     const size_t hash = hash_compute(desc.hash(), type);
 
+    const std::lock_guard lock{m_resource_views_mutex};
+
     const auto it = m_resource_views.find(hash);
     if (it != m_resource_views.end())
         return it->second;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 
 #include "render_core/rhi/device_memory_allocator.h"
@@ -48,6 +49,8 @@ class VulkanImageResource : public ImageResource
   private:
     VkImage m_handle{VK_NULL_HANDLE};
 
+    // Views are requested by passes recorded on different threads
+    std::mutex m_resource_views_mutex;
     std::unordered_map<size_t, VulkanImageResourceView> m_resource_views;
 
     VulkanImageResourceView get_or_create_resource_view(
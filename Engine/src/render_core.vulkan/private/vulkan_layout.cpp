@@ -106,7 +106,9 @@ DescriptorSetLayoutHandle VulkanDescriptorSetLayoutCache::create(const Descripto
 
     const DescriptorSetLayoutHandle handle = DescriptorSetLayoutHandle{hash};
 
-    if (contains(handle))
+    const std::lock_guard lock{m_mutex};
+
+    if (m_cache.contains(handle))
     {
         return handle;
     }
@@ -134,23 +136,25 @@ DescriptorSetLayoutHandle VulkanDescriptorSetLayoutCache::create(const Descripto
 
 VkDescriptorSetLayout VulkanDescriptorSetLayoutCache::get(DescriptorSetLayoutHandle handle) const
 {
-    MIZU_ASSERT(contains(handle), "VulkanDescriptorSetLayoutCache does not contain layout with handle {}", handle.id);
-    return m_cache.find(handle)->second;
+    const std::lock_guard lock{m_mutex};
+
+    const auto it = m_cache.find(handle);
+    MIZU_ASSERT(
+        it != m_cache.end(), "VulkanDescriptorSetLayoutCache does not contain layout with handle {}", handle.id);
+    return it->second;
 }
 
 VkDescriptorSetLayout VulkanDescriptorSetLayoutCache::get_empty_layout()
 {
-    if (!m_empty_layout_handle.is_valid())
-    {
-        m_empty_layout_handle = create(DescriptorSetLayoutDescription{});
-    }
+    std::call_once(m_empty_layout_once, [this] { m_empty_layout_handle = create(DescriptorSetLayoutDescription{}); });
 
     return get(m_empty_layout_handle);
 }
 
 bool VulkanDescriptorSetLayoutCache::contains(DescriptorSetLayoutHandle handle) const
 {
-    return m_cache.find(handle) != m_cache.end();
+    const std::lock_guard lock{m_mutex};
+    return m_cache.contains(handle);
 }
 
 //
@@ -207,7 +211,9 @@ PipelineLayoutHandle VulkanPipelineLayoutCache::create(const PipelineLayoutDescr
 
     const PipelineLayoutHandle handle = PipelineLayoutHandle{hash};
 
-    if (contains(handle))
+    const std::lock_guard lock{m_mutex};
+
+    if (m_cache.contains(handle))
     {
         MIZU_LOG_WARNING("Pipeline layout with handle '{}' has already been created", hash);
         return handle;
@@ -235,17 +241,23 @@ PipelineLayoutHandle VulkanPipelineLayoutCache::create(const PipelineLayoutDescr
 
 VkPipelineLayout VulkanPipelineLayoutCache::get(PipelineLayoutHandle handle) const
 {
-    MIZU_ASSERT(contains(handle), "VulkanPipelineLayoutCache does not contain layout with handle {}", handle.id);
-    return m_cache.find(handle)->second;
+    const std::lock_guard lock{m_mutex};
+
+    const auto it = m_cache.find(handle);
+    MIZU_ASSERT(it != m_cache.end(), "VulkanPipelineLayoutCache does not contain layout with handle {}", handle.id);
+    return it->second;
 }
 
 bool VulkanPipelineLayoutCache::contains(PipelineLayoutHandle handle) const
 {
-    return m_cache.find(handle) != m_cache.end();
+    const std::lock_guard lock{m_mutex};
+    return m_cache.contains(handle);
 }
 
 std::optional<PushConstantItem> VulkanPipelineLayoutCache::get_push_constant_item(PipelineLayoutHandle handle) const
 {
+    const std::lock_guard lock{m_mutex};
+
     const auto it = m_push_constant_item_cache.find(handle);
     if (it != m_push_constant_item_cache.end())
     {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 
@@ -23,8 +24,11 @@ class VulkanDescriptorSetLayoutCache
     bool contains(DescriptorSetLayoutHandle handle) const;
 
   private:
+    // Layouts are created and looked up by passes recorded on different threads
+    mutable std::mutex m_mutex;
     std::unordered_map<DescriptorSetLayoutHandle, VkDescriptorSetLayout> m_cache;
     DescriptorSetLayoutHandle m_empty_layout_handle;
+    std::once_flag m_empty_layout_once;
 };
 
 class VulkanPipelineLayoutCache
@@ -39,6 +43,7 @@ class VulkanPipelineLayoutCache
     std::optional<PushConstantItem> get_push_constant_item(PipelineLayoutHandle handle) const;
 
   private:
+    mutable std::mutex m_mutex;
     std::unordered_map<PipelineLayoutHandle, VkPipelineLayout> m_cache;
     std::unordered_map<PipelineLayoutHandle, PushConstantItem> m_push_constant_item_cache;
 };
@@ -1,5 +1,6 @@
 #include "render_core/rhi/command_buffer.h"
 
+#include "base/debug/assert.h"
 #include "render_core/rhi/buffer_resource.h"
 #include "render_core/rhi/image_resource.h"
 
@@ -11,6 +12,14 @@ void CommandBuffer::submit() const
     submit(CommandBufferSubmitInfo{});
 }
 
+void CommandBuffer::submit_ordered(
+    std::span<const CommandBuffer* const> command_buffers,
+    const CommandBufferSubmitInfo& info)
+{
+    MIZU_ASSERT(!command_buffers.empty(), "Can't submit an empty list of command buffers");
+    command_buffers[0]->submit_ordered_internal(command_buffers, info);
+}
+
 void CommandBuffer::transition_resource(
     const BufferResource& buffer,
     BufferResourceState old_state,
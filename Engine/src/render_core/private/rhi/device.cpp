@@ -52,6 +52,13 @@ Device* Device::create(const DeviceCreationDescription& desc)
         dll_path = MIZU_RENDER_CORE_VULKAN_DLL_PATH;
 #else
         MIZU_UNREACHABLE("Vulkan RenderCore backend was requested but was not built in this configuration");
+#endif
+        break;
+    case GraphicsApi::Null:
+#ifdef MIZU_RENDER_CORE_NULL_DLL_PATH
+        dll_path = MIZU_RENDER_CORE_NULL_DLL_PATH;
+#else
+        MIZU_UNREACHABLE("Null RenderCore backend was requested but was not built in this configuration");
 #endif
         break;
     }
@@ -53,11 +53,22 @@ enum class IndexBufferFormat
     UInt32,
 };
 
+// A split transition begins after the last access in the old state and ends before the first access in the new
+// state, so the GPU can overlap it with the commands recorded in between. Both halves must have the same transition
+// info, must be recorded into the same command buffer and can't transfer queue ownership.
+enum class ResourceTransitionSplit
+{
+    None,
+    Begin,
+    End,
+};
+
 struct ResourceTransitionInfo
 {
     std::optional<CommandBufferType> src_queue_family;
     std::optional<CommandBufferType> dst_queue_family;
     ResourceTransitionMode transition_mode;
+    ResourceTransitionSplit split = ResourceTransitionSplit::None;
 
     ResourceTransitionInfo(
         std::optional<CommandBufferType> src_queue_family_,
@@ -133,6 +144,33 @@ struct AccelerationStructureTransitionInfo : public ResourceTransitionInfo
     }
 };
 
+struct BufferTransition
+{
+    const BufferResource* buffer;
+    BufferTransitionInfo info;
+};
+
+struct ImageTransition
+{
+    const ImageResource* image;
+    ImageTransitionInfo info;
+};
+
+struct AccelerationStructureTransition
+{
+    const AccelerationStructure* accel_struct;
+    AccelerationStructureTransitionInfo info;
+};
+
+struct ResourceTransitionBatch
+{
+    std::span<const BufferTransition> buffers{};
+    std::span<const ImageTransition> images{};
+    std::span<const AccelerationStructureTransition> accel_structs{};
+
+    size_t size() const { return buffers.size() + images.size() + accel_structs.size(); }
+};
+
 struct ImageSubresourceLayers
 {
     uint32_t mip_level = 0;
@@ -196,6 +234,12 @@ class MIZU_RENDER_CORE_API CommandBuffer
     void submit() const;
     virtual void submit(const CommandBufferSubmitInfo& info) const = 0;
 
+    // Submits the command buffers in order as a single submission to the queue of their type, they must all have the
+    // same type. They can be recorded in parallel, as long as each one is only recorded by one thread.
+    static void submit_ordered(
+        std::span<const CommandBuffer* const> command_buffers,
+        const CommandBufferSubmitInfo& info);
+
     virtual void bind_descriptor_set(std::shared_ptr<DescriptorSet> descriptor_set, uint32_t set) = 0;
     virtual void push_constant(uint32_t size, const void* data) const = 0;
 
@@ -266,6 +310,9 @@ class MIZU_RENDER_CORE_API CommandBuffer
         const AccelerationStructure& accel_struct,
         const AccelerationStructureTransitionInfo& info) const = 0;
 
+    // Records all the transitions with as few barriers as possible
+    virtual void transition_resources(const ResourceTransitionBatch& batch) const = 0;
+
     void transition_resource(const BufferResource& buffer, BufferResourceState old_state, BufferResourceState new_state)
         const;
     void transition_resource(
@@ -322,6 +369,12 @@ class MIZU_RENDER_CORE_API CommandBuffer
 
     virtual void begin_gpu_marker(std::string_view label) const = 0;
     virtual void end_gpu_marker() const = 0;
+
+  protected:
+    // Called on the first command buffer of the submission
+    virtual void submit_ordered_internal(
+        std::span<const CommandBuffer* const> command_buffers,
+        const CommandBufferSubmitInfo& info) const = 0;
 };
 
 } // namespace Mizu
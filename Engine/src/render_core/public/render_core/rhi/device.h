@@ -38,6 +38,8 @@ enum class GraphicsApi
 {
     Dx12,
     Vulkan,
+    // Headless backend without a GPU, for testing and benchmarking the CPU side of rendering
+    Null,
 };
 
 struct Version
@@ -65,7 +67,16 @@ struct Dx12SpecificConfiguration
 {
 };
 
-using ApiSpecificConfiguration = std::variant<Dx12SpecificConfiguration, VulkanSpecificConfiguration>;
+// Capabilities reported by the null device, so the paths that depend on them can be exercised without a GPU
+struct NullSpecificConfiguration
+{
+    bool async_compute = false;
+    bool async_transfer = false;
+    bool ray_tracing_hardware = false;
+};
+
+using ApiSpecificConfiguration =
+    std::variant<Dx12SpecificConfiguration, VulkanSpecificConfiguration, NullSpecificConfiguration>;
 
 struct DeviceCreationDescription
 {
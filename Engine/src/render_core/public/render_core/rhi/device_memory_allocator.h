@@ -35,6 +35,9 @@ class TransientMemoryPool
     virtual void place_buffer(BufferResource& buffer, size_t offset) = 0;
     virtual void place_image(ImageResource& image, size_t offset) = 0;
 
+    // The next commit allocates at least `size` bytes, even if the placed resources need less
+    virtual void reserve(size_t size) = 0;
+
     virtual void commit() = 0;
     virtual void reset() = 0;
 
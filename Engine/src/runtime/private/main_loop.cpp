@@ -12,6 +12,7 @@
 #include "render/runtime/render_loop.h"
 #include "render/runtime/renderer.h"
 #include "render/runtime/renderer_settings.h"
+#include "state_manager/state_manager_coordinator.h"
 
 #include "game_package.h"
 #include "runtime/game_main.h"
@@ -42,7 +43,10 @@ bool MainLoop::init(const GamePackage& package)
     g_job_system->init(num_threads);
 
     // Init StateManager
-    g_state_manager_coordinator = new StateManagerCoordinator{};
+    StateManagerCoordinatorDescription state_manager_coordinator_desc{};
+    state_manager_coordinator_desc.job_system = g_job_system;
+
+    g_state_manager_coordinator = new StateManagerCoordinator{state_manager_coordinator_desc};
 
     // Init GamePackage
 #if MIZU_LOGGING_ENABLED
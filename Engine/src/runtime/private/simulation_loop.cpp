@@ -4,6 +4,7 @@
 #include "core/game_context.h"
 #include "core/runtime.h"
 #include "core/window.h"
+#include "state_manager/state_manager_coordinator.h"
 
 #include "runtime/game_simulation.h"
 
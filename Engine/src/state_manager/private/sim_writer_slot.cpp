@@ -0,0 +1,51 @@
+#include "state_manager/sim_writer_slot.h"
+
+#include <mutex>
+#include <vector>
+
+#include "base/debug/assert.h"
+
+namespace Mizu
+{
+
+static std::mutex s_sim_writer_slots_mutex;
+static std::vector<uint32_t> s_free_sim_writer_slots;
+static uint32_t s_num_sim_writer_slots = 0;
+
+struct ThreadSimWriterSlot
+{
+    uint32_t slot = 0;
+
+    ThreadSimWriterSlot()
+    {
+        std::lock_guard lock(s_sim_writer_slots_mutex);
+
+        if (!s_free_sim_writer_slots.empty())
+        {
+            slot = s_free_sim_writer_slots.back();
+            s_free_sim_writer_slots.pop_back();
+        }
+        else
+        {
+            MIZU_VERIFY(
+                s_num_sim_writer_slots < MaxStateManagerSimWriters,
+                "Too many threads writing to state managers, max is {}",
+                MaxStateManagerSimWriters);
+            slot = s_num_sim_writer_slots++;
+        }
+    }
+
+    ~ThreadSimWriterSlot()
+    {
+        std::lock_guard lock(s_sim_writer_slots_mutex);
+        s_free_sim_writer_slots.push_back(slot);
+    }
+};
+
+uint32_t get_state_manager_sim_writer_slot()
+{
+    static thread_local ThreadSimWriterSlot s_thread_slot;
+    return s_thread_slot.slot;
+}
+
+} // namespace Mizu
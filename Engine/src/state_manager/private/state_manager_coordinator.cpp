@@ -3,7 +3,9 @@
 #include <queue>
 
 #include "base/debug/logging.h"
+#include "base/debug/profiling.h"
 #include "base/utils/hash.h"
+#include "core/job_system/job_system.h"
 
 namespace Mizu
 {
@@ -46,6 +48,12 @@ void StateManagerRegistrationBuilder::append_if_not_present(
 // StateManagerCoordinator
 //
 
+StateManagerCoordinator::StateManagerCoordinator(const StateManagerCoordinatorDescription& desc)
+    : m_job_system(desc.job_system)
+    , m_serial_dispatch(desc.serial_dispatch)
+{
+}
+
 void StateManagerCoordinator::register_state_manager(const StateManagerRegistrationBuilder& builder)
 {
     if (builder.m_state_manager->get_identifier() == "BaseStateManager")
@@ -123,27 +131,99 @@ void StateManagerCoordinator::register_state_manager(const StateManagerRegistrat
     build();
 }
 
+void StateManagerCoordinator::set_serial_dispatch(bool serial_dispatch)
+{
+    m_serial_dispatch.store(serial_dispatch, std::memory_order_relaxed);
+}
+
+bool StateManagerCoordinator::is_serial_dispatch() const
+{
+    return m_serial_dispatch.load(std::memory_order_relaxed);
+}
+
 void StateManagerCoordinator::sim_begin_tick(const TickUpdateState& state) const
 {
+    MIZU_PROFILE_SCOPED;
+
+    // Waiting for the render to free a tick would block the worker running the job, wait here instead
     for (IStateManager* manager : m_state_managers)
-        manager->sim_begin_tick(state);
+        manager->sim_make_room_for_tick();
+
+    dispatch([&state](IStateManager* manager) { manager->sim_begin_tick(state); });
 }
 
 void StateManagerCoordinator::sim_end_tick() const
 {
-    for (IStateManager* manager : m_state_managers)
-        manager->sim_end_tick();
+    MIZU_PROFILE_SCOPED;
+    dispatch([](IStateManager* manager) { manager->sim_end_tick(); });
 }
 
 void StateManagerCoordinator::rend_apply_updates(const FrameUpdateState& state) const
 {
-    for (IStateManager* manager : m_state_managers)
-        manager->rend_apply_updates(state);
+    MIZU_PROFILE_SCOPED;
+    dispatch([&state](IStateManager* manager) { manager->rend_apply_updates(state); });
+}
+
+template <typename Func>
+void StateManagerCoordinator::dispatch(const Func& func) const
+{
+    if (m_job_system == nullptr || m_state_managers.size() <= 1 || is_serial_dispatch())
+    {
+        for (IStateManager* manager : m_state_managers)
+            func(manager);
+
+        return;
+    }
+
+    // One job per state manager, indexed by position in m_state_manager_infos. Jobs are scheduled in topological
+    // order so the handles of the inputs of a state manager are always valid when its job is scheduled.
+    std::vector<JobHandle> handles(m_state_manager_infos.size());
+
+    for (const size_t idx : m_topological_order)
+    {
+        const StateManagerInfo& info = m_state_manager_infos[idx];
+        IStateManager* manager = info.state_manager;
+
+        PendingJob job = m_job_system->schedule([&func, manager] { func(manager); });
+        job.name(manager->get_identifier());
+
+        // A job can't have more than MaxJobDependencies dependencies, join the extra ones in an empty job
+        size_t num_direct_inputs = info.inputs.size();
+        if (num_direct_inputs > MaxJobDependencies)
+        {
+            num_direct_inputs = MaxJobDependencies - 1;
+
+            PendingJob join_job = m_job_system->schedule([] {});
+            for (size_t i = num_direct_inputs; i < info.inputs.size(); ++i)
+                join_job.depends_on(JobHandleRef{handles[info.inputs[i]]});
+
+            job.depends_on(join_job.submit());
+        }
+
+        for (size_t i = 0; i < num_direct_inputs; ++i)
+            job.depends_on(JobHandleRef{handles[info.inputs[i]]});
+
+        handles[idx] = job.submit();
+    }
+
+    // Waiting for the state managers without outputs is enough, the rest have finished before them
+    for (size_t idx = 0; idx < m_state_manager_infos.size(); ++idx)
+    {
+        if (m_state_manager_infos[idx].outputs.empty())
+            m_job_system->wait_for(handles[idx]);
+    }
+
+    m_job_system->release_handles(handles);
 }
 
 void StateManagerCoordinator::build()
 {
+    static_assert(
+        MAX_STATE_MANAGER_DEPENDENCIES <= 2 * MaxJobDependencies - 1,
+        "StateManagerCoordinator::dispatch can't join this many dependencies");
+
     m_state_managers.clear();
+    m_topological_order.clear();
 
     std::vector<size_t> in_degree(m_state_manager_infos.size(), 0);
 
@@ -166,6 +246,7 @@ void StateManagerCoordinator::build()
         priority_queue.pop();
 
         m_state_managers.push_back(m_state_manager_infos[top].state_manager);
+        m_topological_order.push_back(top);
 
         for (size_t adj : m_state_manager_infos[top].outputs)
         {
@@ -1,14 +1,17 @@
 #pragma once
 
 #include <array>
-#include <condition_variable>
+#include <atomic>
 #include <cstdint>
+#include <deque>
 #include <mutex>
-#include <stack>
 #include <vector>
 
+#include "base/containers/paged_array.h"
+
 #include "state_manager/state_manager.h"
 #include "state_manager/state_manager_consumer.h"
+#include "state_manager/sim_writer_slot.h"
 
 namespace Mizu
 {
@@ -17,12 +20,63 @@ static constexpr uint64_t MaxTicksAhead = 5;
 
 struct BaseStateManagerConfig
 {
+    // Default max number of handles, can be overriden when constructing the state manager
     static constexpr uint64_t MaxNumHandles = 100;
     static constexpr bool Interpolate = false;
+    static constexpr StateManagerOverflowPolicy OverflowPolicy = StateManagerOverflowPolicy::Block;
+    // Don't publish updates that DynamicState::has_changed reports as unchanged from the last published state
+    static constexpr bool SuppressUnchangedUpdates = false;
+    // Tolerance passed to DynamicState::has_changed(previous, epsilon), 0 uses has_changed(previous). Changes are
+    // compared against the last published state, so small changes accumulate until they are published.
+    static constexpr float ChangeEpsilon = 0.0f;
 
     static constexpr std::string_view Identifier = "BaseStateManager";
 };
 
+// Configs that don't define an OverflowPolicy block
+template <typename Config>
+consteval StateManagerOverflowPolicy get_state_manager_overflow_policy()
+{
+    if constexpr (requires { Config::OverflowPolicy; })
+        return Config::OverflowPolicy;
+    else
+        return StateManagerOverflowPolicy::Block;
+}
+
+// Configs that don't define SuppressUnchangedUpdates publish every update
+template <typename Config>
+consteval bool get_state_manager_suppress_unchanged_updates()
+{
+    if constexpr (requires { Config::SuppressUnchangedUpdates; })
+        return Config::SuppressUnchangedUpdates;
+    else
+        return false;
+}
+
+template <typename Config>
+consteval float get_state_manager_change_epsilon()
+{
+    if constexpr (requires { Config::ChangeEpsilon; })
+        return Config::ChangeEpsilon;
+    else
+        return 0.0f;
+}
+
+struct StateManagerTickStats
+{
+    uint64_t num_ticks_published = 0;
+    // Ticks merged into another tick by the CoalesceOldest and DropIntermediate overflow policies
+    uint64_t num_ticks_coalesced = 0;
+    // Times sim_begin_tick had to wait for the render with the Block overflow policy
+    uint64_t num_sim_stalls = 0;
+    uint64_t sim_stall_time_ns = 0;
+
+    // Update events sent to the render
+    uint64_t num_updates_published = 0;
+    // Updates dropped because the dynamic state did not change, with SuppressUnchangedUpdates
+    uint64_t num_updates_suppressed = 0;
+};
+
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
 class BaseStateManager : public IStateManager
 {
@@ -32,19 +86,35 @@ class BaseStateManager : public IStateManager
 
     using SelfStateManager = BaseStateManager<StaticState, DynamicState, Handle, Config>;
 
+    static constexpr StateManagerOverflowPolicy OverflowPolicy = get_state_manager_overflow_policy<Config>();
+    static constexpr bool SuppressUnchangedUpdates = get_state_manager_suppress_unchanged_updates<Config>();
+    static constexpr float ChangeEpsilon = get_state_manager_change_epsilon<Config>();
+
+    static_assert(
+        ChangeEpsilon == 0.0f || DynamicStateHasChangedWithEpsilon<DynamicState>,
+        "ChangeEpsilon requires DynamicState::has_changed(previous, epsilon)");
+
   public:
     using HandleT = Handle;
     using StaticStateT = StaticState;
     using DynamicStateT = DynamicState;
 
   public:
-    BaseStateManager();
+    // Per handle storage is allocated in pages as handles are created, up to `max_num_handles`
+    explicit BaseStateManager(uint64_t max_num_handles = Config::MaxNumHandles);
+    ~BaseStateManager() override;
 
     // Sim functions
 
+    void sim_make_room_for_tick() override;
     void sim_begin_tick(const TickUpdateState& state) override;
     void sim_end_tick() override;
 
+    // The sim_create/destroy/update/edit/get functions can be called from multiple threads at the same time, between
+    // sim_begin_tick and sim_end_tick. Each thread writes to its own staging buffer, which sim_end_tick merges into the
+    // tick. A handle must not be written from two threads at the same time. References returned by sim_edit are valid
+    // until sim_end_tick.
+
     Handle sim_create(StaticState static_state, DynamicState dynamic_state);
     void sim_destroy(Handle handle);
 
@@ -68,18 +138,29 @@ class BaseStateManager : public IStateManager
 
     std::string_view get_identifier() const override;
 
+    StateManagerTickStats get_tick_stats() const;
+
+    uint64_t get_max_num_handles() const { return m_max_num_handles; }
+
   private:
-    std::stack<uint64_t> m_available_handles{};
-    std::array<uint64_t, Config::MaxNumHandles> m_handle_generation{};
+    uint64_t m_max_num_handles = 0;
 
-    std::condition_variable m_tick_consumed_cv;
-    std::mutex m_tick_consumed_mutex;
+    // Guards creating and recycling handles, which can happen from multiple sim threads
+    std::mutex m_sim_handles_mutex;
+    // Handle ids in [0, m_num_created_handles) have storage allocated
+    uint64_t m_num_created_handles = 0;
 
-    struct Tick
+    // Used as a stack, the last freed handle is the first one reused
+    std::vector<uint64_t> m_available_handles{};
+    paged_array<uint64_t> m_handle_generation;
+
+    enum class TickState : uint8_t
     {
-        uint64_t tick_idx = 0;
-        uint64_t sim_time_us = 0;
-        uint32_t num_updated_handles = 0;
+        Published,
+        // The render has started consuming the tick, the sim can't coalesce into it anymore
+        Consuming,
+        // The sim is coalescing newer ticks into this one
+        Reopened,
     };
 
     struct HandleTick
@@ -89,40 +170,92 @@ class BaseStateManager : public IStateManager
         StateManagerEventKind event_kind{};
     };
 
+    struct Tick
+    {
+        uint64_t tick_idx = 0;
+        uint64_t sim_time_us = 0;
+        uint32_t num_updated_handles = 0;
+        std::atomic<TickState> state = TickState::Published;
+
+        // Only grows, the first num_updated_handles entries are the ones in use. The sim only resizes it while it owns
+        // the tick (in production or reopened).
+        std::vector<HandleTick> handle_ticks{};
+    };
+
+    // Single producer (sim) single consumer (rend) ring, the sim only blocks on m_last_consumed_tick with the Block
+    // overflow policy
     std::atomic<uint64_t> m_last_produced_tick = 0;
     std::atomic<uint64_t> m_last_consumed_tick = 0;
 
     Tick* m_tick_in_production = nullptr;
+    // DropIntermediate keeps the tick in production open while the ring is full
+    bool m_tick_in_production_open = false;
+
+    // The ring slot of the last consumed tick can be reused by the sim, so the render keeps its own copy of the time
+    uint64_t m_rend_last_consumed_sim_time_us = 0;
 
     // Ring buffer of ticks
     std::array<Tick, MaxTicksAhead> m_ticks{};
-    std::array<HandleTick, MaxTicksAhead * Config::MaxNumHandles> m_handle_ticks{};
 
-    std::array<StaticState, Config::MaxNumHandles> m_handle_static_states{};
+    // Writes of one sim thread in the current tick. A deque so entries never move, other threads can keep pointers to
+    // them while the owner keeps writing.
+    struct alignas(64) SimWriterStaging
+    {
+        // Only grows, the first num_handle_ticks entries are the ones in use
+        std::deque<HandleTick> handle_ticks{};
+        uint32_t num_handle_ticks = 0;
+    };
 
-    // Map from pending handles (that have been updated in the current tick) to their position in m_handle_ticks
-    static constexpr uint32_t INVALID_PENDING_IDX = std::numeric_limits<uint32_t>::max();
-    std::array<uint32_t, Config::MaxNumHandles> m_pending_handles_idx{};
+    // Allocated the first time a thread writes to this state manager
+    std::array<std::atomic<SimWriterStaging*>, MaxStateManagerSimWriters> m_sim_writer_stagings{};
 
-    struct HandleStateInfo
-    {
-        DynamicState sim_published_ds{};
-        bool sim_alive = false;
+    paged_array<StaticState> m_handle_static_states;
 
-        DynamicState consumed_ds{};
-        DynamicState applied_ds{};
-    };
-    std::array<HandleStateInfo, Config::MaxNumHandles> m_handle_state_info{};
+    // Map from pending handles (that have been updated in the current tick) to their entry, either in a staging buffer
+    // or, while DropIntermediate keeps it open, in the handle_ticks of the tick in production. Also used as scratch
+    // while coalescing ticks.
+    paged_array<HandleTick*> m_pending_handle_ticks;
+
+    // Per handle state, one array per member so the sim and the render don't share cache lines and the render loops
+    // only touch the states they need
+    paged_array<DynamicState> m_sim_published_ds;
+    paged_array<bool> m_sim_alive;
+
+    paged_array<DynamicState> m_rend_consumed_ds;
+    paged_array<DynamicState> m_rend_applied_ds;
 
     // Highest tick where destroyed handles have been reclaimed back into m_available_handles.
     uint64_t m_last_reclaimed_tick = 0;
 
+    std::atomic<uint64_t> m_num_ticks_published = 0;
+    std::atomic<uint64_t> m_num_ticks_coalesced = 0;
+    std::atomic<uint64_t> m_num_sim_stalls = 0;
+    std::atomic<uint64_t> m_sim_stall_time_ns = 0;
+    std::atomic<uint64_t> m_num_updates_published = 0;
+    std::atomic<uint64_t> m_num_updates_suppressed = 0;
+
     std::vector<IStateManagerConsumer<SelfStateManager>*> m_rend_consumers{};
 
+    // Rend scratch buffers, updates are gathered and sent to the consumers in batches
+    std::vector<Handle> m_rend_batch_handles{};
+    std::vector<DynamicState> m_rend_batch_from_ds{};
+    std::vector<DynamicState> m_rend_batch_ds{};
+
     void rend_notify_on_create(Handle handle, const StaticState& ss, const DynamicState& ds) const;
-    void rend_notify_on_update(Handle handle, const DynamicState& ds) const;
     void rend_notify_on_destroy(Handle handle) const;
 
+    void rend_interpolate_update_batch(double alpha);
+    void rend_flush_update_batch();
+
+    SimWriterStaging& sim_get_writer_staging();
+    void sim_merge_staged_handle_ticks(Tick& tick);
+
+    void sim_wait_for_free_tick(uint64_t last_produced_tick);
+    bool sim_try_coalesce_unconsumed_ticks(uint64_t last_produced_tick);
+    void sim_merge_tick(Tick& target, const Tick& source);
+    void sim_drop_unchanged_updates(Tick& tick);
+    bool sim_has_changed(const DynamicState& ds, const DynamicState& previous) const;
+
     HandleTick& sim_allocate_handle_tick(Handle handle);
     void sim_reset_and_recycle_handle(Handle handle, HandleTick* handle_tick = nullptr);
 
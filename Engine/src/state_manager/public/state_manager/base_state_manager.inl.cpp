@@ -3,6 +3,7 @@
 #include "state_manager/base_state_manager.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "base/debug/assert.h"
 
@@ -10,21 +11,25 @@ namespace Mizu
 {
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
-BaseStateManager<StaticState, DynamicState, Handle, Config>::BaseStateManager()
+BaseStateManager<StaticState, DynamicState, Handle, Config>::BaseStateManager(uint64_t max_num_handles)
+    : m_max_num_handles(max_num_handles)
+    , m_handle_generation(max_num_handles)
+    , m_handle_static_states(max_num_handles)
+    , m_pending_handle_ticks(max_num_handles, nullptr)
+    , m_sim_published_ds(max_num_handles)
+    , m_sim_alive(max_num_handles, false)
+    , m_rend_consumed_ds(max_num_handles)
+    , m_rend_applied_ds(max_num_handles)
 {
-    for (uint64_t i = 0; i < Config::MaxNumHandles; ++i)
-    {
-        // Doing in reverse so that first index is 0
-        m_available_handles.push((Config::MaxNumHandles - 1) - i);
-
-        m_pending_handles_idx[i] = INVALID_PENDING_IDX;
-        m_handle_state_info[i] = HandleStateInfo{};
+    MIZU_ASSERT(max_num_handles >= 1, "State manager must be able to hold at least one handle");
+}
 
-        for (uint64_t tick_idx = 0; tick_idx < MaxTicksAhead; ++tick_idx)
-        {
-            const uint64_t handle_tick_idx = tick_idx * Config::MaxNumHandles + i;
-            m_handle_ticks[handle_tick_idx] = HandleTick{};
-        }
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+BaseStateManager<StaticState, DynamicState, Handle, Config>::~BaseStateManager()
+{
+    for (std::atomic<SimWriterStaging*>& staging : m_sim_writer_stagings)
+    {
+        delete staging.load(std::memory_order_relaxed);
     }
 }
 
@@ -33,48 +38,60 @@ BaseStateManager<StaticState, DynamicState, Handle, Config>::BaseStateManager()
 //
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
-void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_begin_tick(const TickUpdateState& state)
+void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_make_room_for_tick()
 {
     const uint64_t last_produced_tick = m_last_produced_tick.load(std::memory_order_relaxed);
-    uint64_t last_consumed_tick = m_last_consumed_tick.load(std::memory_order_acquire);
+    const uint64_t last_consumed_tick = m_last_consumed_tick.load(std::memory_order_acquire);
 
-    const uint64_t tick_difference = last_produced_tick - last_consumed_tick;
+    // DropIntermediate never publishes a tick that would fill the ring, see sim_end_tick
+    if (last_produced_tick - last_consumed_tick < MaxTicksAhead)
+        return;
 
-    if (tick_difference >= MaxTicksAhead)
-    {
-        // If render can't consume the ticks fast enough, wait until render thread finishes consuming one tick.
+    bool coalesced = false;
+    if constexpr (OverflowPolicy == StateManagerOverflowPolicy::CoalesceOldest)
+        coalesced = sim_try_coalesce_unconsumed_ticks(last_produced_tick);
 
-        std::unique_lock lock(m_tick_consumed_mutex);
-        m_tick_consumed_cv.wait(lock, [&]() {
-            const uint64_t last_consumed = m_last_consumed_tick.load(std::memory_order_acquire);
-            return (last_produced_tick - last_consumed) < MaxTicksAhead;
-        });
+    // If render can't consume the ticks fast enough, wait until render thread finishes consuming one tick.
+    if (!coalesced)
+        sim_wait_for_free_tick(last_produced_tick);
+}
 
-        // Refresh after waiting as the render thread advanced last_consumed while we were blocked.
-        last_consumed_tick = m_last_consumed_tick.load(std::memory_order_acquire);
-    }
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_begin_tick(const TickUpdateState& state)
+{
+    // Only the sim produces ticks, the room made by the coordinator can't be taken before this point
+    sim_make_room_for_tick();
+
+    // Loaded after making room, as coalescing moves last_produced back and the render may have consumed ticks
+    const uint64_t last_produced_tick = m_last_produced_tick.load(std::memory_order_relaxed);
+    const uint64_t last_consumed_tick = m_last_consumed_tick.load(std::memory_order_acquire);
 
     // Reclaim handles from destroy events in ticks that render has fully consumed.
-    // This must run after the `tick_difference >= MaxTicksAhead` wait.
+    // This must run after making room in the ring, the reclaimed slots are the ones reused for new ticks.
     for (uint64_t tick_idx = m_last_reclaimed_tick + 1; tick_idx <= last_consumed_tick; ++tick_idx)
     {
-        const Tick& tick = m_ticks[tick_idx % MaxTicksAhead];
-        const uint64_t slot_base = (tick_idx % MaxTicksAhead) * Config::MaxNumHandles;
+        Tick& tick = m_ticks[tick_idx % MaxTicksAhead];
 
         for (uint32_t i = 0; i < tick.num_updated_handles; ++i)
         {
-            HandleTick& handle_tick = m_handle_ticks[slot_base + i];
+            HandleTick& handle_tick = tick.handle_ticks[i];
             if (handle_tick.event_kind == StateManagerEventKind::Destroy)
                 sim_reset_and_recycle_handle(handle_tick.handle, &handle_tick);
         }
     }
     m_last_reclaimed_tick = last_consumed_tick;
 
+    if (m_tick_in_production_open)
+    {
+        // Keep accumulating into the tick that could not be published
+        m_tick_in_production->sim_time_us = state.sim_time_us;
+        return;
+    }
+
     const uint64_t tick_in_production_ring_idx = (last_produced_tick + 1) % MaxTicksAhead;
     m_tick_in_production = &m_ticks[tick_in_production_ring_idx];
 
-    *m_tick_in_production = Tick{};
-    m_tick_in_production->tick_idx = m_last_produced_tick + 1;
+    m_tick_in_production->tick_idx = last_produced_tick + 1;
     m_tick_in_production->sim_time_us = state.sim_time_us;
     m_tick_in_production->num_updated_handles = 0;
 }
@@ -82,26 +99,62 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_begin_tick
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
 void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_end_tick()
 {
+    sim_merge_staged_handle_ticks(*m_tick_in_production);
+
+    // Catches updates written through sim_edit and updates overwritten back to the published state
+    if constexpr (SuppressUnchangedUpdates)
+        sim_drop_unchanged_updates(*m_tick_in_production);
+
     // Don't produce a new tick if the current tick in production has no updates
     if (m_tick_in_production->num_updated_handles == 0)
     {
         m_tick_in_production = nullptr;
+        m_tick_in_production_open = false;
         return;
     }
 
-    const uint64_t tick_ring_idx = (m_tick_in_production->tick_idx % MaxTicksAhead) * Config::MaxNumHandles;
+    if constexpr (OverflowPolicy == StateManagerOverflowPolicy::DropIntermediate)
+    {
+        // Publishing now would leave no free slot for the next tick, keep the pending handles so the next sim tick
+        // overwrites them
+        const uint64_t last_consumed_tick = m_last_consumed_tick.load(std::memory_order_acquire);
+        if (m_tick_in_production->tick_idx - last_consumed_tick >= MaxTicksAhead)
+        {
+            // Writes of the next sim tick find the handles of this tick in it
+            for (uint32_t i = 0; i < m_tick_in_production->num_updated_handles; ++i)
+            {
+                HandleTick& ht = m_tick_in_production->handle_ticks[i];
+                m_pending_handle_ticks[ht.handle.get_internal_id()] = &ht;
+            }
+
+            m_tick_in_production_open = true;
+            m_num_ticks_coalesced.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    uint64_t num_updates = 0;
     for (uint64_t i = 0; i < m_tick_in_production->num_updated_handles; ++i)
     {
-        const HandleTick& ht = m_handle_ticks[tick_ring_idx + i];
+        const HandleTick& ht = m_tick_in_production->handle_ticks[i];
 
         if (ht.event_kind != StateManagerEventKind::Destroy)
-            m_handle_state_info[ht.handle.get_internal_id()].sim_published_ds = ht.ds;
+            m_sim_published_ds[ht.handle.get_internal_id()] = ht.ds;
 
-        m_pending_handles_idx[ht.handle.get_internal_id()] = INVALID_PENDING_IDX;
+        if (ht.event_kind == StateManagerEventKind::Update)
+            num_updates += 1;
+
+        m_pending_handle_ticks[ht.handle.get_internal_id()] = nullptr;
     }
 
+    m_num_updates_published.fetch_add(num_updates, std::memory_order_relaxed);
+
+    m_tick_in_production->state.store(TickState::Published, std::memory_order_relaxed);
     m_last_produced_tick.store(m_tick_in_production->tick_idx, std::memory_order_release);
+    m_num_ticks_published.fetch_add(1, std::memory_order_relaxed);
+
     m_tick_in_production = nullptr;
+    m_tick_in_production_open = false;
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
@@ -109,22 +162,41 @@ Handle BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_create(
     StaticState static_state,
     DynamicState dynamic_state)
 {
-    if (m_available_handles.empty())
+    uint64_t handle_id = 0;
     {
-        MIZU_UNREACHABLE("Trying to create more handles than MaxNumHandles");
-        return Handle{};
-    }
+        std::lock_guard lock(m_sim_handles_mutex);
 
-    const uint64_t handle_id = m_available_handles.top();
-    m_available_handles.pop();
+        if (!m_available_handles.empty())
+        {
+            handle_id = m_available_handles.back();
+            m_available_handles.pop_back();
+        }
+        else if (m_num_created_handles < m_max_num_handles)
+        {
+            handle_id = m_num_created_handles++;
+
+            // Published together with the tick that contains the create event
+            m_handle_generation.ensure(handle_id);
+            m_handle_static_states.ensure(handle_id);
+            m_pending_handle_ticks.ensure(handle_id);
+            m_sim_published_ds.ensure(handle_id);
+            m_sim_alive.ensure(handle_id);
+            m_rend_consumed_ds.ensure(handle_id);
+            m_rend_applied_ds.ensure(handle_id);
+        }
+        else
+        {
+            MIZU_UNREACHABLE("Trying to create more handles than the max number of handles");
+            return Handle{};
+        }
+    }
 
     const uint64_t generation = m_handle_generation[handle_id];
 
     const Handle handle{handle_id, generation};
 
     m_handle_static_states[handle_id] = static_state;
-    m_handle_state_info[handle_id] = HandleStateInfo{};
-    m_handle_state_info[handle_id].sim_alive = true;
+    m_sim_alive[handle_id] = true;
 
     HandleTick& handle_tick = sim_allocate_handle_tick(handle);
     handle_tick.event_kind = StateManagerEventKind::Create;
@@ -141,10 +213,9 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_destroy(Ha
 
     const uint64_t handle_idx = handle.get_internal_id();
 
-    if (m_pending_handles_idx[handle_idx] != INVALID_PENDING_IDX)
+    if (HandleTick* pending_handle_tick = m_pending_handle_ticks[handle_idx])
     {
-        const uint32_t pending_handle_idx = m_pending_handles_idx[handle_idx];
-        HandleTick& handle_tick = m_handle_ticks[pending_handle_idx];
+        HandleTick& handle_tick = *pending_handle_tick;
 
         if (handle_tick.event_kind == StateManagerEventKind::Destroy)
         {
@@ -152,39 +223,18 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_destroy(Ha
             return;
         }
 
-        // Destroy after Create drops the event
+        // Destroy after Create drops the event, resetting the entry leaves an invalid handle that is skipped when
+        // merging the staged entries into the tick
         if (handle_tick.event_kind == StateManagerEventKind::Create)
         {
-            const uint64_t tick_ring_start_idx =
-                (m_tick_in_production->tick_idx % MaxTicksAhead) * Config::MaxNumHandles;
-
-            auto start_handle_ticks =
-                std::next(m_handle_ticks.begin(), static_cast<std::ptrdiff_t>(tick_ring_start_idx));
-            auto end_handle_ticks =
-                std::next(start_handle_ticks, static_cast<std::ptrdiff_t>(m_tick_in_production->num_updated_handles));
-
-            const auto new_end_it = std::remove_if(
-                start_handle_ticks, end_handle_ticks, [&](const HandleTick& ht) { return ht.handle == handle; });
-
-            m_tick_in_production->num_updated_handles -= 1;
-            m_pending_handles_idx[handle_idx] = INVALID_PENDING_IDX;
-
-            // Update pending indices for all handles that shifted left after compaction
-            const uint64_t removed_local_idx = pending_handle_idx - tick_ring_start_idx;
-            for (uint64_t i = removed_local_idx; i < m_tick_in_production->num_updated_handles; ++i)
-            {
-                const HandleTick& shifted_ht = m_handle_ticks[tick_ring_start_idx + i];
-                m_pending_handles_idx[shifted_ht.handle.get_internal_id()] =
-                    static_cast<uint32_t>(tick_ring_start_idx + i);
-            }
-
-            sim_reset_and_recycle_handle(handle, new_end_it != end_handle_ticks ? &(*new_end_it) : nullptr);
+            m_pending_handle_ticks[handle_idx] = nullptr;
+            sim_reset_and_recycle_handle(handle, &handle_tick);
         }
         else
         {
             // In the rest of cases, any kind converts to destroy
             handle_tick.event_kind = StateManagerEventKind::Destroy;
-            m_handle_state_info[handle_idx].sim_alive = false;
+            m_sim_alive[handle_idx] = false;
         }
 
         return;
@@ -196,7 +246,7 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_destroy(Ha
     handle_tick.event_kind = StateManagerEventKind::Destroy;
     handle_tick.ds = DynamicState{};
 
-    m_handle_state_info[handle_idx].sim_alive = false;
+    m_sim_alive[handle_idx] = false;
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
@@ -205,15 +255,11 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_update(Han
     if (!validate_handle(handle))
         return;
 
-    // TODO: Implement only updating if the new dynamic state is different from the previous value with
-    // DynamicState::has_changed
-
     const uint64_t handle_idx = handle.get_internal_id();
 
-    if (m_pending_handles_idx[handle_idx] != INVALID_PENDING_IDX)
+    if (HandleTick* pending_handle_tick = m_pending_handle_ticks[handle_idx])
     {
-        const uint32_t pending_handle_idx = m_pending_handles_idx[handle_idx];
-        HandleTick& handle_tick = m_handle_ticks[pending_handle_idx];
+        HandleTick& handle_tick = *pending_handle_tick;
 
         if (handle_tick.event_kind == StateManagerEventKind::Destroy)
         {
@@ -232,6 +278,15 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_update(Han
 
     sim_validate_handle_is_alive(handle);
 
+    if constexpr (SuppressUnchangedUpdates)
+    {
+        if (!sim_has_changed(dynamic_state, m_sim_published_ds[handle_idx]))
+        {
+            m_num_updates_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
     HandleTick& handle_tick = sim_allocate_handle_tick(handle);
     handle_tick.event_kind = StateManagerEventKind::Update;
     handle_tick.ds = dynamic_state;
@@ -252,7 +307,7 @@ const DynamicState& BaseStateManager<StaticState, DynamicState, Handle, Config>:
     }
 
     sim_validate_handle_is_alive(handle);
-    return m_handle_state_info[handle.get_internal_id()].sim_published_ds;
+    return m_sim_published_ds[handle.get_internal_id()];
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
@@ -273,7 +328,7 @@ DynamicState& BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_e
 
     HandleTick& handle_tick = sim_allocate_handle_tick(handle);
     handle_tick.event_kind = StateManagerEventKind::Update;
-    handle_tick.ds = m_handle_state_info[handle.get_internal_id()].sim_published_ds;
+    handle_tick.ds = m_sim_published_ds[handle.get_internal_id()];
 
     return handle_tick.ds;
 }
@@ -294,12 +349,20 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::rend_apply_upd
         return;
     }
 
-    const Tick& last_consumed_tick = m_ticks[last_consumed_tick_idx % MaxTicksAhead];
-
     const uint64_t tick_to_consume_idx = last_consumed_tick_idx + 1;
-    const Tick& tick_to_consume = m_ticks[tick_to_consume_idx % MaxTicksAhead];
+    Tick& tick_to_consume = m_ticks[tick_to_consume_idx % MaxTicksAhead];
+
+    // Claim the tick so the sim can't coalesce newer ticks into it while it's being interpolated
+    TickState tick_state = TickState::Published;
+    if (!tick_to_consume.state.compare_exchange_strong(
+            tick_state, TickState::Consuming, std::memory_order_acq_rel, std::memory_order_acquire)
+        && tick_state != TickState::Consuming)
+    {
+        // The sim is coalescing into this tick, it will be published again once it's done
+        return;
+    }
 
-    const uint64_t t0 = last_consumed_tick.sim_time_us;
+    const uint64_t t0 = m_rend_last_consumed_sim_time_us;
     const uint64_t t1 = tick_to_consume.sim_time_us;
 
     double alpha = 1.0;
@@ -313,62 +376,68 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::rend_apply_upd
 
     const bool fully_consumed = alpha >= 1.0;
 
-    for (uint64_t i = 0; i < tick_to_consume.num_updated_handles; ++i)
+    if (!fully_consumed)
     {
-        const uint64_t handle_tick_idx = (tick_to_consume.tick_idx % MaxTicksAhead) * Config::MaxNumHandles + i;
-        const HandleTick& handle_tick = m_handle_ticks[handle_tick_idx];
+        // Only updates are interpolated, creates and destroys wait until the tick is fully consumed
+        if constexpr (Config::Interpolate)
+        {
+            for (uint64_t i = 0; i < tick_to_consume.num_updated_handles; ++i)
+            {
+                const HandleTick& handle_tick = tick_to_consume.handle_ticks[i];
+                if (handle_tick.event_kind != StateManagerEventKind::Update)
+                    continue;
+
+                m_rend_batch_handles.push_back(handle_tick.handle);
+                m_rend_batch_from_ds.push_back(m_rend_consumed_ds[handle_tick.handle.get_internal_id()]);
+                m_rend_batch_ds.push_back(handle_tick.ds);
+            }
+
+            rend_interpolate_update_batch(alpha);
+            rend_flush_update_batch();
+        }
+
+        return;
+    }
 
-        HandleStateInfo& handle_state_info = m_handle_state_info[handle_tick.handle.get_internal_id()];
+    for (uint64_t i = 0; i < tick_to_consume.num_updated_handles; ++i)
+    {
+        const HandleTick& handle_tick = tick_to_consume.handle_ticks[i];
 
         switch (handle_tick.event_kind)
         {
         case StateManagerEventKind::Create: {
-            if (fully_consumed)
-            {
-                const StaticState& ss = m_handle_static_states[handle_tick.handle.get_internal_id()];
+            // Consumers see the events in the same order they were produced
+            rend_flush_update_batch();
 
-                rend_notify_on_create(handle_tick.handle, ss, handle_tick.ds);
-            }
+            const StaticState& ss = m_handle_static_states[handle_tick.handle.get_internal_id()];
+            rend_notify_on_create(handle_tick.handle, ss, handle_tick.ds);
 
             break;
         }
         case StateManagerEventKind::Update: {
-            if (fully_consumed)
-            {
-                rend_notify_on_update(handle_tick.handle, handle_tick.ds);
-            }
-            else if constexpr (Config::Interpolate)
-            {
-                const DynamicState interpolated_ds = handle_state_info.consumed_ds.interpolate(handle_tick.ds, alpha);
-                rend_notify_on_update(handle_tick.handle, interpolated_ds);
-
-                handle_state_info.applied_ds = interpolated_ds;
-            }
+            m_rend_batch_handles.push_back(handle_tick.handle);
+            m_rend_batch_ds.push_back(handle_tick.ds);
 
             break;
         }
         case StateManagerEventKind::Destroy: {
-            if (fully_consumed)
-            {
-                rend_notify_on_destroy(handle_tick.handle);
-            }
+            rend_flush_update_batch();
+            rend_notify_on_destroy(handle_tick.handle);
 
             break;
         }
         }
 
-        if (fully_consumed)
-        {
-            handle_state_info.consumed_ds = handle_tick.ds;
-            handle_state_info.applied_ds = handle_tick.ds;
-        }
+        m_rend_consumed_ds[handle_tick.handle.get_internal_id()] = handle_tick.ds;
+        m_rend_applied_ds[handle_tick.handle.get_internal_id()] = handle_tick.ds;
     }
 
-    if (fully_consumed)
-    {
-        m_last_consumed_tick.store(tick_to_consume_idx, std::memory_order_release);
-        m_tick_consumed_cv.notify_one();
-    }
+    rend_flush_update_batch();
+
+    m_rend_last_consumed_sim_time_us = t1;
+
+    m_last_consumed_tick.store(tick_to_consume_idx, std::memory_order_release);
+    m_last_consumed_tick.notify_one();
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
@@ -376,7 +445,7 @@ const DynamicState& BaseStateManager<StaticState, DynamicState, Handle, Config>:
     Handle handle) const
 {
     MIZU_VERIFY(validate_handle(handle), "Can't get dynamic state of invalid handle");
-    return m_handle_state_info[handle.get_internal_id()].applied_ds;
+    return m_rend_applied_ds[handle.get_internal_id()];
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
@@ -411,6 +480,20 @@ std::string_view BaseStateManager<StaticState, DynamicState, Handle, Config>::ge
     return Config::Identifier;
 }
 
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+StateManagerTickStats BaseStateManager<StaticState, DynamicState, Handle, Config>::get_tick_stats() const
+{
+    StateManagerTickStats stats{};
+    stats.num_ticks_published = m_num_ticks_published.load(std::memory_order_relaxed);
+    stats.num_ticks_coalesced = m_num_ticks_coalesced.load(std::memory_order_relaxed);
+    stats.num_sim_stalls = m_num_sim_stalls.load(std::memory_order_relaxed);
+    stats.sim_stall_time_ns = m_sim_stall_time_ns.load(std::memory_order_relaxed);
+    stats.num_updates_published = m_num_updates_published.load(std::memory_order_relaxed);
+    stats.num_updates_suppressed = m_num_updates_suppressed.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
 //
 // Helpers
 //
@@ -428,23 +511,224 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::rend_notify_on
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
-void BaseStateManager<StaticState, DynamicState, Handle, Config>::rend_notify_on_update(
-    Handle handle,
-    const DynamicState& ds) const
+void BaseStateManager<StaticState, DynamicState, Handle, Config>::rend_notify_on_destroy(Handle handle) const
 {
     for (IStateManagerConsumer<SelfStateManager>* consumer : m_rend_consumers)
     {
-        consumer->rend_on_update(handle, ds);
+        consumer->rend_on_destroy(handle);
     }
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
-void BaseStateManager<StaticState, DynamicState, Handle, Config>::rend_notify_on_destroy(Handle handle) const
+void BaseStateManager<StaticState, DynamicState, Handle, Config>::rend_interpolate_update_batch(double alpha)
 {
+    if constexpr (DynamicStateHasInterpolateBatch<DynamicState>)
+    {
+        DynamicState::interpolate_batch(
+            std::span<const DynamicState>(m_rend_batch_from_ds),
+            std::span<const DynamicState>(m_rend_batch_ds),
+            alpha,
+            std::span<DynamicState>(m_rend_batch_ds));
+    }
+    else if constexpr (DynamicStateHasInterpolate<DynamicState>)
+    {
+        // Explicit instantiations also instantiate this function for states that don't interpolate
+        for (size_t i = 0; i < m_rend_batch_ds.size(); ++i)
+        {
+            m_rend_batch_ds[i] = m_rend_batch_from_ds[i].interpolate(m_rend_batch_ds[i], alpha);
+        }
+    }
+
+    for (size_t i = 0; i < m_rend_batch_handles.size(); ++i)
+    {
+        m_rend_applied_ds[m_rend_batch_handles[i].get_internal_id()] = m_rend_batch_ds[i];
+    }
+
+    m_rend_batch_from_ds.clear();
+}
+
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+void BaseStateManager<StaticState, DynamicState, Handle, Config>::rend_flush_update_batch()
+{
+    if (m_rend_batch_handles.empty())
+        return;
+
     for (IStateManagerConsumer<SelfStateManager>* consumer : m_rend_consumers)
     {
-        consumer->rend_on_destroy(handle);
+        consumer->rend_on_update_batch(
+            std::span<const Handle>(m_rend_batch_handles), std::span<const DynamicState>(m_rend_batch_ds));
+    }
+
+    m_rend_batch_handles.clear();
+    m_rend_batch_ds.clear();
+}
+
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_wait_for_free_tick(uint64_t last_produced_tick)
+{
+    const auto stall_start = std::chrono::steady_clock::now();
+
+    uint64_t last_consumed_tick = m_last_consumed_tick.load(std::memory_order_acquire);
+    while (last_produced_tick - last_consumed_tick >= MaxTicksAhead)
+    {
+        m_last_consumed_tick.wait(last_consumed_tick, std::memory_order_acquire);
+        last_consumed_tick = m_last_consumed_tick.load(std::memory_order_acquire);
+    }
+
+    const auto stall_time = std::chrono::steady_clock::now() - stall_start;
+
+    m_num_sim_stalls.fetch_add(1, std::memory_order_relaxed);
+    m_sim_stall_time_ns.fetch_add(
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stall_time).count()),
+        std::memory_order_relaxed);
+}
+
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+bool BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_try_coalesce_unconsumed_ticks(
+    uint64_t last_produced_tick)
+{
+    // The render may be interpolating the oldest unconsumed tick, coalesce into the first one it has not claimed. The
+    // render consumes ticks in order, so reopening that tick also keeps it away from all the newer ones.
+    uint64_t target_tick_idx = m_last_consumed_tick.load(std::memory_order_acquire) + 1;
+    for (; target_tick_idx < last_produced_tick; ++target_tick_idx)
+    {
+        TickState expected = TickState::Published;
+        if (m_ticks[target_tick_idx % MaxTicksAhead].state.compare_exchange_strong(
+                expected, TickState::Reopened, std::memory_order_acq_rel, std::memory_order_relaxed))
+            break;
+    }
+
+    if (target_tick_idx >= last_produced_tick)
+        return false;
+
+    Tick& target = m_ticks[target_tick_idx % MaxTicksAhead];
+
+    // m_pending_handle_ticks is unused between ticks, reuse it to find the entries of the target tick. The target can't
+    // reallocate while merging, the pointers would dangle.
+    uint64_t num_merged_handle_ticks = target.num_updated_handles;
+    for (uint64_t tick_idx = target_tick_idx + 1; tick_idx <= last_produced_tick; ++tick_idx)
+    {
+        num_merged_handle_ticks += m_ticks[tick_idx % MaxTicksAhead].num_updated_handles;
+    }
+
+    target.handle_ticks.reserve(num_merged_handle_ticks);
+
+    for (uint32_t i = 0; i < target.num_updated_handles; ++i)
+    {
+        m_pending_handle_ticks[target.handle_ticks[i].handle.get_internal_id()] = &target.handle_ticks[i];
+    }
+
+    for (uint64_t tick_idx = target_tick_idx + 1; tick_idx <= last_produced_tick; ++tick_idx)
+    {
+        sim_merge_tick(target, m_ticks[tick_idx % MaxTicksAhead]);
+    }
+
+    // Create followed by destroy leaves an invalid handle behind
+    const auto start_handle_ticks = target.handle_ticks.begin();
+    const auto end_handle_ticks =
+        std::next(start_handle_ticks, static_cast<std::ptrdiff_t>(target.num_updated_handles));
+    const auto new_end_it = std::remove_if(
+        start_handle_ticks, end_handle_ticks, [](const HandleTick& ht) { return !ht.handle.is_valid(); });
+
+    target.num_updated_handles = static_cast<uint32_t>(std::distance(start_handle_ticks, new_end_it));
+
+    for (uint32_t i = 0; i < target.num_updated_handles; ++i)
+    {
+        m_pending_handle_ticks[target.handle_ticks[i].handle.get_internal_id()] = nullptr;
+    }
+
+    target.sim_time_us = m_ticks[last_produced_tick % MaxTicksAhead].sim_time_us;
+
+    m_num_ticks_coalesced.fetch_add(last_produced_tick - target_tick_idx, std::memory_order_relaxed);
+
+    // The merged ticks were never claimed by the render, the next tick in production reuses their slots
+    m_last_produced_tick.store(target_tick_idx, std::memory_order_release);
+    target.state.store(TickState::Published, std::memory_order_release);
+
+    return true;
+}
+
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_merge_tick(Tick& target, const Tick& source)
+{
+    for (uint32_t i = 0; i < source.num_updated_handles; ++i)
+    {
+        const HandleTick& source_ht = source.handle_ticks[i];
+        const uint64_t handle_idx = source_ht.handle.get_internal_id();
+
+        if (m_pending_handle_ticks[handle_idx] == nullptr)
+        {
+            if (target.num_updated_handles == target.handle_ticks.size())
+                target.handle_ticks.push_back(source_ht);
+            else
+                target.handle_ticks[target.num_updated_handles] = source_ht;
+
+            m_pending_handle_ticks[handle_idx] = &target.handle_ticks[target.num_updated_handles];
+            target.num_updated_handles += 1;
+
+            continue;
+        }
+
+        HandleTick& target_ht = *m_pending_handle_ticks[handle_idx];
+        MIZU_ASSERT(
+            target_ht.handle == source_ht.handle && target_ht.event_kind != StateManagerEventKind::Destroy
+                && source_ht.event_kind != StateManagerEventKind::Create,
+            "Handle can't be recreated before its destroy tick is consumed");
+
+        // Same rules as multiple events on one handle in the same tick
+        if (source_ht.event_kind == StateManagerEventKind::Update)
+        {
+            target_ht.ds = source_ht.ds;
+        }
+        else if (target_ht.event_kind == StateManagerEventKind::Create)
+        {
+            // The render never saw the handle, drop both events
+            m_pending_handle_ticks[handle_idx] = nullptr;
+            sim_reset_and_recycle_handle(target_ht.handle);
+
+            target_ht.handle = Handle{};
+        }
+        else
+        {
+            target_ht.event_kind = StateManagerEventKind::Destroy;
+        }
+    }
+}
+
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_drop_unchanged_updates(Tick& tick)
+{
+    uint32_t num_kept = 0;
+    for (uint32_t i = 0; i < tick.num_updated_handles; ++i)
+    {
+        HandleTick& ht = tick.handle_ticks[i];
+        const uint64_t handle_idx = ht.handle.get_internal_id();
+
+        if (ht.event_kind == StateManagerEventKind::Update && !sim_has_changed(ht.ds, m_sim_published_ds[handle_idx]))
+        {
+            m_pending_handle_ticks[handle_idx] = nullptr;
+            m_num_updates_suppressed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (num_kept != i)
+            tick.handle_ticks[num_kept] = std::move(ht);
+
+        num_kept += 1;
     }
+
+    tick.num_updated_handles = num_kept;
+}
+
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+bool BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_has_changed(
+    const DynamicState& ds,
+    const DynamicState& previous) const
+{
+    if constexpr (ChangeEpsilon != 0.0f)
+        return ds.has_changed(previous, ChangeEpsilon);
+    else
+        return ds.has_changed(previous);
 }
 
 #define HandleTickCpp BaseStateManager<StaticState, DynamicState, Handle, Config>::HandleTick
@@ -454,15 +738,19 @@ HandleTickCpp& BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_
 {
     MIZU_ASSERT(m_tick_in_production != nullptr, "There is no tick in production");
 
-    const uint64_t tick_ring_idx = (m_tick_in_production->tick_idx % MaxTicksAhead) * Config::MaxNumHandles
-                                   + m_tick_in_production->num_updated_handles;
+    SimWriterStaging& staging = sim_get_writer_staging();
+    const uint32_t handle_tick_idx = staging.num_handle_ticks;
+
+    if (handle_tick_idx == staging.handle_ticks.size())
+        staging.handle_ticks.emplace_back();
 
-    HandleTick& handle_tick = m_handle_ticks[tick_ring_idx];
-    handle_tick = HandleTick{};
+    // The caller always writes the dynamic state, avoid copying it twice
+    HandleTick& handle_tick = staging.handle_ticks[handle_tick_idx];
     handle_tick.handle = handle;
+    handle_tick.event_kind = StateManagerEventKind::Update;
 
-    m_tick_in_production->num_updated_handles += 1;
-    m_pending_handles_idx[handle.get_internal_id()] = static_cast<uint32_t>(tick_ring_idx);
+    staging.num_handle_ticks += 1;
+    m_pending_handle_ticks[handle.get_internal_id()] = &handle_tick;
 
     return handle_tick;
 }
@@ -479,29 +767,105 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_reset_and_
 
     m_handle_generation[handle_id] += 1;
     m_handle_static_states[handle_id] = StaticState{};
-    m_handle_state_info[handle_id] = HandleStateInfo{};
-    m_available_handles.push(handle_id);
+    m_sim_published_ds[handle_id] = DynamicState{};
+    m_sim_alive[handle_id] = false;
+    m_rend_consumed_ds[handle_id] = DynamicState{};
+    m_rend_applied_ds[handle_id] = DynamicState{};
+
+    std::lock_guard lock(m_sim_handles_mutex);
+    m_available_handles.push_back(handle_id);
 }
 
+#define SimWriterStagingCpp BaseStateManager<StaticState, DynamicState, Handle, Config>::SimWriterStaging
+
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
-HandleTickCpp* BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_get_pending_handle_tick(Handle handle)
+SimWriterStagingCpp& BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_get_writer_staging()
 {
-    const uint32_t pending_handle_idx = m_pending_handles_idx[handle.get_internal_id()];
-    if (pending_handle_idx == INVALID_PENDING_IDX)
-        return nullptr;
+    std::atomic<SimWriterStaging*>& slot = m_sim_writer_stagings[get_state_manager_sim_writer_slot()];
 
-    return &m_handle_ticks[pending_handle_idx];
+    // Only the thread that owns the slot allocates its staging
+    SimWriterStaging* staging = slot.load(std::memory_order_acquire);
+    if (staging == nullptr)
+    {
+        staging = new SimWriterStaging{};
+        slot.store(staging, std::memory_order_release);
+    }
+
+    return *staging;
+}
+
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_merge_staged_handle_ticks(Tick& tick)
+{
+    const auto append_handle_tick = [&tick](uint32_t& num_handle_ticks, HandleTick&& ht) {
+        if (num_handle_ticks == tick.handle_ticks.size())
+            tick.handle_ticks.push_back(std::move(ht));
+        else
+            tick.handle_ticks[num_handle_ticks] = std::move(ht);
+
+        num_handle_ticks += 1;
+    };
+
+    // Entries created and destroyed in the same tick are left with an invalid handle. The tick only has entries when
+    // DropIntermediate kept it open.
+    uint32_t num_handle_ticks = 0;
+    for (uint32_t i = 0; i < tick.num_updated_handles; ++i)
+    {
+        if (!tick.handle_ticks[i].handle.is_valid())
+            continue;
+
+        if (num_handle_ticks != i)
+            tick.handle_ticks[num_handle_ticks] = std::move(tick.handle_ticks[i]);
+
+        num_handle_ticks += 1;
+    }
+
+    const uint32_t first_staged_idx = num_handle_ticks;
+    uint32_t num_writers = 0;
+
+    for (std::atomic<SimWriterStaging*>& slot : m_sim_writer_stagings)
+    {
+        SimWriterStaging* staging = slot.load(std::memory_order_acquire);
+        if (staging == nullptr || staging->num_handle_ticks == 0)
+            continue;
+
+        for (uint32_t i = 0; i < staging->num_handle_ticks; ++i)
+        {
+            HandleTick& ht = staging->handle_ticks[i];
+            if (ht.handle.is_valid())
+                append_handle_tick(num_handle_ticks, std::move(ht));
+        }
+
+        staging->num_handle_ticks = 0;
+        num_writers += 1;
+    }
+
+    tick.num_updated_handles = num_handle_ticks;
+
+    // Slots depend on which threads did the writes, sort so the tick doesn't depend on scheduling. A single writer
+    // keeps the order of its writes.
+    if (num_writers > 1)
+    {
+        const auto start_staged = std::next(tick.handle_ticks.begin(), static_cast<std::ptrdiff_t>(first_staged_idx));
+        const auto end_staged = std::next(tick.handle_ticks.begin(), static_cast<std::ptrdiff_t>(num_handle_ticks));
+
+        std::sort(start_staged, end_staged, [](const HandleTick& a, const HandleTick& b) {
+            return a.handle.get_internal_id() < b.handle.get_internal_id();
+        });
+    }
+}
+
+template <typename StaticState, typename DynamicState, typename Handle, typename Config>
+HandleTickCpp* BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_get_pending_handle_tick(Handle handle)
+{
+    return m_pending_handle_ticks[handle.get_internal_id()];
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
 const HandleTickCpp* BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_get_pending_handle_tick(
     Handle handle) const
 {
-    const uint32_t pending_handle_idx = m_pending_handles_idx[handle.get_internal_id()];
-    if (pending_handle_idx == INVALID_PENDING_IDX)
-        return nullptr;
-
-    return &m_handle_ticks[pending_handle_idx];
+    return m_pending_handle_ticks[handle.get_internal_id()];
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
@@ -509,14 +873,15 @@ void BaseStateManager<StaticState, DynamicState, Handle, Config>::sim_validate_h
     [[maybe_unused]] Handle handle) const
 {
     MIZU_ASSERT(
-        m_handle_state_info[handle.get_internal_id()].sim_alive,
+        m_sim_alive[handle.get_internal_id()],
         "Trying to access the dynamic state of a handle that is not alive on sim side");
 }
 
 template <typename StaticState, typename DynamicState, typename Handle, typename Config>
 bool BaseStateManager<StaticState, DynamicState, Handle, Config>::validate_handle(Handle handle) const
 {
-    const bool valid = handle.is_valid() && handle.get_generation() == m_handle_generation[handle.get_internal_id()];
+    const bool valid = handle.is_valid() && m_handle_generation.is_allocated(handle.get_internal_id())
+                       && handle.get_generation() == m_handle_generation[handle.get_internal_id()];
     MIZU_ASSERT(valid, "Invalid handle");
 
     return valid;
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+#include "mizu_state_manager_module.h"
+
+namespace Mizu
+{
+
+// Max number of threads alive at the same time that can write to the sim side of the state managers
+constexpr uint32_t MaxStateManagerSimWriters = 256;
+
+// Slot in [0, MaxStateManagerSimWriters) of the calling thread, used to pick its staging buffer in the state managers.
+// Assigned on first use and released when the thread exits.
+MIZU_STATE_MANAGER_API uint32_t get_state_manager_sim_writer_slot();
+
+} // namespace Mizu
@@ -3,6 +3,7 @@
 #include <concepts>
 #include <cstdint>
 #include <limits>
+#include <span>
 #include <string_view>
 
 namespace Mizu
@@ -59,6 +60,18 @@ concept DynamicStateHasInterpolate = requires(const T& t, const T& ds, double al
     { t.interpolate(ds, alpha) } -> std::convertible_to<T>;
 };
 
+// Optional, interpolates a whole batch of dynamic states at once. `out` can alias `to`.
+template <typename T>
+concept DynamicStateHasInterpolateBatch = requires(std::span<const T> from, std::span<const T> to, std::span<T> out) {
+    T::interpolate_batch(from, to, 0.5, out);
+};
+
+// Optional, has_changed with a custom tolerance, used by configs that define a ChangeEpsilon
+template <typename T>
+concept DynamicStateHasChangedWithEpsilon = requires(const T& t, const T& previous, float epsilon) {
+    { t.has_changed(previous, epsilon) } -> std::convertible_to<bool>;
+};
+
 template <typename T, bool Interpolate>
 concept IsDynamicState = requires(const T& t, const T& ds) {
     { t.has_changed(ds) } -> std::convertible_to<bool>;
@@ -82,6 +95,18 @@ enum class StateManagerEventKind : uint8_t
     Destroy,
 };
 
+// What the sim does when it is MaxTicksAhead ticks ahead of the render
+enum class StateManagerOverflowPolicy : uint8_t
+{
+    // Wait until the render consumes a tick
+    Block,
+    // Merge the ticks the render has not started consuming into one, keeping only the latest state of each handle
+    CoalesceOldest,
+    // Keep the tick in production open across sim ticks until the render frees a slot, later updates to a handle
+    // overwrite the intermediate ones
+    DropIntermediate,
+};
+
 struct TickUpdateState
 {
     uint64_t sim_time_us;
@@ -97,6 +122,9 @@ class IStateManager
   public:
     virtual ~IStateManager() = default;
 
+    // Waits until there is room for a new tick, called on the sim thread before sim_begin_tick is dispatched so the
+    // jobs running sim_begin_tick never block a worker
+    virtual void sim_make_room_for_tick() {}
     virtual void sim_begin_tick(const TickUpdateState& state) = 0;
     virtual void sim_end_tick() = 0;
 
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
+
+#include "base/debug/assert.h"
+
 namespace Mizu
 {
 
@@ -27,6 +32,17 @@ class IStateManagerConsumer
     virtual void rend_on_create(Handle handle, const StaticState& ss, const DynamicState& ds) = 0;
     virtual void rend_on_update(Handle handle, const DynamicState& ds) = 0;
     virtual void rend_on_destroy(Handle handle) = 0;
+
+    // Receives consecutive updates of a tick in a single call, by default forwards each one to rend_on_update
+    virtual void rend_on_update_batch(std::span<const Handle> handles, std::span<const DynamicState> dss)
+    {
+        MIZU_ASSERT(handles.size() == dss.size(), "Handles and dynamic states must have the same size");
+
+        for (size_t i = 0; i < handles.size(); ++i)
+        {
+            rend_on_update(handles[i], dss[i]);
+        }
+    }
 };
 
 } // namespace Mizu
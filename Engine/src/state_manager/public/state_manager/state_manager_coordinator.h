@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 
@@ -13,6 +14,7 @@ namespace Mizu
 
 struct TickUpdateState;
 struct FrameUpdateState;
+class JobSystem;
 
 constexpr size_t MAX_STATE_MANAGER_DEPENDENCIES = 10;
 
@@ -42,13 +44,26 @@ class MIZU_STATE_MANAGER_API StateManagerRegistrationBuilder
     friend class StateManagerCoordinator;
 };
 
+struct StateManagerCoordinatorDescription
+{
+    // Used to run independent state managers in parallel, if nullptr they are always run serially
+    JobSystem* job_system = nullptr;
+    // Runs the state managers one after another on the calling thread, in topological order
+    bool serial_dispatch = false;
+};
+
 class MIZU_STATE_MANAGER_API StateManagerCoordinator
 {
   public:
     StateManagerCoordinator() = default;
+    explicit StateManagerCoordinator(const StateManagerCoordinatorDescription& desc);
 
     void register_state_manager(const StateManagerRegistrationBuilder& builder);
 
+    // Can be toggled at runtime for debugging, takes effect on the next dispatch
+    void set_serial_dispatch(bool serial_dispatch);
+    bool is_serial_dispatch() const;
+
     void sim_begin_tick(const TickUpdateState& state) const;
     void sim_end_tick() const;
 
@@ -63,12 +78,23 @@ class MIZU_STATE_MANAGER_API StateManagerCoordinator
         inplace_vector<size_t, MAX_STATE_MANAGER_DEPENDENCIES> outputs;
     };
 
+    JobSystem* m_job_system = nullptr;
+    std::atomic<bool> m_serial_dispatch = false;
+
     std::vector<IStateManager*> m_state_managers;
     std::vector<StateManagerInfo> m_state_manager_infos;
 
+    // Positions in m_state_manager_infos, same order as m_state_managers
+    std::vector<size_t> m_topological_order;
+
     std::unordered_map<size_t, size_t> m_state_manager_to_infos_pos;
 
     void build();
+
+    // Calls `func(IStateManager*)` for every state manager, a state manager is only called once all of its inputs
+    // have finished. Returns once all of them have been called.
+    template <typename Func>
+    void dispatch(const Func& func) const;
 };
 
 } // namespace Mizu
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "core/job_system/job_system.h"
+
+using namespace Mizu;
+
+struct JobHandleBenchmarkScope
+{
+    JobSystem job_system;
+    bool initialized = false;
+
+    JobHandleBenchmarkScope()
+    {
+        JobSystemDescription desc{};
+        desc.num_workers = 2;
+        desc.reserve_main_thread = false;
+
+        initialized = job_system.init(desc);
+    }
+
+    ~JobHandleBenchmarkScope()
+    {
+        if (initialized)
+        {
+            job_system.wait_workers_dead();
+        }
+    }
+};
+
+// Runs `func(thread_index)` on `num_threads` threads at the same time, all of them touching the same handle
+template <typename Func>
+static void run_job_handle_benchmark_threads(size_t num_threads, Func&& func)
+{
+    std::atomic<bool> start = false;
+    std::vector<std::thread> threads;
+
+    for (size_t thread_index = 0; thread_index < num_threads; ++thread_index)
+    {
+        threads.emplace_back([&, thread_index] {
+            while (!start.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            func(thread_index);
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST_CASE("JobHandle shared completion record traffic", "[JobSystem][JobHandle]")
+{
+    constexpr size_t NumThreads = 4;
+    constexpr size_t NumHandlesPerThread = 4096;
+
+    JobHandleBenchmarkScope scope;
+    REQUIRE(scope.initialized);
+
+    JobSystem& job_system = scope.job_system;
+
+    // Every thread declares the same upstream job as a dependency many times, like a frame graph fanning out from a
+    // single wait job
+    const JobHandle shared = job_system.schedule([] {}).submit();
+    REQUIRE(job_system.wait_for_blocking(shared));
+
+    BENCHMARK("JobHandle copies (4 threads x 4096)")
+    {
+        run_job_handle_benchmark_threads(NumThreads, [&](size_t) {
+            std::vector<JobHandle> handles(NumHandlesPerThread);
+            for (JobHandle& handle : handles)
+            {
+                handle = shared;
+            }
+        });
+    };
+
+    BENCHMARK("JobHandleRef copies (4 threads x 4096)")
+    {
+        run_job_handle_benchmark_threads(NumThreads, [&](size_t) {
+            std::vector<JobHandleRef> handles(NumHandlesPerThread);
+            for (JobHandleRef& handle : handles)
+            {
+                handle = shared;
+            }
+        });
+    };
+
+    BENCHMARK("JobHandle copies released in batch (4 threads x 4096)")
+    {
+        run_job_handle_benchmark_threads(NumThreads, [&](size_t) {
+            std::vector<JobHandle> handles(NumHandlesPerThread);
+            for (JobHandle& handle : handles)
+            {
+                handle = shared;
+            }
+
+            job_system.release_handles(handles);
+        });
+    };
+}
+
+TEST_CASE("JobHandle dependency declaration", "[JobSystem][JobHandle]")
+{
+    constexpr size_t NumUpstreamJobs = 8;
+    constexpr size_t NumDownstreamJobs = 256;
+
+    JobHandleBenchmarkScope scope;
+    REQUIRE(scope.initialized);
+
+    JobSystem& job_system = scope.job_system;
+
+    std::vector<JobHandle> upstream;
+    for (size_t i = 0; i < NumUpstreamJobs; ++i)
+    {
+        upstream.push_back(job_system.schedule([] {}).submit());
+    }
+
+    for (const JobHandle& handle : upstream)
+    {
+        REQUIRE(job_system.wait_for_blocking(handle));
+    }
+
+    std::vector<JobHandle> downstream;
+    downstream.reserve(NumDownstreamJobs);
+
+    BENCHMARK("256 jobs x 8 dependencies")
+    {
+        downstream.clear();
+
+        for (size_t i = 0; i < NumDownstreamJobs; ++i)
+        {
+            downstream.push_back(job_system.schedule([] {}).depends_on(upstream).submit());
+        }
+
+        for (const JobHandle& handle : downstream)
+        {
+            job_system.wait_for_blocking(handle);
+        }
+
+        job_system.release_handles(downstream);
+        return downstream.size();
+    };
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "core/job_system/mpsc_queue.h"
+#include "core/job_system/work_stealing_deque.h"
+
+using namespace Mizu;
+
+void wait_for_queue_benchmark_start(const std::atomic<bool>& start)
+{
+    while (!start.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+TEST_CASE("MpscQueue contended push/pop", "[MpscQueue]")
+{
+    constexpr size_t NumProducers = 4;
+    constexpr size_t ItemsPerProducer = 4096;
+
+    BENCHMARK("4 producers, 1 consumer (16k items)")
+    {
+        MpscQueue<size_t, 1024> queue;
+
+        std::atomic<bool> start = false;
+        std::vector<std::thread> producers;
+
+        for (size_t producer_index = 0; producer_index < NumProducers; ++producer_index)
+        {
+            producers.emplace_back([&, producer_index] {
+                wait_for_queue_benchmark_start(start);
+
+                for (size_t item = 0; item < ItemsPerProducer; ++item)
+                {
+                    while (!queue.push(producer_index * ItemsPerProducer + item))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        start.store(true, std::memory_order_release);
+
+        size_t num_popped = 0;
+        size_t value = 0;
+        while (num_popped < NumProducers * ItemsPerProducer)
+        {
+            if (queue.pop(value))
+                num_popped += 1;
+        }
+
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+
+        return num_popped;
+    };
+}
+
+TEST_CASE("WorkStealingDeque push/pop", "[WorkStealingDeque]")
+{
+    constexpr int32_t NumItems = 4096;
+    constexpr size_t NumThieves = 3;
+
+    BENCHMARK("owner only (4k items)")
+    {
+        WorkStealingDeque<int32_t, NumItems> deque;
+
+        for (int32_t i = 0; i < NumItems; ++i)
+        {
+            deque.push(i);
+        }
+
+        int32_t value = 0;
+        int32_t num_popped = 0;
+        while (deque.pop(value))
+        {
+            num_popped += 1;
+        }
+
+        return num_popped;
+    };
+
+    BENCHMARK("owner push/pop with 3 thieves (4k items)")
+    {
+        WorkStealingDeque<int32_t, NumItems> deque;
+
+        std::atomic<bool> start = false;
+        std::atomic<bool> done = false;
+        std::atomic<int32_t> num_consumed = 0;
+
+        std::vector<std::thread> thieves;
+        for (size_t thief_index = 0; thief_index < NumThieves; ++thief_index)
+        {
+            thieves.emplace_back([&] {
+                wait_for_queue_benchmark_start(start);
+
+                int32_t value = 0;
+                while (!done.load(std::memory_order_acquire))
+                {
+                    if (deque.steal(value))
+                        num_consumed.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        start.store(true, std::memory_order_release);
+
+        int32_t value = 0;
+        for (int32_t i = 0; i < NumItems; ++i)
+        {
+            deque.push(i);
+
+            // Pop every other item so the owner and the thieves race on the bottom of the deque
+            if ((i & 1) != 0 && deque.pop(value))
+                num_consumed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        while (deque.pop(value))
+        {
+            num_consumed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        while (num_consumed.load(std::memory_order_relaxed) != NumItems)
+        {
+            std::this_thread::yield();
+        }
+
+        done.store(true, std::memory_order_release);
+
+        for (std::thread& thief : thieves)
+        {
+            thief.join();
+        }
+
+        return num_consumed.load(std::memory_order_relaxed);
+    };
+}
@@ -0,0 +1,189 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "base/debug/logging.h"
+
+#include "core/job_system/fibers.h"
+#include "core/job_system/job_system.h"
+
+using namespace Mizu;
+
+struct JobSystemSchedulerBenchmarkScope
+{
+    JobSystem job_system;
+    bool initialized = false;
+
+    explicit JobSystemSchedulerBenchmarkScope(bool enable_worker_counters = false)
+    {
+        JobSystemDescription desc{};
+        desc.num_workers = std::max(std::thread::hardware_concurrency(), 2u);
+        desc.reserve_main_thread = false;
+        desc.enable_worker_counters = enable_worker_counters;
+
+        initialized = job_system.init(desc);
+    }
+
+    ~JobSystemSchedulerBenchmarkScope()
+    {
+        if (initialized)
+        {
+            job_system.wait_workers_dead();
+        }
+    }
+};
+
+struct FiberPingPongState
+{
+    FiberHandle main_fiber{};
+    FiberHandle child_fiber{};
+};
+
+static void fiber_ping_pong_entry(void* arg)
+{
+    auto* state = static_cast<FiberPingPongState*>(arg);
+
+    while (true)
+    {
+        fiber_switch(state->child_fiber, state->main_fiber);
+    }
+}
+
+TEST_CASE("fiber_switch round trip", "[Fibers]")
+{
+    alignas(16) static std::array<uint8_t, 16 * 1024> stack{};
+
+    FiberPingPongState state{};
+    state.main_fiber = fiber_convert_thread_to_fiber();
+    state.child_fiber = fiber_create(stack.data(), stack.size(), &fiber_ping_pong_entry, &state);
+
+    BENCHMARK("main -> child -> main")
+    {
+        fiber_switch(state.main_fiber, state.child_fiber);
+    };
+}
+
+TEST_CASE("JobSystem scheduling overhead", "[JobSystem]")
+{
+    constexpr size_t NumJobs = 1024;
+    constexpr size_t ChainLength = 128;
+    constexpr size_t FanOutWidth = 64;
+
+    JobSystemSchedulerBenchmarkScope scope;
+    REQUIRE(scope.initialized);
+
+    JobSystem& job_system = scope.job_system;
+
+    BENCHMARK("empty job throughput (1024 jobs)")
+    {
+        std::vector<JobHandle> handles;
+        handles.reserve(NumJobs);
+
+        for (size_t i = 0; i < NumJobs; ++i)
+        {
+            handles.push_back(job_system.schedule([] {}).submit());
+        }
+
+        for (const JobHandle& handle : handles)
+        {
+            job_system.wait_for_blocking(handle);
+        }
+
+        return handles.size();
+    };
+
+    BENCHMARK("dependency chain latency (128 jobs)")
+    {
+        JobHandle previous = job_system.schedule([] {}).submit();
+        for (size_t i = 1; i < ChainLength; ++i)
+        {
+            previous = job_system.schedule([] {}).depends_on(previous).submit();
+        }
+
+        return job_system.wait_for_blocking(previous);
+    };
+
+    BENCHMARK("fan-out / fan-in (1 -> 64 -> 1)")
+    {
+        JobHandle root = job_system.schedule([] {}).submit();
+
+        PendingBatch batch = job_system.schedule_batch();
+        for (size_t i = 0; i < FanOutWidth; ++i)
+        {
+            batch.add([] {});
+        }
+
+        JobHandle fan_out = batch.depends_on(root).submit();
+        JobHandle fan_in = job_system.schedule([] {}).depends_on(fan_out).submit();
+
+        return job_system.wait_for_blocking(fan_in);
+    };
+
+    BENCHMARK("suspended fiber resume (128 wait_for)")
+    {
+        JobHandle handle = job_system
+                               .schedule([&job_system] {
+                                   for (size_t i = 0; i < ChainLength; ++i)
+                                   {
+                                       JobHandle child = job_system.schedule([] {}).submit();
+                                       job_system.wait_for(child);
+                                   }
+                               })
+                               .submit();
+
+        return job_system.wait_for_blocking(handle);
+    };
+}
+
+TEST_CASE("JobSystem worker counters under fan-out", "[JobSystem]")
+{
+    constexpr size_t NumIterations = 256;
+    constexpr size_t FanOutWidth = 64;
+
+    JobSystemSchedulerBenchmarkScope scope(true);
+    REQUIRE(scope.initialized);
+
+    JobSystem& job_system = scope.job_system;
+
+    BENCHMARK("fan-out (64 jobs) with worker counters")
+    {
+        PendingBatch batch = job_system.schedule_batch();
+        for (size_t i = 0; i < FanOutWidth; ++i)
+        {
+            batch.add([] {});
+        }
+
+        JobHandle handle = batch.submit();
+        return job_system.wait_for_blocking(handle);
+    };
+
+    for (size_t iteration = 0; iteration < NumIterations; ++iteration)
+    {
+        JobHandle handle = job_system.parallel_for(JobRange{0, FanOutWidth * 16}, 16, [](size_t) {});
+        job_system.wait_for_blocking(handle);
+    }
+
+    const JobSystemCounters counters = job_system.get_counters();
+    for (size_t worker_id = 0; worker_id < counters.workers.size(); ++worker_id)
+    {
+        const JobWorkerCounters& worker = counters.workers[worker_id];
+
+        const double num_steal_attempts = static_cast<double>(worker.num_steal_attempts);
+        [[maybe_unused]] const double steal_rate =
+            num_steal_attempts > 0.0 ? static_cast<double>(worker.num_steals) / num_steal_attempts : 0.0;
+
+        MIZU_LOG_INFO(
+            "Worker {}: {} jobs, {}/{} steals ({:.1f}%), {:.3f} ms idle",
+            worker_id,
+            worker.num_jobs_executed,
+            worker.num_steals,
+            worker.num_steal_attempts,
+            steal_rate * 100.0,
+            static_cast<double>(worker.idle_time_ns) / 1e6);
+    }
+}
@@ -0,0 +1,82 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/job_system/job_system.h"
+
+using namespace Mizu;
+
+struct JobSystemBenchmarkScope
+{
+    JobSystem job_system;
+    bool initialized = false;
+
+    ~JobSystemBenchmarkScope()
+    {
+        if (initialized)
+        {
+            job_system.wait_workers_dead();
+        }
+    }
+};
+
+static void parallel_for_benchmark_kernel(std::vector<float>& values, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        values[i] = std::sqrt(values[i] * 1.5f + 1.0f);
+    }
+}
+
+TEST_CASE("parallel_for against hand-batched loops", "[JobSystem][parallel_for]")
+{
+    // Same as PendingBatch::MaxBatchJobs
+    constexpr size_t NumBatchJobs = 64;
+    constexpr size_t GrainSize = 256;
+
+    JobSystemBenchmarkScope scope;
+    REQUIRE(scope.job_system.init(std::max(std::thread::hardware_concurrency(), 2u), false));
+    scope.initialized = true;
+
+    JobSystem& job_system = scope.job_system;
+
+    for (const size_t num_elements : {size_t{1'000}, size_t{10'000}, size_t{100'000}})
+    {
+        std::vector<float> values(num_elements, 1.0f);
+        const std::string suffix = " (" + std::to_string(num_elements) + " elements)";
+
+        BENCHMARK("serial" + suffix)
+        {
+            parallel_for_benchmark_kernel(values, 0, num_elements);
+            return values[0];
+        };
+
+        BENCHMARK("hand-batched" + suffix)
+        {
+            const size_t chunk_size = (num_elements + NumBatchJobs - 1) / NumBatchJobs;
+
+            PendingBatch batch = job_system.schedule_batch();
+            for (size_t begin = 0; begin < num_elements; begin += chunk_size)
+            {
+                const size_t end = std::min(begin + chunk_size, num_elements);
+                batch.add([&values, begin, end] { parallel_for_benchmark_kernel(values, begin, end); });
+            }
+
+            JobHandle handle = batch.submit();
+            return job_system.wait_for_blocking(handle);
+        };
+
+        BENCHMARK("parallel_for" + suffix)
+        {
+            JobHandle handle = job_system.parallel_for(JobRange{0, num_elements}, GrainSize, [&](JobRange chunk) {
+                parallel_for_benchmark_kernel(values, chunk.begin, chunk.end);
+            });
+            return job_system.wait_for_blocking(handle);
+        };
+    }
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/math/aabb.h"
+#include "render/core/bounding_volume_hierarchy.h"
+#include "render/core/frustum_culling.h"
+
+#include "culling_test_utils.h"
+
+using namespace Mizu;
+
+// Objects spread over a 2km x 2km area, like an open world scene
+static const RandomBoxesDescription BvhBenchmarkScene{
+    .min_position = glm::vec3(-1000.0f, 0.0f, -1000.0f),
+    .max_position = glm::vec3(1000.0f, 20.0f, 1000.0f),
+    .min_size = 0.5f,
+    .max_size = 8.0f,
+};
+
+TEST_CASE("BoundingVolumeHierarchy scene culling", "[Render][BoundingVolumeHierarchy]")
+{
+    constexpr size_t NumObjects = 100'000;
+
+    const std::vector<AABB> boxes = make_random_boxes(NumObjects, 99, BvhBenchmarkScene);
+
+    BENCHMARK("build (100000 objects)")
+    {
+        BoundingVolumeHierarchy bvh;
+        for (size_t i = 0; i < NumObjects; ++i)
+        {
+            bvh.insert(boxes[i], static_cast<uint32_t>(i));
+        }
+        return bvh.get_height();
+    };
+
+    BoundingVolumeHierarchy bvh;
+    std::vector<uint32_t> leaves;
+    leaves.reserve(NumObjects);
+
+    CullingBounds bounds;
+
+    for (size_t i = 0; i < NumObjects; ++i)
+    {
+        leaves.push_back(bvh.insert(boxes[i], static_cast<uint32_t>(i)));
+        bounds.push_back(boxes[i]);
+    }
+
+    BENCHMARK("update 10% of the objects with small movements (100000 objects)")
+    {
+        // Moving back and forth keeps the scene the same between runs
+        for (size_t i = 0; i < NumObjects; i += 10)
+        {
+            const glm::vec3 offset{0.1f, 0.0f, 0.1f};
+            bvh.update(leaves[i], AABB(boxes[i].min() + offset, boxes[i].max() + offset));
+            bvh.update(leaves[i], boxes[i]);
+        }
+        return bvh.get_height();
+    };
+
+    std::vector<uint32_t> visible;
+    visible.reserve(NumObjects);
+    BoundingVolumeHierarchy::QueryScratch query_scratch;
+
+    std::vector<uint64_t> visibility_mask(get_visibility_mask_word_count(NumObjects));
+    std::vector<uint32_t> visible_indices(NumObjects);
+
+    // Far planes that see a small, medium and big part of the scene
+    for (const float zfar : {50.0f, 200.0f, 1000.0f})
+    {
+        const Frustum frustum =
+            make_test_frustum(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, 10.0f, -1.0f), 60.0f, zfar);
+
+        visible.clear();
+        bvh.query(frustum, FrustumMask{}, visible);
+
+        const std::string suffix = " (zfar " + std::to_string(static_cast<int>(zfar)) + ", "
+                                   + std::to_string(visible.size()) + " / 100000 visible)";
+
+        BENCHMARK("scalar is_inside_frustum" + suffix)
+        {
+            size_t num_visible = 0;
+            for (const AABB& box : boxes)
+            {
+                num_visible += frustum.is_inside_frustum(box) ? 1 : 0;
+            }
+            return num_visible;
+        };
+
+        BENCHMARK("cull_frustums + compact_visible_indices" + suffix)
+        {
+            const FrustumMask mask{};
+            cull_frustums(std::span(&frustum, 1), std::span(&mask, 1), bounds, visibility_mask);
+            return compact_visible_indices(visibility_mask, visible_indices);
+        };
+
+        BENCHMARK("BoundingVolumeHierarchy::query" + suffix)
+        {
+            visible.clear();
+            bvh.query(frustum, FrustumMask{}, visible, query_scratch);
+            return visible.size();
+        };
+    }
+}
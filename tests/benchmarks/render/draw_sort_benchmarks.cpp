@@ -0,0 +1,174 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/utils/hash.h"
+#include "base/utils/radix_sort.h"
+#include "render/resources/gpu_resource_types.h"
+#include "shader/shader_declaration.h"
+
+using namespace Mizu;
+
+// Same payload as the `DrawElement` built by `DrawListSystem::compile_draw_list_job`
+struct BenchmarkDrawElement
+{
+    GpuMeshDrawPayload mesh_draw{};
+
+    ShaderInstance vertex_instance{};
+    ShaderInstance fragment_instance{};
+
+    uint32_t instance_count = 0;
+    uint32_t material_buffer_offset = std::numeric_limits<uint32_t>::max();
+    uint32_t transform_buffer_offset = std::numeric_limits<uint32_t>::max();
+    uint32_t draw_index = std::numeric_limits<uint32_t>::max();
+
+    size_t sort_key = 0;
+    size_t pipeline_hash = 0;
+
+    std::string_view debug_name;
+};
+
+struct BenchmarkDrawable
+{
+    GpuMeshDrawPayload mesh_draw{};
+    uint64_t mesh_id = 0;
+    uint32_t material_buffer_offset = 0;
+    uint32_t transform_slot = 0;
+    size_t pipeline_hash = 0;
+    float depth = 0.0f;
+};
+
+// A few pipelines, 256 materials and a mesh shared by every 8 drawables on average
+static std::vector<BenchmarkDrawable> make_benchmark_drawables(size_t count)
+{
+    std::mt19937_64 rng(1234);
+    std::uniform_int_distribution<uint64_t> mesh_dist(0, std::max<uint64_t>(count / 8, 1));
+    std::uniform_int_distribution<uint32_t> material_dist(0, 255);
+    std::uniform_int_distribution<size_t> pipeline_dist(0, 3);
+    std::uniform_real_distribution<float> depth_dist(0.1f, 500.0f);
+
+    std::vector<BenchmarkDrawable> drawables(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint64_t mesh_id = mesh_dist(rng);
+
+        drawables[i] = BenchmarkDrawable{
+            .mesh_draw = {.index_count = 36, .first_index = static_cast<uint32_t>(mesh_id * 36)},
+            .mesh_id = mesh_id,
+            .material_buffer_offset = material_dist(rng) * 64,
+            .transform_slot = static_cast<uint32_t>(i),
+            .pipeline_hash = std::hash<size_t>{}(pipeline_dist(rng)),
+            .depth = depth_dist(rng),
+        };
+    }
+
+    return drawables;
+}
+
+static uint64_t create_benchmark_sort_key(const BenchmarkDrawable& drawable)
+{
+    const uint64_t depth = std::bit_cast<uint32_t>(drawable.depth) >> 16;
+
+    return ((drawable.pipeline_hash & 0xFF) << 56) | ((uint64_t{drawable.material_buffer_offset} & 0xFFFFF) << 36)
+           | ((drawable.mesh_id & 0xFFFFF) << 16) | depth;
+}
+
+static BenchmarkDrawElement make_benchmark_draw_element(
+    const BenchmarkDrawable& drawable,
+    const ShaderInstance& vertex_instance,
+    const ShaderInstance& fragment_instance)
+{
+    return BenchmarkDrawElement{
+        .mesh_draw = drawable.mesh_draw,
+        .vertex_instance = vertex_instance,
+        .fragment_instance = fragment_instance,
+        .instance_count = 1,
+        .material_buffer_offset = drawable.material_buffer_offset,
+        .transform_buffer_offset = drawable.transform_slot,
+        .draw_index = 0,
+        .sort_key = hash_compute(drawable.pipeline_hash, drawable.mesh_id, drawable.material_buffer_offset),
+        .pipeline_hash = drawable.pipeline_hash,
+        .debug_name = "Mesh",
+    };
+}
+
+TEST_CASE("Draw element sorting", "[Render][DrawSort]")
+{
+    ShaderInstance vertex_instance{"/EngineShaders/Benchmark.slang", "vsMain", ShaderType::Vertex, {}};
+    vertex_instance.environment.set_define("MIZU_BENCHMARK_PERMUTATION", 1);
+
+    ShaderInstance fragment_instance{"/EngineShaders/Benchmark.slang", "fsMain", ShaderType::Fragment, {}};
+    fragment_instance.environment.set_define("MIZU_BENCHMARK_PERMUTATION", 1);
+
+    for (const size_t num_elements : {size_t{1'000}, size_t{10'000}, size_t{100'000}})
+    {
+        const std::string suffix = " (" + std::to_string(num_elements) + " elements)";
+
+        const std::vector<BenchmarkDrawable> drawables = make_benchmark_drawables(num_elements);
+
+        std::vector<BenchmarkDrawElement> elements(num_elements);
+
+        std::vector<uint64_t> keys(num_elements), tmp_keys(num_elements);
+        std::vector<uint32_t> indices(num_elements), tmp_indices(num_elements);
+
+        // Previous path: build every element, then sort the elements
+        BENCHMARK("build + std::sort DrawElement" + suffix)
+        {
+            for (size_t i = 0; i < num_elements; ++i)
+            {
+                elements[i] = make_benchmark_draw_element(drawables[i], vertex_instance, fragment_instance);
+            }
+
+            std::sort(elements.begin(), elements.end(), [](const auto& a, const auto& b) {
+                if (a.pipeline_hash != b.pipeline_hash)
+                    return a.pipeline_hash < b.pipeline_hash;
+
+                if (a.material_buffer_offset != b.material_buffer_offset)
+                    return a.material_buffer_offset < b.material_buffer_offset;
+
+                return a.sort_key < b.sort_key;
+            });
+
+            return elements[0].transform_buffer_offset;
+        };
+
+        // Current path: sort packed keys with indices, then build the elements in the final order
+        BENCHMARK("radix_sort keys + gather DrawElement" + suffix)
+        {
+            for (size_t i = 0; i < num_elements; ++i)
+            {
+                keys[i] = create_benchmark_sort_key(drawables[i]);
+                indices[i] = static_cast<uint32_t>(i);
+            }
+
+            radix_sort(keys, indices, tmp_keys, tmp_indices);
+
+            for (size_t i = 0; i < num_elements; ++i)
+            {
+                elements[i] = make_benchmark_draw_element(drawables[indices[i]], vertex_instance, fragment_instance);
+            }
+
+            return elements[0].transform_buffer_offset;
+        };
+
+        BENCHMARK("radix_sort keys only" + suffix)
+        {
+            for (size_t i = 0; i < num_elements; ++i)
+            {
+                keys[i] = create_benchmark_sort_key(drawables[i]);
+                indices[i] = static_cast<uint32_t>(i);
+            }
+
+            radix_sort(keys, indices, tmp_keys, tmp_indices);
+
+            return indices[0];
+        };
+    }
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/math/aabb.h"
+#include "render/core/frustum_culling.h"
+
+#include "culling_test_utils.h"
+
+using namespace Mizu;
+
+// Boxes spread around the origin so roughly a fifth of them are inside the main frustum
+static const RandomBoxesDescription CullingBenchmarkBoxes{
+    .min_position = glm::vec3(-500.0f),
+    .max_position = glm::vec3(500.0f),
+    .min_size = 0.5f,
+    .max_size = 10.0f,
+};
+
+TEST_CASE("Frustum culling", "[Render][FrustumCulling]")
+{
+    // Main view plus the split frustums of 4 shadow cascades
+    const Frustum main_frustum = make_test_frustum(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 60.0f, 500.0f);
+    const std::array cascade_frustums = {
+        make_test_frustum(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 60.0f, 25.0f),
+        make_test_frustum(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 60.0f, 75.0f),
+        make_test_frustum(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 60.0f, 200.0f),
+        make_test_frustum(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 60.0f, 500.0f),
+    };
+    const std::array<FrustumMask, 4> cascade_masks{};
+
+    for (const size_t num_boxes : {size_t{10'000}, size_t{100'000}, size_t{1'000'000}})
+    {
+        const std::string suffix = " (" + std::to_string(num_boxes) + " boxes)";
+
+        const std::vector<AABB> boxes = make_random_boxes(num_boxes, 1234, CullingBenchmarkBoxes);
+
+        CullingBounds bounds;
+        for (const AABB& box : boxes)
+            bounds.push_back(box);
+
+        const size_t word_count = get_visibility_mask_word_count(num_boxes);
+        std::vector<uint64_t> visibility_masks(cascade_frustums.size() * word_count);
+        std::vector<uint32_t> visible_indices(num_boxes);
+
+        BENCHMARK("scalar is_inside_frustum" + suffix)
+        {
+            size_t num_visible = 0;
+            for (const AABB& box : boxes)
+            {
+                num_visible += main_frustum.is_inside_frustum(box) ? 1 : 0;
+            }
+            return num_visible;
+        };
+
+        BENCHMARK("cull_frustums" + suffix)
+        {
+            cull_frustums(std::span(&main_frustum, 1), std::span(cascade_masks.data(), 1), bounds, visibility_masks);
+            return visibility_masks[0];
+        };
+
+        BENCHMARK("cull_frustums + compact_visible_indices" + suffix)
+        {
+            cull_frustums(std::span(&main_frustum, 1), std::span(cascade_masks.data(), 1), bounds, visibility_masks);
+            return compact_visible_indices(std::span(visibility_masks.data(), word_count), visible_indices);
+        };
+
+        BENCHMARK("scalar is_inside_frustum, 4 cascades" + suffix)
+        {
+            size_t num_visible = 0;
+            for (const Frustum& frustum : cascade_frustums)
+            {
+                for (const AABB& box : boxes)
+                {
+                    num_visible += frustum.is_inside_frustum(box) ? 1 : 0;
+                }
+            }
+            return num_visible;
+        };
+
+        BENCHMARK("cull_frustums, 4 cascades in one sweep" + suffix)
+        {
+            cull_frustums(cascade_frustums, cascade_masks, bounds, visibility_masks);
+            return visibility_masks[0];
+        };
+    }
+}
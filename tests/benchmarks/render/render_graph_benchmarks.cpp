@@ -0,0 +1,345 @@
+#include <catch2/catch_all.hpp>
+
+#if MIZU_RENDER_CORE_NULL_ENABLED
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/debug/logging.h"
+
+#include "render/render_graph/render_graph.h"
+#include "render/render_graph/render_graph_builder.h"
+#include "render/render_graph/render_graph_resource_registry.h"
+#include "render/runtime/renderer.h"
+#include "render_core/rhi/device.h"
+#include "render_core/rhi/device_memory_allocator.h"
+
+using namespace Mizu;
+
+struct SyntheticGraphDescription
+{
+    size_t num_passes = 0;
+    size_t num_resources = 0;
+    // Resources read by each pass, written by previous passes
+    size_t fan_in = 2;
+    // Every n-th pass runs on the async compute queue, 0 to not use async compute
+    size_t async_compute_interval = 0;
+};
+
+struct EmptyPassData
+{
+};
+
+// Passes read resources written recently, so lifetimes are short enough to alias
+static constexpr size_t SYNTHETIC_READ_WINDOW = 32;
+
+// Passes only keep a view of their name, the deque keeps the names alive and in place
+static std::string_view get_synthetic_pass_name(size_t pass_idx)
+{
+    static std::deque<std::string> s_names;
+    while (s_names.size() <= pass_idx)
+        s_names.push_back("Pass_" + std::to_string(s_names.size()));
+
+    return s_names[pass_idx];
+}
+
+// Builds the same graph for the same description. Pass i writes its slice of the resources, so every resource has a
+// single producer unless there are more passes than resources. Every pass has side effects to compile the whole graph.
+//
+// Descriptions must respect the per pass limits of RenderGraphPassBuilder: the writes plus the fan-in can't exceed
+// MAX_ACCESS_RECORDS_PER_PASS, and a producer can't have more than RENDER_GRAPH_MAX_PASS_DEPENDENCIES consumers.
+static void build_synthetic_graph(RenderGraphBuilder& builder, const SyntheticGraphDescription& desc)
+{
+    std::mt19937 rng(1234);
+
+    std::vector<RenderGraphResource> resources;
+    resources.reserve(desc.num_resources);
+
+    for (size_t i = 0; i < desc.num_resources; ++i)
+    {
+        // Between 64KiB and 512KiB, so the aliasing has to deal with different sizes
+        const uint64_t size = (64 * 1024) * (1 + i % 8);
+        resources.push_back(builder.create_structured_buffer(size, 4, "Resource_" + std::to_string(i)));
+    }
+
+    std::vector<size_t> read_candidates;
+    std::vector<size_t> reads;
+
+    for (size_t pass_idx = 0; pass_idx < desc.num_passes; ++pass_idx)
+    {
+        const size_t first_write = pass_idx * desc.num_resources / desc.num_passes;
+        const size_t end_write = std::max(first_write + 1, (pass_idx + 1) * desc.num_resources / desc.num_passes);
+
+        read_candidates.clear();
+        for (size_t i = first_write - std::min(first_write, SYNTHETIC_READ_WINDOW); i < first_write; ++i)
+            read_candidates.push_back(i);
+
+        reads.clear();
+        std::sample(read_candidates.begin(), read_candidates.end(), std::back_inserter(reads), desc.fan_in, rng);
+
+        const bool async_compute = desc.async_compute_interval != 0 && pass_idx % desc.async_compute_interval == 0;
+
+        builder.add_pass<EmptyPassData>(
+            get_synthetic_pass_name(pass_idx),
+            [&](RenderGraphPassBuilder& pass, EmptyPassData&) {
+                pass.set_hint(async_compute ? RenderGraphPassHint::AsyncCompute : RenderGraphPassHint::Compute);
+                pass.set_has_side_effects(true);
+
+                for (const size_t idx : reads)
+                    pass.read(resources[idx]);
+
+                for (size_t idx = first_write; idx < end_write; ++idx)
+                    pass.write(resources[idx]);
+            },
+            [](CommandBuffer& command, const EmptyPassData&, const RenderGraphPassResources&) {
+                command.dispatch({1, 1, 1});
+            });
+    }
+}
+
+// Compiles render graphs with the null backend, so only the CPU side of the compile is measured
+struct RenderGraphBenchmarkScope
+{
+    std::shared_ptr<TransientMemoryPool> transient_pool;
+    std::unique_ptr<RenderGraphResourceRegistry> resource_registry;
+    std::unique_ptr<RenderGraph> graph;
+
+    RenderGraphBenchmarkScope()
+    {
+        g_render_device = Device::create(DeviceCreationDescription{
+            .api = GraphicsApi::Null,
+            .specific_config = NullSpecificConfiguration{.async_compute = true},
+        });
+
+        transient_pool = g_render_device->create_transient_memory_pool("RenderGraphBenchmarks");
+        resource_registry = std::make_unique<RenderGraphResourceRegistry>(false);
+        graph = std::make_unique<RenderGraph>();
+    }
+
+    ~RenderGraphBenchmarkScope()
+    {
+        graph.reset();
+        resource_registry.reset();
+        transient_pool = nullptr;
+
+        delete g_render_device;
+        g_render_device = nullptr;
+        Device::free();
+    }
+
+    void compile(RenderGraphBuilder& builder, const SyntheticGraphDescription& desc)
+    {
+        builder.reset();
+        build_synthetic_graph(builder, desc);
+        builder.compile(*graph, RenderGraphBuilderCompileOptions{*transient_pool, *resource_registry});
+    }
+};
+
+[[maybe_unused]] static double to_mib(uint64_t size)
+{
+    return static_cast<double>(size) / (1024.0 * 1024.0);
+}
+
+static std::string get_benchmark_suffix(const SyntheticGraphDescription& desc)
+{
+    return " (" + std::to_string(desc.num_passes) + " passes, " + std::to_string(desc.num_resources)
+           + " resources, fan-in " + std::to_string(desc.fan_in) + ", async every "
+           + std::to_string(desc.async_compute_interval) + ")";
+}
+
+// Logs the average CPU time of each compile stage without caching, and the transient memory of the graph
+static void log_compile_stages(RenderGraphBenchmarkScope& scope, const SyntheticGraphDescription& desc)
+{
+    constexpr size_t NumCompiles = 10;
+
+    RenderGraphBuilder builder(RenderGraphBuilderConfig{.cache_compiled_topology = false});
+
+    RenderGraphCompileStats total{};
+    for (size_t i = 0; i < NumCompiles; ++i)
+    {
+        scope.compile(builder, desc);
+
+        const RenderGraphCompileStats& stats = builder.get_compile_stats();
+        total.cull_passes_ns += stats.cull_passes_ns;
+        total.hash_topology_ns += stats.hash_topology_ns;
+        total.topological_sort_ns += stats.topological_sort_ns;
+        total.transitive_reduction_ns += stats.transitive_reduction_ns;
+        total.merge_passes_ns += stats.merge_passes_ns;
+        total.resource_sharing_ns += stats.resource_sharing_ns;
+        total.create_resources_ns += stats.create_resources_ns;
+        total.create_passes_ns += stats.create_passes_ns;
+        total.total_ns += stats.total_ns;
+    }
+
+    [[maybe_unused]] const auto to_ms = [](uint64_t ns) {
+        return static_cast<double>(ns) / static_cast<double>(NumCompiles) / 1e6;
+    };
+
+    [[maybe_unused]] const RenderGraphCompileStats& stats = builder.get_compile_stats();
+
+    MIZU_LOG_INFO("{}", get_benchmark_suffix(desc));
+    MIZU_LOG_INFO(
+        "  cull {:.3f} ms, hash {:.3f} ms, sort {:.3f} ms, reduction {:.3f} ms, merge {:.3f} ms, sharing {:.3f} ms, "
+        "resources {:.3f} ms, passes {:.3f} ms, total {:.3f} ms",
+        to_ms(total.cull_passes_ns),
+        to_ms(total.hash_topology_ns),
+        to_ms(total.topological_sort_ns),
+        to_ms(total.transitive_reduction_ns),
+        to_ms(total.merge_passes_ns),
+        to_ms(total.resource_sharing_ns),
+        to_ms(total.create_resources_ns),
+        to_ms(total.create_passes_ns),
+        to_ms(total.total_ns));
+    MIZU_LOG_INFO(
+        "  {} transient resources, {:.2f} MiB transient memory, {} barriers, {} transitions",
+        stats.num_transient_resources,
+        to_mib(stats.transient_memory_size),
+        stats.num_barriers,
+        stats.num_transitions);
+}
+
+static void benchmark_compile(RenderGraphBenchmarkScope& scope, const SyntheticGraphDescription& desc)
+{
+    const std::string suffix = get_benchmark_suffix(desc);
+
+    RenderGraphBuilder builder(RenderGraphBuilderConfig{.cache_compiled_topology = false});
+    RenderGraphBuilder cached_builder;
+
+    BENCHMARK("build" + suffix)
+    {
+        builder.reset();
+        build_synthetic_graph(builder, desc);
+    };
+
+    BENCHMARK("build + compile" + suffix)
+    {
+        scope.compile(builder, desc);
+        return builder.get_compile_stats().total_ns;
+    };
+
+    BENCHMARK("build + compile, cached topology" + suffix)
+    {
+        scope.compile(cached_builder, desc);
+        return cached_builder.get_compile_stats().total_ns;
+    };
+
+    log_compile_stages(scope, desc);
+}
+
+static const char* get_aliasing_heuristic_name(RenderGraphAliasingHeuristic heuristic)
+{
+    switch (heuristic)
+    {
+    case RenderGraphAliasingHeuristic::FirstFit:
+        return "first fit";
+    case RenderGraphAliasingHeuristic::BestFit:
+        return "best fit";
+    case RenderGraphAliasingHeuristic::InterferenceGraph:
+        return "interference graph";
+    }
+
+    return "";
+}
+
+// Logs the transient memory of each aliasing heuristic. Fragmentation is the memory over the lower bound, the peak
+// size of the resources alive at the same time.
+static void benchmark_aliasing_heuristics(RenderGraphBenchmarkScope& scope, const SyntheticGraphDescription& desc)
+{
+    MIZU_LOG_INFO("{}", get_benchmark_suffix(desc));
+
+    for (const RenderGraphAliasingHeuristic heuristic :
+         {RenderGraphAliasingHeuristic::FirstFit,
+          RenderGraphAliasingHeuristic::BestFit,
+          RenderGraphAliasingHeuristic::InterferenceGraph})
+    {
+        RenderGraphBuilder builder(
+            RenderGraphBuilderConfig{.cache_compiled_topology = false, .aliasing_heuristic = heuristic});
+
+        const std::string name = get_aliasing_heuristic_name(heuristic);
+
+        BENCHMARK("build + compile, " + name + get_benchmark_suffix(desc))
+        {
+            scope.compile(builder, desc);
+            return builder.get_compile_stats().total_ns;
+        };
+
+        const RenderGraphCompileStats& stats = builder.get_compile_stats();
+
+        const double size = static_cast<double>(stats.transient_memory_size);
+        const double lower_bound = static_cast<double>(stats.transient_memory_lower_bound);
+        [[maybe_unused]] const double fragmentation = size > 0.0 ? (size - lower_bound) / size : 0.0;
+
+        MIZU_LOG_INFO(
+            "  {:<20} {:.2f} MiB ({:.2f} MiB saved of {:.2f} MiB, lower bound {:.2f} MiB, {:.1f}% fragmentation), "
+            "{} heaps, resources {:.3f} ms",
+            name,
+            to_mib(stats.transient_memory_size),
+            to_mib(stats.transient_memory_unaliased_size - stats.transient_memory_size),
+            to_mib(stats.transient_memory_unaliased_size),
+            to_mib(stats.transient_memory_lower_bound),
+            fragmentation * 100.0,
+            stats.num_transient_heaps,
+            static_cast<double>(stats.create_resources_ns) / 1e6);
+    }
+}
+
+TEST_CASE("RenderGraph compile scaling", "[Render][RenderGraph]")
+{
+    RenderGraphBenchmarkScope scope;
+
+    for (const size_t num_passes : {size_t{50}, size_t{500}, size_t{5'000}})
+    {
+        benchmark_compile(scope, SyntheticGraphDescription{.num_passes = num_passes, .num_resources = num_passes * 2});
+    }
+
+    benchmark_compile(scope, SyntheticGraphDescription{.num_passes = 500, .num_resources = 250});
+    benchmark_compile(scope, SyntheticGraphDescription{.num_passes = 500, .num_resources = 5'000});
+}
+
+TEST_CASE("RenderGraph compile fan-in", "[Render][RenderGraph]")
+{
+    RenderGraphBenchmarkScope scope;
+
+    for (const size_t fan_in : {size_t{1}, size_t{4}, size_t{8}})
+    {
+        benchmark_compile(
+            scope, SyntheticGraphDescription{.num_passes = 500, .num_resources = 1'000, .fan_in = fan_in});
+    }
+}
+
+TEST_CASE("RenderGraph compile async compute mix", "[Render][RenderGraph]")
+{
+    RenderGraphBenchmarkScope scope;
+
+    for (const size_t async_compute_interval : {size_t{8}, size_t{4}, size_t{2}})
+    {
+        benchmark_compile(
+            scope,
+            SyntheticGraphDescription{
+                .num_passes = 500,
+                .num_resources = 1'000,
+                .async_compute_interval = async_compute_interval,
+            });
+    }
+}
+
+TEST_CASE("RenderGraph transient aliasing heuristics", "[Render][RenderGraph]")
+{
+    RenderGraphBenchmarkScope scope;
+
+    benchmark_aliasing_heuristics(scope, SyntheticGraphDescription{.num_passes = 500, .num_resources = 1'000});
+    benchmark_aliasing_heuristics(
+        scope, SyntheticGraphDescription{.num_passes = 500, .num_resources = 1'000, .fan_in = 8});
+    benchmark_aliasing_heuristics(
+        scope,
+        SyntheticGraphDescription{.num_passes = 500, .num_resources = 1'000, .async_compute_interval = 4});
+    benchmark_aliasing_heuristics(scope, SyntheticGraphDescription{.num_passes = 5'000, .num_resources = 10'000});
+}
+
+#endif
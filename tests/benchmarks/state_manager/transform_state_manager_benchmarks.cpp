@@ -0,0 +1,111 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "render/state_manager/transform_state_manager.h"
+
+using namespace Mizu;
+
+// Only implements rend_on_update, gets one virtual call per handle through the default rend_on_update_batch
+class TransformPerHandleBenchmarkConsumer : public TransformStateManagerConsumer
+{
+  public:
+    float checksum = 0.0f;
+
+    void rend_on_create(TransformHandle, const TransformStaticState&, const TransformDynamicState&) override {}
+    void rend_on_update(TransformHandle, const TransformDynamicState& ds) override { checksum += ds.translation.x; }
+    void rend_on_destroy(TransformHandle) override {}
+};
+
+class TransformBatchBenchmarkConsumer : public TransformPerHandleBenchmarkConsumer
+{
+  public:
+    void rend_on_update_batch(std::span<const TransformHandle>, std::span<const TransformDynamicState> dss) override
+    {
+        for (const TransformDynamicState& ds : dss)
+        {
+            checksum += ds.translation.x;
+        }
+    }
+};
+
+// Creates `num_transforms` handles and publishes one tick that moves all of them, rendering before the tick time
+// interpolates it without consuming it, so every benchmark run does the same work
+static void publish_moving_transforms(TransformStateManager& state_manager, size_t num_transforms)
+{
+    std::vector<TransformHandle> handles;
+    handles.reserve(num_transforms);
+
+    state_manager.sim_begin_tick(TickUpdateState{100});
+    for (size_t i = 0; i < num_transforms; ++i)
+    {
+        handles.push_back(state_manager.sim_create(TransformStaticState{}, TransformDynamicState{}));
+    }
+    state_manager.sim_end_tick();
+    state_manager.rend_apply_updates(FrameUpdateState{100});
+
+    state_manager.sim_begin_tick(TickUpdateState{200});
+    for (size_t i = 0; i < num_transforms; ++i)
+    {
+        TransformDynamicState& ds = state_manager.sim_edit(handles[i]);
+        ds.translation = glm::vec3(static_cast<float>(i), 1.0f, 2.0f);
+        ds.rotation = glm::vec3(0.5f);
+    }
+    state_manager.sim_end_tick();
+}
+
+TEST_CASE("TransformStateManager interpolation", "[StateManager][Transform]")
+{
+    for (const size_t num_transforms : {size_t{1'000}, size_t{10'000}, size_t{100'000}})
+    {
+        const std::string suffix = " (" + std::to_string(num_transforms) + " transforms)";
+
+        std::vector<TransformDynamicState> from(num_transforms);
+        std::vector<TransformDynamicState> to(num_transforms, TransformDynamicState{glm::vec3(1.0f)});
+        std::vector<TransformDynamicState> out(num_transforms);
+
+        BENCHMARK("scalar interpolate" + suffix)
+        {
+            for (size_t i = 0; i < num_transforms; ++i)
+            {
+                out[i] = from[i].interpolate(to[i], 0.5);
+            }
+            return out[0].translation.x;
+        };
+
+        BENCHMARK("interpolate_batch" + suffix)
+        {
+            TransformDynamicState::interpolate_batch(from, to, 0.5, out);
+            return out[0].translation.x;
+        };
+
+        TransformStateManager state_manager{num_transforms};
+        publish_moving_transforms(state_manager, num_transforms);
+
+        TransformPerHandleBenchmarkConsumer per_handle_consumer;
+        state_manager.register_rend_consumer(&per_handle_consumer);
+
+        BENCHMARK("rend_apply_updates, per handle consumer" + suffix)
+        {
+            state_manager.rend_apply_updates(FrameUpdateState{150});
+            return per_handle_consumer.checksum;
+        };
+
+        state_manager.unregister_rend_consumer(&per_handle_consumer);
+
+        TransformBatchBenchmarkConsumer batch_consumer;
+        state_manager.register_rend_consumer(&batch_consumer);
+
+        BENCHMARK("rend_apply_updates, batch consumer" + suffix)
+        {
+            state_manager.rend_apply_updates(FrameUpdateState{150});
+            return batch_consumer.checksum;
+        };
+
+        state_manager.unregister_rend_consumer(&batch_consumer);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+#include "base/math/aabb.h"
+#include "render/core/camera.h"
+
+// Perspective frustum with a 16:9 aspect ratio at `position`, looking at `target`
+inline Mizu::Frustum make_test_frustum(glm::vec3 position, glm::vec3 target, float fov_degrees, float zfar)
+{
+    const glm::mat4 view = glm::lookAt(position, target, glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(fov_degrees), 16.0f / 9.0f, 0.1f, zfar);
+
+    return Mizu::Frustum::from_view_projection(projection * view, position);
+}
+
+// The min corner of each box is picked between `min_position` and `max_position`, the size of each axis between
+// `min_size` and `max_size`
+struct RandomBoxesDescription
+{
+    glm::vec3 min_position{};
+    glm::vec3 max_position{};
+    float min_size = 0.0f;
+    float max_size = 0.0f;
+};
+
+inline Mizu::AABB make_random_box(std::mt19937& rng, const RandomBoxesDescription& desc)
+{
+    std::uniform_real_distribution<float> x_dist(desc.min_position.x, desc.max_position.x);
+    std::uniform_real_distribution<float> y_dist(desc.min_position.y, desc.max_position.y);
+    std::uniform_real_distribution<float> z_dist(desc.min_position.z, desc.max_position.z);
+    std::uniform_real_distribution<float> size_dist(desc.min_size, desc.max_size);
+
+    const glm::vec3 min{x_dist(rng), y_dist(rng), z_dist(rng)};
+    const glm::vec3 size{size_dist(rng), size_dist(rng), size_dist(rng)};
+
+    return Mizu::AABB(min, min + size);
+}
+
+inline std::vector<Mizu::AABB> make_random_boxes(size_t count, uint32_t seed, const RandomBoxesDescription& desc)
+{
+    std::mt19937 rng(seed);
+
+    std::vector<Mizu::AABB> boxes;
+    boxes.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        boxes.push_back(make_random_box(rng, desc));
+    }
+
+    return boxes;
+}
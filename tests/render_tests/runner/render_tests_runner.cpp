@@ -39,6 +39,9 @@ RenderTestsRunner::RenderTestsRunner(RenderTestsInfo info) : m_info(std::move(in
     case GraphicsApi::Vulkan:
         specific_config = VulkanSpecificConfiguration{};
         break;
+    case GraphicsApi::Null:
+        specific_config = NullSpecificConfiguration{};
+        break;
     }
 
     const DeviceCreationDescription device_desc{
@@ -3,6 +3,7 @@
 #include <ranges>
 
 #include "base/containers/inplace_vector.h"
+#include "base/containers/paged_array.h"
 #include "base/containers/typed_bitset.h"
 
 using namespace Mizu;
@@ -372,6 +373,48 @@ enum class Color
     Blue,
 };
 
+TEST_CASE("paged_array allocates pages on demand", "[Base]")
+{
+    paged_array<uint32_t, 4> array(10, 7u);
+    REQUIRE(array.max_size() == 10);
+    REQUIRE(array.num_allocated_pages() == 0);
+    REQUIRE_FALSE(array.is_allocated(0));
+
+    array.ensure(5);
+    REQUIRE(array.num_allocated_pages() == 1);
+    REQUIRE(array.is_allocated(4));
+    REQUIRE(array.is_allocated(7));
+    REQUIRE_FALSE(array.is_allocated(3));
+    REQUIRE_FALSE(array.is_allocated(8));
+
+    REQUIRE(array[4] == 7);
+    array[5] = 3;
+    REQUIRE(array[5] == 3);
+
+    array.ensure(9);
+    REQUIRE(array.num_allocated_pages() == 2);
+    REQUIRE(array[9] == 7);
+    REQUIRE_FALSE(array.is_allocated(10));
+}
+
+TEST_CASE("paged_array keeps references valid when allocating new pages", "[Base]")
+{
+    paged_array<uint32_t, 2> array(64);
+
+    array.ensure(0);
+    uint32_t& first = array[0];
+    first = 42;
+
+    for (size_t i = 0; i < 64; ++i)
+    {
+        array.ensure(i);
+    }
+
+    REQUIRE(&array[0] == &first);
+    REQUIRE(array[0] == 42);
+    REQUIRE(array[63] == 0);
+}
+
 TEST_CASE("typed_bitset can set values", "[Base]")
 {
     typed_bitset<Color> bitset{};
@@ -0,0 +1,91 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "base/utils/radix_sort.h"
+
+using namespace Mizu;
+
+// Sorts with the radix sort and checks the result against `std::stable_sort` on the same pairs
+static void check_radix_sort_matches_stable_sort(const std::vector<uint64_t>& input_keys)
+{
+    std::vector<uint64_t> keys = input_keys;
+    std::vector<uint32_t> values(keys.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<uint32_t>(i);
+    }
+
+    std::vector<std::pair<uint64_t, uint32_t>> expected(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        expected[i] = {keys[i], values[i]};
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<uint64_t> tmp_keys(keys.size());
+    std::vector<uint32_t> tmp_values(keys.size());
+    radix_sort(keys, values, tmp_keys, tmp_values);
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        REQUIRE(keys[i] == expected[i].first);
+        REQUIRE(values[i] == expected[i].second);
+    }
+}
+
+TEST_CASE("radix_sort sorts keys and values", "[Base]")
+{
+    std::mt19937_64 rng(42);
+
+    SECTION("Empty and single element")
+    {
+        check_radix_sort_matches_stable_sort({});
+        check_radix_sort_matches_stable_sort({5});
+    }
+
+    SECTION("Random keys")
+    {
+        std::vector<uint64_t> keys(5000);
+        for (uint64_t& key : keys)
+        {
+            key = rng();
+        }
+
+        check_radix_sort_matches_stable_sort(keys);
+    }
+
+    SECTION("Duplicated keys keep their order")
+    {
+        std::uniform_int_distribution<uint64_t> dist(0, 15);
+
+        std::vector<uint64_t> keys(2000);
+        for (uint64_t& key : keys)
+        {
+            key = dist(rng) << 40;
+        }
+
+        check_radix_sort_matches_stable_sort(keys);
+    }
+
+    SECTION("Keys with skipped passes")
+    {
+        // Only the lowest, a middle and the highest digits change, so three passes run and the result ends in the
+        // temporary buffers
+        std::uniform_int_distribution<uint64_t> dist(0, 255);
+
+        std::vector<uint64_t> keys(1000);
+        for (uint64_t& key : keys)
+        {
+            key = uint64_t{0x00AB'CD00'0123'4500} | dist(rng) | (dist(rng) << 24) | (dist(rng) << 56);
+        }
+
+        check_radix_sort_matches_stable_sort(keys);
+
+        check_radix_sort_matches_stable_sort(std::vector<uint64_t>(100, 0x1234));
+    }
+}
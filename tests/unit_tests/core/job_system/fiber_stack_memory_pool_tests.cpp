@@ -0,0 +1,73 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "core/job_system/fiber_stack_memory_pool.h"
+
+using namespace Mizu;
+
+TEST_CASE("FiberStackMemoryPool reserves address space without committing it", "[FiberStackMemoryPool]")
+{
+    constexpr size_t NumStacks = 64;
+    constexpr size_t StackBytes = 32 * 1024;
+
+    FiberStackMemoryPool pool;
+    REQUIRE(pool.init(NumStacks, StackBytes));
+
+    REQUIRE(pool.get_stack_size() >= StackBytes);
+    REQUIRE(pool.get_guard_size() > 0);
+    REQUIRE(pool.get_reserved_size() == NumStacks * (pool.get_stack_size() + pool.get_guard_size()));
+    REQUIRE(pool.get_committed_size() == 0);
+}
+
+TEST_CASE("FiberStackMemoryPool commits stacks on first use only", "[FiberStackMemoryPool]")
+{
+    constexpr size_t NumStacks = 8;
+    constexpr size_t StackBytes = 32 * 1024;
+
+    FiberStackMemoryPool pool;
+    REQUIRE(pool.init(NumStacks, StackBytes));
+
+    uint8_t* first = pool.get_memory(0);
+    REQUIRE(first != nullptr);
+    REQUIRE(pool.get_committed_size() == pool.get_stack_size());
+
+    uint8_t* first_again = pool.get_memory(0);
+    REQUIRE(first_again == first);
+    REQUIRE(pool.get_committed_size() == pool.get_stack_size());
+
+    uint8_t* last = pool.get_memory(NumStacks - 1);
+    REQUIRE(last != nullptr);
+    REQUIRE(pool.get_committed_size() == 2 * pool.get_stack_size());
+}
+
+TEST_CASE("FiberStackMemoryPool returns aligned, writable and disjoint stacks", "[FiberStackMemoryPool]")
+{
+    constexpr size_t NumStacks = 4;
+    constexpr size_t StackBytes = 16 * 1024;
+
+    FiberStackMemoryPool pool;
+    REQUIRE(pool.init(NumStacks, StackBytes));
+
+    uint8_t* previous = nullptr;
+    for (size_t index = 0; index < NumStacks; ++index)
+    {
+        uint8_t* stack = pool.get_memory(index);
+
+        REQUIRE((reinterpret_cast<uintptr_t>(stack) & 15u) == 0);
+
+        std::memset(stack, 0xAB, StackBytes);
+        REQUIRE(stack[0] == 0xAB);
+        REQUIRE(stack[StackBytes - 1] == 0xAB);
+
+        if (previous != nullptr)
+        {
+            // The guard page of a stack sits between it and the previous stack
+            REQUIRE(stack >= previous + pool.get_stack_size() + pool.get_guard_size());
+        }
+
+        previous = stack;
+    }
+}
@@ -169,3 +169,95 @@ TEST_CASE("IntrusiveFreeList concurrent allocate and free keeps slots unique", "
 
     REQUIRE(violations.load(std::memory_order_acquire) == 0);
 }
+
+TEST_CASE("IntrusiveFreeList grows up to its maximum capacity", "[IntrusiveFreeList]")
+{
+    constexpr size_t InitialCapacity = 4;
+    constexpr size_t MaxCapacity = 600;
+
+    TestRecordPool<InitialCapacity> pool;
+    pool.init(InitialCapacity, MaxCapacity);
+
+    REQUIRE(pool.get_capacity() == InitialCapacity);
+    REQUIRE(pool.get_max_capacity() == MaxCapacity);
+
+    std::vector<bool> seen(MaxCapacity, false);
+    std::vector<TestRecordIndex> allocated;
+    for (size_t index = 0; index < MaxCapacity; ++index)
+    {
+        const TestRecordIndex record = pool.allocate();
+        REQUIRE(record != TestRecordIndex{});
+        REQUIRE(record.value < MaxCapacity);
+        REQUIRE_FALSE(seen[record.value]);
+        REQUIRE(pool.get(record).pool_index == record);
+
+        seen[record.value] = true;
+        allocated.push_back(record);
+    }
+
+    REQUIRE(pool.allocate() == TestRecordIndex{});
+    REQUIRE(pool.get_capacity() == MaxCapacity);
+    REQUIRE(pool.get_high_water() == MaxCapacity);
+
+    for (const TestRecordIndex record : allocated)
+    {
+        pool.free(record);
+    }
+
+    // Freed records are reused, the list doesn't grow past its maximum capacity
+    for (size_t index = 0; index < MaxCapacity; ++index)
+    {
+        REQUIRE(pool.allocate() != TestRecordIndex{});
+    }
+
+    REQUIRE(pool.allocate() == TestRecordIndex{});
+    REQUIRE(pool.get_capacity() == MaxCapacity);
+}
+
+TEST_CASE("IntrusiveFreeList concurrent growth keeps slots unique", "[IntrusiveFreeList]")
+{
+    constexpr size_t NumThreads = 4;
+    constexpr size_t AllocationsPerThread = 512;
+    constexpr size_t MaxCapacity = NumThreads * AllocationsPerThread;
+
+    TestRecordPool<1> pool;
+    pool.init(1, MaxCapacity);
+
+    std::atomic<bool> start = false;
+    std::array<std::vector<TestRecordIndex>, NumThreads> allocated{};
+
+    std::vector<std::thread> threads;
+    for (size_t thread_idx = 0; thread_idx < NumThreads; ++thread_idx)
+    {
+        threads.emplace_back([&, thread_idx]() {
+            wait_for_intrusive_free_list_start(start);
+
+            for (size_t index = 0; index < AllocationsPerThread; ++index)
+            {
+                allocated[thread_idx].push_back(pool.allocate());
+            }
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<bool> seen(MaxCapacity, false);
+    for (const std::vector<TestRecordIndex>& records : allocated)
+    {
+        for (const TestRecordIndex record : records)
+        {
+            REQUIRE(record != TestRecordIndex{});
+            REQUIRE_FALSE(seen[record.value]);
+            REQUIRE(pool.get(record).pool_index == record);
+
+            seen[record.value] = true;
+        }
+    }
+
+    REQUIRE(pool.allocate() == TestRecordIndex{});
+}
@@ -1,9 +1,12 @@
 #include <catch2/catch_all.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -303,3 +306,221 @@ TEST_CASE("JobSystem supports in-fiber wait_for on batch completion handles", "[
         REQUIRE(waiter_resumed.load(std::memory_order_acquire));
     }
 }
+
+TEST_CASE("JobSystem keeps high priority latency bounded under a flood of low priority jobs", "[JobSystem][stress]")
+{
+    constexpr int32_t NumLowPriorityJobs = 256;
+    constexpr int32_t HighPriorityJobInterval = 32;
+    constexpr int32_t NumHighPriorityJobs = NumLowPriorityJobs / HighPriorityJobInterval;
+    constexpr int32_t MaxLowPriorityJobsAhead = 16;
+
+    JobSystemDescription desc{};
+    desc.num_workers = 4;
+    desc.reserve_main_thread = false;
+    desc.groups.num_render_workers = 2;
+
+    JobSystemStressScope scope;
+    REQUIRE(scope.job_system.init(desc));
+    scope.initialized = true;
+
+    std::atomic<int32_t> low_executed = 0;
+    std::atomic<int32_t> high_executed = 0;
+    std::atomic<int32_t> max_low_jobs_ahead = 0;
+
+    // Some of the low priority jobs submit a high priority job while the flood is being executed, the number of low
+    // priority jobs that finish between the submission and the start of the high priority job is the latency.
+    const auto submit_high_priority_job = [&] {
+        const int32_t low_executed_at_submit = low_executed.load(std::memory_order_acquire);
+
+        scope.job_system
+            .schedule([&, low_executed_at_submit] {
+                const int32_t low_jobs_ahead = low_executed.load(std::memory_order_acquire) - low_executed_at_submit;
+
+                int32_t current_max = max_low_jobs_ahead.load(std::memory_order_relaxed);
+                while (low_jobs_ahead > current_max
+                       && !max_low_jobs_ahead.compare_exchange_weak(current_max, low_jobs_ahead))
+                {
+                }
+
+                high_executed.fetch_add(1, std::memory_order_acq_rel);
+            })
+            .affinity(JobAffinity::RenderHigh)
+            .submit();
+    };
+
+    std::vector<JobHandle> low_handles;
+    low_handles.reserve(static_cast<size_t>(NumLowPriorityJobs));
+
+    for (int32_t index = 0; index < NumLowPriorityJobs; ++index)
+    {
+        low_handles.push_back(scope.job_system
+                                  .schedule([&, index] {
+                                      if (index % HighPriorityJobInterval == HighPriorityJobInterval / 2)
+                                      {
+                                          submit_high_priority_job();
+                                      }
+
+                                      const auto start = std::chrono::steady_clock::now();
+                                      while (std::chrono::steady_clock::now() - start < std::chrono::microseconds(200))
+                                      {
+                                      }
+
+                                      low_executed.fetch_add(1, std::memory_order_acq_rel);
+                                  })
+                                  .affinity(JobAffinity::Render)
+                                  .submit());
+    }
+
+    for (const JobHandle& handle : low_handles)
+    {
+        REQUIRE(scope.job_system.wait_for_blocking(handle));
+    }
+
+    while (high_executed.load(std::memory_order_acquire) != NumHighPriorityJobs)
+    {
+        std::this_thread::yield();
+    }
+
+    REQUIRE(low_executed.load(std::memory_order_acquire) == NumLowPriorityJobs);
+    REQUIRE(max_low_jobs_ahead.load(std::memory_order_acquire) <= MaxLowPriorityJobsAhead);
+}
+
+TEST_CASE("JobSystem never executes group jobs outside of their worker group", "[JobSystem][stress]")
+{
+    constexpr int32_t NumJobsPerAffinity = 128;
+
+    JobSystemDescription desc{};
+    desc.num_workers = 4;
+    desc.reserve_main_thread = false;
+    desc.groups.num_simulation_workers = 1;
+    desc.groups.num_render_workers = 1;
+
+    JobSystemStressScope scope;
+    REQUIRE(scope.job_system.init(desc));
+    scope.initialized = true;
+
+    std::mutex thread_ids_mutex;
+    std::set<std::thread::id> simulation_thread_ids;
+    std::set<std::thread::id> render_thread_ids;
+
+    std::vector<JobHandle> handles;
+    handles.reserve(static_cast<size_t>(NumJobsPerAffinity) * 3);
+
+    for (int32_t index = 0; index < NumJobsPerAffinity; ++index)
+    {
+        handles.push_back(scope.job_system
+                              .schedule([&] {
+                                  std::lock_guard lock(thread_ids_mutex);
+                                  simulation_thread_ids.insert(std::this_thread::get_id());
+                              })
+                              .affinity(index % 2 == 0 ? JobAffinity::Simulation : JobAffinity::SimulationHigh)
+                              .submit());
+
+        handles.push_back(scope.job_system
+                              .schedule([&] {
+                                  std::lock_guard lock(thread_ids_mutex);
+                                  render_thread_ids.insert(std::this_thread::get_id());
+                              })
+                              .affinity(index % 2 == 0 ? JobAffinity::Render : JobAffinity::RenderHigh)
+                              .submit());
+
+        handles.push_back(scope.job_system.schedule([] { std::this_thread::yield(); }).submit());
+    }
+
+    for (const JobHandle& handle : handles)
+    {
+        REQUIRE(scope.job_system.wait_for_blocking(handle));
+    }
+
+    if (scope.job_system.get_num_group_workers(JobAffinity::Simulation) == 1)
+    {
+        REQUIRE(simulation_thread_ids.size() == 1);
+    }
+
+    if (scope.job_system.get_num_group_workers(JobAffinity::Render) == 1)
+    {
+        REQUIRE(render_thread_ids.size() == 1);
+    }
+
+    if (scope.job_system.get_num_group_workers(JobAffinity::Simulation) == 1
+        && scope.job_system.get_num_group_workers(JobAffinity::Render) == 1)
+    {
+        REQUIRE(*simulation_thread_ids.begin() != *render_thread_ids.begin());
+    }
+}
+
+TEST_CASE("JobSystem applies backpressure when a burst exceeds the maximum capacities", "[JobSystem][stress]")
+{
+    constexpr int32_t NumJobs = 4096;
+
+    JobSystemDescription desc{};
+    desc.num_workers = 3;
+    desc.reserve_main_thread = false;
+    desc.capacity.initial_pool_capacity = 16;
+    desc.capacity.max_pool_capacity = 64;
+    desc.capacity.initial_queue_capacity = 4;
+    desc.capacity.max_queue_capacity = 16;
+
+    JobSystemStressScope scope;
+    REQUIRE(scope.job_system.init(desc));
+    scope.initialized = true;
+
+    std::atomic<bool> released = false;
+    std::atomic<int32_t> executed = 0;
+
+    // Jobs don't finish until the submitter has hit the capacity limits, the handles are dropped right away otherwise
+    // their completion records could never be reused
+    const auto submit_burst = [&] {
+        for (int32_t index = 0; index < NumJobs; ++index)
+        {
+            scope.job_system
+                .schedule([&] {
+                    while (!released.load(std::memory_order_acquire))
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    executed.fetch_add(1, std::memory_order_acq_rel);
+                })
+                .submit();
+        }
+    };
+
+    JobHandle root{};
+    std::thread external_submitter;
+
+    SECTION("from a worker")
+    {
+        root = scope.job_system.schedule(submit_burst).submit();
+    }
+
+    SECTION("from an external thread")
+    {
+        external_submitter = std::thread(submit_burst);
+    }
+
+    while (scope.job_system.get_capacity_stats().num_backpressure_waits == 0)
+    {
+        std::this_thread::yield();
+    }
+
+    released.store(true, std::memory_order_release);
+
+    if (root.is_valid())
+        REQUIRE(scope.job_system.wait_for_blocking(root));
+
+    if (external_submitter.joinable())
+        external_submitter.join();
+
+    while (executed.load(std::memory_order_acquire) != NumJobs)
+    {
+        std::this_thread::yield();
+    }
+
+    const JobSystemCapacityStats stats = scope.job_system.get_capacity_stats();
+    REQUIRE(stats.job_records.max_capacity == 64);
+    REQUIRE(stats.job_records.capacity <= 64);
+    REQUIRE(stats.job_records.high_water > 16);
+    REQUIRE(stats.job_records.high_water <= stats.job_records.capacity);
+    REQUIRE(stats.max_queue_capacity <= 16);
+}
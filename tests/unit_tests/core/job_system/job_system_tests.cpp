@@ -2,6 +2,7 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <thread>
 #include <vector>
@@ -467,3 +468,316 @@ TEST_CASE("JobSystem resumes all jobs waiting on the same dependency", "[JobSyst
     REQUIRE(waiters_resumed.load(std::memory_order_acquire) == NumWaiters);
     REQUIRE(ordering_violations.load(std::memory_order_acquire) == 0);
 }
+
+TEST_CASE("JobSystem only commits fiber stacks that have been used", "[JobSystem]")
+{
+    JobSystemBasicScope scope;
+    REQUIRE(scope.job_system.init(2, false));
+    scope.initialized = true;
+
+    const FiberStackMemoryStats initial_stats = scope.job_system.get_fiber_stack_memory_stats();
+    REQUIRE(initial_stats.reserved_bytes > 0);
+    REQUIRE(initial_stats.committed_bytes == 0);
+
+    JobHandle handle = scope.job_system.schedule([] {}).stack_size(StackSize::Small).submit();
+    REQUIRE(scope.job_system.wait_for_blocking(handle));
+
+    const FiberStackMemoryStats stats = scope.job_system.get_fiber_stack_memory_stats();
+    REQUIRE(stats.reserved_bytes == initial_stats.reserved_bytes);
+    REQUIRE(stats.committed_bytes > 0);
+    REQUIRE(stats.committed_bytes < stats.reserved_bytes);
+}
+
+TEST_CASE("JobSystem parks idle workers and wakes them for new work", "[JobSystem]")
+{
+    JobSystemDescription desc{};
+    desc.num_workers = 2;
+    desc.reserve_main_thread = false;
+    desc.idle.strategy = JobSystemIdleStrategy::Adaptive;
+    desc.idle.spin_count = 0;
+    desc.idle.yield_count = 0;
+
+    JobSystemBasicScope scope;
+    REQUIRE(scope.job_system.init(desc));
+    scope.initialized = true;
+
+    while (scope.job_system.get_idle_stats().num_parks == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::atomic<bool> executed = false;
+
+    JobHandle handle =
+        scope.job_system.schedule([&executed] { executed.store(true, std::memory_order_release); }).submit();
+
+    REQUIRE(scope.job_system.wait_for_blocking(handle));
+    REQUIRE(executed.load(std::memory_order_acquire));
+    REQUIRE(scope.job_system.get_idle_stats().num_wakes > 0);
+}
+
+TEST_CASE("JobSystem yield idle strategy never parks workers", "[JobSystem]")
+{
+    JobSystemDescription desc{};
+    desc.num_workers = 2;
+    desc.reserve_main_thread = false;
+    desc.idle.strategy = JobSystemIdleStrategy::Yield;
+
+    JobSystemBasicScope scope;
+    REQUIRE(scope.job_system.init(desc));
+    scope.initialized = true;
+
+    while (scope.job_system.get_idle_stats().num_yields == 0)
+    {
+        std::this_thread::yield();
+    }
+
+    JobHandle handle = scope.job_system.schedule([] {}).submit();
+    REQUIRE(scope.job_system.wait_for_blocking(handle));
+
+    const JobSystemIdleStats stats = scope.job_system.get_idle_stats();
+    REQUIRE(stats.num_parks == 0);
+    REQUIRE(stats.num_spins == 0);
+}
+
+TEST_CASE("JobSystem parallel_for visits every index exactly once", "[JobSystem]")
+{
+    constexpr size_t NumElements = 100'000;
+
+    JobSystemBasicScope scope;
+    REQUIRE(scope.job_system.init(4, false));
+    scope.initialized = true;
+
+    std::vector<std::atomic<uint32_t>> visits(NumElements);
+
+    SECTION("per index")
+    {
+        JobHandle handle = scope.job_system.parallel_for(JobRange{0, NumElements}, 64, [&](size_t index) {
+            visits[index].fetch_add(1, std::memory_order_relaxed);
+        });
+
+        REQUIRE(scope.job_system.wait_for_blocking(handle));
+    }
+
+    SECTION("per chunk")
+    {
+        std::atomic<bool> valid_chunks = true;
+
+        JobHandle handle = scope.job_system.parallel_for(JobRange{0, NumElements}, 64, [&](JobRange chunk) {
+            if (chunk.empty() || chunk.size() > 64)
+                valid_chunks.store(false, std::memory_order_relaxed);
+
+            for (size_t index = chunk.begin; index < chunk.end; ++index)
+            {
+                visits[index].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        REQUIRE(scope.job_system.wait_for_blocking(handle));
+        REQUIRE(valid_chunks.load());
+    }
+
+    for (const std::atomic<uint32_t>& count : visits)
+    {
+        REQUIRE(count.load(std::memory_order_relaxed) == 1);
+    }
+}
+
+TEST_CASE("JobSystem parallel_for with an empty range completes immediately", "[JobSystem]")
+{
+    JobSystemBasicScope scope;
+    REQUIRE(scope.job_system.init(2, false));
+    scope.initialized = true;
+
+    std::atomic<bool> executed = false;
+
+    JobHandle handle = scope.job_system.parallel_for(
+        JobRange{10, 10}, 1, [&](size_t) { executed.store(true, std::memory_order_relaxed); });
+
+    REQUIRE(scope.job_system.wait_for_blocking(handle));
+    REQUIRE_FALSE(executed.load());
+}
+
+TEST_CASE("JobSystem parallel_for and parallel_reduce can be waited from inside a job fiber", "[JobSystem]")
+{
+    constexpr size_t NumElements = 10'000;
+
+    JobSystemBasicScope scope;
+    REQUIRE(scope.job_system.init(4, false));
+    scope.initialized = true;
+
+    std::vector<uint64_t> values(NumElements, 0);
+    uint64_t sum = 0;
+
+    JobHandle handle = scope.job_system
+                           .schedule([&] {
+                               JobHandle fill = scope.job_system.parallel_for(
+                                   JobRange{0, NumElements}, 128, [&](size_t index) { values[index] = index; });
+                               scope.job_system.wait_for(fill);
+
+                               sum = scope.job_system.parallel_reduce(
+                                   JobRange{0, NumElements},
+                                   128,
+                                   uint64_t{0},
+                                   [&](size_t index) { return values[index]; },
+                                   [](uint64_t a, uint64_t b) { return a + b; });
+                           })
+                           .submit();
+
+    REQUIRE(scope.job_system.wait_for_blocking(handle));
+    REQUIRE(sum == uint64_t{NumElements} * (NumElements - 1) / 2);
+}
+
+TEST_CASE("JobSystem worker counters track executed jobs and fibers in use", "[JobSystem]")
+{
+    constexpr int32_t NumJobs = 256;
+
+    JobSystemDescription desc{};
+    desc.num_workers = 4;
+    desc.reserve_main_thread = false;
+
+    SECTION("disabled by default")
+    {
+        JobSystemBasicScope scope;
+        REQUIRE(scope.job_system.init(desc));
+        scope.initialized = true;
+
+        JobHandle handle = scope.job_system.schedule([] {}).submit();
+        REQUIRE(scope.job_system.wait_for_blocking(handle));
+
+        REQUIRE(scope.job_system.get_counters().workers.empty());
+    }
+
+    SECTION("enabled")
+    {
+        desc.enable_worker_counters = true;
+
+        JobSystemBasicScope scope;
+        REQUIRE(scope.job_system.init(desc));
+        scope.initialized = true;
+
+        std::atomic<bool> release = false;
+        std::atomic<int32_t> executed = 0;
+
+        JobHandle blocked = scope.job_system
+                                .schedule([&] {
+                                    while (!release.load(std::memory_order_acquire))
+                                    {
+                                        std::this_thread::yield();
+                                    }
+                                })
+                                .stack_size(StackSize::Small)
+                                .submit();
+
+        // The blocked job keeps its fiber until it returns
+        REQUIRE(scope.job_system.get_counters().num_small_fibers_in_use == 1);
+        release.store(true, std::memory_order_release);
+        REQUIRE(scope.job_system.wait_for_blocking(blocked));
+
+        std::vector<JobHandle> handles;
+        for (int32_t index = 0; index < NumJobs; ++index)
+        {
+            handles.push_back(
+                scope.job_system.schedule([&] { executed.fetch_add(1, std::memory_order_relaxed); }).submit());
+        }
+
+        for (const JobHandle& handle : handles)
+        {
+            REQUIRE(scope.job_system.wait_for_blocking(handle));
+        }
+
+        // Completion is signaled right before the job and fiber are released
+        const auto start = std::chrono::steady_clock::now();
+        while (scope.job_system.get_counters().num_medium_fibers_in_use != 0
+               && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+        {
+            std::this_thread::yield();
+        }
+
+        const JobSystemCounters counters = scope.job_system.get_counters();
+        REQUIRE_FALSE(counters.workers.empty());
+
+        uint64_t num_jobs_executed = 0;
+        for (const JobWorkerCounters& worker_counters : counters.workers)
+        {
+            REQUIRE(worker_counters.num_steals <= worker_counters.num_steal_attempts);
+            num_jobs_executed += worker_counters.num_jobs_executed;
+        }
+
+        REQUIRE(num_jobs_executed == NumJobs + 1);
+        REQUIRE(counters.num_small_fibers_in_use == 0);
+        REQUIRE(counters.num_medium_fibers_in_use == 0);
+        REQUIRE(counters.num_large_fibers_in_use == 0);
+    }
+}
+
+TEST_CASE("JobSystem accepts borrowed and moved dependency handles", "[JobSystem]")
+{
+    JobSystemBasicScope scope;
+    REQUIRE(scope.job_system.init(4, false));
+    scope.initialized = true;
+
+    std::atomic<int32_t> num_upstream_done = 0;
+    std::atomic<int32_t> observed_upstream_done = -1;
+
+    JobHandle borrowed =
+        scope.job_system.schedule([&] { num_upstream_done.fetch_add(1, std::memory_order_acq_rel); }).submit();
+    JobHandle moved =
+        scope.job_system.schedule([&] { num_upstream_done.fetch_add(1, std::memory_order_acq_rel); }).submit();
+
+    const JobHandleRef borrowed_ref = borrowed;
+    REQUIRE(borrowed_ref.is_valid());
+
+    JobHandle downstream =
+        scope.job_system
+            .schedule([&] {
+                const int32_t upstream_done = num_upstream_done.load(std::memory_order_acquire);
+                observed_upstream_done.store(upstream_done, std::memory_order_release);
+            })
+            .depends_on(borrowed_ref)
+            .depends_on(std::move(moved))
+            .submit();
+
+    REQUIRE_FALSE(moved.is_valid());
+    REQUIRE(scope.job_system.wait_for_blocking(downstream));
+    REQUIRE(observed_upstream_done.load(std::memory_order_acquire) == 2);
+
+    JobHandle reassigned = scope.job_system.schedule([] {}).submit();
+    reassigned = std::move(downstream);
+
+    REQUIRE_FALSE(downstream.is_valid());
+    REQUIRE(scope.job_system.wait_for_blocking(reassigned));
+}
+
+TEST_CASE("JobSystem release_handles drops references of duplicated handles", "[JobSystem]")
+{
+    constexpr int32_t NumIterations = 512;
+    constexpr size_t NumCopies = 4;
+
+    JobSystemBasicScope scope;
+    REQUIRE(scope.job_system.init(2, false));
+    scope.initialized = true;
+
+    for (int32_t iteration = 0; iteration < NumIterations; ++iteration)
+    {
+        std::vector<JobHandle> handles;
+
+        JobHandle handle = scope.job_system.schedule([] {}).submit();
+        for (size_t copy = 0; copy < NumCopies; ++copy)
+        {
+            handles.push_back(handle);
+        }
+        handles.push_back(std::move(handle));
+
+        REQUIRE(scope.job_system.wait_for_blocking(handles.front()));
+        scope.job_system.release_handles(handles);
+
+        for (const JobHandle& released : handles)
+        {
+            REQUIRE_FALSE(released.is_valid());
+        }
+    }
+
+    // A leaked reference would keep its completion record allocated on every iteration
+    REQUIRE(scope.job_system.get_capacity_stats().completion_records.high_water < NumIterations / 2);
+}
@@ -456,3 +456,96 @@ TEST_CASE("MpscQueue concurrent producer and consumer preserve all values", "[Mp
     size_t value = 0;
     REQUIRE_FALSE(queue.pop(value));
 }
+
+TEST_CASE("MpscQueue grows up to its maximum capacity preserving order", "[MpscQueue]")
+{
+    constexpr int32_t MaxCapacity = 32;
+
+    MpscQueue<int32_t, 4> queue;
+    queue.init(4, MaxCapacity);
+
+    int32_t value = -1;
+
+    // Leave a value in the first ring so the consumer has to drain it before moving to the grown ones
+    REQUIRE(queue.push(-1));
+    REQUIRE(queue.push(-1));
+    REQUIRE(queue.pop(value));
+
+    int32_t num_pushed = 0;
+    while (queue.push(num_pushed))
+    {
+        num_pushed += 1;
+    }
+
+    REQUIRE(queue.get_capacity() == MaxCapacity);
+    REQUIRE(num_pushed >= MaxCapacity);
+
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == -1);
+
+    for (int32_t i = 0; i < num_pushed; ++i)
+    {
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == i);
+    }
+
+    REQUIRE(queue.empty());
+    REQUIRE_FALSE(queue.pop(value));
+}
+
+TEST_CASE("MpscQueue concurrent producers grow the queue without losing values", "[MpscQueue]")
+{
+    constexpr size_t NumProducers = 4;
+    constexpr size_t ItemsPerProducer = 1024;
+
+    MpscQueue<size_t, 2> queue;
+    queue.init(2, NumProducers * ItemsPerProducer);
+
+    std::atomic<bool> start = false;
+    std::atomic<bool> failed_push = false;
+
+    std::vector<std::thread> producers;
+    for (size_t producer_index = 0; producer_index < NumProducers; ++producer_index)
+    {
+        producers.emplace_back([&, producer_index] {
+            wait_for_mpsc_start(start);
+
+            for (size_t item = 0; item < ItemsPerProducer; ++item)
+            {
+                if (!queue.push(producer_index * ItemsPerProducer + item))
+                    failed_push.store(true, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    REQUIRE_FALSE(failed_push.load());
+
+    std::vector<bool> seen(NumProducers * ItemsPerProducer, false);
+    std::array<size_t, NumProducers> last_item{};
+    last_item.fill(ItemsPerProducer);
+
+    size_t value = 0;
+    size_t num_popped = 0;
+    while (queue.pop(value))
+    {
+        REQUIRE_FALSE(seen[value]);
+        seen[value] = true;
+
+        // Values of the same producer keep their order
+        const size_t producer_index = value / ItemsPerProducer;
+        const size_t item = value % ItemsPerProducer;
+        REQUIRE((last_item[producer_index] == ItemsPerProducer || item > last_item[producer_index]));
+        last_item[producer_index] = item;
+
+        num_popped += 1;
+    }
+
+    REQUIRE(num_popped == NumProducers * ItemsPerProducer);
+}
@@ -441,3 +441,41 @@ TEST_CASE("WorkStealingDeque concurrent push and steal preserves uniqueness", "[
         REQUIRE(unique_values.find(expected) != unique_values.end());
     }
 }
+
+TEST_CASE("WorkStealingDeque grows up to its maximum capacity", "[WorkStealingDeque]")
+{
+    constexpr int32_t MaxCapacity = 64;
+
+    WorkStealingDeque<int32_t, 4> deque;
+    deque.init(4, MaxCapacity);
+
+    int32_t value = -1;
+
+    // Steal a few values first so the live range wraps around the ring when it grows
+    for (int32_t i = 0; i < 3; ++i)
+    {
+        REQUIRE(deque.push(-1));
+        REQUIRE(deque.steal(value));
+    }
+
+    for (int32_t i = 0; i < MaxCapacity; ++i)
+    {
+        REQUIRE(deque.push(i));
+    }
+
+    REQUIRE(deque.get_capacity() == MaxCapacity);
+    REQUIRE(deque.full());
+    REQUIRE_FALSE(deque.push(MaxCapacity));
+
+    REQUIRE(deque.steal(value));
+    REQUIRE(value == 0);
+
+    for (int32_t i = MaxCapacity - 1; i > 0; --i)
+    {
+        REQUIRE(deque.pop(value));
+        REQUIRE(value == i);
+    }
+
+    REQUIRE(deque.empty());
+    REQUIRE_FALSE(deque.full());
+}
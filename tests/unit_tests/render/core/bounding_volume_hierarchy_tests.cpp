@@ -0,0 +1,189 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "base/math/aabb.h"
+#include "render/core/bounding_volume_hierarchy.h"
+
+#include "culling_test_utils.h"
+
+using namespace Mizu;
+
+static const RandomBoxesDescription BvhTestBoxes{
+    .min_position = glm::vec3(-50.0f),
+    .max_position = glm::vec3(50.0f),
+    .min_size = 0.1f,
+    .max_size = 3.0f,
+};
+
+static Frustum make_bvh_test_frustum()
+{
+    return make_test_frustum(glm::vec3(5.0f, 2.0f, 30.0f), glm::vec3(0.0f), 45.0f, 60.0f);
+}
+
+// `boxes[i]` is the box of the leaf with user data `i`, removed boxes have no leaf
+static void require_query_matches_brute_force(
+    const BoundingVolumeHierarchy& bvh,
+    const std::vector<AABB>& boxes,
+    const std::vector<bool>& alive,
+    const Frustum& frustum,
+    FrustumMask mask)
+{
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < boxes.size(); ++i)
+    {
+        if (alive[i] && frustum.is_inside_frustum(boxes[i], mask))
+            expected.push_back(i);
+    }
+
+    std::vector<uint32_t> visible;
+    bvh.query(frustum, mask, visible);
+    std::sort(visible.begin(), visible.end());
+
+    REQUIRE(visible == expected);
+
+    // A scratch that was used by other queries gives the same result
+    static BoundingVolumeHierarchy::QueryScratch scratch;
+
+    visible.clear();
+    bvh.query(frustum, mask, visible, scratch);
+    std::sort(visible.begin(), visible.end());
+
+    REQUIRE(visible == expected);
+}
+
+TEST_CASE("BoundingVolumeHierarchy query matches testing every box", "[Render]")
+{
+    constexpr uint32_t NumBoxes = 2'000;
+
+    std::mt19937 rng(7);
+
+    BoundingVolumeHierarchy bvh;
+    std::vector<AABB> boxes;
+    std::vector<uint32_t> leaves;
+    std::vector<bool> alive(NumBoxes, true);
+
+    for (uint32_t i = 0; i < NumBoxes; ++i)
+    {
+        boxes.push_back(make_random_box(rng, BvhTestBoxes));
+        leaves.push_back(bvh.insert(boxes.back(), i));
+    }
+
+    REQUIRE(bvh.get_num_leaves() == NumBoxes);
+    // An AVL balanced tree is at most ~1.44 * log2(n) high
+    REQUIRE(bvh.get_height() <= static_cast<uint32_t>(std::ceil(1.45 * std::log2(NumBoxes))) + 1);
+
+    const Frustum frustum = make_bvh_test_frustum();
+
+    SECTION("After inserting")
+    {
+        require_query_matches_brute_force(bvh, boxes, alive, frustum, FrustumMask{});
+        require_query_matches_brute_force(bvh, boxes, alive, frustum, FrustumMask{.near = false, .far = false});
+    }
+
+    SECTION("After updating and removing")
+    {
+        std::uniform_real_distribution<float> small_move_dist(-0.2f, 0.2f);
+
+        for (uint32_t i = 0; i < NumBoxes; ++i)
+        {
+            if (i % 3 == 0)
+            {
+                // Small movement, usually stays inside the fat bounds
+                const glm::vec3 offset{small_move_dist(rng), small_move_dist(rng), small_move_dist(rng)};
+                boxes[i] = AABB(boxes[i].min() + offset, boxes[i].max() + offset);
+            }
+            else if (i % 3 == 1)
+            {
+                // Teleport, reinserts the leaf
+                boxes[i] = make_random_box(rng, BvhTestBoxes);
+            }
+            else
+            {
+                continue;
+            }
+
+            bvh.update(leaves[i], boxes[i]);
+        }
+
+        for (uint32_t i = 0; i < NumBoxes; i += 4)
+        {
+            bvh.remove(leaves[i]);
+            alive[i] = false;
+        }
+
+        REQUIRE(bvh.get_num_leaves() == NumBoxes - NumBoxes / 4);
+
+        require_query_matches_brute_force(bvh, boxes, alive, frustum, FrustumMask{});
+    }
+}
+
+TEST_CASE("BoundingVolumeHierarchy only reinserts leaves that leave their fat bounds", "[Render]")
+{
+    BoundingVolumeHierarchy bvh;
+
+    const AABB box(glm::vec3(0.0f), glm::vec3(1.0f));
+    const uint32_t leaf = bvh.insert(box, 0);
+    bvh.insert(AABB(glm::vec3(10.0f), glm::vec3(11.0f)), 1);
+
+    const auto moved_box = [&](float offset) {
+        return AABB(box.min() + glm::vec3(offset, 0.0f, 0.0f), box.max() + glm::vec3(offset, 0.0f, 0.0f));
+    };
+
+    // Inside the margin
+    REQUIRE_FALSE(bvh.update(leaf, moved_box(0.05f)));
+    REQUIRE(bvh.get_bounds(leaf).min() == moved_box(0.05f).min());
+    REQUIRE(bvh.get_bounds(leaf).max() == moved_box(0.05f).max());
+
+    // Out of the fat bounds, which are then extended along the movement
+    REQUIRE(bvh.update(leaf, moved_box(0.5f)));
+    REQUIRE_FALSE(bvh.update(leaf, moved_box(1.0f)));
+
+    // Queries use the exact bounds, the fat bounds of the leaf cross the far plane but the box doesn't
+    const Frustum frustum = make_test_frustum(glm::vec3(-10.0f, 0.5f, 0.5f), glm::vec3(0.0f, 0.5f, 0.5f), 60.0f, 10.5f);
+    REQUIRE_FALSE(frustum.is_inside_frustum(moved_box(1.0f)));
+
+    std::vector<uint32_t> visible;
+    bvh.query(frustum, FrustumMask{}, visible);
+    REQUIRE(visible.empty());
+
+    REQUIRE(bvh.get_num_leaves() == 2);
+}
+
+TEST_CASE("BoundingVolumeHierarchy reuses removed nodes and keeps user data", "[Render]")
+{
+    BoundingVolumeHierarchy bvh;
+
+    std::vector<uint32_t> visible;
+    bvh.query(make_bvh_test_frustum(), FrustumMask{}, visible);
+    REQUIRE(visible.empty());
+
+    const uint32_t leaf_a = bvh.insert(AABB(glm::vec3(-1.0f), glm::vec3(1.0f)), 10);
+    const uint32_t leaf_b = bvh.insert(AABB(glm::vec3(2.0f), glm::vec3(3.0f)), 20);
+
+    REQUIRE(bvh.get_user_data(leaf_a) == 10);
+    REQUIRE(bvh.get_user_data(leaf_b) == 20);
+
+    bvh.set_user_data(leaf_b, 30);
+    REQUIRE(bvh.get_user_data(leaf_b) == 30);
+
+    bvh.remove(leaf_a);
+    REQUIRE(bvh.get_num_leaves() == 1);
+    REQUIRE(bvh.get_height() == 0);
+
+    const uint32_t leaf_c = bvh.insert(AABB(glm::vec3(5.0f), glm::vec3(6.0f)), 40);
+    REQUIRE(bvh.get_user_data(leaf_c) == 40);
+    REQUIRE(bvh.get_user_data(leaf_b) == 30);
+    REQUIRE(bvh.get_height() == 1);
+
+    REQUIRE(bvh.get_bounds(leaf_c).min() == glm::vec3(5.0f));
+    REQUIRE(bvh.get_bounds(leaf_c).max() == glm::vec3(6.0f));
+
+    bvh.clear();
+    REQUIRE(bvh.get_num_leaves() == 0);
+    REQUIRE(bvh.get_height() == 0);
+}
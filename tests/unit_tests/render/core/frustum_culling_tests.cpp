@@ -0,0 +1,103 @@
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "base/math/aabb.h"
+#include "render/core/frustum_culling.h"
+
+#include "culling_test_utils.h"
+
+using namespace Mizu;
+
+// Boxes around the origin, partially inside the test frustums
+static const RandomBoxesDescription CullingTestBoxes{
+    .min_position = glm::vec3(-60.0f),
+    .max_position = glm::vec3(60.0f),
+    .min_size = 0.1f,
+    .max_size = 4.0f,
+};
+
+TEST_CASE("cull_frustums matches Frustum::is_inside_frustum", "[Render]")
+{
+    // Not a multiple of the SIMD width nor of the mask word size, so the scalar tail and partial words are tested
+    constexpr size_t NumBoxes = 1'003;
+
+    const std::vector<AABB> boxes = make_random_boxes(NumBoxes, 42, CullingTestBoxes);
+
+    CullingBounds bounds;
+    for (const AABB& box : boxes)
+        bounds.push_back(box);
+
+    const std::array frustums = {
+        make_test_frustum(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 60.0f, 50.0f),
+        make_test_frustum(glm::vec3(10.0f, 5.0f, 0.0f), glm::vec3(0.0f), 60.0f, 50.0f),
+        make_test_frustum(glm::vec3(-20.0f, 0.0f, 20.0f), glm::vec3(0.0f, -5.0f, 0.0f), 60.0f, 50.0f),
+    };
+    const std::array masks = {
+        FrustumMask{},
+        FrustumMask{.near = false, .far = false},
+        FrustumMask{.top = false},
+    };
+
+    const size_t word_count = get_visibility_mask_word_count(NumBoxes);
+    std::vector<uint64_t> visibility_masks(frustums.size() * word_count, ~uint64_t{0});
+
+    cull_frustums(frustums, masks, bounds, visibility_masks);
+
+    for (size_t f = 0; f < frustums.size(); ++f)
+    {
+        const std::span<const uint64_t> visibility_mask =
+            std::span(visibility_masks).subspan(f * word_count, word_count);
+
+        size_t num_visible = 0;
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            const bool expected = frustums[f].is_inside_frustum(boxes[i], masks[f]);
+            REQUIRE(is_visible(visibility_mask, i) == expected);
+
+            num_visible += expected ? 1 : 0;
+        }
+
+        // Make sure the test frustums are not trivially accepting or rejecting everything
+        REQUIRE(num_visible > 0);
+        REQUIRE(num_visible < NumBoxes);
+
+        // Bits past the last box must stay cleared
+        REQUIRE((visibility_mask.back() >> (NumBoxes % 64)) == 0);
+    }
+}
+
+TEST_CASE("compact_visible_indices writes the visible indices in order", "[Render]")
+{
+    const std::array<uint64_t, 2> visibility_mask = {
+        (uint64_t{1} << 0) | (uint64_t{1} << 5) | (uint64_t{1} << 63),
+        (uint64_t{1} << 2),
+    };
+
+    std::array<uint32_t, 128> indices{};
+    const size_t num_visible = compact_visible_indices(visibility_mask, indices);
+
+    REQUIRE(num_visible == 4);
+    REQUIRE(indices[0] == 0);
+    REQUIRE(indices[1] == 5);
+    REQUIRE(indices[2] == 63);
+    REQUIRE(indices[3] == 66);
+}
+
+TEST_CASE("CullingBounds erase_swap_back moves the last element", "[Render]")
+{
+    CullingBounds bounds;
+    bounds.push_back(AABB(glm::vec3(0.0f), glm::vec3(2.0f)));
+    bounds.push_back(AABB(glm::vec3(10.0f), glm::vec3(14.0f)));
+    bounds.push_back(AABB(glm::vec3(-4.0f), glm::vec3(-2.0f)));
+
+    bounds.erase_swap_back(0);
+
+    REQUIRE(bounds.size() == 2);
+    REQUIRE(bounds.center_x()[0] == -3.0f);
+    REQUIRE(bounds.extent_x()[0] == 1.0f);
+    REQUIRE(bounds.center_x()[1] == 12.0f);
+    REQUIRE(bounds.extent_x()[1] == 2.0f);
+}
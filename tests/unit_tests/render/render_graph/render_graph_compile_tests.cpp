@@ -0,0 +1,489 @@
+#include <catch2/catch_all.hpp>
+
+#if MIZU_RENDER_CORE_NULL_ENABLED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "core/job_system/job_system.h"
+#include "core/runtime.h"
+#include "render/render_graph/render_graph.h"
+#include "render/render_graph/render_graph_builder.h"
+#include "render/render_graph/render_graph_resource_registry.h"
+#include "render/runtime/renderer.h"
+#include "render_core.null/null_command_buffer.h"
+#include "render_core/rhi/device.h"
+#include "render_core/rhi/device_memory_allocator.h"
+#include "render_core/rhi/synchronization.h"
+
+using namespace Mizu;
+
+struct EmptyPassData
+{
+};
+
+// Compiles render graphs with the null backend, so the whole compile runs without a GPU
+struct NullRenderGraphContext
+{
+    std::shared_ptr<TransientMemoryPool> transient_pool;
+    RenderGraphResourceRegistry resource_registry{false};
+
+    NullRenderGraphContext()
+    {
+        g_render_device = Device::create(DeviceCreationDescription{
+            .api = GraphicsApi::Null,
+            .specific_config = NullSpecificConfiguration{},
+        });
+        transient_pool = g_render_device->create_transient_memory_pool("RenderGraphCompileTests");
+    }
+
+    ~NullRenderGraphContext()
+    {
+        resource_registry.reset();
+        transient_pool = nullptr;
+
+        delete g_render_device;
+        g_render_device = nullptr;
+        Device::free();
+    }
+
+    void compile(RenderGraphBuilder& builder, RenderGraph& graph)
+    {
+        builder.compile(graph, RenderGraphBuilderCompileOptions{*transient_pool, resource_registry});
+    }
+
+    std::shared_ptr<BufferResource> create_external_buffer() const
+    {
+        BufferDescription desc = create_structured_buffer_desc(64, 4, "External");
+        desc.usage |= BufferUsageBits::UnorderedAccess;
+
+        return g_render_device->create_buffer(desc);
+    }
+};
+
+using NullCommandInspectFunc = std::function<void(const Null::NullCommandBuffer&)>;
+
+static void add_test_pass(
+    RenderGraphBuilder& builder,
+    std::string_view name,
+    std::initializer_list<RenderGraphResource> reads,
+    std::initializer_list<RenderGraphResource> writes,
+    NullCommandInspectFunc inspect_func = {})
+{
+    builder.add_pass<EmptyPassData>(
+        name,
+        [&](RenderGraphPassBuilder& pass, EmptyPassData&) {
+            pass.set_hint(RenderGraphPassHint::Compute);
+
+            for (RenderGraphResource resource : reads)
+                pass.read(resource);
+
+            for (RenderGraphResource resource : writes)
+                pass.write(resource);
+        },
+        [inspect_func](CommandBuffer& command, const EmptyPassData&, const RenderGraphPassResources&) {
+            if (inspect_func)
+                inspect_func(static_cast<const Null::NullCommandBuffer&>(command));
+
+            command.dispatch({1, 1, 1});
+        });
+}
+
+static RenderGraphResource register_test_external_buffer(
+    RenderGraphBuilder& builder,
+    std::shared_ptr<BufferResource> buffer)
+{
+    return builder.register_external_buffer(
+        std::move(buffer),
+        {.initial_state = BufferResourceState::ShaderReadOnly, .final_state = BufferResourceState::ShaderReadOnly});
+}
+
+// Barrier recorded right before the marker of the pass being executed, nullptr if the pass has no barrier
+static const Null::NullBarrierCmd* get_pass_barrier(const Null::NullCommandBuffer& command)
+{
+    const std::span<const Null::NullCommand> commands = command.get_commands();
+    if (commands.size() < 2 || !std::holds_alternative<Null::NullBeginGpuMarkerCmd>(commands.back()))
+        return nullptr;
+
+    return std::get_if<Null::NullBarrierCmd>(&commands[commands.size() - 2]);
+}
+
+TEST_CASE("RenderGraphBuilder reuses the compiled topology while the graph doesn't change", "[Render]")
+{
+    NullRenderGraphContext context;
+    const std::shared_ptr<BufferResource> output_buffer = context.create_external_buffer();
+
+    RenderGraphBuilder builder;
+    RenderGraph graph;
+
+    const auto build_graph = [&](bool extra_pass) {
+        builder.reset();
+
+        const RenderGraphResource buffer = builder.create_structured_buffer(64, 4, "Buffer");
+        const RenderGraphResource output = register_test_external_buffer(builder, output_buffer);
+
+        add_test_pass(builder, "Producer", {}, {buffer});
+        if (extra_pass)
+            add_test_pass(builder, "Extra", {buffer}, {output});
+        add_test_pass(builder, "Consumer", {buffer}, {output});
+    };
+
+    build_graph(false);
+    context.compile(builder, graph);
+    graph.execute();
+
+    build_graph(false);
+    context.compile(builder, graph);
+    graph.execute();
+
+    REQUIRE(builder.get_compile_stats().num_cache_misses == 1);
+    REQUIRE(builder.get_compile_stats().num_cache_hits == 1);
+
+    build_graph(true);
+    context.compile(builder, graph);
+    graph.execute();
+
+    REQUIRE(builder.get_compile_stats().num_cache_misses == 2);
+    REQUIRE(builder.get_compile_stats().num_cache_hits == 1);
+}
+
+TEST_CASE("RenderGraph records the transitions before a pass in a single barrier", "[Render]")
+{
+    NullRenderGraphContext context;
+    const std::shared_ptr<BufferResource> output_buffer = context.create_external_buffer();
+
+    RenderGraphBuilder builder;
+    RenderGraph graph;
+
+    const RenderGraphResource buffer_a = builder.create_structured_buffer(64, 4, "BufferA");
+    const RenderGraphResource buffer_b = builder.create_structured_buffer(64, 4, "BufferB");
+    const RenderGraphResource output = register_test_external_buffer(builder, output_buffer);
+
+    size_t num_consumer_transitions = 0;
+
+    add_test_pass(builder, "Producer", {}, {buffer_a, buffer_b});
+    add_test_pass(builder, "Consumer", {buffer_a, buffer_b}, {output}, [&](const Null::NullCommandBuffer& command) {
+        const Null::NullBarrierCmd* barrier = get_pass_barrier(command);
+        REQUIRE(barrier != nullptr);
+
+        num_consumer_transitions = barrier->buffer_transitions.size();
+    });
+
+    context.compile(builder, graph);
+    graph.execute();
+
+    // BufferA and BufferB to ShaderReadOnly and the output to UnorderedAccess
+    REQUIRE(num_consumer_transitions == 3);
+
+    const RenderGraphCompileStats& stats = builder.get_compile_stats();
+    REQUIRE(stats.num_barriers < stats.num_transitions);
+    REQUIRE(stats.num_split_transitions == 0);
+}
+
+TEST_CASE("RenderGraph records a transition per barrier when batching is disabled", "[Render]")
+{
+    NullRenderGraphContext context;
+    const std::shared_ptr<BufferResource> output_buffer = context.create_external_buffer();
+
+    RenderGraphBuilder builder(RenderGraphBuilderConfig{.batch_transitions = false});
+    RenderGraph graph;
+
+    const RenderGraphResource buffer_a = builder.create_structured_buffer(64, 4, "BufferA");
+    const RenderGraphResource buffer_b = builder.create_structured_buffer(64, 4, "BufferB");
+    const RenderGraphResource output = register_test_external_buffer(builder, output_buffer);
+
+    add_test_pass(builder, "Producer", {}, {buffer_a, buffer_b});
+    add_test_pass(builder, "Consumer", {buffer_a, buffer_b}, {output});
+
+    context.compile(builder, graph);
+    graph.execute();
+
+    const RenderGraphCompileStats& stats = builder.get_compile_stats();
+    REQUIRE(stats.num_transitions > 0);
+    REQUIRE(stats.num_barriers == stats.num_transitions);
+}
+
+TEST_CASE("RenderGraph splits the transitions of resources not used by the passes in between", "[Render]")
+{
+    NullRenderGraphContext context;
+    const std::shared_ptr<BufferResource> output_buffer = context.create_external_buffer();
+
+    RenderGraphBuilder builder;
+    RenderGraph graph;
+
+    const RenderGraphResource buffer = builder.create_structured_buffer(64, 4, "Buffer");
+    const RenderGraphResource middle_input = builder.create_structured_buffer(64, 4, "MiddleInput");
+    const RenderGraphResource middle_output = builder.create_structured_buffer(64, 4, "MiddleOutput");
+    const RenderGraphResource output = register_test_external_buffer(builder, output_buffer);
+
+    bool middle_begins_split = false;
+    bool consumer_ends_split = false;
+
+    const auto has_split_transition = [&](const Null::NullCommandBuffer& command, ResourceTransitionSplit split) {
+        const Null::NullBarrierCmd* barrier = get_pass_barrier(command);
+        if (barrier == nullptr)
+            return false;
+
+        return std::ranges::any_of(barrier->buffer_transitions, [&](const BufferTransition& transition) {
+            return transition.info.split == split;
+        });
+    };
+
+    // The dependencies through MiddleInput and MiddleOutput order the passes, Middle doesn't access Buffer
+    add_test_pass(builder, "Producer", {}, {buffer, middle_input});
+    add_test_pass(builder, "Middle", {middle_input}, {middle_output}, [&](const Null::NullCommandBuffer& command) {
+        middle_begins_split = has_split_transition(command, ResourceTransitionSplit::Begin);
+    });
+    add_test_pass(builder, "Consumer", {buffer, middle_output}, {output}, [&](const Null::NullCommandBuffer& command) {
+        consumer_ends_split = has_split_transition(command, ResourceTransitionSplit::End);
+    });
+
+    context.compile(builder, graph);
+    graph.execute();
+
+    REQUIRE(builder.get_compile_stats().num_split_transitions > 0);
+    REQUIRE(middle_begins_split);
+    REQUIRE(consumer_ends_split);
+}
+
+TEST_CASE("RenderGraphBuilder aliases the memory of all the resources released in a pass", "[Render]")
+{
+    const RenderGraphAliasingHeuristic heuristic = GENERATE(
+        RenderGraphAliasingHeuristic::FirstFit,
+        RenderGraphAliasingHeuristic::BestFit,
+        RenderGraphAliasingHeuristic::InterferenceGraph);
+
+    NullRenderGraphContext context;
+    const std::shared_ptr<BufferResource> output_buffer = context.create_external_buffer();
+
+    RenderGraphBuilder builder(RenderGraphBuilderConfig{.aliasing_heuristic = heuristic});
+    RenderGraph graph;
+
+    constexpr uint64_t SIZE = 64 * 1024;
+
+    const RenderGraphResource buffer_a = builder.create_structured_buffer(SIZE, 4, "BufferA");
+    const RenderGraphResource buffer_b = builder.create_structured_buffer(SIZE, 4, "BufferB");
+    const RenderGraphResource buffer_c = builder.create_structured_buffer(SIZE, 4, "BufferC");
+    const RenderGraphResource buffer_d = builder.create_structured_buffer(SIZE * 2, 4, "BufferD");
+    const RenderGraphResource output = register_test_external_buffer(builder, output_buffer);
+
+    // BufferA and BufferB are released after the same pass, BufferD fits in the memory of both
+    add_test_pass(builder, "A", {}, {buffer_a, buffer_b});
+    add_test_pass(builder, "B", {buffer_a, buffer_b}, {buffer_c});
+    add_test_pass(builder, "C", {buffer_c}, {buffer_d});
+    add_test_pass(builder, "D", {buffer_d}, {output});
+
+    context.compile(builder, graph);
+    graph.execute();
+
+    const RenderGraphCompileStats& stats = builder.get_compile_stats();
+    REQUIRE(stats.num_transient_resources == 4);
+    REQUIRE(stats.num_transient_heaps == 1);
+    REQUIRE(stats.transient_memory_unaliased_size == SIZE * 5);
+    REQUIRE(stats.transient_memory_lower_bound == SIZE * 3);
+    REQUIRE(stats.transient_memory_size == SIZE * 3);
+    REQUIRE(stats.transient_memory_committed_size >= stats.transient_memory_size);
+}
+
+// Records the passes that allow it on JobSystem workers, like the renderer does
+struct RenderGraphJobSystemScope
+{
+    JobSystem job_system;
+
+    RenderGraphJobSystemScope()
+    {
+        REQUIRE(job_system.init(2, false));
+        g_job_system = &job_system;
+    }
+
+    ~RenderGraphJobSystemScope()
+    {
+        g_job_system = nullptr;
+        job_system.wait_workers_dead();
+    }
+};
+
+struct ChainPassRecord
+{
+    const Null::NullCommandBuffer* command_buffer = nullptr;
+    uint32_t record_order = 0;
+};
+
+// Every pass copies the element of the previous pass into its own element, so all the elements only end with the
+// value of the first one if the passes are submitted in order
+static std::shared_ptr<BufferResource> add_chain_passes(
+    RenderGraphBuilder& builder,
+    std::span<const bool> parallel_passes,
+    std::span<ChainPassRecord> records,
+    std::atomic<uint32_t>& num_recorded_passes)
+{
+    BufferDescription desc = create_staging_buffer_desc(sizeof(uint32_t) * parallel_passes.size(), "Chain");
+    desc.usage |= BufferUsageBits::TransferDst | BufferUsageBits::UnorderedAccess;
+
+    const std::shared_ptr<BufferResource> chain_buffer = g_render_device->create_buffer(desc);
+
+    std::vector<uint32_t> initial_data(parallel_passes.size(), 0);
+    initial_data[0] = 7;
+    chain_buffer->set_data(reinterpret_cast<const uint8_t*>(initial_data.data()));
+
+    const RenderGraphResource chain = register_test_external_buffer(builder, chain_buffer);
+
+    for (size_t pass_idx = 0; pass_idx < parallel_passes.size(); ++pass_idx)
+    {
+        builder.add_pass<EmptyPassData>(
+            parallel_passes[pass_idx] ? "ParallelChainPass" : "SerialChainPass",
+            [&](RenderGraphPassBuilder& pass, EmptyPassData&) {
+                pass.set_hint(RenderGraphPassHint::Compute);
+                pass.set_has_side_effects(true);
+                pass.set_allow_parallel_recording(parallel_passes[pass_idx]);
+
+                pass.write(chain);
+            },
+            [=, &num_recorded_passes](CommandBuffer& command, const EmptyPassData&, const RenderGraphPassResources&) {
+                records[pass_idx] = ChainPassRecord{
+                    .command_buffer = &static_cast<const Null::NullCommandBuffer&>(command),
+                    .record_order = num_recorded_passes.fetch_add(1),
+                };
+
+                if (pass_idx == 0)
+                    return;
+
+                const uint64_t element_size = sizeof(uint32_t);
+                command.copy_buffer_to_buffer(
+                    *chain_buffer,
+                    *chain_buffer,
+                    CopyBufferToBufferInfo{
+                        .size = element_size,
+                        .src_offset = (pass_idx - 1) * element_size,
+                        .dst_offset = pass_idx * element_size,
+                    });
+            });
+    }
+
+    return chain_buffer;
+}
+
+static void require_chain_submitted_in_order(const BufferResource& chain_buffer, size_t num_passes)
+{
+    const uint32_t* chain_data = reinterpret_cast<const uint32_t*>(chain_buffer.get_mapped_data());
+
+    for (size_t i = 0; i < num_passes; ++i)
+    {
+        REQUIRE(chain_data[i] == 7);
+    }
+}
+
+TEST_CASE("RenderGraph records parallel passes into their own command lists and submits them in order", "[Render]")
+{
+    NullRenderGraphContext context;
+    RenderGraphJobSystemScope job_system_scope;
+
+    const std::array parallel_passes = {false, false, true, true, false};
+    std::array<ChainPassRecord, parallel_passes.size()> records{};
+    std::atomic<uint32_t> num_recorded_passes = 0;
+
+    RenderGraphBuilder builder(RenderGraphBuilderConfig{.async_compute_enabled = false});
+    RenderGraph graph;
+
+    const std::shared_ptr<BufferResource> chain_buffer =
+        add_chain_passes(builder, parallel_passes, records, num_recorded_passes);
+
+    context.compile(builder, graph);
+    graph.execute();
+
+    REQUIRE(num_recorded_passes == parallel_passes.size());
+
+    // Consecutive serial passes share a command list, every parallel pass gets its own
+    REQUIRE(records[0].command_buffer == records[1].command_buffer);
+    REQUIRE(records[2].command_buffer != records[1].command_buffer);
+    REQUIRE(records[3].command_buffer != records[2].command_buffer);
+    REQUIRE(records[4].command_buffer != records[3].command_buffer);
+    REQUIRE(records[4].command_buffer != records[0].command_buffer);
+
+    // Serial lists are recorded first and in order, before the parallel ones
+    REQUIRE(records[1].record_order < records[4].record_order);
+    REQUIRE(records[4].record_order < records[2].record_order);
+    REQUIRE(records[4].record_order < records[3].record_order);
+
+    for (const ChainPassRecord& record : records)
+    {
+        REQUIRE(record.command_buffer->get_num_submissions() == 1);
+    }
+
+    require_chain_submitted_in_order(*chain_buffer, parallel_passes.size());
+}
+
+TEST_CASE("RenderGraph records all the passes of a batch together without a JobSystem", "[Render]")
+{
+    NullRenderGraphContext context;
+
+    const std::array parallel_passes = {false, true, true, false};
+    std::array<ChainPassRecord, parallel_passes.size()> records{};
+    std::atomic<uint32_t> num_recorded_passes = 0;
+
+    RenderGraphBuilder builder(RenderGraphBuilderConfig{.async_compute_enabled = false});
+    RenderGraph graph;
+
+    const std::shared_ptr<BufferResource> chain_buffer =
+        add_chain_passes(builder, parallel_passes, records, num_recorded_passes);
+
+    context.compile(builder, graph);
+    graph.execute();
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        REQUIRE(records[i].command_buffer == records[0].command_buffer);
+        REQUIRE(records[i].record_order == i);
+    }
+
+    REQUIRE(records[0].command_buffer->get_num_submissions() == 1);
+
+    require_chain_submitted_in_order(*chain_buffer, parallel_passes.size());
+}
+
+TEST_CASE("Null command buffers execute buffer copies and fills on submit", "[Render]")
+{
+    NullRenderGraphContext context;
+
+    BufferDescription desc = create_staging_buffer_desc(16, "Staging");
+    desc.usage |= BufferUsageBits::TransferDst | BufferUsageBits::UnorderedAccess;
+
+    const std::shared_ptr<BufferResource> source = g_render_device->create_buffer(desc);
+    const std::shared_ptr<BufferResource> dest = g_render_device->create_buffer(desc);
+
+    const std::array<uint32_t, 4> data = {1, 2, 3, 4};
+    source->set_data(reinterpret_cast<const uint8_t*>(data.data()));
+
+    const std::array<uint32_t, 4> initial_data = {9, 9, 9, 9};
+    dest->set_data(reinterpret_cast<const uint8_t*>(initial_data.data()));
+
+    const std::shared_ptr<CommandBuffer> command = g_render_device->create_command_buffer(CommandBufferType::Transfer);
+    command->begin();
+    {
+        command->fill_buffer(*dest, 0);
+        command->copy_buffer_to_buffer(*source, *dest, {.size = 8, .src_offset = 8, .dst_offset = 0});
+    }
+    command->end();
+
+    const auto& null_command = static_cast<const Null::NullCommandBuffer&>(*command);
+    REQUIRE(null_command.get_commands().size() == 2);
+    REQUIRE(std::holds_alternative<Null::NullFillBufferCmd>(null_command.get_commands()[0]));
+    REQUIRE(std::holds_alternative<Null::NullCopyBufferToBufferCmd>(null_command.get_commands()[1]));
+
+    // Nothing is executed until the command buffer is submitted
+    const uint32_t* dest_data = reinterpret_cast<const uint32_t*>(dest->get_mapped_data());
+    REQUIRE(dest_data[0] == 9);
+
+    const std::shared_ptr<Fence> fence = g_render_device->create_fence(false);
+    command->submit({.signal_fence = fence});
+    fence->wait_for();
+
+    REQUIRE(dest_data[0] == 3);
+    REQUIRE(dest_data[1] == 4);
+    REQUIRE(dest_data[2] == 0);
+    REQUIRE(dest_data[3] == 0);
+    REQUIRE(null_command.get_num_submissions() == 1);
+}
+
+#endif
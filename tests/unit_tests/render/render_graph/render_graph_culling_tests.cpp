@@ -0,0 +1,179 @@
+#include <catch2/catch_all.hpp>
+
+#include "render/render_graph/render_graph_builder.h"
+
+using namespace Mizu;
+
+struct EmptyPassData
+{
+};
+
+static void add_test_pass(
+    RenderGraphBuilder& builder,
+    std::string_view name,
+    std::initializer_list<RenderGraphResource> reads,
+    std::initializer_list<RenderGraphResource> writes,
+    bool has_side_effects = false)
+{
+    builder.add_pass<EmptyPassData>(
+        name,
+        [&](RenderGraphPassBuilder& pass, EmptyPassData&) {
+            pass.set_hint(RenderGraphPassHint::Compute);
+            pass.set_has_side_effects(has_side_effects);
+
+            for (RenderGraphResource resource : reads)
+                pass.read(resource);
+
+            for (RenderGraphResource resource : writes)
+                pass.write(resource);
+        },
+        [](CommandBuffer&, const EmptyPassData&, const RenderGraphPassResources&) {});
+}
+
+static RenderGraphResource register_test_external_buffer(RenderGraphBuilder& builder)
+{
+    return builder.register_external_buffer(
+        nullptr,
+        {.initial_state = BufferResourceState::ShaderReadOnly, .final_state = BufferResourceState::ShaderReadOnly});
+}
+
+TEST_CASE("RenderGraphBuilder keeps the passes that contribute to an external resource", "[Render]")
+{
+    RenderGraphBuilder builder;
+
+    const RenderGraphResource buffer_a = builder.create_structured_buffer(64, 4, "BufferA");
+    const RenderGraphResource buffer_b = builder.create_structured_buffer(64, 4, "BufferB");
+    const RenderGraphResource output = register_test_external_buffer(builder);
+
+    add_test_pass(builder, "A", {}, {buffer_a});
+    add_test_pass(builder, "B", {buffer_a}, {buffer_b});
+    add_test_pass(builder, "C", {buffer_b}, {output});
+
+    builder.cull_passes();
+
+    REQUIRE_FALSE(builder.is_pass_culled("A"));
+    REQUIRE_FALSE(builder.is_pass_culled("B"));
+    REQUIRE_FALSE(builder.is_pass_culled("C"));
+
+    REQUIRE_FALSE(builder.is_resource_culled(buffer_a));
+    REQUIRE_FALSE(builder.is_resource_culled(buffer_b));
+}
+
+TEST_CASE("RenderGraphBuilder culls the chain of passes that don't reach a sink", "[Render]")
+{
+    RenderGraphBuilder builder;
+
+    const RenderGraphResource buffer_a = builder.create_structured_buffer(64, 4, "BufferA");
+    const RenderGraphResource buffer_b = builder.create_structured_buffer(64, 4, "BufferB");
+    const RenderGraphResource buffer_c = builder.create_structured_buffer(64, 4, "BufferC");
+    const RenderGraphResource output = register_test_external_buffer(builder);
+
+    add_test_pass(builder, "Live", {}, {output});
+    add_test_pass(builder, "A", {}, {buffer_a});
+    add_test_pass(builder, "B", {buffer_a}, {buffer_b});
+    add_test_pass(builder, "C", {buffer_b}, {buffer_c});
+
+    builder.cull_passes();
+
+    REQUIRE_FALSE(builder.is_pass_culled("Live"));
+    REQUIRE(builder.is_pass_culled("A"));
+    REQUIRE(builder.is_pass_culled("B"));
+    REQUIRE(builder.is_pass_culled("C"));
+
+    REQUIRE(builder.is_resource_culled(buffer_a));
+    REQUIRE(builder.is_resource_culled(buffer_b));
+    REQUIRE(builder.is_resource_culled(buffer_c));
+}
+
+TEST_CASE("RenderGraphBuilder only culls the unused branch of a shared producer", "[Render]")
+{
+    RenderGraphBuilder builder;
+
+    const RenderGraphResource shared = builder.create_structured_buffer(64, 4, "Shared");
+    const RenderGraphResource unused = builder.create_structured_buffer(64, 4, "Unused");
+    const RenderGraphResource output = register_test_external_buffer(builder);
+
+    add_test_pass(builder, "Producer", {}, {shared});
+    add_test_pass(builder, "UsedConsumer", {shared}, {output});
+    add_test_pass(builder, "UnusedConsumer", {shared}, {unused});
+
+    builder.cull_passes();
+
+    REQUIRE_FALSE(builder.is_pass_culled("Producer"));
+    REQUIRE_FALSE(builder.is_pass_culled("UsedConsumer"));
+    REQUIRE(builder.is_pass_culled("UnusedConsumer"));
+
+    REQUIRE_FALSE(builder.is_resource_culled(shared));
+    REQUIRE(builder.is_resource_culled(unused));
+}
+
+TEST_CASE("RenderGraphBuilder culls passes that only read external resources", "[Render]")
+{
+    RenderGraphBuilder builder;
+
+    const RenderGraphResource input = register_test_external_buffer(builder);
+    const RenderGraphResource output = register_test_external_buffer(builder);
+
+    add_test_pass(builder, "Writer", {}, {output});
+    add_test_pass(builder, "Reader", {input}, {});
+
+    builder.cull_passes();
+
+    REQUIRE_FALSE(builder.is_pass_culled("Writer"));
+    REQUIRE(builder.is_pass_culled("Reader"));
+    REQUIRE(builder.is_resource_culled(input));
+}
+
+TEST_CASE("RenderGraphBuilder never culls passes with side effects nor their inputs", "[Render]")
+{
+    RenderGraphBuilder builder;
+
+    const RenderGraphResource buffer_a = builder.create_structured_buffer(64, 4, "BufferA");
+    const RenderGraphResource buffer_b = builder.create_structured_buffer(64, 4, "BufferB");
+
+    add_test_pass(builder, "A", {}, {buffer_a});
+    add_test_pass(builder, "SideEffects", {buffer_a}, {buffer_b}, true);
+
+    builder.cull_passes();
+
+    REQUIRE_FALSE(builder.is_pass_culled("A"));
+    REQUIRE_FALSE(builder.is_pass_culled("SideEffects"));
+    REQUIRE_FALSE(builder.is_resource_culled(buffer_a));
+    REQUIRE_FALSE(builder.is_resource_culled(buffer_b));
+}
+
+TEST_CASE("RenderGraphBuilder keeps all passes when culling is disabled", "[Render]")
+{
+    RenderGraphBuilder builder(RenderGraphBuilderConfig{.cull_unused_passes = false});
+
+    const RenderGraphResource buffer_a = builder.create_structured_buffer(64, 4, "BufferA");
+    const RenderGraphResource buffer_b = builder.create_structured_buffer(64, 4, "BufferB");
+
+    add_test_pass(builder, "A", {}, {buffer_a});
+    add_test_pass(builder, "B", {buffer_a}, {buffer_b});
+
+    builder.cull_passes();
+
+    REQUIRE_FALSE(builder.is_pass_culled("A"));
+    REQUIRE_FALSE(builder.is_pass_culled("B"));
+    REQUIRE_FALSE(builder.is_resource_culled(buffer_a));
+}
+
+TEST_CASE("RenderGraphBuilder reset clears the culling state", "[Render]")
+{
+    RenderGraphBuilder builder;
+
+    const RenderGraphResource unused = builder.create_structured_buffer(64, 4, "Unused");
+    add_test_pass(builder, "A", {}, {unused});
+
+    builder.cull_passes();
+    REQUIRE(builder.is_pass_culled("A"));
+
+    builder.reset();
+
+    const RenderGraphResource output = register_test_external_buffer(builder);
+    add_test_pass(builder, "A", {}, {output});
+
+    builder.cull_passes();
+    REQUIRE_FALSE(builder.is_pass_culled("A"));
+}
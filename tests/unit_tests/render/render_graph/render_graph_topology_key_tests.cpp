@@ -0,0 +1,128 @@
+#include <catch2/catch_all.hpp>
+
+#include "render/render_graph/render_graph_builder.h"
+
+using namespace Mizu;
+
+struct TopologyKeyPassData
+{
+    RenderGraphResource input;
+    RenderGraphResource output;
+};
+
+struct TopologyKeyGraphDesc
+{
+    uint64_t buffer_size = 256;
+    bool extra_pass = false;
+    bool second_pass_writes = false;
+};
+
+static void build_topology_key_graph(RenderGraphBuilder& builder, const TopologyKeyGraphDesc& desc)
+{
+    builder.reset();
+
+    const RenderGraphResource a = builder.create_structured_buffer(desc.buffer_size, 16, "A");
+    const RenderGraphResource b = builder.create_structured_buffer(desc.buffer_size, 16, "B");
+
+    builder.add_pass<TopologyKeyPassData>(
+        "First",
+        [&](RenderGraphPassBuilder& pass, TopologyKeyPassData& data) {
+            pass.set_hint(RenderGraphPassHint::Compute);
+            data.output = pass.write(a);
+        },
+        [](CommandBuffer&, const TopologyKeyPassData&, const RenderGraphPassResources&) {});
+
+    builder.add_pass<TopologyKeyPassData>(
+        "Second",
+        [&](RenderGraphPassBuilder& pass, TopologyKeyPassData& data) {
+            pass.set_hint(RenderGraphPassHint::Compute);
+            data.input = pass.read(a);
+            data.output = desc.second_pass_writes ? pass.write(b) : pass.read(b);
+        },
+        [](CommandBuffer&, const TopologyKeyPassData&, const RenderGraphPassResources&) {});
+
+    if (desc.extra_pass)
+    {
+        builder.add_pass<TopologyKeyPassData>(
+            "Extra",
+            [&](RenderGraphPassBuilder& pass, TopologyKeyPassData& data) {
+                pass.set_hint(RenderGraphPassHint::Compute);
+                data.input = pass.read(b);
+            },
+            [](CommandBuffer&, const TopologyKeyPassData&, const RenderGraphPassResources&) {});
+    }
+}
+
+static RenderGraphTopologyKey get_topology_key(RenderGraphBuilder& builder, const TopologyKeyGraphDesc& desc)
+{
+    build_topology_key_graph(builder, desc);
+
+    RenderGraphTopologyKey key;
+    builder.build_topology_key(key);
+
+    return key;
+}
+
+TEST_CASE("RenderGraphTopologyKey is equal for the same graph", "[Render]")
+{
+    RenderGraphBuilder builder;
+
+    const RenderGraphTopologyKey first = get_topology_key(builder, {});
+    const RenderGraphTopologyKey second = get_topology_key(builder, {});
+
+    REQUIRE(!first.words.empty());
+    REQUIRE(first.hash == second.hash);
+    REQUIRE(first == second);
+}
+
+TEST_CASE("RenderGraphTopologyKey changes with the topology", "[Render]")
+{
+    RenderGraphBuilder builder;
+
+    const RenderGraphTopologyKey base = get_topology_key(builder, {});
+
+    SECTION("Extra pass")
+    {
+        REQUIRE_FALSE(base == get_topology_key(builder, {.extra_pass = true}));
+    }
+
+    SECTION("Different access")
+    {
+        REQUIRE_FALSE(base == get_topology_key(builder, {.second_pass_writes = true}));
+    }
+
+    SECTION("Different resource description")
+    {
+        REQUIRE_FALSE(base == get_topology_key(builder, {.buffer_size = 512}));
+    }
+}
+
+TEST_CASE("RenderGraphTopologyKey changes with the builder config", "[Render]")
+{
+    RenderGraphBuilder async_builder(RenderGraphBuilderConfig{.async_compute_enabled = true});
+    RenderGraphBuilder sync_builder(RenderGraphBuilderConfig{.async_compute_enabled = false});
+
+    REQUIRE_FALSE(get_topology_key(async_builder, {}) == get_topology_key(sync_builder, {}));
+}
+
+TEST_CASE("RenderGraphTopologyKey compares the words on a hash collision", "[Render]")
+{
+    RenderGraphTopologyKey first;
+    first.append(1);
+    first.append(2);
+
+    RenderGraphTopologyKey second;
+    second.append(3);
+    second.append(4);
+
+    // Force a collision, only the words can tell them apart
+    second.hash = first.hash;
+
+    REQUIRE_FALSE(first == second);
+
+    second.clear();
+    second.append(1);
+    second.append(2);
+
+    REQUIRE(first == second);
+}
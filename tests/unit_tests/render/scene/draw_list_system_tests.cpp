@@ -0,0 +1,580 @@
+#include <catch2/catch_all.hpp>
+
+#if MIZU_RENDER_CORE_NULL_ENABLED
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "base/math/aabb.h"
+#include "core/job_system/job_system.h"
+#include "core/runtime.h"
+#include "render/core/bounding_volume_hierarchy.h"
+#include "render/render_graph/render_graph_builder.h"
+#include "render/runtime/renderer.h"
+#include "render/runtime/renderer_settings.h"
+#include "render/scene/draw_list_raster_pass.h"
+#include "render/scene/draw_list_scene.h"
+#include "render/scene/draw_list_system.h"
+#include "render/systems/frame_linear_allocator.h"
+#include "render_core/rhi/buffer_resource.h"
+#include "render_core/rhi/device.h"
+
+#include "culling_test_utils.h"
+
+using namespace Mizu;
+
+// Keeps the drawables like SceneSystem does: swap removed when destroyed, found by their renderable id and marked
+// dirty when they are created, destroyed or moved
+class TestDrawListScene : public IDrawListScene
+{
+  public:
+    std::span<const SceneDrawableInfo> get_drawables() const override { return m_drawables; }
+    const BoundingVolumeHierarchy& get_drawable_bvh() const override { return m_bvh; }
+
+    AABB get_drawable_world_bounds(size_t drawable_idx) const override
+    {
+        return m_bvh.get_bounds(m_bvh_leaves[drawable_idx]);
+    }
+
+    // Only read by the compile passes of gpu driven rendering
+    std::shared_ptr<BufferResource> get_transform_info_buffer() const override { return nullptr; }
+
+    uint32_t get_drawable_index(uint32_t renderable_id) const override
+    {
+        if (renderable_id >= m_renderable_drawable_indices.size())
+            return INVALID_DRAWABLE_INDEX;
+
+        return m_renderable_drawable_indices[renderable_id];
+    }
+
+    std::span<const uint32_t> get_dirty_renderables() const override { return m_dirty_renderables; }
+
+    bool is_renderable_dirty(uint32_t renderable_id) const override
+    {
+        return renderable_id < m_renderable_dirty_flags.size() && m_renderable_dirty_flags[renderable_id];
+    }
+
+    void clear_dirty_renderables() override
+    {
+        for (const uint32_t renderable_id : m_dirty_renderables)
+            m_renderable_dirty_flags[renderable_id] = false;
+
+        m_dirty_renderables.clear();
+    }
+
+    // The renderable id doubles as the transform slot. Drawables only share a material if they share the material
+    // buffer offset.
+    void create_drawable(uint32_t renderable_id, const AABB& bounds, uint64_t mesh_id, uint32_t material_buffer_offset)
+    {
+        REQUIRE(get_drawable_index(renderable_id) == INVALID_DRAWABLE_INDEX);
+
+        const uint32_t index = static_cast<uint32_t>(m_drawables.size());
+
+        SceneDrawableInfo info{};
+        info.static_mesh_handle = StaticMeshHandle(renderable_id, 0);
+        info.mesh_handle = MeshAssetHandle(mesh_id);
+        info.material_handle = MaterialAssetHandle(material_buffer_offset);
+        info.gpu_mesh_record.allocation.handle = info.mesh_handle;
+        info.gpu_mesh_draw = GpuMeshDrawPayload{.index_count = 36, .first_index = static_cast<uint32_t>(mesh_id * 36)};
+        info.material_buffer_offset = material_buffer_offset;
+        info.transform_slot_index = renderable_id;
+
+        m_drawables.push_back(info);
+        m_bvh_leaves.push_back(m_bvh.insert(bounds, index));
+
+        if (renderable_id >= m_renderable_drawable_indices.size())
+            m_renderable_drawable_indices.resize(renderable_id + 1, INVALID_DRAWABLE_INDEX);
+        m_renderable_drawable_indices[renderable_id] = index;
+
+        mark_renderable_dirty(renderable_id);
+    }
+
+    void destroy_drawable(uint32_t renderable_id)
+    {
+        const uint32_t index = get_drawable_index(renderable_id);
+        REQUIRE(index != INVALID_DRAWABLE_INDEX);
+
+        m_bvh.remove(m_bvh_leaves[index]);
+        m_renderable_drawable_indices[renderable_id] = INVALID_DRAWABLE_INDEX;
+        mark_renderable_dirty(renderable_id);
+
+        const uint32_t last_index = static_cast<uint32_t>(m_drawables.size() - 1);
+        if (index != last_index)
+        {
+            m_drawables[index] = m_drawables[last_index];
+            m_bvh_leaves[index] = m_bvh_leaves[last_index];
+            m_bvh.set_user_data(m_bvh_leaves[index], index);
+
+            // Only the index changes, the renderable stays clean
+            m_renderable_drawable_indices[m_drawables[index].static_mesh_handle.get_internal_id()] = index;
+        }
+
+        m_drawables.pop_back();
+        m_bvh_leaves.pop_back();
+    }
+
+    void move_drawable(uint32_t renderable_id, const AABB& bounds)
+    {
+        const uint32_t index = get_drawable_index(renderable_id);
+        REQUIRE(index != INVALID_DRAWABLE_INDEX);
+
+        m_bvh.update(m_bvh_leaves[index], bounds);
+        mark_renderable_dirty(renderable_id);
+    }
+
+  private:
+    std::vector<SceneDrawableInfo> m_drawables;
+    BoundingVolumeHierarchy m_bvh;
+    std::vector<uint32_t> m_bvh_leaves;
+
+    std::vector<uint32_t> m_renderable_drawable_indices;
+    std::vector<uint32_t> m_dirty_renderables;
+    std::vector<bool> m_renderable_dirty_flags;
+
+    void mark_renderable_dirty(uint32_t renderable_id)
+    {
+        if (renderable_id >= m_renderable_dirty_flags.size())
+            m_renderable_dirty_flags.resize(renderable_id + 1, false);
+
+        if (m_renderable_dirty_flags[renderable_id])
+            return;
+
+        m_renderable_dirty_flags[renderable_id] = true;
+        m_dirty_renderables.push_back(renderable_id);
+    }
+};
+
+// Compiles the draw lists on the cpu with the null backend and the job system the compile jobs run on
+struct NullDrawListSystemScope
+{
+    JobSystem job_system;
+    bool gpu_driven_rendering_enabled = false;
+
+    NullDrawListSystemScope()
+    {
+        g_render_device = Device::create(DeviceCreationDescription{
+            .api = GraphicsApi::Null,
+            .specific_config = NullSpecificConfiguration{},
+        });
+
+        REQUIRE(job_system.init(2, false));
+        g_job_system = &job_system;
+
+        RendererSettings& settings = get_setting<RendererSettings>();
+        gpu_driven_rendering_enabled = settings.gpu_driven_rendering_enabled;
+        settings.gpu_driven_rendering_enabled = false;
+    }
+
+    ~NullDrawListSystemScope()
+    {
+        get_setting<RendererSettings>().gpu_driven_rendering_enabled = gpu_driven_rendering_enabled;
+
+        g_job_system = nullptr;
+        job_system.wait_workers_dead();
+
+        delete g_render_device;
+        g_render_device = nullptr;
+        Device::free();
+    }
+};
+
+struct EmptyPassData
+{
+};
+
+// Draw lists are created from the setup of the pass that dispatches them
+static DrawListHandle create_test_draw_list(
+    DrawListSystem& system,
+    DrawListRasterPass& raster_pass,
+    const std::optional<Frustum>& frustum,
+    DrawListSortMode sort_mode = DrawListSortMode::State)
+{
+    RenderGraphBuilder builder;
+    DrawListHandle handle{};
+
+    builder.add_pass<EmptyPassData>(
+        "DrawListPass",
+        [&](RenderGraphPassBuilder& pass, EmptyPassData&) {
+            handle = system.create_draw_list(DrawListRequest{
+                .raster_pass = &raster_pass,
+                .pass_builder = pass,
+                .frustum = frustum,
+                .sort_mode = sort_mode,
+            });
+        },
+        [](CommandBuffer&, const EmptyPassData&, const RenderGraphPassResources&) {});
+
+    return handle;
+}
+
+static AABB make_unit_box(glm::vec3 center)
+{
+    return AABB(center - glm::vec3(0.5f), center + glm::vec3(0.5f));
+}
+
+// A row of boxes along the x axis, wider than the frustum of `make_row_frustum`
+static void create_drawable_row(TestDrawListScene& scene, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float x = (static_cast<float>(i) - static_cast<float>(count) * 0.5f) * 2.0f;
+        scene.create_drawable(i, make_unit_box(glm::vec3(x, 0.0f, 0.0f)), i % 4, i);
+    }
+}
+
+static const glm::vec3 ROW_CAMERA_POSITION = glm::vec3(0.0f, 0.0f, 20.0f);
+
+static Frustum make_row_frustum()
+{
+    return make_test_frustum(ROW_CAMERA_POSITION, glm::vec3(0.0f), 60.0f, 100.0f);
+}
+
+static std::vector<uint32_t> get_visible_renderables(const TestDrawListScene& scene, const Frustum& frustum)
+{
+    std::vector<uint32_t> renderables;
+
+    const std::span<const SceneDrawableInfo> drawables = scene.get_drawables();
+    for (size_t i = 0; i < drawables.size(); ++i)
+    {
+        if (frustum.is_inside_frustum(scene.get_drawable_world_bounds(i)))
+            renderables.push_back(static_cast<uint32_t>(drawables[i].static_mesh_handle.get_internal_id()));
+    }
+
+    std::ranges::sort(renderables);
+    return renderables;
+}
+
+static std::vector<uint32_t> sorted(std::span<const uint32_t> values)
+{
+    std::vector<uint32_t> result(values.begin(), values.end());
+    std::ranges::sort(result);
+    return result;
+}
+
+TEST_CASE("DrawListSystem compiles the drawables inside the frustum", "[Render]")
+{
+    NullDrawListSystemScope scope;
+
+    TestDrawListScene scene;
+    create_drawable_row(scene, 64);
+
+    DrawListSystem system(scene, nullptr, nullptr);
+    MaterialShaderRasterPass raster_pass;
+
+    const Frustum frustum = make_row_frustum();
+
+    system.reset();
+    const DrawListHandle handle = create_test_draw_list(system, raster_pass, frustum);
+    REQUIRE(handle.is_valid());
+
+    system.compile_draw_lists();
+
+    const std::vector<uint32_t> expected = get_visible_renderables(scene, frustum);
+    REQUIRE(!expected.empty());
+    REQUIRE(expected.size() < scene.get_drawables().size());
+
+    REQUIRE(sorted(system.get_draw_list_renderables(handle)) == expected);
+
+    // Every drawable has its own material, so nothing is instanced
+    REQUIRE(system.get_compile_stats().size() == 1);
+    const DrawListCompileStats& stats = system.get_compile_stats()[0];
+    REQUIRE(stats.rebuild_reason == DrawListRebuildReason::NewList);
+    REQUIRE(stats.num_dirty_drawables == 0);
+    REQUIRE(stats.num_visible_drawables == expected.size());
+    REQUIRE(stats.num_draw_elements == expected.size());
+
+    REQUIRE(scene.get_dirty_renderables().empty());
+}
+
+TEST_CASE("DrawListSystem instances drawables with the same mesh and material", "[Render]")
+{
+    NullDrawListSystemScope scope;
+
+    TestDrawListScene scene;
+    for (uint32_t i = 0; i < 6; ++i)
+        scene.create_drawable(i, make_unit_box(glm::vec3(static_cast<float>(i), 0.0f, 0.0f)), i < 4 ? 1 : 2, 0);
+
+    DrawListSystem system(scene, nullptr, nullptr);
+    MaterialShaderRasterPass raster_pass;
+
+    system.reset();
+    const DrawListHandle handle = create_test_draw_list(system, raster_pass, std::nullopt);
+    system.compile_draw_lists();
+
+    REQUIRE(system.get_draw_list_renderables(handle).size() == 6);
+
+    const DrawListCompileStats& stats = system.get_compile_stats()[0];
+    REQUIRE(stats.num_visible_drawables == 6);
+    REQUIRE(stats.num_draw_elements == 2);
+}
+
+TEST_CASE("DrawListSystem shares compile lists between draw lists of the same view", "[Render]")
+{
+    NullDrawListSystemScope scope;
+
+    TestDrawListScene scene;
+    create_drawable_row(scene, 16);
+
+    DrawListSystem system(scene, nullptr, nullptr);
+    MaterialShaderRasterPass first_raster_pass;
+    MaterialShaderRasterPass second_raster_pass;
+
+    const Frustum frustum = make_row_frustum();
+
+    system.reset();
+
+    const DrawListHandle first = create_test_draw_list(system, first_raster_pass, frustum);
+    const DrawListHandle same = create_test_draw_list(system, first_raster_pass, frustum);
+    const DrawListHandle second = create_test_draw_list(system, second_raster_pass, frustum);
+    const DrawListHandle unculled = create_test_draw_list(system, first_raster_pass, std::nullopt);
+
+    REQUIRE(first.index == same.index);
+    REQUIRE(first.index != second.index);
+    REQUIRE(first.index != unculled.index);
+
+    system.compile_draw_lists();
+
+    REQUIRE(system.get_compile_stats().size() == 2);
+
+    const std::span<const uint32_t> first_renderables = system.get_draw_list_renderables(first);
+    const std::span<const uint32_t> second_renderables = system.get_draw_list_renderables(second);
+    REQUIRE(std::ranges::equal(first_renderables, second_renderables));
+
+    REQUIRE(system.get_draw_list_renderables(unculled).size() == 16);
+}
+
+TEST_CASE("DrawListSystem uploads the draw data in draw order", "[Render]")
+{
+    NullDrawListSystemScope scope;
+
+    TestDrawListScene scene;
+    create_drawable_row(scene, 32);
+
+    DrawListSystem system(scene, nullptr, nullptr);
+    MaterialShaderRasterPass raster_pass;
+
+    FrameLinearAllocator allocator(1, 4096);
+    allocator.prepare_frame(0);
+
+    system.reset();
+    const DrawListHandle handle =
+        create_test_draw_list(system, raster_pass, make_row_frustum(), DrawListSortMode::FrontToBack);
+    system.compile_draw_lists();
+    system.build_frame_resources(allocator);
+
+    const std::span<const uint32_t> renderables = system.get_draw_list_renderables(handle);
+    REQUIRE(!renderables.empty());
+
+    // The draw data is the first allocation of the frame, one {transform slot, material offset} pair per draw
+    std::vector<uint32_t> draw_data(renderables.size() * 2);
+    std::memcpy(draw_data.data(), allocator.get_buffer()->get_mapped_data(), draw_data.size() * sizeof(uint32_t));
+
+    for (size_t i = 0; i < renderables.size(); ++i)
+    {
+        const uint32_t drawable_idx = scene.get_drawable_index(renderables[i]);
+        const SceneDrawableInfo& drawable = scene.get_drawables()[drawable_idx];
+
+        REQUIRE(draw_data[i * 2 + 0] == drawable.transform_slot_index);
+        REQUIRE(draw_data[i * 2 + 1] == drawable.material_buffer_offset);
+    }
+
+    // Front to back, depths are quantized to the 7 highest mantissa bits, so close enough draws can swap
+    float previous_distance = 0.0f;
+    for (const uint32_t renderable_id : renderables)
+    {
+        const AABB bounds = scene.get_drawable_world_bounds(scene.get_drawable_index(renderable_id));
+        const float distance = glm::distance((bounds.min() + bounds.max()) * 0.5f, ROW_CAMERA_POSITION);
+
+        REQUIRE(distance >= previous_distance * (1.0f - 1.0f / 64.0f));
+        previous_distance = distance;
+    }
+}
+
+// Requests a single draw list for a new frame and compiles it
+static DrawListHandle compile_test_frame(
+    DrawListSystem& system,
+    DrawListRasterPass& raster_pass,
+    const std::optional<Frustum>& frustum,
+    DrawListSortMode sort_mode = DrawListSortMode::State)
+{
+    system.reset();
+    const DrawListHandle handle = create_test_draw_list(system, raster_pass, frustum, sort_mode);
+    system.compile_draw_lists();
+
+    return handle;
+}
+
+TEST_CASE("DrawListSystem reports why a compile list was rebuilt", "[Render]")
+{
+    NullDrawListSystemScope scope;
+
+    TestDrawListScene scene;
+    create_drawable_row(scene, 64);
+
+    DrawListSystem system(scene, nullptr, nullptr);
+    MaterialShaderRasterPass raster_pass;
+
+    const Frustum frustum = make_row_frustum();
+    const Frustum moved_frustum =
+        make_test_frustum(glm::vec3(10.0f, 0.0f, 20.0f), glm::vec3(10.0f, 0.0f, 0.0f), 60.0f, 100.0f);
+
+    const auto compile_frame = [&](const Frustum& frame_frustum) -> const DrawListCompileStats& {
+        const DrawListHandle handle = compile_test_frame(system, raster_pass, frame_frustum);
+        REQUIRE(sorted(system.get_draw_list_renderables(handle)) == get_visible_renderables(scene, frame_frustum));
+
+        REQUIRE(system.get_compile_stats().size() == 1);
+        return system.get_compile_stats()[0];
+    };
+
+    REQUIRE(compile_frame(frustum).rebuild_reason == DrawListRebuildReason::NewList);
+
+    // Nothing changed, the previous result is reused as is
+    const DrawListCompileStats& unchanged_stats = compile_frame(frustum);
+    REQUIRE(unchanged_stats.rebuild_reason == DrawListRebuildReason::None);
+    REQUIRE(unchanged_stats.num_dirty_drawables == 0);
+
+    // Out of the frustum and back in
+    scene.move_drawable(32, make_unit_box(glm::vec3(0.0f, 50.0f, 0.0f)));
+    scene.move_drawable(0, make_unit_box(glm::vec3(1.0f, 1.0f, 0.0f)));
+
+    const DrawListCompileStats& dirty_stats = compile_frame(frustum);
+    REQUIRE(dirty_stats.rebuild_reason == DrawListRebuildReason::None);
+    REQUIRE(dirty_stats.num_dirty_drawables == 2);
+
+    REQUIRE(compile_frame(moved_frustum).rebuild_reason == DrawListRebuildReason::FrustumChanged);
+
+    for (uint32_t i = 0; i < 20; ++i)
+        scene.move_drawable(i, make_unit_box(glm::vec3(static_cast<float>(i) * 0.5f, 2.0f, 0.0f)));
+
+    const DrawListCompileStats& too_dirty_stats = compile_frame(moved_frustum);
+    REQUIRE(too_dirty_stats.rebuild_reason == DrawListRebuildReason::TooManyDirtyDrawables);
+    REQUIRE(too_dirty_stats.num_dirty_drawables == 0);
+
+    // A frame without the view invalidates its cache
+    compile_test_frame(system, raster_pass, std::nullopt);
+    REQUIRE(compile_frame(moved_frustum).rebuild_reason == DrawListRebuildReason::NewList);
+}
+
+TEST_CASE("DrawListSystem views keep their compile list cache in any request order", "[Render]")
+{
+    NullDrawListSystemScope scope;
+
+    TestDrawListScene scene;
+    create_drawable_row(scene, 64);
+
+    DrawListSystem system(scene, nullptr, nullptr);
+    MaterialShaderRasterPass raster_pass;
+
+    // Same identity, only the frustum differs
+    const std::array<Frustum, 2> frustums = {
+        make_row_frustum(),
+        make_test_frustum(glm::vec3(-10.0f, 0.0f, 20.0f), glm::vec3(-10.0f, 0.0f, 0.0f), 60.0f, 100.0f),
+    };
+
+    const auto compile_frame = [&](std::span<const uint32_t> frustum_order) {
+        system.reset();
+        for (const uint32_t frustum_idx : frustum_order)
+            create_test_draw_list(system, raster_pass, frustums[frustum_idx]);
+        system.compile_draw_lists();
+
+        REQUIRE(system.get_compile_stats().size() == frustum_order.size());
+    };
+
+    const std::array<uint32_t, 2> first_order = {0, 1};
+    const std::array<uint32_t, 2> swapped_order = {1, 0};
+
+    compile_frame(first_order);
+    REQUIRE(system.get_compile_stats()[0].rebuild_reason == DrawListRebuildReason::NewList);
+    REQUIRE(system.get_compile_stats()[1].rebuild_reason == DrawListRebuildReason::NewList);
+
+    scene.move_drawable(10, make_unit_box(glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    compile_frame(swapped_order);
+    REQUIRE(system.get_compile_stats()[0].rebuild_reason == DrawListRebuildReason::None);
+    REQUIRE(system.get_compile_stats()[1].rebuild_reason == DrawListRebuildReason::None);
+    REQUIRE(system.get_compile_stats()[0].num_dirty_drawables == 1);
+}
+
+TEST_CASE("DrawListSystem incremental updates match a full rebuild", "[Render]")
+{
+    NullDrawListSystemScope scope;
+
+    const DrawListSortMode sort_mode = GENERATE(DrawListSortMode::State, DrawListSortMode::FrontToBack);
+    const bool use_frustum = GENERATE(true, false);
+
+    const std::optional<Frustum> frustum = use_frustum ? std::optional(make_row_frustum()) : std::nullopt;
+
+    TestDrawListScene scene;
+    create_drawable_row(scene, 128);
+
+    std::vector<uint32_t> alive_renderables(128);
+    std::iota(alive_renderables.begin(), alive_renderables.end(), 0u);
+    uint32_t next_renderable_id = 128;
+
+    DrawListSystem system(scene, nullptr, nullptr);
+    MaterialShaderRasterPass raster_pass;
+
+    compile_test_frame(system, raster_pass, frustum, sort_mode);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position_dist(-60.0f, 60.0f);
+    std::uniform_int_distribution<uint32_t> op_dist(0, 2);
+
+    const auto random_box = [&]() { return make_unit_box(glm::vec3(position_dist(rng), position_dist(rng), 0.0f)); };
+
+    for (uint32_t frame = 0; frame < 32; ++frame)
+    {
+        // Few enough changes to stay below the rebuild threshold
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            std::uniform_int_distribution<size_t> alive_dist(0, alive_renderables.size() - 1);
+            const size_t alive_idx = alive_dist(rng);
+
+            switch (op_dist(rng))
+            {
+            case 0:
+                // Materials stay unique, so the sort keys are unique and the order can be compared exactly
+                scene.create_drawable(next_renderable_id, random_box(), next_renderable_id % 4, next_renderable_id);
+                alive_renderables.push_back(next_renderable_id);
+                next_renderable_id += 1;
+                break;
+            case 1:
+                // Swap removes the drawable, the last drawable takes its index
+                scene.destroy_drawable(alive_renderables[alive_idx]);
+                alive_renderables[alive_idx] = alive_renderables.back();
+                alive_renderables.pop_back();
+                break;
+            case 2:
+                scene.move_drawable(alive_renderables[alive_idx], random_box());
+                break;
+            }
+        }
+
+        const uint32_t num_dirty = static_cast<uint32_t>(scene.get_dirty_renderables().size());
+
+        const DrawListHandle handle = compile_test_frame(system, raster_pass, frustum, sort_mode);
+
+        const DrawListCompileStats& stats = system.get_compile_stats()[0];
+        REQUIRE(stats.rebuild_reason == DrawListRebuildReason::None);
+        REQUIRE(stats.num_dirty_drawables == num_dirty);
+
+        // A new system has no cache, so it rebuilds the list from scratch
+        DrawListSystem rebuilt_system(scene, nullptr, nullptr);
+        const DrawListHandle rebuilt_handle = compile_test_frame(rebuilt_system, raster_pass, frustum, sort_mode);
+
+        const DrawListCompileStats& rebuilt_stats = rebuilt_system.get_compile_stats()[0];
+        REQUIRE(rebuilt_stats.rebuild_reason == DrawListRebuildReason::NewList);
+
+        REQUIRE(std::ranges::equal(
+            system.get_draw_list_renderables(handle), rebuilt_system.get_draw_list_renderables(rebuilt_handle)));
+        REQUIRE(stats.num_visible_drawables == rebuilt_stats.num_visible_drawables);
+        REQUIRE(stats.num_draw_elements == rebuilt_stats.num_draw_elements);
+    }
+}
+
+#endif
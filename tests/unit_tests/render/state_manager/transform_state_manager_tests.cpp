@@ -0,0 +1,71 @@
+#include <catch2/catch_all.hpp>
+
+#include <vector>
+
+#include "render/state_manager/transform_state_manager.h"
+
+using namespace Mizu;
+
+static std::vector<TransformDynamicState> make_test_transforms(size_t count, float offset)
+{
+    std::vector<TransformDynamicState> transforms(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float value = static_cast<float>(i) + offset;
+
+        transforms[i].translation = glm::vec3(value, -value, value * 2.0f);
+        transforms[i].rotation = glm::vec3(value * 0.1f, value * 0.2f, -value * 0.3f);
+        transforms[i].scale = glm::vec3(1.0f + value, 1.0f, 1.0f - value);
+    }
+
+    return transforms;
+}
+
+static void require_transform_equal(const TransformDynamicState& a, const TransformDynamicState& b)
+{
+    REQUIRE(a.translation.x == Catch::Approx(b.translation.x));
+    REQUIRE(a.translation.y == Catch::Approx(b.translation.y));
+    REQUIRE(a.translation.z == Catch::Approx(b.translation.z));
+    REQUIRE(a.rotation.x == Catch::Approx(b.rotation.x));
+    REQUIRE(a.rotation.y == Catch::Approx(b.rotation.y));
+    REQUIRE(a.rotation.z == Catch::Approx(b.rotation.z));
+    REQUIRE(a.scale.x == Catch::Approx(b.scale.x));
+    REQUIRE(a.scale.y == Catch::Approx(b.scale.y));
+    REQUIRE(a.scale.z == Catch::Approx(b.scale.z));
+}
+
+TEST_CASE("TransformDynamicState interpolate_batch matches interpolate", "[StateManager]")
+{
+    // 7 transforms are 63 floats, so the last values go through the scalar tail
+    constexpr size_t NumTransforms = 7;
+
+    const std::vector<TransformDynamicState> from = make_test_transforms(NumTransforms, 0.0f);
+    const std::vector<TransformDynamicState> to = make_test_transforms(NumTransforms, 5.0f);
+
+    for (const double alpha : {0.0, 0.25, 0.5, 1.0})
+    {
+        std::vector<TransformDynamicState> out(NumTransforms);
+        TransformDynamicState::interpolate_batch(from, to, alpha, out);
+
+        for (size_t i = 0; i < NumTransforms; ++i)
+        {
+            require_transform_equal(out[i], from[i].interpolate(to[i], alpha));
+        }
+    }
+}
+
+TEST_CASE("TransformDynamicState interpolate_batch can write into the target states", "[StateManager]")
+{
+    constexpr size_t NumTransforms = 5;
+
+    const std::vector<TransformDynamicState> from = make_test_transforms(NumTransforms, 0.0f);
+    const std::vector<TransformDynamicState> to = make_test_transforms(NumTransforms, 3.0f);
+
+    std::vector<TransformDynamicState> out = to;
+    TransformDynamicState::interpolate_batch(from, out, 0.5, out);
+
+    for (size_t i = 0; i < NumTransforms; ++i)
+    {
+        require_transform_equal(out[i], from[i].interpolate(to[i], 0.5));
+    }
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_all.hpp>
+
+#if MIZU_RENDER_CORE_NULL_ENABLED
+
+#include <array>
+#include <cstring>
+#include <numeric>
+
+#include "render/runtime/renderer.h"
+#include "render/systems/frame_linear_allocator.h"
+#include "render_core/rhi/buffer_resource.h"
+#include "render_core/rhi/device.h"
+
+using namespace Mizu;
+
+// Allocates from a null device buffer, so the offsets and uploads can be checked without a GPU
+struct NullFrameAllocatorScope
+{
+    NullFrameAllocatorScope()
+    {
+        g_render_device = Device::create(DeviceCreationDescription{
+            .api = GraphicsApi::Null,
+            .specific_config = NullSpecificConfiguration{},
+        });
+    }
+
+    ~NullFrameAllocatorScope()
+    {
+        delete g_render_device;
+        g_render_device = nullptr;
+        Device::free();
+    }
+};
+
+struct TestElement
+{
+    float x, y, z;
+};
+
+static constexpr uint64_t TEST_FRAME_SIZE = 4096;
+
+TEST_CASE("FrameLinearAllocator aligns allocations to the device requirements", "[Render]")
+{
+    NullFrameAllocatorScope scope;
+
+    const DeviceProperties& properties = g_render_device->get_properties();
+    const uint64_t constant_alignment = properties.min_constant_buffer_offset_alignment;
+    const uint64_t raw_alignment = properties.min_raw_buffer_offset_alignment;
+
+    FrameLinearAllocator allocator(2, TEST_FRAME_SIZE);
+    allocator.prepare_frame(0);
+
+    const FrameAllocation first_constant = allocator.allocate_constant<uint32_t>();
+    REQUIRE(first_constant.view.desc.offset == 0);
+    REQUIRE(first_constant.view.desc.size == sizeof(uint32_t));
+    REQUIRE(first_constant.frame_in_flight_idx == 0);
+
+    const FrameAllocation second_constant = allocator.allocate_constant<uint32_t>();
+    REQUIRE(second_constant.view.desc.offset == constant_alignment);
+
+    // Structured allocations start at a multiple of both the element size and the raw buffer alignment
+    const FrameAllocation structured = allocator.allocate_structured<TestElement>(3);
+    const uint64_t structured_alignment = std::lcm(sizeof(TestElement), raw_alignment);
+    REQUIRE(structured.view.desc.offset % structured_alignment == 0);
+    REQUIRE(structured.view.desc.offset >= second_constant.view.desc.offset + sizeof(uint32_t));
+    REQUIRE(structured.view.desc.offset < second_constant.view.desc.offset + sizeof(uint32_t) + structured_alignment);
+    REQUIRE(structured.view.desc.size == sizeof(TestElement) * 3);
+    REQUIRE(structured.view.desc.stride == sizeof(TestElement));
+
+    const FrameAllocation byte_address = allocator.allocate_byte_address(10);
+    REQUIRE(byte_address.view.desc.offset % raw_alignment == 0);
+    REQUIRE(byte_address.view.desc.offset >= structured.view.desc.offset + structured.view.desc.size);
+    REQUIRE(byte_address.view.desc.stride == 0);
+
+    REQUIRE(byte_address.view.buffer == allocator.get_buffer().get());
+}
+
+TEST_CASE("FrameLinearAllocator gives every frame in flight its own range", "[Render]")
+{
+    NullFrameAllocatorScope scope;
+
+    FrameLinearAllocator allocator(3, TEST_FRAME_SIZE);
+    REQUIRE(allocator.get_buffer()->get_size() == 3 * TEST_FRAME_SIZE);
+
+    for (uint32_t frame = 0; frame < 3; ++frame)
+    {
+        allocator.prepare_frame(frame);
+
+        const FrameAllocation first = allocator.allocate_byte_address(64);
+        const FrameAllocation second = allocator.allocate_byte_address(64);
+
+        REQUIRE(first.frame_in_flight_idx == frame);
+        REQUIRE(first.view.desc.offset == frame * TEST_FRAME_SIZE);
+        REQUIRE(second.view.desc.offset == frame * TEST_FRAME_SIZE + 64);
+    }
+
+    // Preparing a frame again starts from the beginning of its range
+    allocator.prepare_frame(1);
+    REQUIRE(allocator.allocate_byte_address(64).view.desc.offset == TEST_FRAME_SIZE);
+}
+
+TEST_CASE("FrameAllocation uploads its data at the offset of the allocation", "[Render]")
+{
+    NullFrameAllocatorScope scope;
+
+    FrameLinearAllocator allocator(2, TEST_FRAME_SIZE);
+    allocator.prepare_frame(1);
+
+    const std::array<TestElement, 2> elements = {TestElement{1.0f, 2.0f, 3.0f}, TestElement{4.0f, 5.0f, 6.0f}};
+    const FrameAllocation structured = allocator.allocate_structured<TestElement>(elements.size());
+    structured.upload(elements);
+
+    const uint32_t value = 42;
+    const FrameAllocation constant = allocator.allocate_constant<uint32_t>();
+    constant.upload(value);
+
+    const uint8_t* mapped_data = allocator.get_buffer()->get_mapped_data();
+
+    std::array<TestElement, 2> uploaded_elements{};
+    std::memcpy(uploaded_elements.data(), mapped_data + structured.view.desc.offset, sizeof(elements));
+    REQUIRE(uploaded_elements[0].x == 1.0f);
+    REQUIRE(uploaded_elements[1].z == 6.0f);
+
+    uint32_t uploaded_value = 0;
+    std::memcpy(&uploaded_value, mapped_data + constant.view.desc.offset, sizeof(uint32_t));
+    REQUIRE(uploaded_value == value);
+}
+
+#endif
@@ -0,0 +1,160 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "core/job_system/job_system.h"
+#include "state_manager/base_state_manager.h"
+#include "state_manager/base_state_manager.inl.cpp"
+
+using namespace Mizu;
+
+struct StressStaticState
+{
+    uint32_t index = 0;
+};
+
+struct StressDynamicState
+{
+    uint64_t value = 0;
+
+    bool has_changed(const StressDynamicState& other) const { return value != other.value; }
+};
+
+MIZU_STATE_MANAGER_CREATE_HANDLE(StressHandle);
+
+struct StressConfig
+{
+    static constexpr uint64_t MaxNumHandles = 8;
+    static constexpr bool Interpolate = false;
+
+    static constexpr std::string_view Identifier = "StressStateManager";
+};
+
+using StressStateManager = BaseStateManager<StressStaticState, StressDynamicState, StressHandle, StressConfig>;
+
+class StressRenderConsumer : public IStateManagerConsumer<StressStateManager>
+{
+  public:
+    uint64_t num_creates = 0;
+    uint64_t num_updates = 0;
+    uint64_t num_destroys = 0;
+
+    void rend_on_create(StressHandle, const StressStaticState&, const StressDynamicState&) override
+    {
+        num_creates += 1;
+    }
+
+    void rend_on_update(StressHandle, const StressDynamicState&) override { num_updates += 1; }
+    void rend_on_destroy(StressHandle) override { num_destroys += 1; }
+};
+
+struct StateManagerStressScope
+{
+    JobSystem job_system;
+    bool initialized = false;
+
+    ~StateManagerStressScope()
+    {
+        if (initialized)
+        {
+            job_system.wait_workers_dead();
+        }
+    }
+};
+
+TEST_CASE("BaseStateManager handles sim writes from all workers at the same time", "[StateManager][stress]")
+{
+    constexpr uint32_t NumHandles = 4096;
+    constexpr uint64_t NumTicks = 32;
+    // Every tick, one in RecreateStride handles is destroyed and created again
+    constexpr uint32_t RecreateStride = 16;
+    constexpr size_t GrainSize = 16;
+
+    StateManagerStressScope scope;
+    REQUIRE(scope.job_system.init(std::max(std::thread::hardware_concurrency(), 4u), false));
+    scope.initialized = true;
+
+    // Destroyed handles are only reclaimed once the render consumes the destroy
+    StressStateManager state_manager{NumHandles + NumHandles / RecreateStride};
+    StressRenderConsumer consumer;
+    state_manager.register_rend_consumer(&consumer);
+
+    std::vector<StressHandle> handles(NumHandles);
+    std::atomic<uint32_t> num_errors = 0;
+
+    const auto expected_value = [](uint64_t tick, size_t index) { return tick * NumHandles + index; };
+
+    const auto run_tick = [&](uint64_t tick, auto&& func) {
+        state_manager.sim_begin_tick(TickUpdateState{tick * 100});
+
+        const JobHandle handle = scope.job_system.parallel_for(JobRange{0, NumHandles}, GrainSize, func);
+        REQUIRE(scope.job_system.wait_for_blocking(handle));
+
+        state_manager.sim_end_tick();
+        state_manager.rend_apply_updates(FrameUpdateState{tick * 100});
+    };
+
+    run_tick(0, [&](size_t i) {
+        handles[i] = state_manager.sim_create(
+            StressStaticState{static_cast<uint32_t>(i)}, StressDynamicState{expected_value(0, i)});
+    });
+
+    REQUIRE(consumer.num_creates == NumHandles);
+
+    std::set<uint64_t> handle_ids;
+    for (const StressHandle& handle : handles)
+    {
+        handle_ids.insert(handle.get_internal_id());
+    }
+    REQUIRE(handle_ids.size() == NumHandles);
+
+    for (uint64_t tick = 1; tick <= NumTicks; ++tick)
+    {
+        run_tick(tick, [&, tick](size_t i) {
+            if (state_manager.sim_get_dynamic_state(handles[i]).value != expected_value(tick - 1, i))
+                num_errors.fetch_add(1, std::memory_order_relaxed);
+
+            const StressDynamicState ds{expected_value(tick, i)};
+
+            if ((i + tick) % RecreateStride == 0)
+            {
+                state_manager.sim_destroy(handles[i]);
+                handles[i] = state_manager.sim_create(StressStaticState{static_cast<uint32_t>(i)}, ds);
+            }
+            else if (i % 2 == 0)
+            {
+                state_manager.sim_update(handles[i], ds);
+            }
+            else
+            {
+                state_manager.sim_edit(handles[i]) = ds;
+            }
+
+            if (state_manager.sim_get_dynamic_state(handles[i]).value != ds.value)
+                num_errors.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        REQUIRE(num_errors.load(std::memory_order_relaxed) == 0);
+
+        constexpr uint64_t NumRecreatedPerTick = NumHandles / RecreateStride;
+        REQUIRE(consumer.num_creates == NumHandles + tick * NumRecreatedPerTick);
+        REQUIRE(consumer.num_destroys == tick * NumRecreatedPerTick);
+        REQUIRE(consumer.num_updates == tick * (NumHandles - NumRecreatedPerTick));
+
+        for (size_t i = 0; i < NumHandles; ++i)
+        {
+            REQUIRE(state_manager.get_static_state(handles[i]).index == i);
+            REQUIRE(state_manager.rend_get_dynamic_state(handles[i]).value == expected_value(tick, i));
+        }
+    }
+
+    REQUIRE(state_manager.get_tick_stats().num_ticks_published == NumTicks + 1);
+
+    state_manager.unregister_rend_consumer(&consumer);
+}
@@ -2,7 +2,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
+#include <span>
 #include <thread>
 #include <vector>
 
@@ -29,6 +31,11 @@ struct TestDynamicState
         return value != other.value || count != other.count || enabled != other.enabled;
     }
 
+    bool has_changed(const TestDynamicState& other, float epsilon) const
+    {
+        return std::abs(value - other.value) > epsilon || count != other.count || enabled != other.enabled;
+    }
+
     TestDynamicState interpolate(const TestDynamicState& other, double alpha) const
     {
         const float a = static_cast<float>(alpha);
@@ -64,6 +71,43 @@ struct TestConfigNoInterp
     static constexpr std::string_view Identifier = "TestStateManagerNoInterp";
 };
 
+struct TestConfigCoalesce
+{
+    static constexpr uint64_t MaxNumHandles = 8;
+    static constexpr bool Interpolate = true;
+    static constexpr StateManagerOverflowPolicy OverflowPolicy = StateManagerOverflowPolicy::CoalesceOldest;
+
+    static constexpr std::string_view Identifier = "TestStateManagerCoalesce";
+};
+
+struct TestConfigDropIntermediate
+{
+    static constexpr uint64_t MaxNumHandles = 8;
+    static constexpr bool Interpolate = true;
+    static constexpr StateManagerOverflowPolicy OverflowPolicy = StateManagerOverflowPolicy::DropIntermediate;
+
+    static constexpr std::string_view Identifier = "TestStateManagerDropIntermediate";
+};
+
+struct TestConfigSuppressUnchanged
+{
+    static constexpr uint64_t MaxNumHandles = 8;
+    static constexpr bool Interpolate = true;
+    static constexpr bool SuppressUnchangedUpdates = true;
+
+    static constexpr std::string_view Identifier = "TestStateManagerSuppressUnchanged";
+};
+
+struct TestConfigChangeEpsilon
+{
+    static constexpr uint64_t MaxNumHandles = 8;
+    static constexpr bool Interpolate = true;
+    static constexpr bool SuppressUnchangedUpdates = true;
+    static constexpr float ChangeEpsilon = 0.1f;
+
+    static constexpr std::string_view Identifier = "TestStateManagerChangeEpsilon";
+};
+
 struct RecordedRenderEvent
 {
     enum class Kind
@@ -223,6 +267,37 @@ class TestStateManagerNoInterpHarness : public TestStateManagerNoInterpBase
     RecordingRenderConsumer<TestStateManagerNoInterpBase> m_default_consumer;
 };
 
+template <typename Config>
+class TestOverflowStateManagerHarness : public BaseStateManager<TestStaticState, TestDynamicState, TestHandle, Config>
+{
+  public:
+    using Base = BaseStateManager<TestStaticState, TestDynamicState, TestHandle, Config>;
+
+    TestOverflowStateManagerHarness() { this->register_rend_consumer(&m_default_consumer); }
+
+    ~TestOverflowStateManagerHarness() override { this->unregister_rend_consumer(&m_default_consumer); }
+
+    void tick(uint64_t sim_time_us, TestHandle handle, float value)
+    {
+        this->sim_begin_tick(TickUpdateState{sim_time_us});
+        this->sim_update(handle, TestDynamicState{value, static_cast<int32_t>(value), false});
+        this->sim_end_tick();
+    }
+
+    void apply_render(uint64_t render_time_us)
+    {
+        m_default_consumer.set_render_time_us(render_time_us);
+        this->rend_apply_updates(FrameUpdateState{render_time_us});
+    }
+
+    void clear_events() { m_default_consumer.clear_events(); }
+
+    const std::vector<RecordedRenderEvent>& events() const { return m_default_consumer.events(); }
+
+  private:
+    RecordingRenderConsumer<Base> m_default_consumer;
+};
+
 TEST_CASE("BaseStateManager has correct identifier", "[StateManager]")
 {
     TestStateManagerHarness harness;
@@ -1010,6 +1085,105 @@ TEST_CASE("BaseStateManager duplicate consumer registrations deliver duplicates"
     harness.unregister_rend_consumer(&consumer);
 }
 
+class BatchRecordingRenderConsumer : public IStateManagerConsumer<TestStateManagerBase>
+{
+  public:
+    // One entry per callback, 'C' create, 'D' destroy and 'U' for a batch of updates
+    std::vector<char> calls;
+    std::vector<std::vector<float>> batches;
+    uint32_t num_single_updates = 0;
+
+    void rend_on_create(TestHandle, const TestStaticState&, const TestDynamicState&) override { calls.push_back('C'); }
+    void rend_on_update(TestHandle, const TestDynamicState&) override { num_single_updates += 1; }
+    void rend_on_destroy(TestHandle) override { calls.push_back('D'); }
+
+    void rend_on_update_batch(std::span<const TestHandle> handles, std::span<const TestDynamicState> dss) override
+    {
+        REQUIRE(handles.size() == dss.size());
+
+        calls.push_back('U');
+
+        std::vector<float>& batch = batches.emplace_back();
+        for (const TestDynamicState& ds : dss)
+        {
+            batch.push_back(ds.value);
+        }
+    }
+
+    void clear()
+    {
+        calls.clear();
+        batches.clear();
+    }
+};
+
+TEST_CASE("BaseStateManager delivers the updates of a tick in batches", "[StateManager]")
+{
+    TestStateManagerBase state_manager;
+    BatchRecordingRenderConsumer consumer;
+    state_manager.register_rend_consumer(&consumer);
+
+    std::vector<TestHandle> handles;
+
+    state_manager.sim_begin_tick(TickUpdateState{100});
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        handles.push_back(state_manager.sim_create(TestStaticState{i}, TestDynamicState{0.0f, 0, false}));
+    }
+    state_manager.sim_end_tick();
+
+    state_manager.rend_apply_updates(FrameUpdateState{100});
+    REQUIRE(consumer.calls == std::vector<char>{'C', 'C', 'C', 'C'});
+    consumer.clear();
+
+    state_manager.sim_begin_tick(TickUpdateState{200});
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        state_manager.sim_update(handles[i], TestDynamicState{static_cast<float>(i + 1) * 10.0f, 0, false});
+    }
+    state_manager.sim_end_tick();
+
+    SECTION("Interpolated updates are sent in one batch")
+    {
+        state_manager.rend_apply_updates(FrameUpdateState{150});
+
+        REQUIRE(consumer.calls == std::vector<char>{'U'});
+        REQUIRE(consumer.batches[0].size() == 4);
+        REQUIRE(consumer.batches[0][0] == Catch::Approx(5.0f));
+        REQUIRE(consumer.batches[0][3] == Catch::Approx(20.0f));
+        REQUIRE(state_manager.rend_get_dynamic_state(handles[3]).value == Catch::Approx(20.0f));
+        consumer.clear();
+
+        state_manager.rend_apply_updates(FrameUpdateState{200});
+
+        REQUIRE(consumer.calls == std::vector<char>{'U'});
+        REQUIRE(consumer.batches[0] == std::vector<float>{10.0f, 20.0f, 30.0f, 40.0f});
+    }
+
+    SECTION("Creates and destroys split the batches to keep the event order")
+    {
+        state_manager.rend_apply_updates(FrameUpdateState{200});
+        consumer.clear();
+
+        state_manager.sim_begin_tick(TickUpdateState{300});
+        state_manager.sim_update(handles[0], TestDynamicState{1.0f, 0, false});
+        state_manager.sim_destroy(handles[1]);
+        state_manager.sim_update(handles[2], TestDynamicState{3.0f, 0, false});
+        state_manager.sim_update(handles[3], TestDynamicState{4.0f, 0, false});
+        state_manager.sim_end_tick();
+
+        state_manager.rend_apply_updates(FrameUpdateState{300});
+
+        REQUIRE(consumer.calls == std::vector<char>{'U', 'D', 'U'});
+        REQUIRE(consumer.batches[0] == std::vector<float>{1.0f});
+        REQUIRE(consumer.batches[1] == std::vector<float>{3.0f, 4.0f});
+    }
+
+    REQUIRE(consumer.num_single_updates == 0);
+
+    state_manager.unregister_rend_consumer(&consumer);
+}
+
 TEST_CASE("BaseStateManager reclaims handle IDs after destroy tick is fully consumed", "[StateManager]")
 {
     TestStateManagerHarness harness;
@@ -1141,4 +1315,389 @@ TEST_CASE("BaseStateManager waits when sim gets MaxTicksAhead of render", "[Stat
     REQUIRE(published_ticks.load(std::memory_order_acquire) == MaxTicksAhead);
     REQUIRE(overflow_tick_started.load(std::memory_order_acquire) == true);
     REQUIRE(overflow_tick_finished.load(std::memory_order_acquire) == true);
+
+    const StateManagerTickStats stats = harness.get_tick_stats();
+    REQUIRE(stats.num_ticks_published == MaxTicksAhead + 1);
+    REQUIRE(stats.num_ticks_coalesced == 0);
+    REQUIRE(stats.num_sim_stalls == 1);
+    REQUIRE(stats.sim_stall_time_ns > 0);
+}
+
+TEST_CASE("BaseStateManager coalesce overflow policy merges unconsumed ticks", "[StateManager]")
+{
+    TestOverflowStateManagerHarness<TestConfigCoalesce> harness;
+
+    harness.sim_begin_tick(TickUpdateState{100});
+    const TestHandle handle = harness.sim_create(TestStaticState{0}, TestDynamicState{1.0f, 1, false});
+    harness.sim_end_tick();
+    harness.apply_render(100);
+    harness.clear_events();
+
+    SECTION("no tick claimed by render")
+    {
+        harness.tick(200, handle, 2.0f);
+
+        // Created and destroyed inside the coalesced ticks, render never sees it
+        harness.sim_begin_tick(TickUpdateState{300});
+        harness.sim_update(handle, TestDynamicState{3.0f, 3, false});
+        const TestHandle transient = harness.sim_create(TestStaticState{1}, TestDynamicState{});
+        harness.sim_end_tick();
+
+        harness.sim_begin_tick(TickUpdateState{400});
+        harness.sim_update(handle, TestDynamicState{4.0f, 4, false});
+        harness.sim_destroy(transient);
+        harness.sim_end_tick();
+
+        harness.tick(500, handle, 5.0f);
+        harness.tick(600, handle, 6.0f);
+
+        // Sim is MaxTicksAhead ticks ahead, this must not block
+        harness.sim_begin_tick(TickUpdateState{700});
+        harness.sim_update(handle, TestDynamicState{7.0f, 7, false});
+        const TestHandle reused = harness.sim_create(TestStaticState{2}, TestDynamicState{});
+        harness.sim_end_tick();
+
+        REQUIRE(reused.get_internal_id() == transient.get_internal_id());
+        REQUIRE(reused.get_generation() > transient.get_generation());
+
+        const StateManagerTickStats stats = harness.get_tick_stats();
+        REQUIRE(stats.num_ticks_coalesced == MaxTicksAhead - 1);
+        REQUIRE(stats.num_sim_stalls == 0);
+
+        harness.apply_render(700);
+        REQUIRE(harness.events().size() == 1);
+        REQUIRE(harness.events()[0].kind == RecordedRenderEvent::Kind::Update);
+        REQUIRE(harness.events()[0].value == Catch::Approx(6.0f));
+
+        harness.clear_events();
+
+        harness.apply_render(700);
+        REQUIRE(harness.events().size() == 2);
+        REQUIRE(harness.events()[0].kind == RecordedRenderEvent::Kind::Update);
+        REQUIRE(harness.events()[0].value == Catch::Approx(7.0f));
+        REQUIRE(harness.events()[1].kind == RecordedRenderEvent::Kind::Create);
+        REQUIRE(harness.events()[1].handle_idx == reused.get_internal_id());
+    }
+
+    SECTION("oldest tick being interpolated by render")
+    {
+        for (uint64_t tick = 2; tick <= MaxTicksAhead + 1; ++tick)
+        {
+            harness.tick(tick * 100, handle, static_cast<float>(tick));
+        }
+
+        // Halfway through tick 2, it can't be merged anymore
+        harness.apply_render(150);
+        REQUIRE(harness.events().size() == 1);
+        REQUIRE(harness.events()[0].value == Catch::Approx(1.5f));
+        harness.clear_events();
+
+        harness.tick(700, handle, 7.0f);
+        REQUIRE(harness.get_tick_stats().num_ticks_coalesced == MaxTicksAhead - 2);
+
+        harness.apply_render(200);
+        REQUIRE(harness.events().size() == 1);
+        REQUIRE(harness.events()[0].value == Catch::Approx(2.0f));
+        harness.clear_events();
+
+        harness.apply_render(600);
+        REQUIRE(harness.events().size() == 1);
+        REQUIRE(harness.events()[0].value == Catch::Approx(6.0f));
+        harness.clear_events();
+
+        harness.apply_render(700);
+        REQUIRE(harness.events().size() == 1);
+        REQUIRE(harness.events()[0].value == Catch::Approx(7.0f));
+    }
+}
+
+TEST_CASE("BaseStateManager drop intermediate overflow policy keeps the tick open", "[StateManager]")
+{
+    TestOverflowStateManagerHarness<TestConfigDropIntermediate> harness;
+
+    harness.sim_begin_tick(TickUpdateState{100});
+    const TestHandle handle = harness.sim_create(TestStaticState{0}, TestDynamicState{1.0f, 1, false});
+    harness.sim_end_tick();
+    harness.apply_render(100);
+    harness.clear_events();
+
+    for (uint64_t tick = 2; tick <= MaxTicksAhead + 2; ++tick)
+    {
+        harness.tick(tick * 100, handle, static_cast<float>(tick));
+    }
+
+    // The last two sim ticks could not be published
+    REQUIRE(harness.get_tick_stats().num_ticks_published == MaxTicksAhead);
+    REQUIRE(harness.get_tick_stats().num_ticks_coalesced == 2);
+    REQUIRE(harness.sim_get_dynamic_state(handle).value == Catch::Approx(static_cast<float>(MaxTicksAhead + 2)));
+
+    harness.apply_render(200);
+    harness.clear_events();
+
+    // Render freed a slot, the open tick gets published with the latest state
+    const uint64_t last_tick_time = (MaxTicksAhead + 3) * 100;
+    harness.tick(last_tick_time, handle, 42.0f);
+    REQUIRE(harness.get_tick_stats().num_ticks_published == MaxTicksAhead + 1);
+
+    for (uint64_t tick = 3; tick < MaxTicksAhead + 1; ++tick)
+    {
+        harness.apply_render(tick * 100);
+    }
+    harness.clear_events();
+
+    harness.apply_render(last_tick_time);
+    REQUIRE(harness.events().size() == 1);
+    REQUIRE(harness.events()[0].kind == RecordedRenderEvent::Kind::Update);
+    REQUIRE(harness.events()[0].value == Catch::Approx(42.0f));
+    REQUIRE(harness.get_tick_stats().num_sim_stalls == 0);
+}
+
+TEST_CASE("BaseStateManager supports a runtime max number of handles", "[StateManager]")
+{
+    constexpr uint64_t MaxNumHandles = 5000;
+
+    TestStateManagerBase state_manager{MaxNumHandles};
+    RecordingRenderConsumer<TestStateManagerBase> consumer;
+    state_manager.register_rend_consumer(&consumer);
+
+    REQUIRE(TestStateManagerHarness{}.get_max_num_handles() == TestConfig::MaxNumHandles);
+    REQUIRE(state_manager.get_max_num_handles() == MaxNumHandles);
+
+    std::vector<TestHandle> handles;
+
+    state_manager.sim_begin_tick(TickUpdateState{100});
+    for (uint32_t i = 0; i < MaxNumHandles; ++i)
+    {
+        handles.push_back(
+            state_manager.sim_create(TestStaticState{i}, TestDynamicState{static_cast<float>(i), 0, false}));
+    }
+    state_manager.sim_end_tick();
+
+    consumer.set_render_time_us(100);
+    state_manager.rend_apply_updates(FrameUpdateState{100});
+
+    REQUIRE(consumer.events().size() == MaxNumHandles);
+    REQUIRE(handles.back().get_internal_id() == MaxNumHandles - 1);
+    REQUIRE(state_manager.get_static_state(handles.back()).value == MaxNumHandles - 1);
+    consumer.clear_events();
+
+    state_manager.sim_begin_tick(TickUpdateState{200});
+    for (const TestHandle& handle : handles)
+    {
+        state_manager.sim_edit(handle).count = 1;
+    }
+    state_manager.sim_destroy(handles.front());
+    state_manager.sim_end_tick();
+
+    consumer.set_render_time_us(200);
+    state_manager.rend_apply_updates(FrameUpdateState{200});
+
+    REQUIRE(consumer.events().size() == MaxNumHandles);
+    REQUIRE(consumer.events().front().kind == RecordedRenderEvent::Kind::Destroy);
+    REQUIRE(state_manager.rend_get_dynamic_state(handles.back()).count == 1);
+    REQUIRE(state_manager.rend_get_dynamic_state(handles.back()).value == Catch::Approx(4999.0f));
+
+    // The destroyed id is the only one that can be reused
+    state_manager.sim_begin_tick(TickUpdateState{300});
+    const TestHandle reused = state_manager.sim_create(TestStaticState{}, TestDynamicState{});
+    state_manager.sim_end_tick();
+
+    REQUIRE(reused.get_internal_id() == handles.front().get_internal_id());
+    REQUIRE(reused.get_generation() > handles.front().get_generation());
+
+    state_manager.unregister_rend_consumer(&consumer);
+}
+
+TEST_CASE("BaseStateManager publishes unchanged updates by default", "[StateManager]")
+{
+    TestStateManagerHarness harness;
+
+    harness.begin_tick(100);
+    const TestHandle handle = harness.create(0, TestDynamicState{1.0f, 1, false});
+    harness.end_tick();
+    harness.apply_render(100);
+    harness.clear_events();
+
+    harness.begin_tick(200);
+    harness.update(handle, TestDynamicState{1.0f, 1, false});
+    harness.end_tick();
+    harness.apply_render(200);
+
+    REQUIRE(harness.events().size() == 1);
+    REQUIRE(harness.get_tick_stats().num_updates_published == 1);
+    REQUIRE(harness.get_tick_stats().num_updates_suppressed == 0);
+}
+
+TEST_CASE("BaseStateManager suppresses unchanged updates", "[StateManager]")
+{
+    TestOverflowStateManagerHarness<TestConfigSuppressUnchanged> harness;
+
+    harness.sim_begin_tick(TickUpdateState{100});
+    const TestHandle handle = harness.sim_create(TestStaticState{0}, TestDynamicState{1.0f, 1, false});
+    harness.sim_end_tick();
+    harness.apply_render(100);
+    harness.clear_events();
+
+    SECTION("Updates with the published state don't publish a tick")
+    {
+        harness.tick(200, handle, 1.0f);
+        harness.apply_render(200);
+
+        REQUIRE(harness.events().empty());
+        REQUIRE(harness.get_tick_stats().num_ticks_published == 1);
+        REQUIRE(harness.get_tick_stats().num_updates_published == 0);
+        REQUIRE(harness.get_tick_stats().num_updates_suppressed == 1);
+
+        harness.tick(300, handle, 2.0f);
+        harness.apply_render(300);
+
+        REQUIRE(harness.events().size() == 1);
+        REQUIRE(harness.events()[0].value == Catch::Approx(2.0f));
+        REQUIRE(harness.get_tick_stats().num_updates_published == 1);
+    }
+
+    SECTION("Unchanged sim_edit and updates reverted in the same tick are dropped")
+    {
+        harness.sim_begin_tick(TickUpdateState{200});
+        harness.sim_edit(handle).enabled = false;
+        harness.sim_end_tick();
+
+        harness.sim_begin_tick(TickUpdateState{300});
+        harness.sim_update(handle, TestDynamicState{5.0f, 5, true});
+        harness.sim_update(handle, TestDynamicState{1.0f, 1, false});
+        harness.sim_end_tick();
+
+        harness.apply_render(300);
+
+        REQUIRE(harness.events().empty());
+        REQUIRE(harness.get_tick_stats().num_ticks_published == 1);
+        REQUIRE(harness.get_tick_stats().num_updates_suppressed == 2);
+    }
+
+    SECTION("Create and destroy events are never suppressed")
+    {
+        harness.sim_begin_tick(TickUpdateState{200});
+        const TestHandle other = harness.sim_create(TestStaticState{1}, TestDynamicState{});
+        harness.sim_update(other, TestDynamicState{});
+        harness.sim_destroy(handle);
+        harness.sim_end_tick();
+
+        harness.apply_render(200);
+
+        REQUIRE(harness.events().size() == 2);
+        REQUIRE(harness.events()[0].kind == RecordedRenderEvent::Kind::Create);
+        REQUIRE(harness.events()[1].kind == RecordedRenderEvent::Kind::Destroy);
+    }
+}
+
+TEST_CASE("BaseStateManager ChangeEpsilon accumulates small changes", "[StateManager]")
+{
+    TestOverflowStateManagerHarness<TestConfigChangeEpsilon> harness;
+
+    harness.sim_begin_tick(TickUpdateState{100});
+    const TestHandle handle = harness.sim_create(TestStaticState{0}, TestDynamicState{1.0f, 1, false});
+    harness.sim_end_tick();
+    harness.apply_render(100);
+    harness.clear_events();
+
+    const auto update_value = [&](uint64_t sim_time_us, float value) {
+        harness.sim_begin_tick(TickUpdateState{sim_time_us});
+        harness.sim_update(handle, TestDynamicState{value, 1, false});
+        harness.sim_end_tick();
+    };
+
+    // Both changes are below the epsilon compared to the published state
+    update_value(200, 1.06f);
+    update_value(300, 0.95f);
+    REQUIRE(harness.get_tick_stats().num_updates_suppressed == 2);
+
+    // Compared against the published 1.0 and not against the suppressed 1.06
+    update_value(400, 1.12f);
+    harness.apply_render(400);
+
+    REQUIRE(harness.events().size() == 1);
+    REQUIRE(harness.events()[0].value == Catch::Approx(1.12f));
+    REQUIRE(harness.get_tick_stats().num_updates_published == 1);
+}
+
+TEST_CASE("BaseStateManager merges the writes of multiple threads in handle order", "[StateManager]")
+{
+    TestStateManagerBase state_manager{};
+    RecordingRenderConsumer<TestStateManagerBase> consumer;
+    state_manager.register_rend_consumer(&consumer);
+
+    std::vector<TestHandle> handles;
+
+    state_manager.sim_begin_tick(TickUpdateState{100});
+    for (uint32_t i = 0; i < TestConfig::MaxNumHandles; ++i)
+    {
+        handles.push_back(state_manager.sim_create(TestStaticState{i}, TestDynamicState{}));
+    }
+    state_manager.sim_end_tick();
+
+    consumer.set_render_time_us(100);
+    state_manager.rend_apply_updates(FrameUpdateState{100});
+    consumer.clear_events();
+
+    SECTION("Writes from different threads are sorted by handle")
+    {
+        // Both threads stay alive until both have written, so they don't share a staging buffer
+        std::atomic<uint32_t> num_finished = 0;
+        const auto write_handles = [&](int32_t first, bool use_edit) {
+            for (int32_t i = first; i >= 0; i -= 2)
+            {
+                const TestHandle handle = handles[static_cast<size_t>(i)];
+                if (use_edit)
+                    state_manager.sim_edit(handle).value = static_cast<float>(i);
+                else
+                    state_manager.sim_update(handle, TestDynamicState{static_cast<float>(i), 0, false});
+            }
+
+            num_finished.fetch_add(1, std::memory_order_acq_rel);
+            while (num_finished.load(std::memory_order_acquire) != 2)
+            {
+                std::this_thread::yield();
+            }
+        };
+
+        state_manager.sim_begin_tick(TickUpdateState{200});
+        std::thread odd_writer(write_handles, 7, false);
+        std::thread even_writer(write_handles, 6, true);
+        odd_writer.join();
+        even_writer.join();
+        state_manager.sim_end_tick();
+
+        consumer.set_render_time_us(200);
+        state_manager.rend_apply_updates(FrameUpdateState{200});
+
+        REQUIRE(consumer.events().size() == handles.size());
+        for (size_t i = 0; i < handles.size(); ++i)
+        {
+            REQUIRE(consumer.events()[i].kind == RecordedRenderEvent::Kind::Update);
+            REQUIRE(consumer.events()[i].handle_idx == handles[i].get_internal_id());
+            REQUIRE(consumer.events()[i].value == Catch::Approx(static_cast<float>(i)));
+        }
+    }
+
+    SECTION("Writes from a single thread keep their order")
+    {
+        state_manager.sim_begin_tick(TickUpdateState{200});
+        std::thread writer([&] {
+            for (size_t i = handles.size(); i > 0; --i)
+            {
+                state_manager.sim_update(handles[i - 1], TestDynamicState{static_cast<float>(i - 1), 0, false});
+            }
+        });
+        writer.join();
+        state_manager.sim_end_tick();
+
+        consumer.set_render_time_us(200);
+        state_manager.rend_apply_updates(FrameUpdateState{200});
+
+        REQUIRE(consumer.events().size() == handles.size());
+        REQUIRE(consumer.events().front().handle_idx == handles.back().get_internal_id());
+        REQUIRE(consumer.events().back().handle_idx == handles.front().get_internal_id());
+    }
+
+    state_manager.unregister_rend_consumer(&consumer);
 }
@@ -1,8 +1,14 @@
 #include <catch2/catch_all.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
+#include "core/job_system/job_system.h"
 #include "state_manager/state_manager.h"
 #include "state_manager/state_manager_coordinator.h"
 
@@ -250,3 +256,221 @@ TEST_CASE("Build is stable across multiple rebuilds", "[StateManagerCoordinator]
     REQUIRE(index_of(order, "B") < index_of(order, "D"));
     REQUIRE(index_of(order, "C") < index_of(order, "D"));
 }
+
+class ConcurrentMockStateManager : public IStateManager
+{
+  public:
+    ConcurrentMockStateManager(std::string_view identifier, std::atomic<uint32_t>& clock)
+        : m_identifier(identifier)
+        , m_clock(clock)
+    {
+    }
+
+    void sim_make_room_for_tick() override { make_room_thread_id = std::this_thread::get_id(); }
+    void sim_begin_tick(const TickUpdateState&) override { record(); }
+    void sim_end_tick() override { record(); }
+    void rend_apply_updates(const FrameUpdateState&) override { record(); }
+
+    std::string_view get_identifier() const override { return m_identifier; }
+
+    uint32_t begin_time = 0;
+    uint32_t end_time = 0;
+    uint32_t num_calls = 0;
+    std::thread::id thread_id{};
+    std::thread::id make_room_thread_id{};
+
+  private:
+    std::string_view m_identifier;
+    std::atomic<uint32_t>& m_clock;
+
+    void record()
+    {
+        begin_time = m_clock.fetch_add(1, std::memory_order_acq_rel);
+        thread_id = std::this_thread::get_id();
+        num_calls += 1;
+
+        // Widen the window so managers running at the same time overlap
+        std::this_thread::yield();
+
+        end_time = m_clock.fetch_add(1, std::memory_order_acq_rel);
+    }
+};
+
+struct StateManagerCoordinatorJobSystemScope
+{
+    JobSystem job_system;
+    bool initialized = false;
+
+    ~StateManagerCoordinatorJobSystemScope()
+    {
+        if (initialized)
+        {
+            job_system.wait_workers_dead();
+        }
+    }
+};
+
+TEST_CASE("Parallel dispatch respects dependencies", "[StateManagerCoordinator]")
+{
+    StateManagerCoordinatorJobSystemScope scope;
+    REQUIRE(scope.job_system.init(4, false));
+    scope.initialized = true;
+
+    std::atomic<uint32_t> clock = 0;
+
+    // Same graph as the renderer state managers, plus a manager with more inputs than a single job can depend on
+    ConcurrentMockStateManager transform("Transform", clock);
+    ConcurrentMockStateManager view("View", clock);
+    ConcurrentMockStateManager layer("Layer", clock);
+    ConcurrentMockStateManager volume("Volume", clock);
+    ConcurrentMockStateManager mesh("Mesh", clock);
+    ConcurrentMockStateManager light("Light", clock);
+
+    std::vector<std::string> leaf_identifiers;
+    for (size_t i = 0; i < MAX_STATE_MANAGER_DEPENDENCIES; ++i)
+        leaf_identifiers.push_back("Leaf" + std::to_string(i));
+
+    std::vector<std::unique_ptr<ConcurrentMockStateManager>> leaves;
+    for (const std::string& identifier : leaf_identifiers)
+        leaves.push_back(std::make_unique<ConcurrentMockStateManager>(identifier, clock));
+
+    ConcurrentMockStateManager fan_in("FanIn", clock);
+
+    StateManagerCoordinatorDescription desc{};
+    desc.job_system = &scope.job_system;
+
+    StateManagerCoordinator coordinator{desc};
+
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&transform));
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&view));
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&layer).depends_on(&view));
+    coordinator.register_state_manager(
+        StateManagerRegistrationBuilder::begin(&volume).depends_on(&transform).depends_on(&view).depends_on(&layer));
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&mesh).depends_on(&transform));
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&light)
+                                           .depends_on(&transform)
+                                           .depends_on(&view)
+                                           .depends_on(&layer)
+                                           .depends_on(&volume));
+
+    auto fan_in_builder = StateManagerRegistrationBuilder::begin(&fan_in);
+    for (const std::unique_ptr<ConcurrentMockStateManager>& leaf : leaves)
+    {
+        coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(leaf.get()));
+        fan_in_builder.depends_on(leaf.get());
+    }
+    coordinator.register_state_manager(fan_in_builder);
+
+    const auto happens_before = [](const ConcurrentMockStateManager& input, const ConcurrentMockStateManager& output) {
+        return input.end_time < output.begin_time;
+    };
+
+    constexpr uint32_t NumIterations = 64;
+    for (uint32_t iteration = 0; iteration < NumIterations; ++iteration)
+    {
+        switch (iteration % 3)
+        {
+        case 0:
+            coordinator.sim_begin_tick(TickUpdateState{});
+            break;
+        case 1:
+            coordinator.sim_end_tick();
+            break;
+        case 2:
+            coordinator.rend_apply_updates(FrameUpdateState{});
+            break;
+        }
+
+        REQUIRE(transform.num_calls == iteration + 1);
+        REQUIRE(light.num_calls == iteration + 1);
+        REQUIRE(fan_in.num_calls == iteration + 1);
+
+        REQUIRE(happens_before(view, layer));
+        REQUIRE(happens_before(transform, volume));
+        REQUIRE(happens_before(view, volume));
+        REQUIRE(happens_before(layer, volume));
+        REQUIRE(happens_before(transform, mesh));
+        REQUIRE(happens_before(transform, light));
+        REQUIRE(happens_before(view, light));
+        REQUIRE(happens_before(layer, light));
+        REQUIRE(happens_before(volume, light));
+
+        for (const std::unique_ptr<ConcurrentMockStateManager>& leaf : leaves)
+        {
+            REQUIRE(leaf->num_calls == iteration + 1);
+            REQUIRE(happens_before(*leaf, fan_in));
+        }
+    }
+}
+
+TEST_CASE("Parallel dispatch makes room for the tick on the calling thread", "[StateManagerCoordinator]")
+{
+    StateManagerCoordinatorJobSystemScope scope;
+    REQUIRE(scope.job_system.init(2, false));
+    scope.initialized = true;
+
+    std::atomic<uint32_t> clock = 0;
+
+    ConcurrentMockStateManager manager_a("A", clock);
+    ConcurrentMockStateManager manager_b("B", clock);
+
+    StateManagerCoordinatorDescription desc{};
+    desc.job_system = &scope.job_system;
+
+    StateManagerCoordinator coordinator{desc};
+
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&manager_a));
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&manager_b));
+
+    coordinator.sim_begin_tick(TickUpdateState{});
+
+    // Blocking on the render must not stall a worker
+    REQUIRE(manager_a.make_room_thread_id == std::this_thread::get_id());
+    REQUIRE(manager_b.make_room_thread_id == std::this_thread::get_id());
+    REQUIRE(manager_a.num_calls == 1);
+    REQUIRE(manager_b.num_calls == 1);
+}
+
+TEST_CASE("Serial dispatch runs on the calling thread in topological order", "[StateManagerCoordinator]")
+{
+    StateManagerCoordinatorJobSystemScope scope;
+    REQUIRE(scope.job_system.init(2, false));
+    scope.initialized = true;
+
+    std::atomic<uint32_t> clock = 0;
+
+    ConcurrentMockStateManager manager_a("A", clock);
+    ConcurrentMockStateManager manager_b("B", clock);
+    ConcurrentMockStateManager manager_c("C", clock);
+
+    StateManagerCoordinatorDescription desc{};
+    desc.job_system = &scope.job_system;
+    desc.serial_dispatch = true;
+
+    StateManagerCoordinator coordinator{desc};
+    REQUIRE(coordinator.is_serial_dispatch());
+
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&manager_a));
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&manager_b).depends_on(&manager_a));
+    coordinator.register_state_manager(StateManagerRegistrationBuilder::begin(&manager_c));
+
+    coordinator.rend_apply_updates(FrameUpdateState{});
+
+    REQUIRE(manager_a.thread_id == std::this_thread::get_id());
+    REQUIRE(manager_b.thread_id == std::this_thread::get_id());
+    REQUIRE(manager_c.thread_id == std::this_thread::get_id());
+
+    // Managers run one after another in topological order: A, C, B
+    REQUIRE(manager_a.end_time < manager_c.begin_time);
+    REQUIRE(manager_c.end_time < manager_b.begin_time);
+
+    coordinator.set_serial_dispatch(false);
+    REQUIRE_FALSE(coordinator.is_serial_dispatch());
+
+    coordinator.rend_apply_updates(FrameUpdateState{});
+
+    REQUIRE(manager_a.num_calls == 2);
+    REQUIRE(manager_b.num_calls == 2);
+    REQUIRE(manager_c.num_calls == 2);
+    REQUIRE(manager_a.end_time < manager_b.begin_time);
+}